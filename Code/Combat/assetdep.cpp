@@ -41,12 +41,15 @@
 #include "ffactory.h"
 #include "saveloadstatus.h"
 #include "wwprofile.h"
+#include "asyncfileio.h"
+#include "mappedfile.h"
 
 ///////////////////////////////////////////////////////////////////////
 //	Local prototypes
 ///////////////////////////////////////////////////////////////////////
 static void Asset_Name_From_Filename (StringClass& new_name, const char *filename);
 static void Get_Filename_From_Path (StringClass& new_name, const char *filename);
+static void Load_Asset_Files (const DynamicVectorClass<StringClass> &filename_list);
 
 
 ///////////////////////////////////////////////////////////////////////
@@ -54,6 +57,7 @@ static void Get_Filename_From_Path (StringClass& new_name, const char *filename)
 ///////////////////////////////////////////////////////////////////////
 static const char * ALWAYS_FILENAME	= "always.dep";
 static const char * DEP_EXTENSION	= ".dep";
+static const int ASSET_READ_AHEAD	= 8;
 
 enum
 {
@@ -257,8 +261,9 @@ AssetDependencyManager::Load_Assets (ChunkLoadClass &cload)
 
 		//
 		//	Read the filename of each asset from the chunk and
-		// load its assets into the asset manager.
+		// make a list of the ones that aren't loaded yet.
 		//
+		DynamicVectorClass<StringClass> filename_list;
 		while (cload.Open_Micro_Chunk ()) {
 			switch (cload.Cur_Micro_Chunk_ID ())
 			{
@@ -277,15 +282,9 @@ AssetDependencyManager::Load_Assets (ChunkLoadClass &cload)
 					//
 					StringClass render_obj_name(0,true);
 					::Asset_Name_From_Filename (render_obj_name,filename);
-					INIT_SUB_STATUS(filename);
-
-					//
-					//	Load the assets from this file into the asset manager
-					//
 					if (WW3DAssetManager::Get_Instance ()->Render_Obj_Exists (render_obj_name) == false) {
-						WW3DAssetManager::Get_Instance ()->Load_3D_Assets (filename);
+						filename_list.Add (filename);
 					}
-//	WWLOG_INTERMEDIATE(filename);
 				}
 				break;
 
@@ -296,6 +295,11 @@ AssetDependencyManager::Load_Assets (ChunkLoadClass &cload)
 
 			cload.Close_Micro_Chunk ();
 		}
+
+		//
+		//	Load the assets from these files into the asset manager
+		//
+		::Load_Asset_Files (filename_list);
 	}
 
 	cload.Close_Chunk ();
@@ -303,6 +307,67 @@ AssetDependencyManager::Load_Assets (ChunkLoadClass &cload)
 }
 
 
+////////////////////////////////////////////////////////////////////////////
+//
+//  Load_Asset_Files
+//
+//	The files are read ahead on the async file IO threads, so the next few
+// are coming off the disk while each one is parsed.
+//
+////////////////////////////////////////////////////////////////////////////
+void
+Load_Asset_Files (const DynamicVectorClass<StringClass> &filename_list)
+{
+	WW3DAssetManager *asset_mgr	= WW3DAssetManager::Get_Instance ();
+	AsyncReadClass *read_list[ASSET_READ_AHEAD] = { NULL };
+	int count							= filename_list.Count ();
+	int next_read						= 0;
+
+	for (int index = 0; index < count; index ++) {
+
+		//
+		//	Keep the read ahead window full
+		//
+		while (next_read < count && next_read < index + ASSET_READ_AHEAD) {
+			read_list[next_read % ASSET_READ_AHEAD] = AsyncFileIOClass::Read_File (filename_list[next_read],
+				NULL, NULL, AsyncReadClass::PRIORITY_HIGH, AsyncReadClass::COMPLETE_ON_WORKER);
+			next_read ++;
+		}
+
+		const StringClass &filename	= filename_list[index];
+		AsyncReadClass *read				= read_list[index % ASSET_READ_AHEAD];
+		read_list[index % ASSET_READ_AHEAD] = NULL;
+
+		INIT_SUB_STATUS(filename);
+		AsyncFileIOClass::Wait (read);
+
+		//
+		//	An earlier file may have held this one's render object too
+		//
+		StringClass render_obj_name(0,true);
+		::Asset_Name_From_Filename (render_obj_name,filename);
+		if (asset_mgr->Render_Obj_Exists (render_obj_name) == false) {
+
+			//
+			//	Parse the data that was read, or fall back to opening the file
+			// here if it couldn't be read
+			//
+			if (read->Succeeded ()) {
+				MappedFileClass file (read->Peek_Data (), read->Get_Size (), filename);
+				asset_mgr->Load_3D_Assets (file);
+			} else {
+				asset_mgr->Load_3D_Assets (filename);
+			}
+		}
+//	WWLOG_INTERMEDIATE(filename);
+
+		read->Release_Ref ();
+	}
+
+	return ;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////
 //
 //  Get_Filename_From_Path
@@ -52,6 +52,7 @@
 #include "wwphysids.h"
 #include "damageablestaticphys.h"
 #include "wwprofile.h"
+#include "collisionprofiler.h"
 #include "part_emt.h"
 #include "realcrc.h"
 #include "soldier.h"
@@ -546,7 +547,7 @@ void BulletClass::Init( const BulletDataClass & data, float progress_time, const
 		// We don't need to do anything
 	} else {
 		RenderObjClass * model = NULL;
-		model = WW3DAssetManager::Get_Instance ()->Create_Render_Obj( BulletData.AmmoDefinition->ModelName );
+		model = WW3DAssetManager::Get_Instance ()->Create_Render_Obj( BulletData.AmmoDefinition->Get_Model_Atom() );
 
 		// If no name is given, lets create the NULL render obj
 		if ( model == NULL ) {
@@ -762,6 +763,7 @@ ExpirationReactionType	BulletClass::Object_Expired(PhysClass * observed_obj)
 void	BulletClass::Think( void )
 {
 	WWPROFILE( "Bullet Think" );
+	COLLISION_PROFILE_CATEGORY("Bullets");
 
 	// Count down safety timer
 	BulletData.GrenadeSafetyTimer -= TimeManager::Get_Frame_Seconds();
@@ -841,6 +843,7 @@ void	BulletClass::Think( void )
 void	Simulate_Instant_Bullet( BulletDataClass & data, float progress_time )
 {
 	WWPROFILE("Simulate_Instant_Bullet");
+	COLLISION_PROFILE_CATEGORY("Bullets");
 //	WWASSERT(data.Position.Is_Valid());
 //	WWASSERT(data.Velocity.Is_Valid());
 
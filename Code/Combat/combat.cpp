@@ -62,6 +62,7 @@
 #include "objectives.h"
 #include "conversationmgr.h"
 #include "bullet.h"
+#include "perceptionmgr.h"
 #include "dazzle.h"
 #include "messagewindow.h"
 #include "hudinfo.h"
@@ -322,6 +323,8 @@ void	CombatManager::Pre_Load_Level( bool render_available )
 
 	BulletManager::Init();
 
+	PerceptionManager::Init();
+
 	cEncoderList::Clear_Entries();
 
 	cPacket::Init_Encoder();
@@ -581,6 +584,9 @@ void	CombatManager::Unload_Level( void )
 	BulletManager::Shutdown();
 	WWLOG_INTERMEDIATE("BulletManager::Shutdown()");
 
+	PerceptionManager::Shutdown();
+	WWLOG_INTERMEDIATE("PerceptionManager::Shutdown()");
+
 	ObjectiveManager::Reset();
 	WWLOG_INTERMEDIATE("ObjectiveManager::Reset()");
 
@@ -701,6 +707,9 @@ void 	CombatManager::Think()
 {	WWPROFILE( "Game Obj Think" );
 	GameObjManager::Think();
 
+	// Run the sight checks the objects asked for this frame
+	PerceptionManager::Think();
+
 	// Now, Process all objects physically
 }{	WWPROFILE( "Scene" );
   	COMBAT_SCENE->Update( TimeManager::Get_Frame_Seconds(), 0 );
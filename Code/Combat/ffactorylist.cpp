@@ -36,6 +36,7 @@
 
 #include "ffactorylist.h"
 #include "wwfile.h"
+#include "realcrc.h"
 
 
 FileFactoryListClass * FileFactoryListClass::Instance = NULL;
@@ -62,9 +63,11 @@ FileFactoryListClass::~FileFactoryListClass( void )
 */
 void	FileFactoryListClass::Add_FileFactory( FileFactoryClass * factory, const char *name )
 {
+	CriticalSectionClass::LockClass lock(Mutex);
 	FactoryList.Add( factory );
 	FactoryNameList.Add( name );
-	Reset_Search_Start ();
+	Add_To_Index( FactoryList.Count() - 1 );
+	SearchStartIndex = 0;
 }
 
 
@@ -73,6 +76,8 @@ void	FileFactoryListClass::Add_FileFactory( FileFactoryClass * factory, const ch
 */
 void	FileFactoryListClass::Remove_FileFactory( FileFactoryClass * factory )
 {
+	CriticalSectionClass::LockClass lock(Mutex);
+
 	for (int index = 0; index < FactoryList.Count (); index ++) {
 
 		//
@@ -82,7 +87,8 @@ void	FileFactoryListClass::Remove_FileFactory( FileFactoryClass * factory )
 		if (FactoryList[index] == factory) {
 			FactoryList.Delete (index);
 			FactoryNameList.Delete (index);
-			Reset_Search_Start ();
+			Build_Index ();
+			SearchStartIndex = 0;
 			break;
 		}
 	}
@@ -106,27 +112,31 @@ void	FileFactoryListClass::Remove_FileFactory( FileFactoryClass * factory )
  *=============================================================================================*/
 FileFactoryClass *FileFactoryListClass::Remove_FileFactory(void)
 {
+	CriticalSectionClass::LockClass lock(Mutex);
 	FileFactoryClass *factory = NULL;
 
 	if (FactoryList.Count()) {
 		factory = FactoryList[0];
 		FactoryList.Delete(0);
 		FactoryNameList.Delete(0);
+		Build_Index();
 	}
 
-	Reset_Search_Start ();
+	SearchStartIndex = 0;
 	return(factory);
 }
 
 
 void	FileFactoryListClass::Add_Temp_FileFactory( FileFactoryClass * factory )
 {
+	CriticalSectionClass::LockClass lock(Mutex);
 	WWASSERT( TempFactory == NULL );
 	TempFactory = factory;
 }
 
 FileFactoryClass * FileFactoryListClass::Remove_Temp_FileFactory( void )
 {
+	CriticalSectionClass::LockClass lock(Mutex);
 	FileFactoryClass * factory = TempFactory;
 	TempFactory = NULL;
 	return factory;
@@ -136,6 +146,7 @@ FileFactoryClass * FileFactoryListClass::Remove_Temp_FileFactory( void )
 FileClass * FileFactoryListClass::Get_File( char const *filename )
 {
 	// Very kludgly...
+	CriticalSectionClass::LockClass lock(Mutex);
 
 	// Then the temp factory
 	if ( TempFactory ) {
@@ -150,26 +161,43 @@ FileClass * FileFactoryListClass::Get_File( char const *filename )
 	}
 
 	// Try the first in the list...
-	if ( SearchStartIndex < FactoryList.Count() ) {
-		FileClass * file = FactoryList[SearchStartIndex]->Get_File( filename );
-		if ( file != NULL ) {
-			if ( file->Is_Available() ) {
+	FileClass * file = Try_Factory( SearchStartIndex, filename );
+	if ( file != NULL ) {
+		return file;
+	}
+
+	// Then try the rest.  The indexed factories that don't have the file are
+	// skipped, only the ones that can't be indexed have to be asked.
+	int indexed = -1;
+	FileIndex.Get( CRC_Stringi( filename ), indexed );
+
+	int i;
+	for ( i = 0; i < UnindexedList.Count(); i++ ) {
+		if ( indexed >= 0 && UnindexedList[i] > indexed ) {
+			break;
+		}
+		if ( UnindexedList[i] != SearchStartIndex ) {
+			file = Try_Factory( UnindexedList[i], filename );
+			if ( file != NULL ) {
 				return file;
-			} else {
-				FactoryList[SearchStartIndex]->Return_File( file );
 			}
 		}
 	}
 
-	// Then try the rest
-	for ( int i = 0; i < FactoryList.Count(); i++ ) {
-		if (i != SearchStartIndex) {
-			FileClass * file = FactoryList[i]->Get_File( filename );
+	if ( indexed >= 0 ) {
+		if ( indexed != SearchStartIndex ) {
+			file = Try_Factory( indexed, filename );
 			if ( file != NULL ) {
-				if ( file->Is_Available() ) {
+				return file;
+			}
+		}
+
+		// The indexed file wasn't available, ask everything after it the old way
+		for ( i = indexed + 1; i < FactoryList.Count(); i++ ) {
+			if ( i != SearchStartIndex ) {
+				file = Try_Factory( i, filename );
+				if ( file != NULL ) {
 					return file;
-				} else {
-					FactoryList[i]->Return_File( file );
 				}
 			}
 		}
@@ -188,15 +216,35 @@ FileClass * FileFactoryListClass::Get_File( char const *filename )
 	return NULL;
 }
 
+FileClass * FileFactoryListClass::Try_Factory( int index, char const *filename )
+{
+	if ( index >= FactoryList.Count() ) {
+		return NULL;
+	}
+
+	FileClass * file = FactoryList[index]->Get_File( filename );
+	if ( file != NULL ) {
+		if ( file->Is_Available() ) {
+			return file;
+		} else {
+			FactoryList[index]->Return_File( file );
+		}
+	}
+
+	return NULL;
+}
+
 void FileFactoryListClass::Return_File( FileClass *file )
 {
 	// This is kinda bad. Just return it to the first one.  (Since they all do the same thing)
+	CriticalSectionClass::LockClass lock(Mutex);
 	FactoryList[0]->Return_File( file );
 }
 
 
 void FileFactoryListClass::Set_Search_Start( const char *name )
 {
+	CriticalSectionClass::LockClass lock(Mutex);
 	SearchStartIndex = 0;
 
 	//
@@ -210,3 +258,45 @@ void FileFactoryListClass::Set_Search_Start( const char *name )
 	}
 	return ;
 }
+
+void FileFactoryListClass::Reset_Search_Start( void )
+{
+	CriticalSectionClass::LockClass lock(Mutex);
+	SearchStartIndex = 0;
+	return ;
+}
+
+
+/*
+**	The index has to be rebuilt from scratch when a factory is removed, since the
+** factories after it move down the list.
+*/
+void FileFactoryListClass::Build_Index( void )
+{
+	FileIndex.Remove_All();
+	UnindexedList.Delete_All();
+
+	for (int index = 0; index < FactoryList.Count (); index ++) {
+		Add_To_Index( index );
+	}
+	return ;
+}
+
+void FileFactoryListClass::Add_To_Index( int index )
+{
+	DynamicVectorClass<unsigned long> crc_list;
+	if ( FactoryList[index]->Get_CRC_List( crc_list ) == false ) {
+		UnindexedList.Add( index );
+		return ;
+	}
+
+	//
+	//	Names already held by an earlier factory stay with it
+	//
+	for (int crc_index = 0; crc_index < crc_list.Count (); crc_index ++) {
+		if ( FileIndex.Exists( crc_list[crc_index] ) == false ) {
+			FileIndex.Insert( crc_list[crc_index], index );
+		}
+	}
+	return ;
+}
@@ -49,6 +49,9 @@
 	#include "ffactory.h"
 #endif
 
+#include "hashtemplate.h"
+#include "mutex.h"
+
 /*
 **
 */
@@ -63,7 +66,7 @@ public:
 	FileFactoryClass *Remove_FileFactory(void);
 
 	void	Set_Search_Start( const char *name );
-	void	Reset_Search_Start( void )					{ SearchStartIndex = 0; }
+	void	Reset_Search_Start( void );
 
 	void	Add_Temp_FileFactory( FileFactoryClass * factory );
 	FileFactoryClass * Remove_Temp_FileFactory( void );
@@ -79,11 +82,29 @@ public:
 
 private:
 
+	FileClass *	Try_Factory( int index, char const *filename );
+	void			Build_Index( void );
+	void			Add_To_Index( int index );
+
 	FileFactoryClass * TempFactory;
 	SimpleDynVecClass<FileFactoryClass *>	FactoryList;
 	DynamicVectorClass<StringClass>			FactoryNameList;
 	int												SearchStartIndex;
 
+	//
+	//	Index of the files in the factories that can list their contents (mix files),
+	// from the CRC_Stringi of a name to the first factory in the list that holds it.
+	// The factories that can't be indexed are kept in list order.
+	//
+	HashTemplateClass<unsigned long, int>	FileIndex;
+	DynamicVectorClass<int>						UnindexedList;
+
+	//
+	//	The list is shared with the async file IO workers, so every access to
+	// the factories, the index and the search start is made under this lock.
+	//
+	CriticalSectionClass							Mutex;
+
 	static FileFactoryListClass * Instance;
 };
 
@@ -0,0 +1,214 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/***********************************************************************************************
+ ***                            Confidential - Westwood Studios                              ***
+ ***********************************************************************************************
+ *                                                                                             *
+ *                 Project Name : Commando                                                     *
+ *                                                                                             *
+ *                     $Archive:: /Commando/Code/Combat/perceptionmgr.cpp                     $*
+ *                                                                                             *
+ *---------------------------------------------------------------------------------------------*
+ * Functions:                                                                                  *
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+#include "perceptionmgr.h"
+#include "smartgameobj.h"
+#include "combat.h"
+#include "soldier.h"
+#include "combatphysobserver.h"
+#include "pscene.h"
+#include "physlist.h"
+#include "gameobjobserver.h"
+#include "rendobj.h"
+#include "wwprofile.h"
+
+
+/*
+** Constants for this module
+*/
+const int	DEFAULT_MAX_RAYS_PER_FRAME	= 64;
+
+
+/*
+** Static members
+*/
+DynamicVectorClass<SmartGameObj *>							PerceptionManager::ScanList;
+DynamicVectorClass<PerceptionManager::RayTestStruct>	PerceptionManager::RayList;
+int																	PerceptionManager::RayHead				= 0;
+int																	PerceptionManager::MaxRaysPerFrame	= DEFAULT_MAX_RAYS_PER_FRAME;
+
+
+/*
+**
+*/
+void	PerceptionManager::Init( void )
+{
+	ScanList.Set_Growth_Step( 32 );
+	RayList.Set_Growth_Step( 128 );
+	Shutdown();
+}
+
+/*
+**
+*/
+void	PerceptionManager::Shutdown( void )
+{
+	ScanList.Delete_All();
+	RayList.Delete_All();
+	RayHead = 0;
+}
+
+/*
+** Queue a sight scan for this observer.  It is run in the next Think.
+*/
+void	PerceptionManager::Request_Scan( SmartGameObj * observer )
+{
+	WWASSERT( observer != NULL );
+
+	// Nothing to do if this observer can't see anything
+	if ( observer->Get_Sight_Range() <= 0 ) {
+		return;
+	}
+
+	if ( ScanList.ID( observer ) == -1 ) {
+		ScanList.Add( observer );
+	}
+}
+
+/*
+** Called when a smart object is destroyed, so no queued scan or ray
+** refers to it afterwards.
+*/
+void	PerceptionManager::Remove_Object( SmartGameObj * obj )
+{
+	ScanList.Delete( obj );
+
+	for ( int index = RayHead; index < RayList.Count(); index++ ) {
+		if ( RayList[index].Observer == obj || RayList[index].Target == obj ) {
+			RayList[index].Observer = NULL;
+			RayList[index].Target = NULL;
+		}
+	}
+}
+
+/*
+** The same tests the old per-object loop used to decide whether an object
+** is worth looking at.
+*/
+bool	PerceptionManager::Is_Valid_Target( SmartGameObj * observer, SmartGameObj * obj )
+{
+	if ( obj == NULL )							return false;
+	if ( obj == observer )						return false;
+	if ( !observer->Is_Enemy( obj ) )		return false;
+	if ( !obj->Is_Visible() )					return false;
+
+	// Don't see hidden models
+	if ( obj != COMBAT_STAR && obj->Peek_Model() && obj->Peek_Model()->Is_Hidden() ) {
+		return false;
+	}
+
+	return true;
+}
+
+/*
+** Collect the objects near the observer from the scene's dynamic object grid
+** and queue a ray for each one inside its sight range and arc.
+*/
+void	PerceptionManager::Scan( SmartGameObj * observer )
+{
+	float range = observer->Get_Sight_Range();
+	Vector3 pos = observer->Get_Look_Transform().Get_Translation();
+	AABoxClass box( pos, Vector3( range, range, range ) );
+
+	NonRefPhysListClass obj_list;
+	COMBAT_SCENE->Collect_Objects( box, false, true, &obj_list );
+
+	NonRefPhysListIterator it( &obj_list );
+	for ( it.First(); !it.Is_Done(); it.Next() ) {
+		CombatPhysObserverClass * phys_observer = (CombatPhysObserverClass *)it.Peek_Obj()->Get_Observer();
+		if ( phys_observer == NULL || phys_observer->As_PhysicalGameObj() == NULL ) {
+			continue;
+		}
+
+		SmartGameObj * obj = phys_observer->As_PhysicalGameObj()->As_SmartGameObj();
+		if ( Is_Valid_Target( observer, obj ) && observer->Is_Obj_In_Sight_Cone( obj ) ) {
+			RayTestStruct test;
+			test.Observer = observer;
+			test.Target = obj;
+			RayList.Add( test );
+		}
+	}
+}
+
+/*
+** Run the queued scans, then cast up to MaxRaysPerFrame of the queued rays.
+** Rays that don't fit in this frame's budget are left for the next one.
+*/
+void	PerceptionManager::Think( void )
+{
+	WWPROFILE( "Perception" );
+
+	{	WWPROFILE( "Scan" );
+		for ( int index = 0; index < ScanList.Count(); index++ ) {
+			Scan( ScanList[index] );
+		}
+		ScanList.Delete_All();
+	}
+
+	{	WWPROFILE( "Cast Rays" );
+		int budget = MaxRaysPerFrame;
+		while ( RayHead < RayList.Count() && budget > 0 ) {
+			RayTestStruct test = RayList[RayHead++];
+			if ( test.Observer == NULL || test.Target == NULL ) {
+				continue;
+			}
+
+			// The target may have hidden itself since the scan
+			if ( !Is_Valid_Target( test.Observer, test.Target ) ) {
+				continue;
+			}
+
+			budget--;
+			if ( test.Observer->Is_Obj_In_Line_Of_Sight( test.Target ) ) {
+				const GameObjObserverList & observer_list = test.Observer->Get_Observers();
+				for( int index = 0; index < observer_list.Count(); index++ ) {
+					observer_list[ index ]->Enemy_Seen( test.Observer, test.Target );
+				}
+			}
+		}
+
+		// Once everything queued has been cast, reuse the list from the start.
+		// If we are falling behind, slide the uncast rays down instead so the
+		// list doesn't keep growing.
+		if ( RayHead >= RayList.Count() ) {
+			RayList.Reset_Active();
+			RayHead = 0;
+		} else if ( RayHead > RayList.Count() / 2 ) {
+			int remaining = RayList.Count() - RayHead;
+			for ( int index = 0; index < remaining; index++ ) {
+				RayList[index] = RayList[RayHead + index];
+			}
+			while ( RayList.Count() > remaining ) {
+				RayList.Delete( RayList.Count() - 1 );
+			}
+			RayHead = 0;
+		}
+	}
+}
@@ -0,0 +1,89 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/***********************************************************************************************
+ ***                            Confidential - Westwood Studios                              ***
+ ***********************************************************************************************
+ *                                                                                             *
+ *                 Project Name : Commando                                                     *
+ *                                                                                             *
+ *                     $Archive:: /Commando/Code/Combat/perceptionmgr.h                       $*
+ *                                                                                             *
+ *---------------------------------------------------------------------------------------------*
+ * Functions:                                                                                  *
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#ifndef	PERCEPTIONMGR_H
+#define	PERCEPTIONMGR_H
+
+#ifndef	ALWAYS_H
+	#include "always.h"
+#endif
+
+#include "vector.h"
+
+class	SmartGameObj;
+
+
+/*
+** PerceptionManager
+** Batches the "who can I see" checks that smart objects used to run inline in
+** their Think.  An observer asks for a scan, the scan collects candidates from
+** the scene's dynamic object grid and drops anything out of sight range/arc,
+** and the surviving ray casts are queued.  Each frame a budgeted number of
+** queued rays are cast and Enemy_Seen is sent to the observer's observers for
+** each one that is clear.
+*/
+class PerceptionManager {
+
+public:
+	static	void	Init( void );
+	static	void	Shutdown( void );
+	static	void	Think( void );
+
+	static	void	Request_Scan( SmartGameObj * observer );
+	static	void	Remove_Object( SmartGameObj * obj );
+
+	static	void	Set_Max_Rays_Per_Frame( int count )	{ MaxRaysPerFrame = count; }
+	static	int	Get_Max_Rays_Per_Frame( void )			{ return MaxRaysPerFrame; }
+	static	int	Get_Pending_Ray_Count( void )				{ return RayList.Count() - RayHead; }
+
+private:
+	struct RayTestStruct {
+		SmartGameObj *	Observer;
+		SmartGameObj *	Target;
+
+		bool operator == (const RayTestStruct & src) { return (Observer == src.Observer) && (Target == src.Target); }
+		bool operator != (const RayTestStruct & src) { return !(*this == src); }
+	};
+
+	static	void	Scan( SmartGameObj * observer );
+	static	bool	Is_Valid_Target( SmartGameObj * observer, SmartGameObj * obj );
+
+	static	DynamicVectorClass<SmartGameObj *>		ScanList;
+	static	DynamicVectorClass<RayTestStruct>		RayList;
+	static	int												RayHead;
+	static	int												MaxRaysPerFrame;
+};
+
+
+#endif	// PERCEPTIONMGR_H
@@ -72,6 +72,7 @@
 #include "clientcontrol.h"
 #include "stealtheffect.h"
 #include "hud.h"
+#include "perceptionmgr.h"
 
 
 const float STEALTH_FIRING_TIME = 5.0f;  // amount of time an object stays un-stealthed after firing
@@ -186,6 +187,7 @@ SmartGameObj::SmartGameObj( void ) :
 SmartGameObj::~SmartGameObj( void )
 {
 	GameObjManager::Remove_Smart( this );
+	PerceptionManager::Remove_Object( this );
 	Listener->Remove_From_Scene();
 	Listener->Release_Ref();
 	REF_PTR_RELEASE(StealthEffect);
@@ -722,28 +724,11 @@ void SmartGameObj::Think()
 //			MovingSoundTimer += FreeRandom.Get_Float( 1, 2 );	// sound every 1-2 seconds
 			MovingSoundTimer += FreeRandom.Get_Float( 0.5f, 1 );	// sound every 0.5 - 1 seconds
 
-			// if I have sight, see who I see
+			// if I have sight, see who I see.  The perception manager
+			// collects the candidates and casts the rays in batches,
+			// calling Enemy_Seen on our observers for each one we see.
 			if ( Is_Enemy_Seen_Enabled() ) {
-				// for all physicalgameobjs
-				SLNode<BaseGameObj> *objnode;
-				for (	objnode = GameObjManager::Get_Game_Obj_List()->Head(); objnode; objnode = objnode->Next()) {
-					SmartGameObj *obj = objnode->Data()->As_SmartGameObj();
-					if ( obj ) {
-						if ( obj == this )	continue;
-						if ( !Is_Enemy( obj ) ) continue;
-						if ( !obj->Is_Visible() ) continue;
-						// Don't see hidden models
-						if ( obj != COMBAT_STAR && obj->Peek_Model() && obj->Peek_Model()->Is_Hidden() ) {
-							continue;
-						}
-						if ( Is_Obj_Visible( obj ) ) {
-							const GameObjObserverList & observer_list = Get_Observers();
-							for( int index = 0; index < observer_list.Count(); index++ ) {
-								observer_list[ index ]->Enemy_Seen( this, obj );
-							}		
-						}
-					}
-				}
+				PerceptionManager::Request_Scan( this );
 			}
 		}
 
@@ -813,6 +798,22 @@ void	SmartGameObj::Apply_Damage(const OffenseObjectClass & damager, float scale,
 }
 
 bool	SmartGameObj::Is_Obj_Visible( PhysicalGameObj *obj ) 
+{
+	return Is_Obj_In_Sight_Cone( obj ) && Is_Obj_In_Line_Of_Sight( obj );
+}
+
+/*
+** How far this object can see, after the global scale
+*/
+float	SmartGameObj::Get_Sight_Range( void ) const
+{
+	return Get_Definition().SightRange * GlobalSightRangeScale;
+}
+
+/*
+** Cheap range and view angle test, no raycast
+*/
+bool	SmartGameObj::Is_Obj_In_Sight_Cone( PhysicalGameObj *obj ) 
 {
 	Vector3 diff = obj->Get_Bullseye_Position();
 
@@ -820,42 +821,47 @@ bool	SmartGameObj::Is_Obj_Visible( PhysicalGameObj *obj )
 	Matrix3D::Inverse_Transform_Vector( look_tm, diff, &diff );
 
 	float dist = diff.Length();
-	if ( dist < Get_Definition().SightRange * GlobalSightRangeScale) {
+	if ( dist < Get_Sight_Range() ) {
 		// find view angle
 		diff.Z = 0;
 		diff.Normalize();
 		float angle = WWMath::Fast_Acos( diff.X );
 
-		if ( WWMath::Fabs( angle ) < Get_Definition().SightArc/2 ) {
+		return ( WWMath::Fabs( angle ) < Get_Definition().SightArc/2 );
+	}
+	return false;
+}
 
-			// if it passes this test, do a raycast to see if we see it.
-			Vector3	me = look_tm.Get_Translation();
-			Vector3	him = obj->Get_Bullseye_Position();
+/*
+** Raycast from our eyes to the object to see if anything is in the way
+*/
+bool	SmartGameObj::Is_Obj_In_Line_Of_Sight( PhysicalGameObj *obj ) 
+{
+	Vector3	me = Get_Look_Transform().Get_Translation();
+	Vector3	him = obj->Get_Bullseye_Position();
 
-			Peek_Physical_Object()->Inc_Ignore_Counter();
+	Peek_Physical_Object()->Inc_Ignore_Counter();
 
-			CastResultStruct res;
-			LineSegClass ray( me, him );
-			PhysRayCollisionTestClass raytest(ray, &res, BULLET_COLLISION_GROUP);
+	CastResultStruct res;
+	LineSegClass ray( me, him );
+	PhysRayCollisionTestClass raytest(ray, &res, BULLET_COLLISION_GROUP);
 { WWPROFILE( "Cast Ray" );
-			PhysicsSceneClass::Get_Instance()->Cast_Ray(raytest);
+	PhysicsSceneClass::Get_Instance()->Cast_Ray(raytest);
 }
 
-			Peek_Physical_Object()->Dec_Ignore_Counter();
+	Peek_Physical_Object()->Dec_Ignore_Counter();
 
 #if 0
-			if (raytest.Result->StartBad) {
-//				Debug_Say(( "Is_Vis Start Bad\n" ));
-			} else if ( raytest.CollidedPhysObj == obj->Peek_Physical_Object() ) {
-				return true;
-	  		}
-#else
-			return ((raytest.Result->Fraction == 1.0f ) ||
-					 ( raytest.CollidedPhysObj == obj->Peek_Physical_Object() ));
-#endif
-		}
+	if (raytest.Result->StartBad) {
+//		Debug_Say(( "Is_Vis Start Bad\n" ));
+	} else if ( raytest.CollidedPhysObj == obj->Peek_Physical_Object() ) {
+		return true;
 	}
 	return false;
+#else
+	return ((raytest.Result->Fraction == 1.0f ) ||
+			 ( raytest.CollidedPhysObj == obj->Peek_Physical_Object() ));
+#endif
 }
 
 /*
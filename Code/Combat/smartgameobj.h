@@ -183,6 +183,9 @@ public:
    bool Is_Control_Data_Dirty(cPacket & packet);
 
 	bool	Is_Obj_Visible( PhysicalGameObj *obj );
+	bool	Is_Obj_In_Sight_Cone( PhysicalGameObj *obj );
+	bool	Is_Obj_In_Line_Of_Sight( PhysicalGameObj *obj );
+	float	Get_Sight_Range( void ) const;
 
 	void	Set_Enemy_Seen_Enabled( bool enabled )	{ IsEnemySeenEnabled = enabled; }
    bool	Is_Enemy_Seen_Enabled( void )				{ return IsEnemySeenEnabled; }
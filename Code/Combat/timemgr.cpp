@@ -46,6 +46,7 @@
 #include "persistfactory.h"
 #include "combatchunkid.h"
 #include "wwprofile.h"
+#include "framearena.h"
 
 #include "win.h"
 //#include "systimer.h"		// for timegettime
@@ -303,6 +304,9 @@ void	TimeManager::Update( void )
 	// tell the profiling code that another frame has gone by
 	WWProfileManager::Increment_Frame_Counter();
 
+	// release last frame's temporary allocations
+	FrameArenaClass::End_Frame();
+
 
 #ifdef WWDEBUG
 	//
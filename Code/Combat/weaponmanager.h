@@ -49,6 +49,10 @@
 	#include "definition.h"
 #endif
 
+#ifndef	STRINGATOM_H
+	#include "stringatom.h"
+#endif
+
 #ifndef	_DATASAFE_H
 	#include	"..\commando\datasafe.h"
 #endif		//_DATASAFE_H
@@ -138,6 +142,9 @@ public:
 	bool operator == ( const AmmoDefinitionClass & vector) const { return false; }
 	bool operator != ( const AmmoDefinitionClass & vector) const	{ return true; }
 
+	// ModelName as an atom, for creating the bullet models without a lookup by name
+	const StringAtomClass &				Get_Model_Atom( void ) const		{ return ModelAtom.Refresh( ModelName ); }
+
 	StringClass		ModelFilename;
 	StringClass		ModelName;
 	safe_int			Warhead;
@@ -198,6 +205,9 @@ public:
 	Vector2			IconOffset;
 
 	float			GrenadeSafetyTime;
+
+protected:
+	mutable StringAtomClass	ModelAtom;
 };
 
 
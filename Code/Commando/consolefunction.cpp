@@ -76,6 +76,9 @@
 #include "spawn.h"
 #include "input.h"
 #include "pathfind.h"
+#include "pathfindflowfield.h"
+#include "physrecorder.h"
+#include "shattersystem.h"
 #include "waypath.h"
 #include "definitionclassids.h"
 #include "netinterface.h"
@@ -158,6 +161,8 @@
 #include "gamespyadmin.h"
 #include "gamespybanlist.h"
 #include "specialbuilds.h"
+#include "physcoltest.h"
+#include "random.h"
 #include "lightsolve.h"
 #include "lightsolvecontext.h"
 
@@ -695,6 +700,26 @@ class ShadowBlobTextureConsoleFunctionClass : public ConsoleFunctionClass
 	}
 };
 
+class ShatterCacheConsoleFunctionClass : public ConsoleFunctionClass
+{
+public:
+	virtual	const char * Get_Name( void )	{ return "shatter_cache"; }
+	virtual	const char * Get_Help( void )	{ return "SHATTER_CACHE - toggles the precomputed glass fragment cache and prints its size."; }
+	virtual	void Activate( const char * input )
+	{
+		ShatterSystem::Enable_Fragment_Cache(!ShatterSystem::Is_Fragment_Cache_Enabled());
+		if (ShatterSystem::Is_Fragment_Cache_Enabled()) {
+			Print("shatter fragment cache enabled\n");
+		} else {
+			Print("shatter fragment cache disabled\n");
+		}
+		const ShatterSystem::StatisticsStruct & stats = ShatterSystem::Get_Statistics();
+		Print("%d models cached (%d bytes)\n",ShatterSystem::Get_Fragment_Cache_Model_Count(),ShatterSystem::Get_Fragment_Cache_Bytes());
+		Print("%d shatters (%d cached), last %.2fms, max %.2fms\n",
+				stats.ShatterCount,stats.CachedShatterCount,stats.LastShatterTime * 1000.0f,stats.MaxShatterTime * 1000.0f);
+	}
+};
+
 class ShadowElevationConsoleFunctionClass : public ConsoleFunctionClass
 {
 	virtual	const char * Get_Name( void )	{ return "shadow_elevation"; }
@@ -784,6 +809,210 @@ public:
 	}
 };
 
+class CastBenchConsoleFunctionClass : public ConsoleFunctionClass
+{
+public:
+	virtual	const char * Get_Name( void )	{ return "cast_bench"; }
+	virtual	const char * Get_Help( void )	{ return "CAST_BENCH [count] [length] - times single vs. batched ray casts against the current level."; }
+	virtual	void Activate( const char * input ) {
+
+		int count = 1000;
+		float length = 25.0f;
+		sscanf(input, "%d %f", &count, &length);
+		if (count <= 0 || length <= 0.0f) {
+			Print("usage: cast_bench [count] [length]\n");
+			return;
+		}
+
+		//
+		//	Build a repeatable set of rays scattered through the level
+		//
+		Vector3 level_min,level_max;
+		COMBAT_SCENE->Get_Level_Extents(level_min,level_max);
+
+		RandomClass random(1234);
+		DynamicVectorClass<LineSegClass> lines(count);
+		for (int i=0; i<count; i++) {
+			Vector3 p0,dir;
+			p0.X = WWMath::Lerp(level_min.X,level_max.X,random(0,10000) / 10000.0f);
+			p0.Y = WWMath::Lerp(level_min.Y,level_max.Y,random(0,10000) / 10000.0f);
+			p0.Z = WWMath::Lerp(level_min.Z,level_max.Z,random(0,10000) / 10000.0f);
+			dir.X = random(-10000,10000) / 10000.0f;
+			dir.Y = random(-10000,10000) / 10000.0f;
+			dir.Z = random(-10000,10000) / 10000.0f;
+			if (dir.Length2() < WWMATH_EPSILON) {
+				dir.Set(0,0,-1);
+			}
+			dir.Normalize();
+			lines.Add(LineSegClass(p0,p0 + dir * length));
+		}
+
+		CastResultStruct * single_results = new CastResultStruct[count];
+		CastResultStruct * batch_results = new CastResultStruct[count];
+		PhysRayCollisionTestClass ** single_tests = new PhysRayCollisionTestClass *[count];
+		PhysRayCollisionTestClass ** batch_tests = new PhysRayCollisionTestClass *[count];
+		bool * single_hits = new bool[count];
+		bool * batch_hits = new bool[count];
+
+		int i;
+		for (i=0; i<count; i++) {
+			single_tests[i] = new PhysRayCollisionTestClass(lines[i],&single_results[i],BULLET_COLLISION_GROUP);
+			batch_tests[i] = new PhysRayCollisionTestClass(lines[i],&batch_results[i],BULLET_COLLISION_GROUP);
+		}
+
+		//
+		//	Time the two ways of casting them
+		//
+		__int64 ticks_per_sec = 1;
+		__int64 start_ticks = 0;
+		__int64 single_ticks = 0;
+		__int64 batch_ticks = 0;
+		::QueryPerformanceFrequency ((LARGE_INTEGER *)&ticks_per_sec);
+
+		::QueryPerformanceCounter ((LARGE_INTEGER *)&start_ticks);
+		for (i=0; i<count; i++) {
+			single_hits[i] = COMBAT_SCENE->Cast_Ray(*single_tests[i]);
+		}
+		::QueryPerformanceCounter ((LARGE_INTEGER *)&single_ticks);
+		single_ticks -= start_ticks;
+
+		::QueryPerformanceCounter ((LARGE_INTEGER *)&start_ticks);
+		int hit_count = COMBAT_SCENE->Cast_Ray_Batch(batch_tests,batch_hits,count);
+		::QueryPerformanceCounter ((LARGE_INTEGER *)&batch_ticks);
+		batch_ticks -= start_ticks;
+
+		//
+		//	Both ways must give exactly the same answers
+		//
+		int mismatch_count = 0;
+		for (i=0; i<count; i++) {
+			if (	(single_hits[i] != batch_hits[i]) ||
+					(single_results[i].Fraction != batch_results[i].Fraction) ||
+					(single_results[i].StartBad != batch_results[i].StartBad) ||
+					(single_results[i].Normal != batch_results[i].Normal) ||
+					(single_tests[i]->CollidedPhysObj != batch_tests[i]->CollidedPhysObj) )
+			{
+				mismatch_count++;
+			}
+		}
+
+		float single_ms = float(double(single_ticks) * 1000.0 / double(ticks_per_sec));
+		float batch_ms = float(double(batch_ticks) * 1000.0 / double(ticks_per_sec));
+		Print("cast_bench: %d rays of length %.1f, %d hits\n",count,length,hit_count);
+		Print("  single: %.3f ms (%.0f rays/sec)\n",single_ms,(single_ms > 0.0f) ? count * 1000.0f / single_ms : 0.0f);
+		Print("  batch:  %.3f ms (%.0f rays/sec)\n",batch_ms,(batch_ms > 0.0f) ? count * 1000.0f / batch_ms : 0.0f);
+		Print("  mismatches: %d\n",mismatch_count);
+
+		for (i=0; i<count; i++) {
+			delete single_tests[i];
+			delete batch_tests[i];
+		}
+		delete [] single_tests;
+		delete [] batch_tests;
+		delete [] single_results;
+		delete [] batch_results;
+		delete [] single_hits;
+		delete [] batch_hits;
+	}
+};
+
+class CollisionProfileBeginConsoleFunctionClass : public ConsoleFunctionClass
+{
+public:
+	virtual	const char * Get_Name( void )	{ return "collision_profile_begin"; }
+	virtual	const char * Get_Help( void )	{ return "COLLISION_PROFILE_BEGIN [cell size] - starts profiling the collision queries over the current level."; }
+	virtual	void Activate( const char * input ) {
+
+		float cell_size = 10.0f;
+		sscanf(input, "%f", &cell_size);
+		COMBAT_SCENE->Begin_Collision_Profile(cell_size);
+		Print("collision profiling started\n");
+	}
+};
+
+class CollisionProfileEndConsoleFunctionClass : public ConsoleFunctionClass
+{
+public:
+	virtual	const char * Get_Name( void )	{ return "collision_profile_end"; }
+	virtual	const char * Get_Help( void )	{ return "COLLISION_PROFILE_END [filename] - stops profiling the collision queries and writes the report."; }
+	virtual	void Activate( const char * input ) {
+
+		const char * filename = "collision_profile.txt";
+		if (input != NULL && input[0] != 0) {
+			filename = input;
+		}
+		COMBAT_SCENE->End_Collision_Profile(filename);
+		Print("collision profile written to %s\n",filename);
+	}
+};
+
+class PhysRecordBeginConsoleFunctionClass : public ConsoleFunctionClass
+{
+public:
+	virtual	const char * Get_Name( void )	{ return "phys_record_begin"; }
+	virtual	const char * Get_Help( void )	{ return "PHYS_RECORD_BEGIN [filename] - starts recording the physics simulation for the PhysReplay tool."; }
+	virtual	void Activate( const char * input ) {
+
+		const char * filename = "phys_recording.dat";
+		if (input != NULL && input[0] != 0) {
+			filename = input;
+		}
+		if (_PhysRecorder.Start_Recording(filename)) {
+			Print("recording physics into %s\n",filename);
+		} else {
+			Print("unable to start recording into %s\n",filename);
+		}
+	}
+};
+
+class PhysRecordEndConsoleFunctionClass : public ConsoleFunctionClass
+{
+public:
+	virtual	const char * Get_Name( void )	{ return "phys_record_end"; }
+	virtual	const char * Get_Help( void )	{ return "PHYS_RECORD_END - stops recording the physics simulation and writes the recording."; }
+	virtual	void Activate( const char * input ) {
+
+		if (_PhysRecorder.Is_Recording()) {
+			_PhysRecorder.Stop_Recording();
+			Print("physics recording written\n");
+		} else {
+			Print("not recording\n");
+		}
+	}
+};
+
+class PhysSweepPruneConsoleFunctionClass : public ConsoleFunctionClass
+{
+public:
+	virtual	const char * Get_Name( void )	{ return "phys_sweep_prune"; }
+	virtual	const char * Get_Help( void )	{ return "PHYS_SWEEP_PRUNE - toggles the sweep-and-prune broadphase for rigid body collision regions."; }
+	virtual	void Activate( const char * input ) {
+
+		COMBAT_SCENE->Enable_Sweep_Prune(!COMBAT_SCENE->Is_Sweep_Prune_Enabled());
+		if (COMBAT_SCENE->Is_Sweep_Prune_Enabled()) {
+			Print("sweep-and-prune enabled, %d pairs\n",COMBAT_SCENE->Get_Sweep_Prune_Pair_Count());
+		} else {
+			Print("sweep-and-prune disabled\n");
+		}
+	}
+};
+
+class PathFlowFieldConsoleFunctionClass : public ConsoleFunctionClass
+{
+public:
+	virtual	const char * Get_Name( void )	{ return "path_flowfield"; }
+	virtual	const char * Get_Help( void )	{ return "PATH_FLOWFIELD - toggles shared flow-field path solving for groups of units."; }
+	virtual	void Activate( const char * input ) {
+
+		PathfindFlowFieldMgrClass::Enable(!PathfindFlowFieldMgrClass::Is_Enabled());
+		if (PathfindFlowFieldMgrClass::Is_Enabled()) {
+			Print("path flow fields enabled\n");
+		} else {
+			Print("path flow fields disabled\n");
+		}
+	}
+};
+
 class Phys3NetConsoleFunctionClass : public ConsoleFunctionClass
 {
 public:
@@ -5031,8 +5260,15 @@ void	ConsoleFunctionManager::Init( void )
 	FunctionList.Add( new NextRenderConsoleFunctionClass() );
 	FunctionList.Add( new OneShotKillsConsoleFunctionClass() );
 	FunctionList.Add( new OpenConsoleFunctionClass() );
+	FunctionList.Add( new PathFlowFieldConsoleFunctionClass() );
 	FunctionList.Add( new Phys3NetConsoleFunctionClass() );
 	FunctionList.Add( new PhysicsDebugConsoleFunctionClass() );
+	FunctionList.Add( new PhysSweepPruneConsoleFunctionClass() );
+	FunctionList.Add( new PhysRecordBeginConsoleFunctionClass() );
+	FunctionList.Add( new PhysRecordEndConsoleFunctionClass() );
+	FunctionList.Add( new CastBenchConsoleFunctionClass() );
+	FunctionList.Add( new CollisionProfileBeginConsoleFunctionClass() );
+	FunctionList.Add( new CollisionProfileEndConsoleFunctionClass() );
 	FunctionList.Add( new PlayerPositionConsoleFunctionClass() );
 	FunctionList.Add( new ProfileCollectBeginConsoleFunctionClass() );
 	FunctionList.Add( new ProfileCollectEndConsoleFunctionClass() );
@@ -5079,6 +5315,7 @@ void	ConsoleFunctionManager::Init( void )
 	FunctionList.Add( new ShadowBlobTextureConsoleFunctionClass() );
 	FunctionList.Add( new ShadowCountConsoleFunctionClass() );
 	FunctionList.Add( new ShadowElevationConsoleFunctionClass() );
+	FunctionList.Add( new ShatterCacheConsoleFunctionClass() );
 	FunctionList.Add( new ShadowIntensityConsoleFunctionClass() );
 	FunctionList.Add( new ShadowPerPolyCullingConsoleFunctionClass() );
 	FunctionList.Add( new ShadowResolutionConsoleFunctionClass() );
@@ -112,6 +112,7 @@
 #include "gamespyadmin.h"
 #include "shutdown.h"
 #include "specialbuilds.h"
+#include "asyncfileio.h"
 
 extern const char *VALUE_NAME_TEXTURE_FILTER_MODE;
 
@@ -775,6 +776,8 @@ bool Game_Init(void)
 
 	AudioFileFactory.Set_Base_Factory( _TheFileFactory );
 
+	AsyncFileIOClass::Init();
+
 	//Setup_Mix_File();
 
 	// Lets seed the Random Generator, a little
@@ -1159,4 +1162,4 @@ char *Build_Registry_Location_String(char *base, char *modifier, char *sub)
 		strcat(_whole_registry_string, sub);
 	}
 	return(_whole_registry_string);
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -65,6 +65,7 @@
 #include "gamespyadmin.h"
 #include "demosupport.h"
 #include "GameSpy_QnR.h"
+#include "asyncfileio.h"
 
 
 /*
@@ -151,6 +152,10 @@ void _Game_Main_Loop_Loop(void)
 		WWAudioClass::Get_Instance ()->On_Frame_Update (0);
 	}
 }
+
+{	WWPROFILE( "Async File I/O" );
+	AsyncFileIOClass::Update();
+}
 	// Give the sound manager a chance to think
   // PROFILE(	"Audio", WWAudioClass::Get_Instance ()->On_Frame_Update (0) );
 
@@ -217,4 +222,4 @@ int Game_Main_Loop(void)
 	}
 
 	return ExitCode;
-}
\ No newline at end of file
+}
\ No newline at end of file
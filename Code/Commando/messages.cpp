@@ -71,6 +71,7 @@
 #include "loadingevent.h"
 #include "clientcontrol.h"
 #include "wwprofile.h"
+#include "framearena.h"
 #include "changeteamevent.h"
 #include "DlgMPTeamSelect.h"
 #include "dlgmessagebox.h"
@@ -140,15 +141,12 @@ if (cDevOptions::UseNewTCADO.Is_False()) {
 	/*
 	** List of objects requiring frequent updates.
 	*/
-	static DynamicVectorClass<NetworkObjectClass *> object_list;
+	FrameDynamicVectorClass<NetworkObjectClass *> object_list(count);
 
 	/*
 	** List of objects requiring guaranteed updates. We can't schedule these.
 	*/
-	static DynamicVectorClass<NetworkObjectClass *> g_object_list;
-
-	object_list.Clear();
-	g_object_list.Clear();
+	FrameDynamicVectorClass<NetworkObjectClass *> g_object_list(count);
 
 	SoldierGameObj * player_ptr = GameObjManager::Find_Soldier_Of_Client_ID(client_id);
 
@@ -1619,4 +1617,4 @@ void cNetwork::Test_For_Team_Defaulting(cPlayer * p_player)
 		p_team_gdi->Set_Score(score_nod);
 		p_team_nod->Set_Score(score_gdi);
 	}
-}
\ No newline at end of file
+}
\ No newline at end of file
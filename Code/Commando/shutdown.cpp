@@ -78,6 +78,7 @@
 #include "dx8caps.h"
 #include "registry.h"
 #include "specialbuilds.h"
+#include "asyncfileio.h"
 #include <windows.h>
 #include <lmcons.h>	// UNLEN
 extern SimpleFileFactoryClass RenegadeBaseFileFactory;
@@ -433,6 +434,7 @@ void Game_Shutdown(void)
 	PathMgrClass::Shutdown();
 	WWMath::Shutdown();
 	WWSaveLoad::Shutdown();
+	AsyncFileIOClass::Shutdown();
 	WW3D::Shutdown();
 	WWPhys::Shutdown();
 
@@ -527,4 +529,4 @@ void Debug_Refs(void)
 	}
 //	Debug_Say(("Done.\r\n"));
 #endif
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -0,0 +1,173 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/***********************************************************************************************
+ ***              C O N F I D E N T I A L  ---  W E S T W O O D  S T U D I O S               ***
+ ***********************************************************************************************
+ *                                                                                             *
+ *                 Project Name : Hash Benchmark                                               *
+ *                                                                                             *
+ *                     $Archive:: /Commando/Code/Tests/HashBench/chainedhash.h                $*
+ *                                                                                             *
+ *---------------------------------------------------------------------------------------------*
+ * Functions:                                                                                  *
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#ifndef __CHAINEDHASH_H
+#define __CHAINEDHASH_H
+
+#include "hashtemplate.h"
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	ChainedHashClass
+//
+//		The chained HashTemplateClass as it was before it moved to open
+//	addressing (bucket heads plus an entry table linked through 'Next'),
+// trimmed down to what the benchmark uses.  Kept here so the two can
+// be compared on the same key sets.
+//
+/////////////////////////////////////////////////////////////////////////
+template <class KeyType, class ValueType>
+class ChainedHashClass
+{
+public:
+
+	enum
+	{
+		NIL = -1
+	};
+
+	ChainedHashClass(void) : Hash(0),Table(0),First(NIL),Size(0) {}
+	~ChainedHashClass(void)			{ delete[] Hash; delete[] Table; }
+
+	void Insert(const KeyType& s, const ValueType& d)
+	{
+		int h				= Alloc_Entry();
+		unsigned int hval	= Get_Hash_Val(s,Size);
+		Table[h].Key	= s;
+		Table[h].Value	= d;
+		Table[h].Next	= Hash[hval];
+		Hash[hval]		= h;
+	}
+
+	bool Get(const KeyType& s, ValueType& d) const
+	{
+		if (Hash) {
+			int  h = Hash[Get_Hash_Val(s,Size)];
+			while (h!=NIL)
+			{
+				if (Table[h].Key == s)
+				{
+					d = Table[h].Value;
+					return true;
+				}
+				h = Table[h].Next;
+			}
+		}
+		return false;
+	}
+
+	unsigned int Get_Size(void) const		{ return Size; }
+	unsigned int Get_Memory_Usage(void) const	{ return Size * (sizeof(int) + sizeof(Entry)); }
+
+private:
+
+	struct Entry
+	{
+		int Next;
+		KeyType Key;
+		ValueType Value;
+	};
+
+	static unsigned int Get_Hash_Val(const KeyType& s, const unsigned int hash_array_size)
+	{
+		return HashTemplateKeyClass<KeyType>::Get_Hash_Value (s) & (hash_array_size-1);
+	}
+
+	int Alloc_Entry(void)
+	{
+		if (First == NIL)
+			Re_Hash();
+		int h	= First;
+		First	= Table[First].Next;
+		return h;
+	}
+
+	void Re_Hash(void)
+	{
+		unsigned int new_size = Size*2;
+		if (new_size < 4)
+			new_size = 4;
+
+		Entry  *new_table = new Entry[new_size];
+		int *new_hash  = new int[new_size];
+
+		int cnt = 0;
+		int	i;
+
+		for (i = 0; i < (int)new_size; i++)
+		{
+			new_table[i].Next	= NIL;
+			new_hash[i]			= NIL;
+		}
+
+		if (Size)
+		{
+			for (i = 0; i < (int)Size; i++)
+			{
+				int	h = Hash[i];
+				while (h != NIL)
+				{
+					unsigned int hVal		= Get_Hash_Val(Table[h].Key, new_size);
+					new_table[cnt].Key	= Table[h].Key;
+					new_table[cnt].Value = Table[h].Value;
+					new_table[cnt].Next	= new_hash[hVal];
+					new_hash[hVal]		= cnt;
+					cnt++;
+					h = Table[h].Next;
+				}
+			}
+			delete[] Hash;
+			delete[] Table;
+		}
+
+		for (i = cnt; i < (int)new_size; i++)
+			new_table[i].Next = i+1;
+		new_table[new_size-1].Next = NIL;
+
+		First	= cnt;
+		Hash	= new_hash;
+		Table	= new_table;
+		Size	= new_size;
+	}
+
+	int* Hash;
+	Entry* Table;
+	int First;
+	unsigned int Size;
+};
+
+
+#endif //__CHAINEDHASH_H
@@ -0,0 +1,385 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/***********************************************************************************************
+ ***              C O N F I D E N T I A L  ---  W E S T W O O D  S T U D I O S               ***
+ ***********************************************************************************************
+ *                                                                                             *
+ *                 Project Name : Hash Benchmark                                               *
+ *                                                                                             *
+ *                     $Archive:: /Commando/Code/Tests/HashBench/hashbench.cpp                $*
+ *                                                                                             *
+ *---------------------------------------------------------------------------------------------*
+ * Functions:                                                                                  *
+ *   HashBenchClass::Load_Keys -- Adds the keys from a mix file or a text file                 *
+ *   HashBenchClass::Run -- Times both tables, keeping the best time of each pass              *
+ *   HashBenchClass::Print_Report -- Prints the timings and memory use side by side            *
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+#include "hashbench.h"
+#include "hashtemplate.h"
+#include "chainedhash.h"
+#include "mixfile.h"
+#include "ffactory.h"
+#include "random.h"
+#include <stdio.h>
+#include <string.h>
+#include <windows.h>
+
+
+/////////////////////////////////////////////////////////////////////////
+//	Local constants
+/////////////////////////////////////////////////////////////////////////
+static const char *	TABLE_NAMES[]	=
+{
+	"Chained (old)",
+	"Open addressing",
+};
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	HashBenchClass
+//
+/////////////////////////////////////////////////////////////////////////
+HashBenchClass::HashBenchClass (void)
+	:	m_TicksPerSec (1)
+{
+	::memset (m_Results, 0, sizeof (m_Results));
+	::QueryPerformanceFrequency ((LARGE_INTEGER *)&m_TicksPerSec);
+	return ;
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	~HashBenchClass
+//
+/////////////////////////////////////////////////////////////////////////
+HashBenchClass::~HashBenchClass (void)
+{
+	return ;
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	Load_Keys
+//
+//	Mix files (.mix, .dat) contribute the names of the files inside them,
+// anything else is read as a text file with one key per line.  Keys
+// that were already loaded are skipped.
+//
+/////////////////////////////////////////////////////////////////////////
+bool
+HashBenchClass::Load_Keys (const char *filename)
+{
+	const char *extension = ::strrchr (filename, '.');
+	if (extension != NULL && (::stricmp (extension, ".mix") == 0 || ::stricmp (extension, ".dat") == 0)) {
+		return Load_Mix_Keys (filename);
+	}
+
+	return Load_Text_Keys (filename);
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	Load_Mix_Keys
+//
+/////////////////////////////////////////////////////////////////////////
+bool
+HashBenchClass::Load_Mix_Keys (const char *filename)
+{
+	SimpleFileFactoryClass file_factory;
+	MixFileFactoryClass mix_factory (filename, &file_factory);
+	DynamicVectorClass<StringClass> name_list;
+
+	if (mix_factory.Is_Valid () == false || mix_factory.Build_Filename_List (name_list) == false) {
+		printf ("Unable to read the file list of %s.\n", filename);
+		return false;
+	}
+
+	HashTemplateClass<StringClass, int> loaded;
+	int index;
+	for (index = 0; index < m_KeyList.Count (); index ++) {
+		loaded.Insert (m_KeyList[index], index);
+	}
+
+	for (index = 0; index < name_list.Count (); index ++) {
+		if (loaded.Exists (name_list[index]) == false) {
+			loaded.Insert (name_list[index], m_KeyList.Count ());
+			m_KeyList.Add (name_list[index]);
+		}
+	}
+
+	printf ("%s: %d names.\n", filename, name_list.Count ());
+	return true;
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	Load_Text_Keys
+//
+/////////////////////////////////////////////////////////////////////////
+bool
+HashBenchClass::Load_Text_Keys (const char *filename)
+{
+	FILE *file = ::fopen (filename, "rt");
+	if (file == NULL) {
+		printf ("Unable to open %s.\n", filename);
+		return false;
+	}
+
+	HashTemplateClass<StringClass, int> loaded;
+	int index;
+	for (index = 0; index < m_KeyList.Count (); index ++) {
+		loaded.Insert (m_KeyList[index], index);
+	}
+
+	char line[512];
+	int count = 0;
+	while (::fgets (line, sizeof (line), file) != NULL) {
+
+		//
+		//	Strip the line ending and skip blank lines
+		//
+		int len = ::strlen (line);
+		while (len > 0 && (line[len - 1] == '\n' || line[len - 1] == '\r' || line[len - 1] == ' ')) {
+			line[-- len] = 0;
+		}
+		if (len == 0) {
+			continue;
+		}
+
+		StringClass key (line);
+		if (loaded.Exists (key) == false) {
+			loaded.Insert (key, m_KeyList.Count ());
+			m_KeyList.Add (key);
+		}
+		count ++;
+	}
+
+	::fclose (file);
+	printf ("%s: %d names.\n", filename, count);
+	return true;
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	Shuffle_Lookups
+//
+//	The hits are the keys in a scrambled (but repeatable) order so the
+// lookups don't walk the tables in insertion order.  The misses are
+// the keys with an extra character on the end, which is about as close
+// as a failed asset or definition lookup gets to a real name.
+//
+/////////////////////////////////////////////////////////////////////////
+void
+HashBenchClass::Shuffle_Lookups (void)
+{
+	m_HitList = m_KeyList;
+	m_MissList.Delete_All ();
+
+	RandomClass random (1);
+	int index;
+	for (index = m_HitList.Count () - 1; index > 0; index --) {
+		int other = ((random () << 15) | random ()) % (index + 1);
+		StringClass temp		= m_HitList[index];
+		m_HitList[index]		= m_HitList[other];
+		m_HitList[other]		= temp;
+	}
+
+	for (index = 0; index < m_HitList.Count (); index ++) {
+		StringClass miss = m_HitList[index];
+		miss += "~";
+		m_MissList.Add (miss);
+	}
+
+	return ;
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	Run
+//
+/////////////////////////////////////////////////////////////////////////
+void
+HashBenchClass::Run (int passes)
+{
+	Shuffle_Lookups ();
+
+	int table;
+	for (table = 0; table < TABLE_COUNT; table ++) {
+		m_Results[table].InsertTime	= 1.0E30F;
+		m_Results[table].HitTime		= 1.0E30F;
+		m_Results[table].MissTime		= 1.0E30F;
+	}
+
+	for (int pass = 0; pass < passes; pass ++) {
+		{
+			ChainedHashClass<StringClass, int> chained;
+			Run_Table (chained, m_Results[TABLE_CHAINED]);
+			m_Results[TABLE_CHAINED].Memory = chained.Get_Memory_Usage ();
+		}
+		{
+			HashTemplateClass<StringClass, int> open;
+			Run_Table (open, m_Results[TABLE_OPEN]);
+			m_Results[TABLE_OPEN].Memory = open.Get_Memory_Usage ();
+		}
+	}
+
+	return ;
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	Run_Table
+//
+/////////////////////////////////////////////////////////////////////////
+template<class T> void
+HashBenchClass::Run_Table (T &table, ResultStruct &result)
+{
+	__int64 start_ticks = 0;
+	int value = 0;
+	int found = 0;
+	int index;
+
+	::QueryPerformanceCounter ((LARGE_INTEGER *)&start_ticks);
+	for (index = 0; index < m_KeyList.Count (); index ++) {
+		table.Insert (m_KeyList[index], index);
+	}
+	result.InsertTime = min (result.InsertTime, Get_Elapsed (start_ticks));
+
+	::QueryPerformanceCounter ((LARGE_INTEGER *)&start_ticks);
+	for (index = 0; index < m_HitList.Count (); index ++) {
+		if (table.Get (m_HitList[index], value)) {
+			found ++;
+		}
+	}
+	result.HitTime = min (result.HitTime, Get_Elapsed (start_ticks));
+
+	::QueryPerformanceCounter ((LARGE_INTEGER *)&start_ticks);
+	for (index = 0; index < m_MissList.Count (); index ++) {
+		if (table.Get (m_MissList[index], value)) {
+			found ++;
+		}
+	}
+	result.MissTime = min (result.MissTime, Get_Elapsed (start_ticks));
+
+	result.Found = found;
+	return ;
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	Check_Duplicates
+//
+//	Inserts every key three times, one whole pass over the keys at a
+// time so the table re-hashes between the copies, then checks that the
+// newest copy shadows the older ones the way it did in the chained
+// table: Get returns the newest, and removing it exposes the next one.
+//
+/////////////////////////////////////////////////////////////////////////
+bool
+HashBenchClass::Check_Duplicates (void)
+{
+	HashTemplateClass<StringClass, int> table;
+	int count = m_KeyList.Count ();
+	int errors = 0;
+	int index;
+
+	for (int copy = 0; copy < 3; copy ++) {
+		for (index = 0; index < count; index ++) {
+			table.Insert (m_KeyList[index], copy * count + index);
+		}
+	}
+
+	for (index = 0; index < count; index ++) {
+		const StringClass &key = m_KeyList[index];
+		for (int copy = 2; copy >= 0; copy --) {
+			int value = -1;
+			if (table.Get (key, value) == false || value != copy * count + index) {
+				errors ++;
+				break;
+			}
+			table.Remove (key);
+		}
+		if (table.Exists (key)) {
+			errors ++;
+		}
+	}
+
+	if (errors > 0) {
+		printf ("Duplicate keys: %d of %d keys came back in the wrong order\n", errors, count);
+	} else {
+		printf ("Duplicate keys: newest first for all %d keys\n", count);
+	}
+
+	return (errors == 0);
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	Get_Elapsed
+//
+/////////////////////////////////////////////////////////////////////////
+float
+HashBenchClass::Get_Elapsed (__int64 start_ticks)
+{
+	__int64 end_ticks = 0;
+	::QueryPerformanceCounter ((LARGE_INTEGER *)&end_ticks);
+	return float(double(end_ticks - start_ticks) * 1000.0 / double(m_TicksPerSec));
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	Print_Report
+//
+/////////////////////////////////////////////////////////////////////////
+void
+HashBenchClass::Print_Report (void)
+{
+	int count = max (m_KeyList.Count (), 1);
+
+	printf ("\n");
+	printf ("Keys:             %d\n", m_KeyList.Count ());
+	printf ("%-18s %12s %12s %12s %12s\n", "", "insert ns", "hit ns", "miss ns", "memory KB");
+	for (int table = 0; table < TABLE_COUNT; table ++) {
+		const ResultStruct &result = m_Results[table];
+		printf ("%-18s %12.1f %12.1f %12.1f %12.1f\n",
+					TABLE_NAMES[table],
+					result.InsertTime * 1.0E6F / float(count),
+					result.HitTime * 1.0E6F / float(count),
+					result.MissTime * 1.0E6F / float(count),
+					float(result.Memory) / 1024.0F);
+
+		if (result.Found != m_KeyList.Count ()) {
+			printf ("  WARNING: found %d of %d keys\n", result.Found, m_KeyList.Count ());
+		}
+	}
+
+	return ;
+}
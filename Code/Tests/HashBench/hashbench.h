@@ -0,0 +1,119 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/***********************************************************************************************
+ ***              C O N F I D E N T I A L  ---  W E S T W O O D  S T U D I O S               ***
+ ***********************************************************************************************
+ *                                                                                             *
+ *                 Project Name : Hash Benchmark                                               *
+ *                                                                                             *
+ *                     $Archive:: /Commando/Code/Tests/HashBench/hashbench.h                  $*
+ *                                                                                             *
+ *---------------------------------------------------------------------------------------------*
+ * Functions:                                                                                  *
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#ifndef __HASHBENCH_H
+#define __HASHBENCH_H
+
+#include "always.h"
+#include "vector.h"
+#include "wwstring.h"
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	HashBenchClass
+//
+//		Times HashTemplateClass against the old chained implementation
+//	on a set of real keys (asset names out of a mix file, or any list
+// of names such as a dump of the definition names).  Both tables are
+// keyed the way the engine keys them, by StringClass.
+//
+/////////////////////////////////////////////////////////////////////////
+class HashBenchClass
+{
+public:
+
+	/////////////////////////////////////////////////////////////////////////
+	// Public constructors/destructors
+	/////////////////////////////////////////////////////////////////////////
+	HashBenchClass (void);
+	~HashBenchClass (void);
+
+	/////////////////////////////////////////////////////////////////////////
+	// Public methods
+	/////////////////////////////////////////////////////////////////////////
+	bool				Load_Keys (const char *filename);
+	int				Get_Key_Count (void) const	{ return m_KeyList.Count (); }
+	void				Run (int passes);
+	bool				Check_Duplicates (void);
+	void				Print_Report (void);
+
+protected:
+
+	/////////////////////////////////////////////////////////////////////////
+	// Protected data types
+	/////////////////////////////////////////////////////////////////////////
+	struct ResultStruct
+	{
+		float								InsertTime;		// best time over all passes (ms)
+		float								HitTime;
+		float								MissTime;
+		unsigned int					Memory;			// bytes
+		int								Found;
+
+		bool operator== (const ResultStruct &src) { return false; }
+		bool operator!= (const ResultStruct &src) { return true; }
+	};
+
+	enum
+	{
+		TABLE_CHAINED	= 0,
+		TABLE_OPEN,
+		TABLE_COUNT
+	};
+
+	/////////////////////////////////////////////////////////////////////////
+	// Protected methods
+	/////////////////////////////////////////////////////////////////////////
+	bool				Load_Mix_Keys (const char *filename);
+	bool				Load_Text_Keys (const char *filename);
+	void				Shuffle_Lookups (void);
+	template<class T> void Run_Table (T &table, ResultStruct &result);
+	float				Get_Elapsed (__int64 start_ticks);
+
+private:
+
+	/////////////////////////////////////////////////////////////////////////
+	// Private member data
+	/////////////////////////////////////////////////////////////////////////
+	DynamicVectorClass<StringClass>		m_KeyList;
+	DynamicVectorClass<StringClass>		m_HitList;			// the keys in a scrambled order
+	DynamicVectorClass<StringClass>		m_MissList;			// near misses of the keys
+	ResultStruct								m_Results[TABLE_COUNT];
+	__int64										m_TicksPerSec;
+};
+
+
+#endif //__HASHBENCH_H
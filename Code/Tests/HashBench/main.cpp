@@ -0,0 +1,104 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/***********************************************************************************************
+ ***              C O N F I D E N T I A L  ---  W E S T W O O D  S T U D I O S               ***
+ ***********************************************************************************************
+ *                                                                                             *
+ *                 Project Name : Hash Benchmark                                               *
+ *                                                                                             *
+ *                     $Archive:: /Commando/Code/Tests/HashBench/main.cpp                     $*
+ *                                                                                             *
+ *---------------------------------------------------------------------------------------------*
+ * Functions:                                                                                  *
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+#include "hashbench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/////////////////////////////////////////////////////////////////////////
+//	Local prototypes
+/////////////////////////////////////////////////////////////////////////
+static void	Print_Usage (void);
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	main
+//
+//	HashBench <keys> [<keys> ...] [options]
+//
+//	Exit code is 0 on success, 1 if duplicate keys don't come back
+// newest first and 2 on usage/load errors.
+//
+/////////////////////////////////////////////////////////////////////////
+int
+main (int argc, char *argv[])
+{
+	if (argc < 2) {
+		Print_Usage ();
+		return 2;
+	}
+
+	HashBenchClass bench;
+	int passes = 5;
+
+	for (int index = 1; index < argc; index ++) {
+		const char *arg = argv[index];
+
+		if (::stricmp (arg, "-passes") == 0) {
+			if (index + 1 >= argc) {
+				Print_Usage ();
+				return 2;
+			}
+			passes = ::atoi (argv[++ index]);
+		} else if (bench.Load_Keys (arg) == false) {
+			return 2;
+		}
+	}
+
+	if (bench.Get_Key_Count () == 0) {
+		printf ("No keys loaded.\n");
+		return 2;
+	}
+
+	printf ("Running %d passes...\n", passes);
+	bench.Run (passes);
+	bench.Print_Report ();
+	printf ("\n");
+	return bench.Check_Duplicates () ? 0 : 1;
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	Print_Usage
+//
+/////////////////////////////////////////////////////////////////////////
+static void
+Print_Usage (void)
+{
+	printf ("Usage: HashBench <keys> [<keys> ...] [options]\n");
+	printf ("  <keys>             a mix file (.mix/.dat) for its asset names, or a text\n");
+	printf ("                     file with one key per line (e.g. definition names)\n");
+	printf ("  -passes <n>        times to run each table, best time is kept (default 5)\n");
+	return ;
+}
@@ -0,0 +1,112 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/***********************************************************************************************
+ ***              C O N F I D E N T I A L  ---  W E S T W O O D  S T U D I O S               ***
+ ***********************************************************************************************
+ *                                                                                             *
+ *                 Project Name : Mix Benchmark                                                *
+ *                                                                                             *
+ *                     $Archive:: /Commando/Code/Tests/MixBench/main.cpp                      $*
+ *                                                                                             *
+ *---------------------------------------------------------------------------------------------*
+ * Functions:                                                                                  *
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+#include "mixbench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/////////////////////////////////////////////////////////////////////////
+//	Local prototypes
+/////////////////////////////////////////////////////////////////////////
+static void	Print_Usage (void);
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	main
+//
+//	MixBench <mix> [<mix> ...] [options]
+//
+//	Exit code is 0 on success, 1 if the two modes didn't read the same
+// files and 2 on usage/load errors.
+//
+/////////////////////////////////////////////////////////////////////////
+int
+main (int argc, char *argv[])
+{
+	if (argc < 2) {
+		Print_Usage ();
+		return 2;
+	}
+
+	MixBenchClass bench;
+	int passes = 5;
+
+	for (int index = 1; index < argc; index ++) {
+		const char *arg = argv[index];
+
+		if (::stricmp (arg, "-passes") == 0 || ::stricmp (arg, "-names") == 0) {
+			if (index + 1 >= argc) {
+				Print_Usage ();
+				return 2;
+			}
+			if (::stricmp (arg, "-passes") == 0) {
+				passes = ::atoi (argv[++ index]);
+			} else if (bench.Load_Names (argv[++ index]) == false) {
+				return 2;
+			}
+		} else if (bench.Add_Mix (arg) == false) {
+			return 2;
+		}
+	}
+
+	if (bench.Get_Mix_Count () == 0) {
+		printf ("No mix files loaded.\n");
+		return 2;
+	}
+
+	printf ("Running %d passes...\n", passes);
+	bench.Run (passes);
+	bench.Print_Report ();
+	return bench.Modes_Agree () ? 0 : 1;
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	Print_Usage
+//
+/////////////////////////////////////////////////////////////////////////
+static void
+Print_Usage (void)
+{
+	printf ("Usage: MixBench <mix> [<mix> ...] [options]\n");
+	printf ("  <mix>              a mix file (.mix/.dat); files are looked up in the\n");
+	printf ("                     order the mix files are given\n");
+	printf ("  -names <file>      text file with the files to read, one per line, in\n");
+	printf ("                     load order (default: every file in every mix)\n");
+	printf ("  -passes <n>        times to run each mode, best time is kept (default 5)\n");
+	printf ("\n");
+	printf ("The first pass reads from disk, later passes mostly from the OS file\n");
+	printf ("cache.  Use -passes 1 on a freshly booted machine for cold load times.\n");
+	return ;
+}
@@ -0,0 +1,306 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/***********************************************************************************************
+ ***              C O N F I D E N T I A L  ---  W E S T W O O D  S T U D I O S               ***
+ ***********************************************************************************************
+ *                                                                                             *
+ *                 Project Name : Mix Benchmark                                                *
+ *                                                                                             *
+ *                     $Archive:: /Commando/Code/Tests/MixBench/mixbench.cpp                  $*
+ *                                                                                             *
+ *---------------------------------------------------------------------------------------------*
+ * Functions:                                                                                  *
+ *   MixBenchClass::Add_Mix -- Adds a mix file, and its file names if there is no name list    *
+ *   MixBenchClass::Load_Names -- Reads the list of files to load from a text file             *
+ *   MixBenchClass::Run -- Times both modes, keeping the best time of each pass                *
+ *   MixBenchClass::Print_Report -- Prints the timings side by side                            *
+ *   MixBenchClass::Modes_Agree -- Did both modes read the same data?                          *
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+#include "mixbench.h"
+#include "mixfile.h"
+#include "ffactory.h"
+#include "wwfile.h"
+#include <stdio.h>
+#include <string.h>
+#include <windows.h>
+
+
+/////////////////////////////////////////////////////////////////////////
+//	Local constants
+/////////////////////////////////////////////////////////////////////////
+static const char *	MODE_NAMES[]	=
+{
+	"File handles",
+	"Memory mapped",
+};
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	MixBenchClass
+//
+/////////////////////////////////////////////////////////////////////////
+MixBenchClass::MixBenchClass (void)
+	:	m_HasNameList (false),
+		m_Buffer (NULL),
+		m_BufferSize (0),
+		m_TicksPerSec (1)
+{
+	::memset (m_Results, 0, sizeof (m_Results));
+	::QueryPerformanceFrequency ((LARGE_INTEGER *)&m_TicksPerSec);
+	return ;
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	~MixBenchClass
+//
+/////////////////////////////////////////////////////////////////////////
+MixBenchClass::~MixBenchClass (void)
+{
+	delete [] m_Buffer;
+	m_Buffer = NULL;
+	return ;
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	Add_Mix
+//
+/////////////////////////////////////////////////////////////////////////
+bool
+MixBenchClass::Add_Mix (const char *filename)
+{
+	SimpleFileFactoryClass file_factory;
+	MixFileFactoryClass mix_factory (filename, &file_factory);
+	DynamicVectorClass<StringClass> name_list;
+
+	if (mix_factory.Is_Valid () == false || mix_factory.Build_Filename_List (name_list) == false) {
+		printf ("Unable to read the file list of %s.\n", filename);
+		return false;
+	}
+
+	m_MixList.Add (filename);
+	if (m_HasNameList == false) {
+		for (int index = 0; index < name_list.Count (); index ++) {
+			m_NameList.Add (name_list[index]);
+		}
+	}
+
+	printf ("%s: %d files.\n", filename, name_list.Count ());
+	return true;
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	Load_Names
+//
+//	The list replaces any names taken from the mix files, and mix files
+// added after it don't add their names.
+//
+/////////////////////////////////////////////////////////////////////////
+bool
+MixBenchClass::Load_Names (const char *filename)
+{
+	FILE *file = ::fopen (filename, "rt");
+	if (file == NULL) {
+		printf ("Unable to open %s.\n", filename);
+		return false;
+	}
+
+	m_NameList.Delete_All ();
+	m_HasNameList = true;
+
+	char line[512];
+	while (::fgets (line, sizeof (line), file) != NULL) {
+
+		//
+		//	Strip the line ending and skip blank lines
+		//
+		int len = ::strlen (line);
+		while (len > 0 && (line[len - 1] == '\n' || line[len - 1] == '\r' || line[len - 1] == ' ')) {
+			line[-- len] = 0;
+		}
+		if (len > 0) {
+			m_NameList.Add (line);
+		}
+	}
+
+	::fclose (file);
+	printf ("%s: %d names.\n", filename, m_NameList.Count ());
+	return true;
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	Run
+//
+/////////////////////////////////////////////////////////////////////////
+void
+MixBenchClass::Run (int passes)
+{
+	int mode;
+	for (mode = 0; mode < MODE_COUNT; mode ++) {
+		m_Results[mode].OpenTime	= 1.0E30F;
+		m_Results[mode].ReadTime	= 1.0E30F;
+	}
+
+	bool was_enabled = MixFileFactoryClass::Is_Memory_Mapping_Enabled ();
+	for (int pass = 0; pass < passes; pass ++) {
+		Run_Mode (false, m_Results[MODE_HANDLES]);
+		Run_Mode (true, m_Results[MODE_MAPPED]);
+	}
+	MixFileFactoryClass::Enable_Memory_Mapping (was_enabled);
+
+	return ;
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	Run_Mode
+//
+//	Opens the mix files, then reads every name through them in the same
+// way FileFactoryListClass looks files up.
+//
+/////////////////////////////////////////////////////////////////////////
+void
+MixBenchClass::Run_Mode (bool mapped, ResultStruct &result)
+{
+	MixFileFactoryClass::Enable_Memory_Mapping (mapped);
+
+	SimpleFileFactoryClass file_factory;
+	DynamicVectorClass<MixFileFactoryClass *> factory_list;
+	__int64 start_ticks = 0;
+	int index;
+
+	::QueryPerformanceCounter ((LARGE_INTEGER *)&start_ticks);
+	for (index = 0; index < m_MixList.Count (); index ++) {
+		factory_list.Add (new MixFileFactoryClass (m_MixList[index], &file_factory));
+	}
+	result.OpenTime = min (result.OpenTime, Get_Elapsed (start_ticks));
+
+	int found = 0;
+	unsigned int bytes = 0;
+
+	::QueryPerformanceCounter ((LARGE_INTEGER *)&start_ticks);
+	for (index = 0; index < m_NameList.Count (); index ++) {
+		for (int factory_index = 0; factory_index < factory_list.Count (); factory_index ++) {
+			MixFileFactoryClass *factory = factory_list[factory_index];
+			FileClass *file = factory->Get_File (m_NameList[index]);
+			if (file == NULL) {
+				continue;
+			}
+
+			//
+			//	Read the whole file, the way the loaders do
+			//
+			file->Open ();
+			int size = file->Size ();
+			if (size > m_BufferSize) {
+				delete [] m_Buffer;
+				m_Buffer			= new char[size];
+				m_BufferSize	= size;
+			}
+			bytes += file->Read (m_Buffer, size);
+			file->Close ();
+			factory->Return_File (file);
+
+			found ++;
+			break;
+		}
+	}
+	result.ReadTime	= min (result.ReadTime, Get_Elapsed (start_ticks));
+	result.Found		= found;
+	result.Bytes		= bytes;
+
+	for (index = 0; index < factory_list.Count (); index ++) {
+		delete factory_list[index];
+	}
+
+	return ;
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	Get_Elapsed
+//
+/////////////////////////////////////////////////////////////////////////
+float
+MixBenchClass::Get_Elapsed (__int64 start_ticks)
+{
+	__int64 end_ticks = 0;
+	::QueryPerformanceCounter ((LARGE_INTEGER *)&end_ticks);
+	return float(double(end_ticks - start_ticks) * 1000.0 / double(m_TicksPerSec));
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	Print_Report
+//
+/////////////////////////////////////////////////////////////////////////
+void
+MixBenchClass::Print_Report (void)
+{
+	int count = max (m_NameList.Count (), 1);
+
+	printf ("\n");
+	printf ("Files:            %d\n", m_NameList.Count ());
+	printf ("%-18s %12s %12s %12s %12s\n", "", "open ms", "read ms", "us/file", "MB/s");
+	for (int mode = 0; mode < MODE_COUNT; mode ++) {
+		const ResultStruct &result = m_Results[mode];
+		float seconds = max (result.ReadTime / 1000.0F, 1.0E-6F);
+		printf ("%-18s %12.2f %12.2f %12.2f %12.1f\n",
+					MODE_NAMES[mode],
+					result.OpenTime,
+					result.ReadTime,
+					result.ReadTime * 1000.0F / float(count),
+					float(result.Bytes) / (1024.0F * 1024.0F) / seconds);
+
+		if (result.Found != m_NameList.Count ()) {
+			printf ("  %d of %d files were not found\n", m_NameList.Count () - result.Found, m_NameList.Count ());
+		}
+	}
+
+	if (Modes_Agree () == false) {
+		printf ("  WARNING: the two modes read different files\n");
+	}
+
+	return ;
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	Modes_Agree
+//
+/////////////////////////////////////////////////////////////////////////
+bool
+MixBenchClass::Modes_Agree (void) const
+{
+	return (m_Results[MODE_HANDLES].Found == m_Results[MODE_MAPPED].Found &&
+			  m_Results[MODE_HANDLES].Bytes == m_Results[MODE_MAPPED].Bytes);
+}
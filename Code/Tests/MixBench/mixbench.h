@@ -0,0 +1,121 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/***********************************************************************************************
+ ***              C O N F I D E N T I A L  ---  W E S T W O O D  S T U D I O S               ***
+ ***********************************************************************************************
+ *                                                                                             *
+ *                 Project Name : Mix Benchmark                                                *
+ *                                                                                             *
+ *                     $Archive:: /Commando/Code/Tests/MixBench/mixbench.h                    $*
+ *                                                                                             *
+ *---------------------------------------------------------------------------------------------*
+ * Functions:                                                                                  *
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#ifndef __MIXBENCH_H
+#define __MIXBENCH_H
+
+#include "always.h"
+#include "vector.h"
+#include "wwstring.h"
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	MixBenchClass
+//
+//		Times reading files out of a set of mix files, once through
+//	file handles (the old way) and once through memory mapped mix files.
+// The files are looked up in the mix files in order, the way the game's
+// file factory list does, and each one is read in full the way the
+// loaders read them.  With no name list every file in every mix file is
+// read; a name list (such as the files one level loads) gives the load
+// order of a real level.
+//
+/////////////////////////////////////////////////////////////////////////
+class MixBenchClass
+{
+public:
+
+	/////////////////////////////////////////////////////////////////////////
+	// Public constructors/destructors
+	/////////////////////////////////////////////////////////////////////////
+	MixBenchClass (void);
+	~MixBenchClass (void);
+
+	/////////////////////////////////////////////////////////////////////////
+	// Public methods
+	/////////////////////////////////////////////////////////////////////////
+	bool				Add_Mix (const char *filename);
+	bool				Load_Names (const char *filename);
+	int				Get_Mix_Count (void) const		{ return m_MixList.Count (); }
+	void				Run (int passes);
+	void				Print_Report (void);
+	bool				Modes_Agree (void) const;
+
+protected:
+
+	/////////////////////////////////////////////////////////////////////////
+	// Protected data types
+	/////////////////////////////////////////////////////////////////////////
+	struct ResultStruct
+	{
+		float								OpenTime;		// best time over all passes (ms)
+		float								ReadTime;
+		int								Found;
+		unsigned int					Bytes;
+
+		bool operator== (const ResultStruct &src) { return false; }
+		bool operator!= (const ResultStruct &src) { return true; }
+	};
+
+	enum
+	{
+		MODE_HANDLES	= 0,
+		MODE_MAPPED,
+		MODE_COUNT
+	};
+
+	/////////////////////////////////////////////////////////////////////////
+	// Protected methods
+	/////////////////////////////////////////////////////////////////////////
+	void				Run_Mode (bool mapped, ResultStruct &result);
+	float				Get_Elapsed (__int64 start_ticks);
+
+private:
+
+	/////////////////////////////////////////////////////////////////////////
+	// Private member data
+	/////////////////////////////////////////////////////////////////////////
+	DynamicVectorClass<StringClass>		m_MixList;
+	DynamicVectorClass<StringClass>		m_NameList;			// files to read, in order
+	bool											m_HasNameList;		// names came from a list, not the mix files
+	char *										m_Buffer;
+	int											m_BufferSize;
+	ResultStruct								m_Results[MODE_COUNT];
+	__int64										m_TicksPerSec;
+};
+
+
+#endif //__MIXBENCH_H
@@ -0,0 +1,165 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/***********************************************************************************************
+ ***              C O N F I D E N T I A L  ---  W E S T W O O D  S T U D I O S               ***
+ ***********************************************************************************************
+ *                                                                                             *
+ *                 Project Name : Pathfind Benchmark                                           *
+ *                                                                                             *
+ *                     $Archive:: /Commando/Code/Tests/PathfindBench/main.cpp                 $*
+ *                                                                                             *
+ *---------------------------------------------------------------------------------------------*
+ * Functions:                                                                                  *
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+#include "pathbench.h"
+#include "wwmath.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/////////////////////////////////////////////////////////////////////////
+//	Local prototypes
+/////////////////////////////////////////////////////////////////////////
+static void	Print_Usage (void);
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	main
+//
+//	PathfindBench <level.lsd> [options]
+//
+//	Exit code is 0 on success, 1 if any route differs from the golden
+// file and 2 on usage/load errors, so it can be used from a build script.
+//
+/////////////////////////////////////////////////////////////////////////
+int
+main (int argc, char *argv[])
+{
+	if (argc < 2) {
+		Print_Usage ();
+		return 2;
+	}
+
+	const char *level_file	= argv[1];
+	const char *golden_file	= NULL;
+	const char *record_file	= NULL;
+	uint32 seed					= 1;
+	int count					= 1000;
+	int passes					= 3;
+	float radius				= 5.0F;
+	float tolerance			= 0.01F;
+
+	//
+	//	Parse the options
+	//
+	for (int index = 2; index < argc; index ++) {
+		const char *arg		= argv[index];
+		const char *value		= (index + 1 < argc) ? argv[index + 1] : NULL;
+
+		if (value == NULL) {
+			Print_Usage ();
+			return 2;
+		}
+
+		if (::stricmp (arg, "-seed") == 0) {
+			seed = (uint32)::strtoul (value, NULL, 10);
+		} else if (::stricmp (arg, "-count") == 0) {
+			count = ::atoi (value);
+		} else if (::stricmp (arg, "-passes") == 0) {
+			passes = ::atoi (value);
+		} else if (::stricmp (arg, "-radius") == 0) {
+			radius = (float)::atof (value);
+		} else if (::stricmp (arg, "-tolerance") == 0) {
+			tolerance = (float)::atof (value);
+		} else if (::stricmp (arg, "-golden") == 0) {
+			golden_file = value;
+		} else if (::stricmp (arg, "-record") == 0) {
+			record_file = value;
+		} else {
+			Print_Usage ();
+			return 2;
+		}
+
+		index ++;
+	}
+
+	WWMath::Init ();
+
+	int retval = 0;
+	{
+		PathBenchClass bench;
+		if (bench.Load_Level (level_file) == false) {
+			retval = 2;
+		} else {
+
+			//
+			//	Build the query set and time it
+			//
+			printf ("Running %d queries (seed %u, %d passes)...\n", count, seed, passes);
+			bench.Generate_Queries (seed, count, radius);
+			bench.Run (passes);
+			bench.Print_Report ();
+
+			//
+			//	Record or check the routes
+			//
+			if (record_file != NULL && bench.Save_Golden (record_file) == false) {
+				retval = 2;
+			}
+
+			if (golden_file != NULL) {
+				int mismatches = bench.Compare_Golden (golden_file, tolerance);
+				if (mismatches < 0) {
+					retval = 2;
+				} else if (mismatches > 0) {
+					printf ("%d routes differ from %s.\n", mismatches, golden_file);
+					retval = 1;
+				} else {
+					printf ("All routes match %s.\n", golden_file);
+				}
+			}
+		}
+	}
+
+	WWMath::Shutdown ();
+	return retval;
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	Print_Usage
+//
+/////////////////////////////////////////////////////////////////////////
+static void
+Print_Usage (void)
+{
+	printf ("Usage: PathfindBench <level.lsd> [options]\n");
+	printf ("  -seed <n>          random seed for the query set (default 1)\n");
+	printf ("  -count <n>         number of start/end pairs (default 1000)\n");
+	printf ("  -passes <n>        times to solve each pair, best time is kept (default 3)\n");
+	printf ("  -radius <m>        Find_Random_Spot radius around each sector (default 5)\n");
+	printf ("  -record <file>     write the solved routes as a golden file\n");
+	printf ("  -golden <file>     compare the solved routes against a golden file\n");
+	printf ("  -tolerance <m>     allowed per-point difference from the golden file (default 0.01)\n");
+	return ;
+}
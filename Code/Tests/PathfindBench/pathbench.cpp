@@ -0,0 +1,463 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/***********************************************************************************************
+ ***              C O N F I D E N T I A L  ---  W E S T W O O D  S T U D I O S               ***
+ ***********************************************************************************************
+ *                                                                                             *
+ *                 Project Name : Pathfind Benchmark                                           *
+ *                                                                                             *
+ *                     $Archive:: /Commando/Code/Tests/PathfindBench/pathbench.cpp            $*
+ *                                                                                             *
+ *---------------------------------------------------------------------------------------------*
+ * Functions:                                                                                  *
+ *   PathBenchClass::Load_Level -- Pulls the pathfind data out of a level file                 *
+ *   PathBenchClass::Generate_Queries -- Builds a repeatable list of start/end pairs           *
+ *   PathBenchClass::Run -- Solves every query, keeping the best time of each                  *
+ *   PathBenchClass::Print_Report -- Prints timing, node and length statistics                 *
+ *   PathBenchClass::Save_Golden -- Writes the solved routes out as the reference set          *
+ *   PathBenchClass::Compare_Golden -- Checks the solved routes against a reference set        *
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+#include "pathbench.h"
+#include "pathfind.h"
+#include "pathfindsector.h"
+#include "pathsolve.h"
+#include "physstaticsavesystem.h"
+#include "wwphysids.h"
+#include "rawfile.h"
+#include "chunkio.h"
+#include "random.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <windows.h>
+
+
+/////////////////////////////////////////////////////////////////////////
+//	Local constants
+/////////////////////////////////////////////////////////////////////////
+static const char *	GOLDEN_HEADER	= "PATHBENCH_GOLDEN";
+static const char *	STATE_NAMES[]	=
+{
+	"THINKING",
+	"SOLVED",
+	"BAD_START",
+	"BAD_DEST",
+	"NO_PATH"
+};
+
+
+/////////////////////////////////////////////////////////////////////////
+//	Local prototypes
+/////////////////////////////////////////////////////////////////////////
+static int __cdecl	fnFloatSortCallback (const void *elem1, const void *elem2);
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	PathBenchClass
+//
+/////////////////////////////////////////////////////////////////////////
+PathBenchClass::PathBenchClass (void)
+	:	m_Pathfind (NULL),
+		m_TicksPerSec (1)
+{
+	m_Pathfind = new PathfindClass;
+	m_PathObject.Init_Human ();
+
+	::QueryPerformanceFrequency ((LARGE_INTEGER *)&m_TicksPerSec);
+	return ;
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	~PathBenchClass
+//
+/////////////////////////////////////////////////////////////////////////
+PathBenchClass::~PathBenchClass (void)
+{
+	delete m_Pathfind;
+	m_Pathfind = NULL;
+	return ;
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	Load_Level
+//
+//	Reads a level's static data file (.lsd) and loads just the pathfind
+// chunk from the physics static-data sub-system.
+//
+/////////////////////////////////////////////////////////////////////////
+bool
+PathBenchClass::Load_Level (const char *filename)
+{
+	bool retval = false;
+
+	RawFileClass file (filename);
+	if (file.Open (RawFileClass::READ) == false) {
+		printf ("Unable to open %s.\n", filename);
+		return false;
+	}
+
+	ChunkLoadClass cload (&file);
+	while (cload.Open_Chunk ()) {
+		if (cload.Cur_Chunk_ID () == PHYSICS_CHUNKID_STATIC_DATA_SUBSYSTEM) {
+			while (cload.Open_Chunk ()) {
+				if (cload.Cur_Chunk_ID () == PhysStaticDataSaveSystemClass::PSDSSC_CHUNKID_PATHFIND) {
+					retval = m_Pathfind->Load (cload);
+				}
+				cload.Close_Chunk ();
+			}
+		}
+		cload.Close_Chunk ();
+	}
+
+	file.Close ();
+
+	if (retval == false || m_Pathfind->Does_Pathfind_Data_Exist () == false) {
+		printf ("No pathfind data found in %s.\n", filename);
+		return false;
+	}
+
+	printf ("Loaded %d pathfind sectors from %s.\n", m_Pathfind->Get_Sector_Count (), filename);
+	return true;
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	Generate_Queries
+//
+//	Both the sector choice and Find_Random_Spot are driven from the seed,
+// so the same seed always produces the same list for the same level.
+//
+/////////////////////////////////////////////////////////////////////////
+void
+PathBenchClass::Generate_Queries (uint32 seed, int count, float spot_radius)
+{
+	m_QueryList.Delete_All ();
+
+	int sector_count = m_Pathfind->Get_Sector_Count ();
+	if (sector_count == 0) {
+		return ;
+	}
+
+	RandomClass random (seed);
+	::srand (seed);
+
+	for (int index = 0; index < count; index ++) {
+
+		PathfindSectorClass *start_sector	= m_Pathfind->Peek_Sector (random (0, sector_count - 1));
+		PathfindSectorClass *dest_sector		= m_Pathfind->Peek_Sector (random (0, sector_count - 1));
+
+		QueryStruct query;
+		query.StartPos			= start_sector->Get_Bounding_Box ().Center;
+		query.DestPos			= dest_sector->Get_Bounding_Box ().Center;
+		query.State				= PathSolveClass::THINKING;
+		query.SolveTime		= 0;
+		query.ExpandedNodes	= 0;
+		query.PathLength		= 0;
+
+		m_Pathfind->Find_Random_Spot (query.StartPos, spot_radius, &query.StartPos);
+		m_Pathfind->Find_Random_Spot (query.DestPos, spot_radius, &query.DestPos);
+		m_QueryList.Add (query);
+	}
+
+	return ;
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	Solve_Query
+//
+/////////////////////////////////////////////////////////////////////////
+void
+PathBenchClass::Solve_Query (QueryStruct &query, bool record_route)
+{
+	PathSolveClass *solver = new PathSolveClass;
+	solver->Set_Path_Object (m_PathObject);
+
+	__int64 start_ticks = 0;
+	__int64 end_ticks = 0;
+	::QueryPerformanceCounter ((LARGE_INTEGER *)&start_ticks);
+
+	//
+	//	Run the solve to completion (the same sequence PathMgrClass uses,
+	// without the per-frame time slicing).
+	//
+	PathSolveClass::STATE_DESC state = solver->Reset (query.StartPos, query.DestPos);
+	if (state == PathSolveClass::THINKING) {
+		solver->Process_Initial_Sector ();
+		while (state == PathSolveClass::THINKING) {
+			state = solver->Timestep (1000);
+		}
+	}
+
+	::QueryPerformanceCounter ((LARGE_INTEGER *)&end_ticks);
+	solver->Unlink_Pathfind_Hooks ();
+
+	float solve_time = float(double(end_ticks - start_ticks) * 1000.0 / double(m_TicksPerSec));
+	if (record_route || solve_time < query.SolveTime) {
+		query.SolveTime = solve_time;
+	}
+
+	//
+	//	Record the route itself
+	//
+	if (record_route) {
+		query.State				= state;
+		query.ExpandedNodes	= solver->Get_Expanded_Node_Count ();
+		query.PathLength		= 0;
+		query.PointList.Delete_All ();
+
+		for (int index = 0; index < solver->Get_Path_Point_Count (); index ++) {
+			const Vector3 &point = solver->Get_Path_Point (index);
+			if (index > 0) {
+				query.PathLength += (point - query.PointList[index - 1]).Length ();
+			}
+			query.PointList.Add (point);
+		}
+	}
+
+	REF_PTR_RELEASE (solver);
+	return ;
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	Run
+//
+/////////////////////////////////////////////////////////////////////////
+void
+PathBenchClass::Run (int passes)
+{
+	passes = max (passes, 1);
+
+	for (int pass = 0; pass < passes; pass ++) {
+		for (int index = 0; index < m_QueryList.Count (); index ++) {
+			Solve_Query (m_QueryList[index], (pass == 0));
+		}
+	}
+
+	return ;
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	Get_Percentile
+//
+/////////////////////////////////////////////////////////////////////////
+float
+PathBenchClass::Get_Percentile (DynamicVectorClass<float> &sorted_list, float percent)
+{
+	if (sorted_list.Count () == 0) {
+		return 0;
+	}
+
+	int index = int((percent / 100.0F) * float(sorted_list.Count () - 1) + 0.5F);
+	index = max (index, 0);
+	index = min (index, sorted_list.Count () - 1);
+	return sorted_list[index];
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	Print_Report
+//
+/////////////////////////////////////////////////////////////////////////
+void
+PathBenchClass::Print_Report (void)
+{
+	DynamicVectorClass<float> time_list;
+	int state_counts[ARRAY_SIZE (STATE_NAMES)] = { 0 };
+	float total_time		= 0;
+	float total_length	= 0;
+	int total_nodes		= 0;
+	int max_nodes			= 0;
+	int solved_count		= 0;
+
+	int index;
+	for (index = 0; index < m_QueryList.Count (); index ++) {
+		const QueryStruct &query = m_QueryList[index];
+		time_list.Add (query.SolveTime);
+		total_time	+= query.SolveTime;
+		total_nodes	+= query.ExpandedNodes;
+		max_nodes	= max (max_nodes, query.ExpandedNodes);
+
+		if (query.State >= 0 && query.State < ARRAY_SIZE (STATE_NAMES)) {
+			state_counts[query.State] ++;
+		}
+
+		if (query.State == PathSolveClass::SOLVED_PATH) {
+			total_length += query.PathLength;
+			solved_count ++;
+		}
+	}
+
+	if (time_list.Count () > 0) {
+		::qsort (&time_list[0], time_list.Count (), sizeof (float), fnFloatSortCallback);
+	}
+
+	int count = max (m_QueryList.Count (), 1);
+	printf ("\n");
+	printf ("Queries:          %d\n", m_QueryList.Count ());
+	for (index = 0; index < ARRAY_SIZE (STATE_NAMES); index ++) {
+		if (state_counts[index] > 0) {
+			printf ("  %-15s %d\n", STATE_NAMES[index], state_counts[index]);
+		}
+	}
+	printf ("Solve time (ms):  mean %.3f  p50 %.3f  p90 %.3f  p99 %.3f  max %.3f\n",
+				total_time / float(count),
+				Get_Percentile (time_list, 50),
+				Get_Percentile (time_list, 90),
+				Get_Percentile (time_list, 99),
+				Get_Percentile (time_list, 100));
+	printf ("Nodes expanded:   mean %.1f  max %d\n", float(total_nodes) / float(count), max_nodes);
+	printf ("Path length (m):  mean %.2f\n", (solved_count > 0) ? (total_length / float(solved_count)) : 0.0F);
+	return ;
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	Save_Golden
+//
+//	Text format, one query per line:
+//
+//		index state point_count length x y z x y z ...
+//
+/////////////////////////////////////////////////////////////////////////
+bool
+PathBenchClass::Save_Golden (const char *filename)
+{
+	FILE *file = ::fopen (filename, "wt");
+	if (file == NULL) {
+		printf ("Unable to create %s.\n", filename);
+		return false;
+	}
+
+	fprintf (file, "%s %d\n", GOLDEN_HEADER, m_QueryList.Count ());
+	for (int index = 0; index < m_QueryList.Count (); index ++) {
+		const QueryStruct &query = m_QueryList[index];
+		fprintf (file, "%d %d %d %f", index, query.State, query.PointList.Count (), query.PathLength);
+		for (int point = 0; point < query.PointList.Count (); point ++) {
+			const Vector3 &pos = query.PointList[point];
+			fprintf (file, " %f %f %f", pos.X, pos.Y, pos.Z);
+		}
+		fprintf (file, "\n");
+	}
+
+	::fclose (file);
+	return true;
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	Compare_Golden
+//
+//	Returns the number of queries whose result doesn't match the golden
+// file (or -1 if the file couldn't be used).
+//
+/////////////////////////////////////////////////////////////////////////
+int
+PathBenchClass::Compare_Golden (const char *filename, float tolerance)
+{
+	FILE *file = ::fopen (filename, "rt");
+	if (file == NULL) {
+		printf ("Unable to open %s.\n", filename);
+		return -1;
+	}
+
+	char header[64]	= { 0 };
+	int golden_count	= 0;
+	if (	fscanf (file, "%63s %d", header, &golden_count) != 2 ||
+			::strcmp (header, GOLDEN_HEADER) != 0 ||
+			golden_count != m_QueryList.Count ())
+	{
+		printf ("%s does not match this query set.\n", filename);
+		::fclose (file);
+		return -1;
+	}
+
+	int mismatch_count = 0;
+	for (int index = 0; index < golden_count; index ++) {
+		const QueryStruct &query = m_QueryList[index];
+
+		int golden_index	= 0;
+		int state			= 0;
+		int point_count	= 0;
+		float length		= 0;
+		if (fscanf (file, "%d %d %d %f", &golden_index, &state, &point_count, &length) != 4) {
+			printf ("%s is truncated at query %d.\n", filename, index);
+			::fclose (file);
+			return -1;
+		}
+
+		//
+		//	Compare the route point-by-point
+		//
+		bool matches = (state == query.State) && (point_count == query.PointList.Count ());
+		for (int point = 0; point < point_count; point ++) {
+			Vector3 pos;
+			fscanf (file, "%f %f %f", &pos.X, &pos.Y, &pos.Z);
+			if (matches && (pos - query.PointList[point]).Length () > tolerance) {
+				matches = false;
+			}
+		}
+
+		if (matches == false) {
+			printf ("Query %d differs: expected %s with %d points (%.2fm), got %s with %d points (%.2fm).\n",
+						index,
+						STATE_NAMES[min (max (state, 0), ARRAY_SIZE (STATE_NAMES) - 1)], point_count, length,
+						STATE_NAMES[min (max (query.State, 0), ARRAY_SIZE (STATE_NAMES) - 1)], query.PointList.Count (), query.PathLength);
+			mismatch_count ++;
+		}
+	}
+
+	::fclose (file);
+	return mismatch_count;
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	fnFloatSortCallback
+//
+/////////////////////////////////////////////////////////////////////////
+static int __cdecl
+fnFloatSortCallback (const void *elem1, const void *elem2)
+{
+	float value1 = *((const float *)elem1);
+	float value2 = *((const float *)elem2);
+
+	if (value1 < value2) {
+		return -1;
+	} else if (value1 > value2) {
+		return 1;
+	}
+
+	return 0;
+}
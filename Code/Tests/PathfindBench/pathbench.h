@@ -0,0 +1,123 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/***********************************************************************************************
+ ***              C O N F I D E N T I A L  ---  W E S T W O O D  S T U D I O S               ***
+ ***********************************************************************************************
+ *                                                                                             *
+ *                 Project Name : Pathfind Benchmark                                           *
+ *                                                                                             *
+ *                     $Archive:: /Commando/Code/Tests/PathfindBench/pathbench.h              $*
+ *                                                                                             *
+ *---------------------------------------------------------------------------------------------*
+ * Functions:                                                                                  *
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#ifndef __PATHBENCH_H
+#define __PATHBENCH_H
+
+#include "always.h"
+#include "vector.h"
+#include "vector3.h"
+#include "PathObject.h"
+
+
+/////////////////////////////////////////////////////////////////////////
+// Forward declarations
+/////////////////////////////////////////////////////////////////////////
+class PathfindClass;
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	PathBenchClass
+//
+//		Loads the pathfind data out of a level file, generates a repeatable
+//	set of start/end pairs and runs each one through PathSolveClass to
+// completion.  Results can be written out as 'golden' routes and later
+// compared against, so changes to the solver can be checked for both
+// speed and correctness.
+//
+/////////////////////////////////////////////////////////////////////////
+class PathBenchClass
+{
+public:
+
+	/////////////////////////////////////////////////////////////////////////
+	// Public constructors/destructors
+	/////////////////////////////////////////////////////////////////////////
+	PathBenchClass (void);
+	~PathBenchClass (void);
+
+	/////////////////////////////////////////////////////////////////////////
+	// Public methods
+	/////////////////////////////////////////////////////////////////////////
+	bool				Load_Level (const char *filename);
+	void				Generate_Queries (uint32 seed, int count, float spot_radius);
+	void				Run (int passes);
+	void				Print_Report (void);
+
+	//
+	//	Golden route support
+	//
+	bool				Save_Golden (const char *filename);
+	int				Compare_Golden (const char *filename, float tolerance);
+
+protected:
+
+	/////////////////////////////////////////////////////////////////////////
+	// Protected data types
+	/////////////////////////////////////////////////////////////////////////
+	struct QueryStruct
+	{
+		Vector3							StartPos;
+		Vector3							DestPos;
+
+		int								State;
+		float								SolveTime;		// best time over all passes (ms)
+		int								ExpandedNodes;
+		float								PathLength;
+		DynamicVectorClass<Vector3>	PointList;
+
+		bool operator== (const QueryStruct &src) { return false; }
+		bool operator!= (const QueryStruct &src) { return true; }
+	};
+
+	/////////////////////////////////////////////////////////////////////////
+	// Protected methods
+	/////////////////////////////////////////////////////////////////////////
+	void				Solve_Query (QueryStruct &query, bool record_route);
+	static float	Get_Percentile (DynamicVectorClass<float> &sorted_list, float percent);
+
+private:
+
+	/////////////////////////////////////////////////////////////////////////
+	// Private member data
+	/////////////////////////////////////////////////////////////////////////
+	PathfindClass *							m_Pathfind;
+	PathObjectClass							m_PathObject;
+	DynamicVectorClass<QueryStruct>		m_QueryList;
+	__int64										m_TicksPerSec;
+};
+
+
+#endif //__PATHBENCH_H
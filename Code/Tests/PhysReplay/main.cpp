@@ -0,0 +1,218 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/***********************************************************************************************
+ ***              C O N F I D E N T I A L  ---  W E S T W O O D  S T U D I O S               ***
+ ***********************************************************************************************
+ *                                                                                             *
+ *                 Project Name : Physics Replay                                               *
+ *                                                                                             *
+ *                     $Archive:: /Commando/Code/Tests/PhysReplay/main.cpp                    $*
+ *                                                                                             *
+ *---------------------------------------------------------------------------------------------*
+ * Functions:                                                                                  *
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+#include "physreplay.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/////////////////////////////////////////////////////////////////////////
+//	Local prototypes
+/////////////////////////////////////////////////////////////////////////
+static void	Print_Usage (void);
+static int	Compare_Island_Timestep (const char *recording_file);
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	main
+//
+//	PhysReplay <recording> [options]
+//
+//	Exit code is 0 on success, 1 if any object ends up somewhere other
+// than where it was recorded (or, with -compare, if island time-stepping
+// doesn't match the serial loop) and 2 on usage/load errors, so it can
+// be used from a build script.
+//
+/////////////////////////////////////////////////////////////////////////
+int
+main (int argc, char *argv[])
+{
+	if (argc < 2) {
+		Print_Usage ();
+		return 2;
+	}
+
+	const char *recording_file	= argv[1];
+	int islands						= -1;
+	bool check						= true;
+	bool compare					= false;
+	float pos_tolerance			= 0.01F;
+	float rot_tolerance			= 0.001F;
+
+	//
+	//	Parse the options
+	//
+	for (int index = 2; index < argc; index ++) {
+		const char *arg		= argv[index];
+
+		if (::stricmp (arg, "-nocheck") == 0) {
+			check = false;
+			continue;
+		}
+
+		if (::stricmp (arg, "-compare") == 0) {
+			compare = true;
+			continue;
+		}
+
+		const char *value		= (index + 1 < argc) ? argv[index + 1] : NULL;
+		if (value == NULL) {
+			Print_Usage ();
+			return 2;
+		}
+
+		if (::stricmp (arg, "-islands") == 0) {
+			islands = ::atoi (value);
+		} else if (::stricmp (arg, "-postol") == 0) {
+			pos_tolerance = (float)::atof (value);
+		} else if (::stricmp (arg, "-rottol") == 0) {
+			rot_tolerance = (float)::atof (value);
+		} else {
+			Print_Usage ();
+			return 2;
+		}
+
+		index ++;
+	}
+
+	if (compare) {
+		return Compare_Island_Timestep (recording_file);
+	}
+
+	int retval = 0;
+	{
+		PhysReplayClass replay;
+		if (replay.Init () == false || replay.Load_Recording (recording_file) == false) {
+			retval = 2;
+		} else {
+
+			if (islands != -1) {
+				replay.Set_Island_Timestep (islands != 0);
+			}
+
+			//
+			//	Re-run the recording and time it
+			//
+			printf ("Replaying %s...\n", recording_file);
+			replay.Run ();
+			replay.Print_Report ();
+
+			//
+			//	Check where everything ended up
+			//
+			if (check) {
+				int mismatches = replay.Check_Transforms (pos_tolerance, rot_tolerance);
+				if (mismatches > 0) {
+					printf ("%d objects differ from %s.\n", mismatches, recording_file);
+					retval = 1;
+				} else {
+					printf ("All objects match %s.\n", recording_file);
+				}
+			}
+		}
+
+		replay.Shutdown ();
+	}
+
+	return retval;
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	Compare_Island_Timestep
+//
+//	Replays the recording once with the serial time-step loop and once
+// with island time-stepping, each from a fresh load, and checks that
+// every recorded object ends up in exactly the same place.  Use a
+// recording made on a level with an elevator or doors so the pusher
+// and rider ordering gets exercised.
+//
+/////////////////////////////////////////////////////////////////////////
+static int
+Compare_Island_Timestep (const char *recording_file)
+{
+	DynamicVectorClass<Matrix3D> serial_transforms;
+
+	for (int pass = 0; pass < 2; pass ++) {
+		bool islands = (pass == 1);
+
+		PhysReplayClass replay;
+		if (replay.Init () == false || replay.Load_Recording (recording_file) == false) {
+			replay.Shutdown ();
+			return 2;
+		}
+
+		replay.Set_Island_Timestep (islands);
+		printf ("Replaying %s %s...\n", recording_file, islands ? "with islands" : "serially");
+		replay.Run ();
+
+		if (islands == false) {
+			replay.Get_Transforms (serial_transforms);
+			replay.Shutdown ();
+			continue;
+		}
+
+		int mismatches = replay.Compare_Transforms (serial_transforms);
+		replay.Shutdown ();
+
+		if (mismatches > 0) {
+			printf ("%d objects differ between the serial and island time-step.\n", mismatches);
+			return 1;
+		}
+	}
+
+	printf ("Island time-step matches the serial time-step.\n");
+	return 0;
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	Print_Usage
+//
+/////////////////////////////////////////////////////////////////////////
+static void
+Print_Usage (void)
+{
+	printf ("Usage: PhysReplay <recording> [options]\n");
+	printf ("  -islands <0|1>     force island time-stepping off or on (default: scene default)\n");
+	printf ("  -nocheck           don't compare the final transforms with the recording\n");
+	printf ("  -compare           replay serially and with islands and require identical results\n");
+	printf ("  -postol <m>        allowed position difference (default 0.01)\n");
+	printf ("  -rottol <n>        allowed difference in any rotation element (default 0.001)\n");
+	printf ("\n");
+	printf ("Recordings are made in the game with the phys_record_begin and phys_record_end\n");
+	printf ("console commands.  Objects spawned during the recording aren't recorded.\n");
+	printf ("Run from the game's data directory so the models can be found.\n");
+	return ;
+}
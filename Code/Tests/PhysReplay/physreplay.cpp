@@ -0,0 +1,486 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/***********************************************************************************************
+ ***              C O N F I D E N T I A L  ---  W E S T W O O D  S T U D I O S               ***
+ ***********************************************************************************************
+ *                                                                                             *
+ *                 Project Name : Physics Replay                                               *
+ *                                                                                             *
+ *                     $Archive:: /Commando/Code/Tests/PhysReplay/physreplay.cpp              $*
+ *                                                                                             *
+ *---------------------------------------------------------------------------------------------*
+ * Functions:                                                                                  *
+ *   PhysReplayClass::Init -- Brings up the physics system without a renderer                  *
+ *   PhysReplayClass::Shutdown -- Releases the scene and shuts the libraries down              *
+ *   PhysReplayClass::Load_Recording -- Loads the initial state and the recorded frames        *
+ *   PhysReplayClass::Run -- Re-runs every recorded frame, timing each one                     *
+ *   PhysReplayClass::Print_Report -- Prints frame timings and the profiled phases             *
+ *   PhysReplayClass::Check_Transforms -- Compares final transforms with the recording         *
+ *   PhysReplayClass::Get_Transforms -- Captures the transform of every recorded object        *
+ *   PhysReplayClass::Compare_Transforms -- Compares transforms with a captured set            *
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+#include "physreplay.h"
+#include "physrecorder.h"
+#include "pscene.h"
+#include "phys.h"
+#include "pathmgr.h"
+#include "wwphys.h"
+#include "wwsaveload.h"
+#include "saveload.h"
+#include "definitionmgr.h"
+#include "assetmgr.h"
+#include "ww3d.h"
+#include "wwmath.h"
+#include "wwprofile.h"
+#include "rawfile.h"
+#include "chunkio.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <windows.h>
+
+
+/////////////////////////////////////////////////////////////////////////
+//	Local prototypes
+/////////////////////////////////////////////////////////////////////////
+static int __cdecl	fnFloatSortCallback (const void *elem1, const void *elem2);
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	PhysReplayClass
+//
+/////////////////////////////////////////////////////////////////////////
+PhysReplayClass::PhysReplayClass (void)
+	:	m_Scene (NULL),
+		m_IsInitted (false),
+		m_SimulatedTime (0),
+		m_TicksPerSec (1)
+{
+	::QueryPerformanceFrequency ((LARGE_INTEGER *)&m_TicksPerSec);
+	return ;
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	~PhysReplayClass
+//
+/////////////////////////////////////////////////////////////////////////
+PhysReplayClass::~PhysReplayClass (void)
+{
+	Shutdown ();
+	return ;
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	Init
+//
+//	Same start-up order as the game uses for a dedicated server: WW3D
+// comes up in 'lite' mode so no render device is created.  The assets
+// the objects use are loaded through the default file factory, so the
+// tool should be run from the game's data directory.
+//
+/////////////////////////////////////////////////////////////////////////
+bool
+PhysReplayClass::Init (void)
+{
+	new WW3DAssetManager;
+
+	WWMath::Init ();
+	PathMgrClass::Initialize ();
+
+	if (WW3D::Init (NULL, NULL, true) != WW3D_ERROR_OK) {
+		printf ("Unable to initialize WW3D.\n");
+		return false;
+	}
+
+	WWPhys::Init ();
+	WWSaveLoad::Init ();
+
+	m_Scene = new PhysicsSceneClass;
+	m_IsInitted = true;
+	return true;
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	Shutdown
+//
+/////////////////////////////////////////////////////////////////////////
+void
+PhysReplayClass::Shutdown (void)
+{
+	if (m_IsInitted == false) {
+		return ;
+	}
+
+	//
+	//	The recorder's controllers are still hooked up to the objects
+	//
+	_PhysRecorder.Reset ();
+
+	m_Scene->Remove_All ();
+	REF_PTR_RELEASE (m_Scene);
+	DefinitionMgrClass::Free_Definitions ();
+
+	PathMgrClass::Shutdown ();
+	WWMath::Shutdown ();
+	WWSaveLoad::Shutdown ();
+	WW3D::Shutdown ();
+	WWPhys::Shutdown ();
+	WW3DAssetManager::Delete_This ();
+
+	m_IsInitted = false;
+	return ;
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	Load_Recording
+//
+//	The recording is an ordinary save file, so the normal save-load
+// system recreates the level and the objects and hands the frames to
+// the recording sub-system.
+//
+/////////////////////////////////////////////////////////////////////////
+bool
+PhysReplayClass::Load_Recording (const char *filename)
+{
+	RawFileClass file (filename);
+	if (file.Open (RawFileClass::READ) == false) {
+		printf ("Unable to open %s.\n", filename);
+		return false;
+	}
+
+	ChunkLoadClass cload (&file);
+	SaveLoadSystemClass::Load (cload);
+	file.Close ();
+
+	if (_PhysRecorder.Get_Frame_Count () == 0) {
+		printf ("No recorded frames found in %s.\n", filename);
+		return false;
+	}
+
+	//
+	//	Without a renderer nothing is ever visible, so every object has to
+	// be simulated.  Recordings made with the visible-only optimization
+	// on may not match.
+	//
+	if (_PhysRecorder.Get_Update_Only_Visible_Objects ()) {
+		printf ("Warning: %s was recorded with Update_Only_Visible_Objects enabled.\n", filename);
+	}
+	m_Scene->Set_Update_Only_Visible_Objects (false);
+
+	printf ("Loaded %d frames and %d objects from %s.\n",
+				_PhysRecorder.Get_Frame_Count (), _PhysRecorder.Get_Object_Count (), filename);
+	return true;
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	Set_Island_Timestep
+//
+/////////////////////////////////////////////////////////////////////////
+void
+PhysReplayClass::Set_Island_Timestep (bool onoff)
+{
+	m_Scene->Enable_Island_Timestep (onoff);
+	return ;
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	Run
+//
+/////////////////////////////////////////////////////////////////////////
+void
+PhysReplayClass::Run (void)
+{
+	m_FrameTimes.Delete_All ();
+	m_SimulatedTime = 0;
+	WWProfileManager::Reset ();
+
+	for (int frame = 0; frame < _PhysRecorder.Get_Frame_Count (); frame ++) {
+		float dt = _PhysRecorder.Get_Frame_Time (frame);
+		_PhysRecorder.Apply_Frame_Inputs (frame);
+
+		__int64 start_ticks = 0;
+		__int64 end_ticks = 0;
+		::QueryPerformanceCounter ((LARGE_INTEGER *)&start_ticks);
+
+		m_Scene->Update (dt, frame);
+
+		::QueryPerformanceCounter ((LARGE_INTEGER *)&end_ticks);
+		WWProfileManager::Increment_Frame_Counter ();
+
+		m_FrameTimes.Add (float(double(end_ticks - start_ticks) * 1000.0 / double(m_TicksPerSec)));
+		m_SimulatedTime += dt;
+	}
+
+	return ;
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	Get_Percentile
+//
+/////////////////////////////////////////////////////////////////////////
+float
+PhysReplayClass::Get_Percentile (DynamicVectorClass<float> &sorted_list, float percent)
+{
+	if (sorted_list.Count () == 0) {
+		return 0;
+	}
+
+	int index = int((percent / 100.0F) * float(sorted_list.Count () - 1) + 0.5F);
+	index = max (index, 0);
+	index = min (index, sorted_list.Count () - 1);
+	return sorted_list[index];
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	Print_Report
+//
+/////////////////////////////////////////////////////////////////////////
+void
+PhysReplayClass::Print_Report (void)
+{
+	DynamicVectorClass<float> time_list;
+	float total_time = 0;
+
+	for (int index = 0; index < m_FrameTimes.Count (); index ++) {
+		time_list.Add (m_FrameTimes[index]);
+		total_time += m_FrameTimes[index];
+	}
+
+	if (time_list.Count () > 0) {
+		::qsort (&time_list[0], time_list.Count (), sizeof (float), fnFloatSortCallback);
+	}
+
+	int count = max (m_FrameTimes.Count (), 1);
+	printf ("\n");
+	printf ("Frames:           %d (%.2f s of game time)\n", m_FrameTimes.Count (), m_SimulatedTime);
+	printf ("Total time (ms):  %.3f\n", total_time);
+	printf ("Frame time (ms):  mean %.3f  p50 %.3f  p90 %.3f  p99 %.3f  max %.3f\n",
+				total_time / float(count),
+				Get_Percentile (time_list, 50),
+				Get_Percentile (time_list, 90),
+				Get_Percentile (time_list, 99),
+				Get_Percentile (time_list, 100));
+
+	//
+	//	Break the time down by the phases the scene profiles
+	//
+	printf ("\n%-48s %10s %12s %10s\n", "Phase", "Calls", "Total (ms)", "Per frame");
+	WWProfileIterator *iterator = WWProfileManager::Get_Iterator ();
+	Print_Profile (iterator, 0);
+	WWProfileManager::Release_Iterator (iterator);
+	return ;
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	Print_Profile
+//
+//	Prints each child of the iterator's current node followed by its own
+// children, indented by depth.
+//
+/////////////////////////////////////////////////////////////////////////
+void
+PhysReplayClass::Print_Profile (WWProfileIterator *iterator, int depth)
+{
+	int frames = max (WWProfileManager::Get_Frame_Count_Since_Reset (), 1);
+
+	int index = 0;
+	iterator->First ();
+	while (iterator->Is_Done () == false) {
+
+		float time = iterator->Get_Current_Total_Time () * 1000.0F;
+		printf ("%*s%-*s %10d %12.3f %10.4f\n",
+					depth * 2, "",
+					48 - depth * 2, iterator->Get_Current_Name (),
+					iterator->Get_Current_Total_Calls (),
+					time,
+					time / float(frames));
+
+		iterator->Enter_Child ();
+		Print_Profile (iterator, depth + 1);
+		iterator->Enter_Parent ();
+
+		//
+		//	Entering the parent puts us back at its first child
+		//
+		index ++;
+		iterator->First ();
+		for (int skip = 0; skip < index && iterator->Is_Done () == false; skip ++) {
+			iterator->Next ();
+		}
+	}
+
+	return ;
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	Check_Transforms
+//
+//	Returns the number of objects whose final transform is further than
+// the tolerances from the recorded one.  The rotation tolerance is the
+// largest difference allowed in any element of the rotation part.
+//
+/////////////////////////////////////////////////////////////////////////
+int
+PhysReplayClass::Check_Transforms (float pos_tolerance, float rot_tolerance)
+{
+	int mismatch_count	= 0;
+	int checked_count		= 0;
+
+	for (int index = 0; index < _PhysRecorder.Get_Object_Count (); index ++) {
+		PhysClass *obj = _PhysRecorder.Peek_Object (index);
+
+		Matrix3D recorded_tm;
+		if (obj == NULL || _PhysRecorder.Get_Final_Transform (index, &recorded_tm) == false) {
+			continue;
+		}
+		checked_count ++;
+
+		const Matrix3D &tm = obj->Get_Transform ();
+		float pos_error = (tm.Get_Translation () - recorded_tm.Get_Translation ()).Length ();
+		float rot_error = 0;
+		for (int row = 0; row < 3; row ++) {
+			for (int col = 0; col < 3; col ++) {
+				rot_error = max (rot_error, WWMath::Fabs (tm[row][col] - recorded_tm[row][col]));
+			}
+		}
+
+		if (pos_error > pos_tolerance || rot_error > rot_tolerance) {
+			Vector3 pos				= tm.Get_Translation ();
+			Vector3 recorded_pos	= recorded_tm.Get_Translation ();
+			printf ("Object %d (%s) differs: expected (%.3f, %.3f, %.3f), got (%.3f, %.3f, %.3f), rotation error %.4f.\n",
+						index, obj->Get_Name (),
+						recorded_pos.X, recorded_pos.Y, recorded_pos.Z,
+						pos.X, pos.Y, pos.Z,
+						rot_error);
+			mismatch_count ++;
+		}
+	}
+
+	printf ("Checked %d object transforms.\n", checked_count);
+	return mismatch_count;
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	Get_Transforms
+//
+//	One entry per recorded object, in recording order, so the list can
+// be compared against another replay of the same recording.
+//
+/////////////////////////////////////////////////////////////////////////
+void
+PhysReplayClass::Get_Transforms (DynamicVectorClass<Matrix3D> &list)
+{
+	list.Delete_All ();
+
+	for (int index = 0; index < _PhysRecorder.Get_Object_Count (); index ++) {
+		PhysClass *obj = _PhysRecorder.Peek_Object (index);
+		if (obj != NULL) {
+			list.Add (obj->Get_Transform ());
+		} else {
+			list.Add (Matrix3D (1));
+		}
+	}
+
+	return ;
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	Compare_Transforms
+//
+//	Used to check island time-stepping against the serial loop.  Both
+// runs replay the same inputs on the same machine so the transforms
+// have to match exactly, there is no tolerance.
+//
+/////////////////////////////////////////////////////////////////////////
+int
+PhysReplayClass::Compare_Transforms (const DynamicVectorClass<Matrix3D> &list)
+{
+	if (list.Count () != _PhysRecorder.Get_Object_Count ()) {
+		printf ("Object count differs: expected %d, got %d.\n", list.Count (), _PhysRecorder.Get_Object_Count ());
+		return max (list.Count (), _PhysRecorder.Get_Object_Count ());
+	}
+
+	int mismatch_count = 0;
+	for (int index = 0; index < list.Count (); index ++) {
+		PhysClass *obj = _PhysRecorder.Peek_Object (index);
+		if (obj == NULL) {
+			continue;
+		}
+
+		const Matrix3D &tm = obj->Get_Transform ();
+		if (tm != list[index]) {
+			Vector3 pos				= tm.Get_Translation ();
+			Vector3 expected_pos	= list[index].Get_Translation ();
+			printf ("Object %d (%s) differs: serial (%.4f, %.4f, %.4f), islands (%.4f, %.4f, %.4f).\n",
+						index, obj->Get_Name (),
+						expected_pos.X, expected_pos.Y, expected_pos.Z,
+						pos.X, pos.Y, pos.Z);
+			mismatch_count ++;
+		}
+	}
+
+	printf ("Compared %d object transforms.\n", list.Count ());
+	return mismatch_count;
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	fnFloatSortCallback
+//
+/////////////////////////////////////////////////////////////////////////
+static int __cdecl
+fnFloatSortCallback (const void *elem1, const void *elem2)
+{
+	float value1 = *((const float *)elem1);
+	float value2 = *((const float *)elem2);
+
+	if (value1 < value2) {
+		return -1;
+	} else if (value1 > value2) {
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,115 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/***********************************************************************************************
+ ***              C O N F I D E N T I A L  ---  W E S T W O O D  S T U D I O S               ***
+ ***********************************************************************************************
+ *                                                                                             *
+ *                 Project Name : Physics Replay                                               *
+ *                                                                                             *
+ *                     $Archive:: /Commando/Code/Tests/PhysReplay/physreplay.h                $*
+ *                                                                                             *
+ *---------------------------------------------------------------------------------------------*
+ * Functions:                                                                                  *
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#ifndef __PHYSREPLAY_H
+#define __PHYSREPLAY_H
+
+#include "always.h"
+#include "vector.h"
+#include "matrix3d.h"
+
+
+/////////////////////////////////////////////////////////////////////////
+// Forward declarations
+/////////////////////////////////////////////////////////////////////////
+class PhysicsSceneClass;
+class WWProfileIterator;
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	PhysReplayClass
+//
+//		Brings up the physics system without a renderer, loads a recording
+// made with PhysRecorderClass and re-runs it as fast as possible.  The
+// time spent in each frame and in each profiled phase of the scene
+// update is reported, and the transforms the objects end up with can be
+// checked against the ones in the recording.
+//
+/////////////////////////////////////////////////////////////////////////
+class PhysReplayClass
+{
+public:
+
+	/////////////////////////////////////////////////////////////////////////
+	// Public constructors/destructors
+	/////////////////////////////////////////////////////////////////////////
+	PhysReplayClass (void);
+	~PhysReplayClass (void);
+
+	/////////////////////////////////////////////////////////////////////////
+	// Public methods
+	/////////////////////////////////////////////////////////////////////////
+	bool				Init (void);
+	void				Shutdown (void);
+
+	bool				Load_Recording (const char *filename);
+	void				Set_Island_Timestep (bool onoff);
+	void				Run (void);
+	void				Print_Report (void);
+
+	//
+	//	Determinism check
+	//
+	int				Check_Transforms (float pos_tolerance, float rot_tolerance);
+
+	//
+	//	Serial vs. island check
+	//
+	void				Get_Transforms (DynamicVectorClass<Matrix3D> &list);
+	int				Compare_Transforms (const DynamicVectorClass<Matrix3D> &list);
+
+protected:
+
+	/////////////////////////////////////////////////////////////////////////
+	// Protected methods
+	/////////////////////////////////////////////////////////////////////////
+	static void		Print_Profile (WWProfileIterator *iterator, int depth);
+	static float	Get_Percentile (DynamicVectorClass<float> &sorted_list, float percent);
+
+private:
+
+	/////////////////////////////////////////////////////////////////////////
+	// Private member data
+	/////////////////////////////////////////////////////////////////////////
+	PhysicsSceneClass *					m_Scene;
+	bool										m_IsInitted;
+	DynamicVectorClass<float>			m_FrameTimes;		// ms spent in each frame's update
+	float										m_SimulatedTime;	// seconds of game time replayed
+	__int64									m_TicksPerSec;
+};
+
+
+#endif //__PHYSREPLAY_H
@@ -0,0 +1,147 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/***********************************************************************************************
+ ***              C O N F I D E N T I A L  ---  W E S T W O O D  S T U D I O S               ***
+ ***********************************************************************************************
+ *                                                                                             *
+ *                 Project Name : Vector Benchmark                                             *
+ *                                                                                             *
+ *                     $Archive:: /Commando/Code/Tests/VectorBench/copyvector.h               $*
+ *                                                                                             *
+ *---------------------------------------------------------------------------------------------*
+ * Functions:                                                                                  *
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#ifndef __COPYVECTOR_H
+#define __COPYVECTOR_H
+
+#include "always.h"
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	CopyVectorClass
+//
+//		DynamicVectorClass as it was before it became move-aware, trimmed
+//	down to what the benchmark uses: every element is copied when the
+// array grows, the array grows by a fixed step of 10 and Delete copies
+// the tail down.
+//
+//		The old Insert memmoved the tail up and then assigned the new
+// element over the hole.  That isn't safe for types that own memory
+// (the hole still shares its buffer with the element next to it), so
+// this one copies the tail up instead, which is what the old code would
+// have had to do to be correct for StringClass.
+//
+/////////////////////////////////////////////////////////////////////////
+template <class T>
+class CopyVectorClass
+{
+public:
+
+	CopyVectorClass(void) : Vector(0),VectorMax(0),ActiveCount(0),GrowthStep(10) {}
+	CopyVectorClass(const CopyVectorClass& src) : Vector(0),VectorMax(0),ActiveCount(0),GrowthStep(10) { *this = src; }
+	~CopyVectorClass(void)			{ delete[] Vector; }
+
+	CopyVectorClass& operator= (const CopyVectorClass& src)
+	{
+		if (this != &src) {
+			delete[] Vector;
+			Vector		= 0;
+			VectorMax	= src.VectorMax;
+			if (VectorMax) {
+				Vector = new T[VectorMax];
+				for (int index = 0; index < VectorMax; index++) {
+					Vector[index] = src.Vector[index];
+				}
+			}
+			ActiveCount	= src.ActiveCount;
+			GrowthStep	= src.GrowthStep;
+		}
+		return *this;
+	}
+
+	// Stubbed equality operators so you can have vectors of vectors
+	bool operator== (const CopyVectorClass &src)	{ return false; }
+	bool operator!= (const CopyVectorClass &src)	{ return true; }
+
+	T& operator[](int index)					{ return Vector[index]; }
+	const T& operator[](int index) const	{ return Vector[index]; }
+	int Count(void) const						{ return ActiveCount; }
+
+	bool Add(const T& object)
+	{
+		if (ActiveCount >= VectorMax) {
+			Resize(VectorMax + GrowthStep);
+		}
+		Vector[ActiveCount++] = object;
+		return true;
+	}
+
+	bool Insert(int index,const T& object)
+	{
+		if (index < 0 || index > ActiveCount) return false;
+		if (ActiveCount >= VectorMax) {
+			Resize(VectorMax + GrowthStep);
+		}
+		for (int i = ActiveCount; i > index; i--) {
+			Vector[i] = Vector[i-1];
+		}
+		Vector[index] = object;
+		ActiveCount++;
+		return true;
+	}
+
+	bool Delete(int index)
+	{
+		if (index >= ActiveCount) return false;
+		ActiveCount--;
+		for (int i = index; i < ActiveCount; i++) {
+			Vector[i] = Vector[i+1];
+		}
+		return true;
+	}
+
+private:
+
+	void Resize(int newsize)
+	{
+		T* newptr = new T[newsize];
+		int copycount = (newsize < VectorMax) ? newsize : VectorMax;
+		for (int index = 0; index < copycount; index++) {
+			newptr[index] = Vector[index];
+		}
+		delete[] Vector;
+		Vector		= newptr;
+		VectorMax	= newsize;
+	}
+
+	T* Vector;
+	int VectorMax;
+	int ActiveCount;
+	int GrowthStep;
+};
+
+
+#endif //__COPYVECTOR_H
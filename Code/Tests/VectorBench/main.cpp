@@ -0,0 +1,100 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/***********************************************************************************************
+ ***              C O N F I D E N T I A L  ---  W E S T W O O D  S T U D I O S               ***
+ ***********************************************************************************************
+ *                                                                                             *
+ *                 Project Name : Vector Benchmark                                             *
+ *                                                                                             *
+ *                     $Archive:: /Commando/Code/Tests/VectorBench/main.cpp                   $*
+ *                                                                                             *
+ *---------------------------------------------------------------------------------------------*
+ * Functions:                                                                                  *
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+#include "vectorbench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/////////////////////////////////////////////////////////////////////////
+//	Local prototypes
+/////////////////////////////////////////////////////////////////////////
+static void	Print_Usage (void);
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	main
+//
+//	VectorBench [options]
+//
+//	Exit code is 0 on success, 1 if the copying and moving vectors ended
+// up with different contents and 2 on usage errors.
+//
+/////////////////////////////////////////////////////////////////////////
+int
+main (int argc, char *argv[])
+{
+	int count = 20000;
+	int passes = 5;
+
+	for (int index = 1; index < argc; index ++) {
+		const char *arg = argv[index];
+
+		if (index + 1 >= argc) {
+			Print_Usage ();
+			return 2;
+		} else if (::stricmp (arg, "-count") == 0) {
+			count = ::atoi (argv[++ index]);
+		} else if (::stricmp (arg, "-passes") == 0) {
+			passes = ::atoi (argv[++ index]);
+		} else {
+			Print_Usage ();
+			return 2;
+		}
+	}
+
+	if (count < 10 || passes < 1) {
+		Print_Usage ();
+		return 2;
+	}
+
+	VectorBenchClass bench;
+	printf ("Running %d passes...\n", passes);
+	bench.Run (count, passes);
+	bench.Print_Report ();
+	return bench.Contents_Match () ? 0 : 1;
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	Print_Usage
+//
+/////////////////////////////////////////////////////////////////////////
+static void
+Print_Usage (void)
+{
+	printf ("Usage: VectorBench [options]\n");
+	printf ("  -count <n>         elements to grow each vector to (default 20000)\n");
+	printf ("  -passes <n>        times to run each vector, best time is kept (default 5)\n");
+	return ;
+}
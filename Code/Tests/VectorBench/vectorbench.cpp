@@ -0,0 +1,253 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/***********************************************************************************************
+ ***              C O N F I D E N T I A L  ---  W E S T W O O D  S T U D I O S               ***
+ ***********************************************************************************************
+ *                                                                                             *
+ *                 Project Name : Vector Benchmark                                             *
+ *                                                                                             *
+ *                     $Archive:: /Commando/Code/Tests/VectorBench/vectorbench.cpp            $*
+ *                                                                                             *
+ *---------------------------------------------------------------------------------------------*
+ * Functions:                                                                                  *
+ *   VectorBenchClass::Run -- Times every vector on both element types                         *
+ *   VectorBenchClass::Print_Report -- Prints the timings side by side                         *
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+#include "vectorbench.h"
+#include "copyvector.h"
+#include <stdio.h>
+#include <string.h>
+#include <windows.h>
+
+
+/////////////////////////////////////////////////////////////////////////
+//	Local constants
+/////////////////////////////////////////////////////////////////////////
+static const char *	TABLE_NAMES[]	=
+{
+	"Copy (old)",
+	"Move, fixed step",
+	"Move, geometric",
+};
+
+static const char *	ELEMENT_NAMES[]	=
+{
+	"StringClass",
+	"DynamicVectorClass<int>",
+};
+
+static const int		INNER_COUNT		= 16;		// ints in each inner vector
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	VectorBenchClass
+//
+/////////////////////////////////////////////////////////////////////////
+VectorBenchClass::VectorBenchClass (void)
+	:	m_Count (0),
+		m_ContentsMatch (true),
+		m_TicksPerSec (1)
+{
+	::memset (m_Results, 0, sizeof (m_Results));
+	::QueryPerformanceFrequency ((LARGE_INTEGER *)&m_TicksPerSec);
+	return ;
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	~VectorBenchClass
+//
+/////////////////////////////////////////////////////////////////////////
+VectorBenchClass::~VectorBenchClass (void)
+{
+	return ;
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	Run
+//
+//	The elements are built once up front, so the timings only cover the
+// vectors.  After the first pass the contents of the copying and the
+// moving vectors are compared, they have to come out the same.
+//
+/////////////////////////////////////////////////////////////////////////
+void
+VectorBenchClass::Run (int count, int passes)
+{
+	m_Count			= count;
+	m_ContentsMatch	= true;
+
+	int element;
+	int table;
+	int index;
+	for (element = 0; element < ELEMENT_COUNT; element ++) {
+		for (table = 0; table < TABLE_COUNT; table ++) {
+			m_Results[element][table].GrowTime		= 1.0E30F;
+			m_Results[element][table].InsertTime	= 1.0E30F;
+			m_Results[element][table].DeleteTime	= 1.0E30F;
+		}
+	}
+
+	//
+	//	Names about as long as preset and asset names, so every string
+	// has its own heap buffer
+	//
+	StringClass *strings = new StringClass[count];
+	CopyVectorClass<int> *copy_inners = new CopyVectorClass<int>[count];
+	DynamicVectorClass<int> *move_inners = new DynamicVectorClass<int>[count];
+	for (index = 0; index < count; index ++) {
+		strings[index].Format ("Preset_%06d_With_A_Longer_Name", index);
+		for (int inner = 0; inner < INNER_COUNT; inner ++) {
+			copy_inners[index].Add (index * INNER_COUNT + inner);
+			move_inners[index].Add (index * INNER_COUNT + inner);
+		}
+	}
+
+	for (int pass = 0; pass < passes; pass ++) {
+		{
+			CopyVectorClass<StringClass> copy_vec;
+			Run_Vector (copy_vec, strings, m_Results[ELEMENT_STRING][TABLE_COPY]);
+
+			DynamicVectorClass<StringClass> step_vec;
+			step_vec.Set_Growth_Percent (0);
+			Run_Vector (step_vec, strings, m_Results[ELEMENT_STRING][TABLE_MOVE_STEP]);
+
+			DynamicVectorClass<StringClass> move_vec;
+			Run_Vector (move_vec, strings, m_Results[ELEMENT_STRING][TABLE_MOVE]);
+
+			if (pass == 0) {
+				m_ContentsMatch &= (copy_vec.Count () == move_vec.Count ());
+				for (index = 0; m_ContentsMatch && index < move_vec.Count (); index ++) {
+					m_ContentsMatch &= (::strcmp (copy_vec[index], move_vec[index]) == 0);
+				}
+			}
+		}
+		{
+			CopyVectorClass< CopyVectorClass<int> > copy_vec;
+			Run_Vector (copy_vec, copy_inners, m_Results[ELEMENT_VECTOR][TABLE_COPY]);
+
+			DynamicVectorClass< DynamicVectorClass<int> > step_vec;
+			step_vec.Set_Growth_Percent (0);
+			Run_Vector (step_vec, move_inners, m_Results[ELEMENT_VECTOR][TABLE_MOVE_STEP]);
+
+			DynamicVectorClass< DynamicVectorClass<int> > move_vec;
+			Run_Vector (move_vec, move_inners, m_Results[ELEMENT_VECTOR][TABLE_MOVE]);
+
+			if (pass == 0) {
+				m_ContentsMatch &= (copy_vec.Count () == move_vec.Count ());
+				for (index = 0; m_ContentsMatch && index < move_vec.Count (); index ++) {
+					m_ContentsMatch &= (copy_vec[index].Count () == move_vec[index].Count ());
+					m_ContentsMatch &= (copy_vec[index][0] == move_vec[index][0]);
+				}
+			}
+		}
+	}
+
+	delete [] strings;
+	delete [] copy_inners;
+	delete [] move_inners;
+	return ;
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	Run_Vector
+//
+//	Grows the vector to m_Count elements one Add at a time, then inserts
+// and deletes a tenth of that at scattered positions (the same ones for
+// every vector).
+//
+/////////////////////////////////////////////////////////////////////////
+template<class V, class E> void
+VectorBenchClass::Run_Vector (V &vec, const E *source, ResultStruct &result)
+{
+	__int64 start_ticks = 0;
+	int change_count = m_Count / 10;
+	int index;
+
+	::QueryPerformanceCounter ((LARGE_INTEGER *)&start_ticks);
+	for (index = 0; index < m_Count; index ++) {
+		vec.Add (source[index]);
+	}
+	result.GrowTime = min (result.GrowTime, Get_Elapsed (start_ticks));
+
+	::QueryPerformanceCounter ((LARGE_INTEGER *)&start_ticks);
+	for (index = 0; index < change_count; index ++) {
+		vec.Insert ((index * 7919) % (vec.Count () + 1), source[index]);
+	}
+	result.InsertTime = min (result.InsertTime, Get_Elapsed (start_ticks));
+
+	::QueryPerformanceCounter ((LARGE_INTEGER *)&start_ticks);
+	for (index = 0; index < change_count; index ++) {
+		vec.Delete ((index * 7907) % vec.Count ());
+	}
+	result.DeleteTime = min (result.DeleteTime, Get_Elapsed (start_ticks));
+	return ;
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	Get_Elapsed
+//
+/////////////////////////////////////////////////////////////////////////
+float
+VectorBenchClass::Get_Elapsed (__int64 start_ticks)
+{
+	__int64 end_ticks = 0;
+	::QueryPerformanceCounter ((LARGE_INTEGER *)&end_ticks);
+	return float(double(end_ticks - start_ticks) * 1000.0 / double(m_TicksPerSec));
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	Print_Report
+//
+/////////////////////////////////////////////////////////////////////////
+void
+VectorBenchClass::Print_Report (void)
+{
+	printf ("\n");
+	printf ("Elements:         %d (%d inserted and deleted)\n", m_Count, m_Count / 10);
+
+	for (int element = 0; element < ELEMENT_COUNT; element ++) {
+		printf ("\n%-24s %12s %12s %12s\n", ELEMENT_NAMES[element], "grow ms", "insert ms", "delete ms");
+		for (int table = 0; table < TABLE_COUNT; table ++) {
+			const ResultStruct &result = m_Results[element][table];
+			printf ("%-24s %12.2f %12.2f %12.2f\n",
+						TABLE_NAMES[table],
+						result.GrowTime,
+						result.InsertTime,
+						result.DeleteTime);
+		}
+	}
+
+	if (m_ContentsMatch == false) {
+		printf ("\nWARNING: the copying and moving vectors ended up with different contents\n");
+	}
+
+	return ;
+}
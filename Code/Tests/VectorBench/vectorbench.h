@@ -0,0 +1,118 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/***********************************************************************************************
+ ***              C O N F I D E N T I A L  ---  W E S T W O O D  S T U D I O S               ***
+ ***********************************************************************************************
+ *                                                                                             *
+ *                 Project Name : Vector Benchmark                                             *
+ *                                                                                             *
+ *                     $Archive:: /Commando/Code/Tests/VectorBench/vectorbench.h              $*
+ *                                                                                             *
+ *---------------------------------------------------------------------------------------------*
+ * Functions:                                                                                  *
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#ifndef __VECTORBENCH_H
+#define __VECTORBENCH_H
+
+#include "always.h"
+#include "vector.h"
+#include "wwstring.h"
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	VectorBenchClass
+//
+//		Times DynamicVectorClass against the old copying implementation
+//	on the two kinds of element where moves matter: StringClass and
+// vectors of vectors.  Each vector is grown one Add at a time, then has
+// elements inserted and deleted at scattered positions.  The new
+// vector is run twice, once with the old fixed growth step, so the
+// effect of the moves and of the geometric growth can be told apart.
+//
+/////////////////////////////////////////////////////////////////////////
+class VectorBenchClass
+{
+public:
+
+	/////////////////////////////////////////////////////////////////////////
+	// Public constructors/destructors
+	/////////////////////////////////////////////////////////////////////////
+	VectorBenchClass (void);
+	~VectorBenchClass (void);
+
+	/////////////////////////////////////////////////////////////////////////
+	// Public methods
+	/////////////////////////////////////////////////////////////////////////
+	void				Run (int count, int passes);
+	void				Print_Report (void);
+	bool				Contents_Match (void) const	{ return m_ContentsMatch; }
+
+protected:
+
+	/////////////////////////////////////////////////////////////////////////
+	// Protected data types
+	/////////////////////////////////////////////////////////////////////////
+	struct ResultStruct
+	{
+		float								GrowTime;		// best time over all passes (ms)
+		float								InsertTime;
+		float								DeleteTime;
+	};
+
+	enum
+	{
+		TABLE_COPY		= 0,
+		TABLE_MOVE_STEP,
+		TABLE_MOVE,
+		TABLE_COUNT
+	};
+
+	enum
+	{
+		ELEMENT_STRING	= 0,
+		ELEMENT_VECTOR,
+		ELEMENT_COUNT
+	};
+
+	/////////////////////////////////////////////////////////////////////////
+	// Protected methods
+	/////////////////////////////////////////////////////////////////////////
+	template<class V, class E> void Run_Vector (V &vec, const E *source, ResultStruct &result);
+	float				Get_Elapsed (__int64 start_ticks);
+
+private:
+
+	/////////////////////////////////////////////////////////////////////////
+	// Private member data
+	/////////////////////////////////////////////////////////////////////////
+	int											m_Count;
+	ResultStruct								m_Results[ELEMENT_COUNT][TABLE_COUNT];
+	bool											m_ContentsMatch;
+	__int64										m_TicksPerSec;
+};
+
+
+#endif //__VECTORBENCH_H
@@ -103,6 +103,10 @@ Clip_Point (Vector3 *point, const AABoxClass &box)
 //	Local constants
 //////////////////////////////////////////////////////////////////////////
 const float ONE_SEC_FALL_DIST		= 4.9F;
+const int	DEFAULT_TILE_SIZE			= 32;
+const int	MIN_PARALLEL_PROBES		= 64;
+const float	FLOOR_SWEEP_DIST			= 6.5F;		// how far the ground and ceiling casts go
+const float	FLOOR_SWEEP_HALF_HEIGHT	= 0.1F;		// half the height of the box they sweep
 
 
 class SimDirInfoClass
@@ -150,7 +154,9 @@ PathfindSectorBuilderClass::PathfindSectorBuilderClass (void)
 		m_TotalBoxGuess (0),
 		m_BeforeUpdateCount (0),
 		m_AllowWaterFloodfill (false),
-		m_MaxSectorDim (28000.0F)
+		m_MaxSectorDim (28000.0F),
+		m_ThreadCount (1),
+		m_TileSize (DEFAULT_TILE_SIZE)
 {
 	RenderObjClass *commando_obj = NULL;
 
@@ -540,6 +546,15 @@ PathfindSectorBuilderClass::Generate_Sectors (void)
 		}
 	}
 
+	//
+	//	Hand the rest of the floodfill off to the worker threads if
+	// we've been asked to use more than one.
+	//
+	if (m_ThreadCount > 1) {
+		Floodfill_Parallel ();
+		return ;
+	}
+
 	//
 	//	Process all the floodfill boxes that have been queued up
 	//
@@ -565,32 +580,120 @@ PathfindSectorBuilderClass::Generate_Sectors (void)
 
 //////////////////////////////////////////////////////////////////////////
 //
-//	Find_Ground
+//	Cast_Ground
+//
+//	Sweeps a very short box downwards to see where the ground is.  The
+// static and dynamic objects can be cast separately, see Merge_Cast_Result.
 //
 //////////////////////////////////////////////////////////////////////////
-bool
-PathfindSectorBuilderClass::Find_Ground (const Vector3 &pos, float *ground_pos)
+void
+PathfindSectorBuilderClass::Cast_Ground
+(
+	const Vector3 &		pos,
+	CastResultStruct *	result,
+	bool						static_objs,
+	bool						dynamic_objs
+)
 {
-	bool retval = false;
+	AABoxClass sweep_box;
+	sweep_box.Center		= pos;
+	sweep_box.Center.Z	+= m_StepHeight;
+	sweep_box.Extent		= m_SimBoxExtents;
+	sweep_box.Extent.Z	= FLOOR_SWEEP_HALF_HEIGHT;
 
+	Vector3 sweep_vector (0, 0, -FLOOR_SWEEP_DIST);
+	PhysAABoxCollisionTestClass test(	sweep_box,
+													sweep_vector,
+													result,
+													STATIC_OBJ_COLLISION_GROUP,
+													COLLISION_TYPE_PHYSICAL);
+
+	test.CheckStaticObjs		= static_objs;
+	test.CheckDynamicObjs	= dynamic_objs;
+
+	PhysicsSceneClass::Get_Instance ()->Cast_AABox (test);
+	return ;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+//
+//	Cast_Ceiling
+//
+//	Sweeps a very short box upwards to see where the ceiling is.
+//
+//////////////////////////////////////////////////////////////////////////
+void
+PathfindSectorBuilderClass::Cast_Ceiling
+(
+	const Vector3 &		pos,
+	CastResultStruct *	result,
+	bool						static_objs,
+	bool						dynamic_objs
+)
+{
 	AABoxClass sweep_box;
 	sweep_box.Center		= pos;
 	sweep_box.Center.Z	+= m_StepHeight;
 	sweep_box.Extent		= m_SimBoxExtents;
-	sweep_box.Extent.Z	= 0.1F;
+	sweep_box.Extent.Z	= FLOOR_SWEEP_HALF_HEIGHT;
 
-	//
-	//	Sweep a very short box downwards to see where the ground is
-	//
-	CastResultStruct result;
-	Vector3 sweep_vector (0, 0, -6.5F);
+	Vector3 sweep_vector (0, 0, FLOOR_SWEEP_DIST);
 	PhysAABoxCollisionTestClass test(	sweep_box,
 													sweep_vector,
-													&result,
+													result,
 													STATIC_OBJ_COLLISION_GROUP,
 													COLLISION_TYPE_PHYSICAL);
 
+	test.CheckStaticObjs		= static_objs;
+	test.CheckDynamicObjs	= dynamic_objs;
+
 	PhysicsSceneClass::Get_Instance ()->Cast_AABox (test);
+	return ;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+//
+//	Merge_Cast_Result
+//
+//	Folds the result of a dynamic object cast into the result of the same
+// cast against the static objects, giving what a single cast against both
+// would have.  (The scene casts the static objects first and stops if the
+// start was bad, the dynamic objects only win if they are closer.)
+//
+//////////////////////////////////////////////////////////////////////////
+void
+PathfindSectorBuilderClass::Merge_Cast_Result
+(
+	CastResultStruct *			result,
+	const CastResultStruct &	dynamic_result
+)
+{
+	if (result->StartBad == false) {
+		if (dynamic_result.StartBad || dynamic_result.Fraction < result->Fraction) {
+			(*result) = dynamic_result;
+		}
+	}
+
+	return ;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+//
+//	Find_Ground
+//
+//////////////////////////////////////////////////////////////////////////
+bool
+PathfindSectorBuilderClass::Find_Ground
+(
+	const Vector3 &				pos,
+	const CastResultStruct &	result,
+	float *							ground_pos
+)
+{
+	bool retval = false;
 
 	//
 	//	Check to see if we found a floor, and its valid to stand on.
@@ -601,9 +704,9 @@ PathfindSectorBuilderClass::Find_Ground (const Vector3 &pos, float *ground_pos)
 			(m_AllowWaterFloodfill || (result.SurfaceType != SURFACE_TYPE_WATER)))
 	{
 		//
-		//	Calculate what z-position the ground is
+		//	Calculate what z-position the ground is (see Cast_Ground)
 		//
-		(*ground_pos) = (sweep_box.Center.Z + (sweep_vector.Z * result.Fraction)) - sweep_box.Extent.Z;
+		(*ground_pos) = (pos.Z + m_StepHeight - (FLOOR_SWEEP_DIST * result.Fraction)) - FLOOR_SWEEP_HALF_HEIGHT;
 		retval = true;
 	}
 
@@ -617,38 +720,24 @@ PathfindSectorBuilderClass::Find_Ground (const Vector3 &pos, float *ground_pos)
 //
 //////////////////////////////////////////////////////////////////////////
 bool
-PathfindSectorBuilderClass::Find_Ceiling (const Vector3 &pos, float *ceiling_pos)
+PathfindSectorBuilderClass::Find_Ceiling
+(
+	const Vector3 &				pos,
+	const CastResultStruct &	result,
+	float *							ceiling_pos
+)
 {
 	bool retval = false;
 
-	AABoxClass sweep_box;
-	sweep_box.Center		= pos;
-	sweep_box.Center.Z	+= m_StepHeight;
-	sweep_box.Extent		= m_SimBoxExtents;
-	sweep_box.Extent.Z	= 0.1F;
-
-	//
-	//	Sweep a very short box downwards to see where the ground is
-	//
-	CastResultStruct result;
-	Vector3 sweep_vector (0, 0, 6.5F);
-	PhysAABoxCollisionTestClass test(	sweep_box,
-													sweep_vector,
-													&result,
-													STATIC_OBJ_COLLISION_GROUP,
-													COLLISION_TYPE_PHYSICAL);
-
-	PhysicsSceneClass::Get_Instance ()->Cast_AABox (test);
-
 	//
 	//	Check to ensure we didn't start the cast intersecting a poly
 	//
 	if (result.StartBad == false) {
 		
 		//
-		//	Calculate what the z-position of the ceiling is
+		//	Calculate what the z-position of the ceiling is (see Cast_Ceiling)
 		//
-		(*ceiling_pos) = (sweep_box.Center.Z + (sweep_vector.Z * result.Fraction)) + sweep_box.Extent.Z;
+		(*ceiling_pos) = (pos.Z + m_StepHeight + (FLOOR_SWEEP_DIST * result.Fraction)) + FLOOR_SWEEP_HALF_HEIGHT;
 		retval = true;
 	}
 
@@ -668,6 +757,40 @@ PathfindSectorBuilderClass::Try_Moving_Here
 	const Vector3 &	expected_pos,
 	AABoxClass *		real_pos
 )
+{
+	CastResultStruct ground_result;
+	CastResultStruct ceiling_result;
+	Cast_Ground (expected_pos, &ground_result, true, true);
+
+	//
+	//	The ceiling only matters if there is ground to step onto
+	//
+	float ground_pos = 0;
+	if (Find_Ground (expected_pos, ground_result, &ground_pos)) {
+		Cast_Ceiling (expected_pos, &ceiling_result, true, true);
+	}
+
+	return Check_Move (start_pos, expected_pos, ground_result, ceiling_result, real_pos);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+//
+//	Check_Move
+//
+//	Decides whether the character can step from start_pos to expected_pos
+// given the ground and ceiling casts at expected_pos.
+//
+//////////////////////////////////////////////////////////////////////////
+bool
+PathfindSectorBuilderClass::Check_Move
+(
+	const Vector3 &				start_pos,
+	const Vector3 &				expected_pos,
+	const CastResultStruct &	ground_result,
+	const CastResultStruct &	ceiling_result,
+	AABoxClass *					real_pos
+)
 {
 	bool is_valid = false;
 
@@ -678,7 +801,7 @@ PathfindSectorBuilderClass::Try_Moving_Here
 	//	Find the ground level where we were standing and the ground level where
 	// we want to be standing
 	//
-	if (Find_Ground (expected_pos, &curr_ground_pos)) {
+	if (Find_Ground (expected_pos, ground_result, &curr_ground_pos)) {
 
 		//
 		//	Check to see if the character can step from the old position to the new one
@@ -690,7 +813,7 @@ PathfindSectorBuilderClass::Try_Moving_Here
 			//	Find the ceiling
 			//
 			float curr_ceiling_pos = curr_ground_pos;
-			Find_Ceiling (expected_pos, &curr_ceiling_pos);
+			Find_Ceiling (expected_pos, ceiling_result, &curr_ceiling_pos);
 
 			//
 			//	Can the character fit between the floor and ceiling without crouching?
@@ -788,8 +911,9 @@ PathfindSectorBuilderClass::Try_Standing_Here
 void
 PathfindSectorBuilderClass::Do_Physics_Sim
 (
-	const Vector3 &	start_pos,
-	PATHFIND_DIR		direction
+	const Vector3 &			start_pos,
+	PATHFIND_DIR				direction,
+	const FLOODFILL_PROBE *	probe
 )
 {
 	//
@@ -834,10 +958,20 @@ PathfindSectorBuilderClass::Do_Physics_Sim
 		Vector3 move_vector	= (m_DirInfo[direction].move);
 		Vector3 new_pos		= start_pos + move_vector;
 
-		AABoxClass new_box;
-		//if (Try_Standing_Here (new_pos, &new_box)) {
-		if (Try_Moving_Here (start_pos, new_pos, &new_box)) {		
-			Submit_Box (m_CurrentSector, new_box, direction);
+		//
+		//	Use the result of the cast if one of the worker threads
+		// already did it for us.
+		//
+		if (probe != NULL) {
+			if (probe->is_valid) {
+				Submit_Box (m_CurrentSector, probe->result_box, direction);
+			}
+		} else {
+			AABoxClass new_box;
+			//if (Try_Standing_Here (new_pos, &new_box)) {
+			if (Try_Moving_Here (start_pos, new_pos, &new_box)) {		
+				Submit_Box (m_CurrentSector, new_box, direction);
+			}
 		}
 	}
 
@@ -1116,6 +1250,383 @@ PathfindSectorBuilderClass::Floodfill (const Vector3 &start_pos)
 }
 
 
+//////////////////////////////////////////////////////////////////////////
+//
+//	Set_Thread_Count
+//
+//////////////////////////////////////////////////////////////////////////
+void
+PathfindSectorBuilderClass::Set_Thread_Count (int count)
+{
+	//
+	//	Zero means 'use every processor in the machine'
+	//
+	if (count <= 0) {
+		SYSTEM_INFO sys_info = { 0 };
+		::GetSystemInfo (&sys_info);
+		count = (int)sys_info.dwNumberOfProcessors;
+	}
+
+	m_ThreadCount = max (count, 1);
+	return ;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+//
+//	Is_Neighbor_Known
+//
+//	The 'quick-and-dirty' test from Do_Physics_Sim, without the side
+// effects.  Returns true if the neighbor we already know about in this
+// direction is tall enough to contain the box we would have cast.
+//
+//////////////////////////////////////////////////////////////////////////
+bool
+PathfindSectorBuilderClass::Is_Neighbor_Known
+(
+	FloodfillBoxClass *	box,
+	const Vector3 &		expected_pos,
+	PATHFIND_DIR			direction
+)
+{
+	bool found = false;
+
+	FloodfillBoxClass *neighbor = box->Peek_Neighbor (direction, false);
+	if (neighbor != NULL) {
+
+		AABoxClass sweep_box		= m_SimSweepBox;
+		sweep_box.Center			= expected_pos;
+		AABoxClass bounding_box	= Get_Body_Box_Bounds (neighbor);
+
+		float min1 = bounding_box.Center.Z - bounding_box.Extent.Z;
+		float max1 = bounding_box.Center.Z + bounding_box.Extent.Z;
+		float min2 = sweep_box.Center.Z - sweep_box.Extent.Z;
+		float max2 = sweep_box.Center.Z + sweep_box.Extent.Z;
+
+		found = (min1 <= min2) && (max1 >= max2);
+	}
+
+	return found;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+//
+//	Floodfill_Parallel
+//
+//	Processes the floodfill one 'wave' at a time, where a wave is
+// everything in the process list when the wave starts.  The box casts
+// for every direction the wave might need are bucketed into spatial
+// tiles and run on the worker threads first.  The wave is then run
+// through exactly the same code as the serial floodfill, in queue order,
+// using the precomputed casts.  A cast only depends on where it starts
+// and where it is going, so this gives the same boxes, links and queue
+// order as a single threaded build.  Any cast that wasn't guessed ahead
+// of time is just done here.
+//
+//////////////////////////////////////////////////////////////////////////
+void
+PathfindSectorBuilderClass::Floodfill_Parallel (void)
+{
+	BODY_BOX_LIST			wave_list;
+	FLOODFILL_PROBE_LIST	probe_list;
+	wave_list.Set_Growth_Step (20000);
+	probe_list.Set_Growth_Step (20000);
+
+	while (m_FloodFillProcessList.Count () > 0 && m_pDialog->Was_Cancelled () == false) {
+
+		//
+		//	Everything that is queued up now becomes the current wave
+		//
+		wave_list = m_FloodFillProcessList;
+		m_FloodFillProcessList.Delete_All ();
+
+		//
+		//	Build the list of box casts this wave will probably need.  The
+		// probes are kept in queue and direction order.
+		//
+		probe_list.Delete_All ();
+		int index;
+		for (index = 0; index < wave_list.Count (); index ++) {
+			FloodfillBoxClass *box = wave_list[index];
+
+			Vector3 start_pos	= Get_Sim_Start_Pos (box);
+			int tile_index		= m_BodyBoxCullingSystem.Get_Tile_Index (start_pos, m_TileSize);
+
+			for (int dir_index = 0; dir_index < DIR_MAX; dir_index ++) {
+				PATHFIND_DIR direction = PATHFIND_DIR(dir_index);
+				if (box->Peek_Neighbor (direction) == NULL) {
+
+					Vector3 expected_pos = start_pos + m_DirInfo[direction].move;
+					if (Is_Neighbor_Known (box, expected_pos, direction) == false) {
+
+						FLOODFILL_PROBE probe;
+						probe.from_box			= box;
+						probe.direction		= direction;
+						probe.start_pos		= start_pos;
+						probe.expected_pos	= expected_pos;
+						probe.tile_index		= tile_index;
+						probe.is_valid			= false;
+						probe_list.Add (probe);
+					}
+				}
+			}
+		}
+
+		//
+		//	Do the box casts
+		//
+		Run_Probes (probe_list);
+
+		//
+		//	Now floodfill the wave just as the serial code would
+		//
+		int probe_index = 0;
+		for (index = 0; index < wave_list.Count () && m_pDialog->Was_Cancelled () == false; index ++) {
+			m_CurrentSector = wave_list[index];
+
+			//
+			//	Find the probes that were cast from this box
+			//
+			const FLOODFILL_PROBE *box_probes[DIR_MAX] = { NULL };
+			while (probe_index < probe_list.Count () && probe_list[probe_index].from_box == m_CurrentSector) {
+				box_probes[probe_list[probe_index].direction] = &probe_list[probe_index];
+				probe_index ++;
+			}
+
+			Vector3 start_pos = Get_Sim_Start_Pos (m_CurrentSector);
+			for (int dir_index = 0; dir_index < DIR_MAX; dir_index ++) {
+				if (m_CurrentSector->Peek_Neighbor (PATHFIND_DIR(dir_index)) == NULL) {
+					Do_Physics_Sim (start_pos, PATHFIND_DIR(dir_index), box_probes[dir_index]);
+					m_BeforeUpdateCount ++;
+				}
+			}
+
+			//
+			//	Check for ladders, doors, etc and mark the box as processed
+			//
+			Check_For_Level_Feature (m_CurrentSector);
+			m_CurrentSector->Needs_Processing (false);
+
+			//
+			// Update the UI
+			//
+			if (m_BeforeUpdateCount > 512) {
+				CString message;
+				message.Format ("Floodfilled %d boxes (%d threads). Approx total boxes: %d", m_TotalBoxCount, m_ThreadCount, m_TotalBoxGuess);
+				m_pDialog->Set_Status (message, float (m_TotalBoxCount) / float (m_TotalBoxGuess));
+				m_BeforeUpdateCount = 0;
+			}
+		}
+
+		General_Pump_Messages ();
+	}
+
+	return ;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+//
+//	Get_Sim_Start_Pos
+//
+//	Where the floodfill simulates the character standing in a box.
+//
+//////////////////////////////////////////////////////////////////////////
+Vector3
+PathfindSectorBuilderClass::Get_Sim_Start_Pos (FloodfillBoxClass *box)
+{
+	AABoxClass bounds	= Get_Body_Box_Bounds (box);
+	Vector3 pos			= bounds.Center;
+	pos.Z					= bounds.Center.Z - bounds.Extent.Z + (m_SimBoundingBox.Z * 0.5F);
+	return pos;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+//	Local types used to hand probes out to the worker threads
+//////////////////////////////////////////////////////////////////////////
+typedef struct _PROBE_SORT_ENTRY
+{
+	int	tile_index;
+	int	probe_index;
+} PROBE_SORT_ENTRY;
+
+typedef struct _PROBE_WORK
+{
+	PathfindSectorBuilderClass *	builder;
+	FLOODFILL_PROBE_LIST *			probe_list;
+	PROBE_SORT_ENTRY *				sort_list;
+	int *									tile_start;
+	int									tile_count;
+	volatile LONG						next_tile;
+} PROBE_WORK;
+
+
+static int __cdecl
+fnProbeSortCallback (const void *elem1, const void *elem2)
+{
+	const PROBE_SORT_ENTRY *entry1 = (const PROBE_SORT_ENTRY *)elem1;
+	const PROBE_SORT_ENTRY *entry2 = (const PROBE_SORT_ENTRY *)elem2;
+
+	if (entry1->tile_index != entry2->tile_index) {
+		return (entry1->tile_index < entry2->tile_index) ? -1 : 1;
+	}
+
+	return entry1->probe_index - entry2->probe_index;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+//
+//	Run_Probes
+//
+//////////////////////////////////////////////////////////////////////////
+void
+PathfindSectorBuilderClass::Run_Probes (FLOODFILL_PROBE_LIST &probe_list)
+{
+	int count = probe_list.Count ();
+	if (count == 0) {
+		return ;
+	}
+
+	//
+	//	Sort the probes by tile so each worker walks a compact region
+	// of the level (and the same parts of the static culling tree).
+	//
+	PROBE_SORT_ENTRY *sort_list = new PROBE_SORT_ENTRY[count];
+	int index;
+	for (index = 0; index < count; index ++) {
+		sort_list[index].tile_index	= probe_list[index].tile_index;
+		sort_list[index].probe_index	= index;
+	}
+	::qsort (sort_list, count, sizeof (PROBE_SORT_ENTRY), fnProbeSortCallback);
+
+	//
+	//	Find where each tile starts in the sorted list
+	//
+	int *tile_start	= new int[count + 1];
+	int tile_count		= 0;
+	for (index = 0; index < count; index ++) {
+		if (index == 0 || sort_list[index].tile_index != sort_list[index - 1].tile_index) {
+			tile_start[tile_count ++] = index;
+		}
+	}
+	tile_start[tile_count] = count;
+
+	PROBE_WORK work;
+	work.builder		= this;
+	work.probe_list	= &probe_list;
+	work.sort_list		= sort_list;
+	work.tile_start	= tile_start;
+	work.tile_count	= tile_count;
+	work.next_tile		= 0;
+
+	//
+	//	Small waves aren't worth the cost of starting threads
+	//
+	int thread_count = min (m_ThreadCount, tile_count);
+	if (count < MIN_PARALLEL_PROBES) {
+		thread_count = 1;
+	}
+
+	//
+	//	Kick off the helper threads (this thread does its share too)
+	//
+	DynamicVectorClass<CWinThread *> thread_list;
+	DynamicVectorClass<HANDLE> handle_list;
+	for (index = 1; index < thread_count; index ++) {
+		CWinThread *thread = ::AfxBeginThread (Probe_Thread_Proc, &work, THREAD_PRIORITY_NORMAL, 0, CREATE_SUSPENDED);
+		if (thread != NULL) {
+			thread->m_bAutoDelete = FALSE;
+			thread->ResumeThread ();
+			thread_list.Add (thread);
+			handle_list.Add (thread->m_hThread);
+		}
+	}
+
+	Probe_Thread_Proc (&work);
+
+	//
+	//	Wait for the helpers to finish
+	//
+	if (handle_list.Count () > 0) {
+		::WaitForMultipleObjects (handle_list.Count (), &handle_list[0], TRUE, INFINITE);
+	}
+
+	for (index = 0; index < thread_list.Count (); index ++) {
+		delete thread_list[index];
+	}
+
+	//
+	//	The dynamic objects live in a grid that shares one collection list
+	// between all its casts, so they are cast here, one probe at a time, and
+	// folded into the static results the workers found.
+	//
+	for (index = 0; index < count; index ++) {
+		FLOODFILL_PROBE &probe = probe_list[index];
+
+		CastResultStruct dynamic_result;
+		if (probe.ground_result.StartBad == false) {
+			Cast_Ground (probe.expected_pos, &dynamic_result, false, true);
+			Merge_Cast_Result (&probe.ground_result, dynamic_result);
+		}
+
+		//
+		//	As in Try_Moving_Here, the ceiling only matters if there's ground
+		//
+		float ground_pos = 0;
+		if (Find_Ground (probe.expected_pos, probe.ground_result, &ground_pos) && probe.ceiling_result.StartBad == false) {
+			dynamic_result.Reset ();
+			Cast_Ceiling (probe.expected_pos, &dynamic_result, false, true);
+			Merge_Cast_Result (&probe.ceiling_result, dynamic_result);
+		}
+
+		probe.is_valid = Check_Move (probe.start_pos, probe.expected_pos, probe.ground_result, probe.ceiling_result, &probe.result_box);
+	}
+
+	delete [] tile_start;
+	delete [] sort_list;
+	return ;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+//
+//	Probe_Thread_Proc
+//
+//	Worker loop: grab the next unclaimed tile and cast every probe in it
+// against the static objects.  The casts read the builder's settings and
+// the static culling tree, and write the probe's own results.  The
+// collision contexts, the collision math stats and the collision profiler
+// they go through are per thread.  The dynamic object grid is not (it has
+// one shared collection list), so the casts leave it out and Run_Probes
+// does it afterwards.
+//
+//////////////////////////////////////////////////////////////////////////
+UINT
+PathfindSectorBuilderClass::Probe_Thread_Proc (LPVOID param)
+{
+	PROBE_WORK *work = (PROBE_WORK *)param;
+	FLOODFILL_PROBE_LIST &probe_list = *(work->probe_list);
+
+	for (;;) {
+		int tile = (int)::InterlockedIncrement (&work->next_tile) - 1;
+		if (tile >= work->tile_count) {
+			break;
+		}
+
+		for (int index = work->tile_start[tile]; index < work->tile_start[tile + 1]; index ++) {
+			FLOODFILL_PROBE &probe = probe_list[work->sort_list[index].probe_index];
+			work->builder->Cast_Ground (probe.expected_pos, &probe.ground_result, true, false);
+			work->builder->Cast_Ceiling (probe.expected_pos, &probe.ceiling_result, true, false);
+		}
+	}
+
+	return 0;
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 //
 //	Get_Sector_Occupant
@@ -48,6 +48,7 @@
 #include "floodfillgrid.h"
 #include "heightwatcher.h"
 #include "levelfeature.h"
+#include "castres.h"
 
 
 //////////////////////////////////////////////////////////////////////////
@@ -78,12 +79,39 @@ typedef struct _BOX_PERIMETER
 } BOX_PERIMETER;
 
 
+//////////////////////////////////////////////////////////////////////////
+//	FLOODFILL_PROBE
+//
+//	One pending 'can we step from this box in this direction' test.  The
+// casts against the static objects are done on worker threads, the casts
+// against the dynamic objects and the result are done afterwards on the
+// main thread.
+//////////////////////////////////////////////////////////////////////////
+typedef struct _FLOODFILL_PROBE
+{
+	FloodfillBoxClass *	from_box;
+	PATHFIND_DIR			direction;
+	Vector3					start_pos;
+	Vector3					expected_pos;
+	int						tile_index;
+	CastResultStruct		ground_result;
+	CastResultStruct		ceiling_result;
+	bool						is_valid;
+	AABoxClass				result_box;
+
+	bool operator== (const _FLOODFILL_PROBE &src)	{ return false; }
+	bool operator!= (const _FLOODFILL_PROBE &src)	{ return true; }
+
+} FLOODFILL_PROBE;
+
+
 //////////////////////////////////////////////////////////////////////////
 //	Typedefs
 //////////////////////////////////////////////////////////////////////////
 typedef DynamicVectorClass<Vector3>								START_POINT_LIST;
 typedef DynamicVectorClass<LevelFeatureClass *>				LEVEL_FEATURE_LIST;
 typedef TypedAABTreeCullSystemClass<LevelFeatureClass>	LEVEL_FEATURE_CULLING_SYSTEM;
+typedef DynamicVectorClass<FLOODFILL_PROBE>					FLOODFILL_PROBE_LIST;
 
 
 //////////////////////////////////////////////////////////////////////////
@@ -129,19 +157,38 @@ public:
 	//
 	void						Allow_Water_Floodfill (bool onoff);
 
+	//
+	//	Threading control (a thread count of 0 means one per processor)
+	//
+	void						Set_Thread_Count (int count);
+	void						Set_Tile_Size (int cells);
+
 protected:
 
 	////////////////////////////////////////////////////////////////////
 	//	Protected methods
 	////////////////////////////////////////////////////////////////////
-	void							Do_Physics_Sim (const Vector3 &start_pos, PATHFIND_DIR direction);
+	void							Do_Physics_Sim (const Vector3 &start_pos, PATHFIND_DIR direction, const FLOODFILL_PROBE *probe = NULL);
 	void							Do_Real_Physics_Sim (const Vector3 &start_pos, PATHFIND_DIR direction);
 	void							Floodfill (const Vector3 &start_pos);
+
+	//
+	//	Multi-threaded floodfill
+	//
+	void							Floodfill_Parallel (void);
+	bool							Is_Neighbor_Known (FloodfillBoxClass *box, const Vector3 &expected_pos, PATHFIND_DIR direction);
+	void							Run_Probes (FLOODFILL_PROBE_LIST &probe_list);
+	Vector3						Get_Sim_Start_Pos (FloodfillBoxClass *box);
+	static UINT					Probe_Thread_Proc (LPVOID param);
 	
 	bool							Try_Standing_Here (const Vector3 &expected_pos, AABoxClass *real_pos);
 	bool							Try_Moving_Here (const Vector3 &start_pos, const Vector3 &expected_pos, AABoxClass *real_pos);
-	bool							Find_Ground (const Vector3 &pos, float *ground_pos);
-	bool							Find_Ceiling (const Vector3 &pos, float *ceiling_pos);
+	bool							Check_Move (const Vector3 &start_pos, const Vector3 &expected_pos, const CastResultStruct &ground_result, const CastResultStruct &ceiling_result, AABoxClass *real_pos);
+	void							Cast_Ground (const Vector3 &pos, CastResultStruct *result, bool static_objs, bool dynamic_objs);
+	void							Cast_Ceiling (const Vector3 &pos, CastResultStruct *result, bool static_objs, bool dynamic_objs);
+	static void					Merge_Cast_Result (CastResultStruct *result, const CastResultStruct &dynamic_result);
+	bool							Find_Ground (const Vector3 &pos, const CastResultStruct &result, float *ground_pos);
+	bool							Find_Ceiling (const Vector3 &pos, const CastResultStruct &result, float *ceiling_pos);
 
 
 	FloodfillBoxClass *		Get_Sector_Occupant (const Vector3 &pos);
@@ -239,6 +286,10 @@ private:
 	int									m_TotalBoxGuess;
 
 	float									m_MaxSectorDim;
+
+	// Threading
+	int									m_ThreadCount;
+	int									m_TileSize;
 };
 
 
@@ -271,6 +322,16 @@ PathfindSectorBuilderClass::Add_Start_Point (const Vector3 &start_pos)
 	return ;
 }
 
+////////////////////////////////////////////////////////////////////
+//	Set_Tile_Size
+////////////////////////////////////////////////////////////////////
+inline void
+PathfindSectorBuilderClass::Set_Tile_Size (int cells)
+{
+	m_TileSize = max (cells, 1);
+	return ;
+}
+
 ////////////////////////////////////////////////////////////////////
 //	Set_Max_Sector_Size
 ////////////////////////////////////////////////////////////////////
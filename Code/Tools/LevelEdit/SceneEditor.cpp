@@ -1883,7 +1883,7 @@ SceneEditorClass::Get_Render_Camera (void)
 //
 ////////////////////////////////////////////////////////////////
 void
-SceneEditorClass::Generate_Pathfind_Portals (void)
+SceneEditorClass::Generate_Pathfind_Portals (int thread_count)
 {
 	CWaitCursor wait_cursor;
 
@@ -1892,6 +1892,7 @@ SceneEditorClass::Generate_Pathfind_Portals (void)
 	//
 	PathfindSectorBuilderClass builder;
 	builder.Allow_Water_Floodfill (true);
+	builder.Set_Thread_Count (thread_count);
 	builder.Initialize ();	
 
 	//
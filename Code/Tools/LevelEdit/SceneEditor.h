@@ -228,7 +228,7 @@ class SceneEditorClass : public PhysicsSceneClass
 		//
 		//	Pathfinding methods
 		//
-		void									Generate_Pathfind_Portals (void);
+		void									Generate_Pathfind_Portals (int thread_count = 1);
 		void									Pathfind_Floodfill (Phys3Class &char_sim, const Vector3 &start_pos);
 		void									DoObjectGoto (NodeClass *node1, NodeClass *node2);
 		
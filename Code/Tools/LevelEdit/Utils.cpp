@@ -2235,6 +2235,14 @@ Perform_Job (LPCTSTR filename, bool delete_on_completion)
 	CString output_file;
 	::GetPrivateProfileString ("Job Description", "Output", "", output_file.GetBufferSetLength (MAX_PATH), MAX_PATH, filename);
 
+	//
+	//	Pathfind jobs can be spread across several threads (0 = one per processor)
+	//
+	CString job_type;
+	::GetPrivateProfileString ("Job Description", "Type", "VIS", job_type.GetBufferSetLength (20), 20, filename);
+	job_type.ReleaseBuffer ();
+	int thread_count = ::GetPrivateProfileInt ("Job Description", "Threads", 0, filename);
+
 	if (level_file.GetLength () > 0) {
 		
 		//
@@ -2244,21 +2252,32 @@ Perform_Job (LPCTSTR filename, bool delete_on_completion)
 		EditorSaveLoadClass::Load_Level (level_file);
 		::Get_Main_View ()->Allow_Repaint (true);
 
-		//
-		//	Start VIS
-		//
+		if (job_type.CompareNoCase ("Pathfind") == 0) {
+
+			//
+			//	Regenerate the pathfind sectors and export them to the given file
+			//
+			::Get_Scene_Editor ()->Generate_Pathfind_Portals (thread_count);
+			PathfindImportExportSaveLoadClass::Export_Pathfind (output_file);
+
+		} else {
+
+			//
+			//	Start VIS
+			//
 #if (1)		
-		::Get_Scene_Editor ()->Generate_Uniform_Sampled_Vis (granularity,false,false,true,index,total);
+			::Get_Scene_Editor ()->Generate_Uniform_Sampled_Vis (granularity,false,false,true,index,total);
 #else
-		::Get_Scene_Editor ()->Generate_Edge_Sampled_Vis (granularity,false,true,index,total);
+			::Get_Scene_Editor ()->Generate_Edge_Sampled_Vis (granularity,false,true,index,total);
 #endif
-		::Get_Scene_Editor ()->Generate_Manual_Vis (true,index,total);
-		::Get_Scene_Editor ()->Generate_Light_Vis (true,index,total);
+			::Get_Scene_Editor ()->Generate_Manual_Vis (true,index,total);
+			::Get_Scene_Editor ()->Generate_Light_Vis (true,index,total);
 
-		//
-		//	Export VIS to the given file
-		//
-		::Get_Scene_Editor ()->Export_VIS (output_file);
+			//
+			//	Export VIS to the given file
+			//
+			::Get_Scene_Editor ()->Export_VIS (output_file);
+		}
 	}
 
 	//
@@ -29,12 +29,21 @@ static unsigned Add_Files (const StringClass &basepath, const StringClass &subpa
 
 int main (int argc, char *argv[])
 {
+	int	first = 1;
+	bool	compressed = false;
+
+	// An optional -compress switch stores the files LZO compressed.
+	if ((argc > 1) && (stricmp (argv [1], "-compress") == 0)) {
+		compressed = true;
+		first++;
+	}
+
 	// Must have at least 3 command line arguments - the executable, a full source path, and a mixfile name.
-	if (argc >= 3) {
+	if (argc - first >= 2) {
 
-		MixFileCreator	mixfile (argv [argc - 1]);
+		MixFileCreator	mixfile (argv [argc - 1], compressed);
 
-		for (int c = 1; c < argc - 1; c++) {
+		for (int c = first; c < argc - 1; c++) {
 
 			unsigned		filecount;
 			StringClass basepath (argv [c]);
@@ -49,7 +58,7 @@ int main (int argc, char *argv[])
 		}
 
 	} else {
-		printf ("Usage - MakeMix <source directory0>..<source directory n> <mixfilename>\n");
+		printf ("Usage - MakeMix [-compress] <source directory0>..<source directory n> <mixfilename>\n");
 	}
 
 	return (0);
@@ -121,4 +130,4 @@ unsigned Add_Files (const StringClass &basepath, const StringClass &subpath, Mix
 		}
 	}
 	return (filecount);
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -75,7 +75,6 @@ class AABTreeSoundCullClass : public AABTreeCullClass
 		//	Protected methods
 		//////////////////////////////////////////////////////////////////////
 		virtual void	Load_Node_Contents (AABTreeNodeClass * node,ChunkLoadClass & cload)	{ };
-		virtual void	Save_Node_Contents (AABTreeNodeClass * node,ChunkSaveClass & csave)	{ };
 
 };
 
@@ -53,9 +53,11 @@ DEFINE_AUTO_POOL(AABTreeNodeClass,256);
 
 
 /*
-** Current version of the file format
+** Versions of the file format.  Version 1 saved each node in its own set of chunks,
+** version 2 saves all of the nodes as one packed array.
 */
-const uint32 AABTREE_CURRENT_VERSION = 0x00010000;
+const uint32 AABTREE_LEGACY_VERSION = 0x00010000;
+const uint32 AABTREE_CURRENT_VERSION = 0x00020000;
 
 
 /*
@@ -71,6 +73,8 @@ enum
 
 	AABTREE_CHUNK_NODE_INDEX				= 0x00000200,	// wrapper around the node index for an object
 
+	AABTREE_CHUNK_PACKED_NODES				= 0x00000300,	// array of IOAABPackedNodeStruct, one per node
+
 	AABTREE_VARIABLE_NODESTRUCT			= 0x00,
 	AABTREE_VARIABLE_USERDATA
 };
@@ -91,6 +95,24 @@ struct IOAABNodeStruct
 };
 
 
+/*
+** IOAABPackedNodeStruct
+** Data structure for a node in the packed format.  The nodes are stored in index
+** order (which is a pre-order walk of the tree) and refer to their children by 
+** index, so the array does not depend on where it is loaded in memory.
+*/
+#define AABNODE_NO_CHILD						0xFFFFFFFF
+
+struct IOAABPackedNodeStruct
+{
+	IOVector3Struct	Center;
+	IOVector3Struct	Extent;
+	uint32				Front;
+	uint32				Back;
+	uint32				UserData;
+};
+
+
 /*************************************************************************
 **
 ** Utility functions for walking the object list in an AABTree Node
@@ -711,21 +733,27 @@ void AABTreeCullSystemClass::Load(ChunkLoadClass & cload)
 		return;
 	}
 
-	// read in the version and verify that it is the current version
+	// read in the version and verify that it is one we know how to read
 	uint32 version;
 	cload.Read(&version,sizeof(version));
-	if (version != AABTREE_CURRENT_VERSION) {
+	if ((version != AABTREE_CURRENT_VERSION) && (version != AABTREE_LEGACY_VERSION)) {
 		WWDEBUG_ERROR(("Attempting to read an obsolete AAB-Tree!"));
 		cload.Close_Chunk();
 		return;
 	}
 	cload.Close_Chunk();
 
-	// read in the tree
-	Load_Nodes(RootNode,cload);
+	if (version == AABTREE_CURRENT_VERSION) {
 
-	// re-index all nodes
-	Re_Index_Nodes();
+		// read in the packed node array and build the tree from it
+		Load_Packed_Nodes(cload);
+
+	} else {
+
+		// read in the tree one node at a time and re-index all nodes
+		Load_Nodes(RootNode,cload);
+		Re_Index_Nodes();
+	}
 
 	// reset the statistics
 	Reset_Statistics();
@@ -799,6 +827,120 @@ void AABTreeCullSystemClass::Load_Nodes(AABTreeNodeClass * node,ChunkLoadClass &
 	}
 }
 
+void AABTreeCullSystemClass::Load_Packed_Nodes(ChunkLoadClass & cload)
+{
+	cload.Open_Chunk();
+	WWASSERT(cload.Cur_Chunk_ID() == AABTREE_CHUNK_PACKED_NODES);
+
+	// read the whole array in one go
+	int count = cload.Cur_Chunk_Length() / sizeof(IOAABPackedNodeStruct);
+	IOAABPackedNodeStruct * packed_nodes = NULL;
+	if (count > 0) {
+		packed_nodes = new IOAABPackedNodeStruct[count];
+		cload.Read(packed_nodes,count * sizeof(IOAABPackedNodeStruct));
+	}
+	cload.Close_Chunk();
+
+	bool ok = false;
+	if (packed_nodes != NULL) {
+		ok = Build_From_Packed_Nodes(packed_nodes,count);
+		delete[] packed_nodes;
+	}
+
+	if (!ok) {
+		Re_Index_Nodes();
+	}
+}
+
+bool AABTreeCullSystemClass::Build_From_Packed_Nodes(const void * packed_nodes,int count)
+{
+	WWASSERT(RootNode->Front == NULL);
+	WWASSERT(RootNode->Back == NULL);
+
+	if ((packed_nodes == NULL) || (count <= 0)) {
+		return false;
+	}
+
+	const IOAABPackedNodeStruct * nodes = (const IOAABPackedNodeStruct *)packed_nodes;
+
+	// Check the child links before building anything.  The array has to be in pre-order:
+	// the front child comes right after its parent, the back child somewhere after it, and
+	// every node but the root is the child of exactly one node.
+	int i;
+	unsigned char * parent_counts = new unsigned char[count];
+	memset(parent_counts,0,count);
+
+	bool ok = true;
+	for (i=0; (i<count) && ok; i++) {
+
+		const IOAABPackedNodeStruct & node_desc = nodes[i];
+		if (node_desc.Front != AABNODE_NO_CHILD) {
+			if ((node_desc.Front != (uint32)i + 1) || (node_desc.Front >= (uint32)count) || (parent_counts[node_desc.Front]++ != 0)) {
+				ok = false;
+			}
+		}
+		if (ok && (node_desc.Back != AABNODE_NO_CHILD)) {
+			if ((node_desc.Back <= (uint32)i) || (node_desc.Back >= (uint32)count) || (parent_counts[node_desc.Back]++ != 0)) {
+				ok = false;
+			}
+		}
+	}
+	for (i=1; (i<count) && ok; i++) {
+		if (parent_counts[i] != 1) {
+			ok = false;
+		}
+	}
+	delete[] parent_counts;
+
+	if (!ok) {
+		WWDEBUG_ERROR(("Bad child index in a packed AAB-Tree of %d nodes!",count));
+		return false;
+	}
+
+	// Allocate every node up front, the root is node zero
+	if (IndexedNodes != NULL) {
+		delete[] IndexedNodes;
+		IndexedNodes = NULL;
+	}
+	NodeCount = count;
+	IndexedNodes = new AABTreeNodeClass *[NodeCount];
+	IndexedNodes[0] = RootNode;
+
+	for (i=1; i<NodeCount; i++) {
+		IndexedNodes[i] = new AABTreeNodeClass;
+	}
+
+	// Initialize the nodes and hook up the children
+	for (i=0; i<NodeCount; i++) {
+
+		AABTreeNodeClass * node = IndexedNodes[i];
+		const IOAABPackedNodeStruct & node_desc = nodes[i];
+
+		node->Index = i;
+		node->UserData = node_desc.UserData;
+
+		node->Box.Center.X = node_desc.Center.X;
+		node->Box.Center.Y = node_desc.Center.Y;
+		node->Box.Center.Z = node_desc.Center.Z;
+
+		node->Box.Extent.X = node_desc.Extent.X;
+		node->Box.Extent.Y = node_desc.Extent.Y;
+		node->Box.Extent.Z = node_desc.Extent.Z;
+
+		// the array is in pre-order so the children always come after their parent
+		if (node_desc.Front != AABNODE_NO_CHILD) {
+			node->Front = IndexedNodes[node_desc.Front];
+			node->Front->Parent = node;
+		}
+
+		if (node_desc.Back != AABNODE_NO_CHILD) {
+			node->Back = IndexedNodes[node_desc.Back];
+			node->Back->Parent = node;
+		}
+	}
+	return true;
+}
+
 void AABTreeCullSystemClass::Save(ChunkSaveClass & csave)
 {
 	csave.Begin_Chunk(AABTREE_CHUNK_VERSION);
@@ -806,51 +948,40 @@ void AABTreeCullSystemClass::Save(ChunkSaveClass & csave)
 	csave.Write(&version,sizeof(uint32));
 	csave.End_Chunk();
 
-	Save_Nodes(RootNode,csave);
+	Save_Packed_Nodes(csave);
 }
 
-void AABTreeCullSystemClass::Save_Nodes(AABTreeNodeClass * node,ChunkSaveClass & csave)
+void AABTreeCullSystemClass::Save_Packed_Nodes(ChunkSaveClass & csave)
 {
-	WWASSERT(node);
-	csave.Begin_Chunk(AABTREE_CHUNK_AABNODE);
+	WWASSERT(NodeCount == Partition_Node_Count());
 
-	csave.Begin_Chunk(AABTREE_CHUNK_AABNODE_VARIABLES);
-	IOAABNodeStruct node_desc;
-	memset(&node_desc,0,sizeof(node_desc));
+	IOAABPackedNodeStruct * packed_nodes = new IOAABPackedNodeStruct[NodeCount];
+	memset(packed_nodes,0,NodeCount * sizeof(IOAABPackedNodeStruct));
 
-	node_desc.Center.X = node->Box.Center.X;
-	node_desc.Center.Y = node->Box.Center.Y;
-	node_desc.Center.Z = node->Box.Center.Z;
+	for (int i=0; i<NodeCount; i++) {
 
-	node_desc.Extent.X = node->Box.Extent.X;
-	node_desc.Extent.Y = node->Box.Extent.Y;
-	node_desc.Extent.Z = node->Box.Extent.Z;
+		AABTreeNodeClass * node = IndexedNodes[i];
+		IOAABPackedNodeStruct & node_desc = packed_nodes[i];
+		WWASSERT(node->Index == (uint32)i);
 
-	if (node->Front) {
-		node_desc.Attributes |= AABNODE_ATTRIBUTE_FRONT_CHILD;
-	}
+		node_desc.Center.X = node->Box.Center.X;
+		node_desc.Center.Y = node->Box.Center.Y;
+		node_desc.Center.Z = node->Box.Center.Z;
 
-	if (node->Back) {
-		node_desc.Attributes |= AABNODE_ATTRIBUTE_BACK_CHILD;
-	}
-	
-	WRITE_MICRO_CHUNK(csave,AABTREE_VARIABLE_NODESTRUCT,node_desc);
-	WRITE_MICRO_CHUNK(csave,AABTREE_VARIABLE_USERDATA,node->UserData);
-	csave.End_Chunk();
+		node_desc.Extent.X = node->Box.Extent.X;
+		node_desc.Extent.Y = node->Box.Extent.Y;
+		node_desc.Extent.Z = node->Box.Extent.Z;
 
-	csave.Begin_Chunk(AABTREE_CHUNK_AABNODE_CONTENTS);
-	Save_Node_Contents(node,csave);
-	csave.End_Chunk();
+		node_desc.Front = (node->Front != NULL) ? node->Front->Index : AABNODE_NO_CHILD;
+		node_desc.Back = (node->Back != NULL) ? node->Back->Index : AABNODE_NO_CHILD;
+		node_desc.UserData = node->UserData;
+	}
 
+	csave.Begin_Chunk(AABTREE_CHUNK_PACKED_NODES);
+	csave.Write(packed_nodes,NodeCount * sizeof(IOAABPackedNodeStruct));
 	csave.End_Chunk();
 
-	if (node->Front) {
-		Save_Nodes(node->Front,csave);
-	}
-
-	if (node->Back) {
-		Save_Nodes(node->Back,csave);
-	}
+	delete[] packed_nodes;
 }
 
 void AABTreeCullSystemClass::Load_Object_Linkage(ChunkLoadClass & cload,CullableClass * obj)
@@ -1613,4 +1744,4 @@ void AABTreeIterator::validate(void)
 	
 	Total Size:				28 bytes
 
-*/
\ No newline at end of file
+*/
\ No newline at end of file
@@ -177,11 +177,20 @@ protected:
 
 	void					Update_Bounding_Boxes_Recursive(AABTreeNodeClass * node);
 
+	/*
+	** Trees are saved as one packed array of nodes which refer to each other by index.
+	** Build_From_Packed_Nodes takes the array straight from memory and can be used on 
+	** an image that didn't come from a chunk file.  It checks the child indices first
+	** and returns false (leaving just the root) if the array isn't a pre-order tree.
+	** Load_Nodes reads the older format which stored every node in its own set of 
+	** chunks (along with any node contents).
+	*/
+	void					Load_Packed_Nodes(ChunkLoadClass & cload);
+	void					Save_Packed_Nodes(ChunkSaveClass & csave);
+	bool					Build_From_Packed_Nodes(const void * packed_nodes,int count);
 	void					Load_Nodes(AABTreeNodeClass * node,ChunkLoadClass & cload);
-	void					Save_Nodes(AABTreeNodeClass * node,ChunkSaveClass & csave);
 
 	virtual void		Load_Node_Contents(AABTreeNodeClass * /*node*/,ChunkLoadClass & /*cload*/) { }
-	virtual void		Save_Node_Contents(AABTreeNodeClass * /*node*/,ChunkSaveClass & /*csave*/) { }
 	
 	AABTreeNodeClass *	RootNode;			// root of the AAB-Tree
 	int						ObjectCount;		// number of objects in the system
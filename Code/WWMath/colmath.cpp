@@ -38,7 +38,7 @@
 #include "colmath.h"
 
 const float CollisionMath::COINCIDENCE_EPSILON = 0.000001f;
-CollisionMath::ColmathStatsStruct CollisionMath::Stats;
+thread_local CollisionMath::ColmathStatsStruct CollisionMath::Stats;
 
 CollisionMath::ColmathStatsStruct::ColmathStatsStruct(void)
 {
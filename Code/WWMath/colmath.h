@@ -238,7 +238,8 @@ private:
 
 	static const float COINCIDENCE_EPSILON;
 
-	static ColmathStatsStruct				Stats;
+	// Per thread, so that tools can cast from several threads at once
+	static thread_local ColmathStatsStruct	Stats;
 };
 
 
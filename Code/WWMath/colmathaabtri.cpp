@@ -180,7 +180,11 @@ private:
 	BTCollisionStruct & operator = (const BTCollisionStruct &);
 };
 
-static BTCollisionStruct CollisionContext;
+/*
+** The context is per-thread so that tools (e.g. the pathfind floodfiller) can
+** cast boxes against the static scene from several worker threads at once.
+*/
+static thread_local BTCollisionStruct CollisionContext;
 
 /***********************************************************************************************
  * aabtri_separation_test -- test the projected extents for separation                         *
@@ -896,7 +900,7 @@ private:
 	AABTIntersectStruct & operator = (const AABTIntersectStruct &);
 };
 
-static AABTIntersectStruct IntersectContext;
+static thread_local AABTIntersectStruct IntersectContext;
 
 
 /***********************************************************************************************
@@ -92,7 +92,12 @@ AABTreeClass::AABTreeClass(void) :
 	Nodes(NULL),
 	PolyCount(0),
 	PolyIndices(NULL),
-	Mesh(NULL)
+	Mesh(NULL),
+	WideNodeCount(0),
+	WideNodes(NULL),
+	WideTriBlockCount(0),
+	WideTriBlocks(NULL),
+	WideLeafBlocks(NULL)
 {
 }
 
@@ -111,7 +116,13 @@ AABTreeClass::AABTreeClass(void) :
  *   6/19/98    GTH : Created.                                                                 *
  *   5/23/2000  gth : Created.                                                                 *
  *=============================================================================================*/
-AABTreeClass::AABTreeClass(AABTreeBuilderClass * builder)
+AABTreeClass::AABTreeClass(AABTreeBuilderClass * builder) :
+	Mesh(NULL),
+	WideNodeCount(0),
+	WideNodes(NULL),
+	WideTriBlockCount(0),
+	WideTriBlocks(NULL),
+	WideLeafBlocks(NULL)
 {
 	NodeCount = builder->Node_Count();
 	Nodes = new AABTreeClass::CullNodeStruct[NodeCount];
@@ -141,7 +152,12 @@ AABTreeClass::AABTreeClass(const AABTreeClass & that) :
 	Nodes(NULL),
 	PolyCount(0),
 	PolyIndices(0),
-	Mesh(NULL)
+	Mesh(NULL),
+	WideNodeCount(0),
+	WideNodes(NULL),
+	WideTriBlockCount(0),
+	WideTriBlocks(NULL),
+	WideLeafBlocks(NULL)
 { 
 	*this = that; 
 }
@@ -193,6 +209,10 @@ AABTreeClass & AABTreeClass::operator = (const AABTreeClass & that)
 
 	Mesh = that.Mesh;
 
+	if (that.Has_Wide_Tree()) {
+		Build_Wide_Tree();
+	}
+
 	return *this;
 }
 
@@ -224,6 +244,7 @@ void AABTreeClass::Reset(void)
 	if (Mesh) {
 		Mesh = NULL;
 	}
+	Reset_Wide_Tree();
 }
 
 
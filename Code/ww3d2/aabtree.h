@@ -106,6 +106,16 @@ public:
 	bool						Cast_OBBox(OBBoxCollisionTestClass & boxtest);
 	bool						Intersect_OBBox(OBBoxIntersectionTestClass & boxtest);
 
+	/*
+	** Ray casts can use an alternate 4-wide copy of the tree which tests all four
+	** children of a node (and four polygons of a leaf) at once with SSE.  It is built
+	** from the binary tree once the mesh is loaded and gives identical results.
+	*/
+	void						Build_Wide_Tree(void);
+	bool						Has_Wide_Tree(void) const								{ return WideLeafBlocks != NULL; }
+	static void				Enable_Wide_Tree(bool onoff)							{ _WideTreeEnabled = onoff; }
+	static bool				Is_Wide_Tree_Enabled(void)								{ return _WideTreeEnabled; }
+
 private:
 	
 	AABTreeClass &			operator = (const AABTreeClass & that);
@@ -200,12 +210,70 @@ private:
 
 	void						Update_Bounding_Boxes_Recursive(CullNodeStruct * node);
 
+	/*
+	** WideNodeStruct - one node of the 4-wide tree.  Each slot is one of the children
+	** or grandchildren of a binary node, in the same order the binary tree visits
+	** them.  The boxes are stored a component at a time so four of them can be loaded
+	** into SSE registers directly.  Parent is the binary node skipped over to reach
+	** a grandchild (-1 for a direct child), Wide is the wide node for a non-leaf slot.
+	*/
+	struct WideNodeStruct
+	{
+		float					MinX[4];
+		float					MinY[4];
+		float					MinZ[4];
+		float					MaxX[4];
+		float					MaxY[4];
+		float					MaxZ[4];
+
+		int					Node[4];
+		int					Parent[4];
+		int					Wide[4];
+	};
+
+	/*
+	** WideTriBlockStruct - bounds and plane equations of four of a leaf's polygons,
+	** used to throw out polygons the ray can't reach before the exact test.
+	*/
+	struct WideTriBlockStruct
+	{
+		float					MinX[4];
+		float					MinY[4];
+		float					MinZ[4];
+		float					MaxX[4];
+		float					MaxY[4];
+		float					MaxZ[4];
+
+		float					NX[4];
+		float					NY[4];
+		float					NZ[4];
+		float					D[4];
+	};
+
+	struct WideRayStruct;
+
+	void						Reset_Wide_Tree(void);
+	int						Build_Wide_Node_Recursive(int node_index);
+	void						Build_Wide_Leaf(int node_index);
+
+	bool						Cast_Ray_Wide(RayCollisionTestClass & raytest);
+	bool						Cast_Ray_Wide_Recursive(int wide_index,RayCollisionTestClass & raytest,WideRayStruct & ray);
+	bool						Cast_Ray_To_Polys_Wide(int node_index,RayCollisionTestClass & raytest,WideRayStruct & ray);
+
 	int						NodeCount;			// number of nodes in the tree
 	CullNodeStruct *		Nodes;				// array of nodes
 	int						PolyCount;			// number of polygons in the parent mesh (and the number of indexes in our array)
 	uint32 *					PolyIndices;		// linear array of polygon indices, nodes index into this array
 	MeshGeometryClass *	Mesh;					// pointer to the parent mesh (non-ref-counted; we are a member of this mesh)
 
+	int						WideNodeCount;		// number of nodes in the 4-wide tree
+	WideNodeStruct *		WideNodes;			// 4-wide copy of the tree (NULL if the root is a leaf)
+	int						WideTriBlockCount;// number of polygon blocks
+	WideTriBlockStruct *	WideTriBlocks;		// polygon bounds and planes, four at a time
+	int *						WideLeafBlocks;	// first polygon block of each leaf node (indexed by node)
+
+	static bool				_WideTreeEnabled;
+
 	friend class MeshClass;
 	friend class MeshGeometryClass;
 	friend class AuxMeshDataClass;
@@ -217,12 +285,18 @@ inline int AABTreeClass::Compute_Ram_Size(void)
 { 
 	return	NodeCount * sizeof(CullNodeStruct) +
 				PolyCount * sizeof(int) +
+				WideNodeCount * sizeof(WideNodeStruct) +
+				WideTriBlockCount * sizeof(WideTriBlockStruct) +
+				((WideLeafBlocks != NULL) ? NodeCount * sizeof(int) : 0) +
 				sizeof(AABTreeClass);
 }
 
 inline bool AABTreeClass::Cast_Ray(RayCollisionTestClass & raytest)
 {
 	WWASSERT(Nodes != NULL);
+	if (_WideTreeEnabled && (WideLeafBlocks != NULL)) {
+		return Cast_Ray_Wide(raytest);
+	}
 	return Cast_Ray_Recursive(&(Nodes[0]),raytest);
 }
 
@@ -273,6 +347,11 @@ inline void AABTreeClass::Update_Bounding_Boxes(void)
 {
 	WWASSERT(Nodes != NULL);
 	Update_Bounding_Boxes_Recursive(&(Nodes[0]));
+
+	// the polygons have moved, the wide tree's copy of the boxes is stale
+	if (WideLeafBlocks != NULL) {
+		Build_Wide_Tree();
+	}
 }
 
 
@@ -0,0 +1,595 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/***********************************************************************************************
+ ***              C O N F I D E N T I A L  ---  W E S T W O O D  S T U D I O S               ***
+ ***********************************************************************************************
+ *                                                                                             *
+ *                 Project Name : WW3D                                                         *
+ *                                                                                             *
+ *                     $Archive:: /Commando/Code/ww3d2/aabtreewide.cpp                        $*
+ *                                                                                             *
+ *---------------------------------------------------------------------------------------------*
+ * Functions:                                                                                  *
+ *   AABTreeClass::Build_Wide_Tree -- Build the 4-wide copy of the tree used for ray casts     *
+ *   AABTreeClass::Reset_Wide_Tree -- Release the 4-wide copy of the tree                      *
+ *   AABTreeClass::Build_Wide_Node_Recursive -- Build the wide node for a binary node          *
+ *   AABTreeClass::Build_Wide_Leaf -- Fill in the polygon blocks for a leaf                    *
+ *   AABTreeClass::Cast_Ray_Wide -- Cast_Ray using the 4-wide tree                             *
+ *   AABTreeClass::Cast_Ray_Wide_Recursive -- Internal implementation of Cast_Ray_Wide         *
+ *   AABTreeClass::Cast_Ray_To_Polys_Wide -- Cast the ray to the polys in a leaf               *
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+
+#include "aabtree.h"
+#include "wwdebug.h"
+#include "wwmemlog.h"
+#include "tri.h"
+#include "meshgeometry.h"
+#include "coltest.h"
+#include "colmathinlines.h"
+#include "cpudetect.h"
+#include <string.h>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__SSE__)
+#define AABTREE_WIDE_SSE	1
+#include <xmmintrin.h>
+#else
+#define AABTREE_WIDE_SSE	0
+#endif
+
+
+/*
+** How much the SSE tests grow every box and polygon before testing it.  The SSE
+** tests are only used to throw things out; anything they keep is tested again with
+** the same code the binary tree uses.  The slack makes sure that they never throw
+** out something the exact test would have kept.
+*/
+const float WIDE_MARGIN_ABSOLUTE	= 0.001f;
+const float WIDE_MARGIN_RELATIVE	= 0.00001f;
+
+
+bool AABTreeClass::_WideTreeEnabled = true;
+
+
+/*
+** WideRayStruct
+** The ray in the form the SSE tests want it.  The segment being tested is always
+** P0 to P0 + fraction * DP where fraction is the result's current fraction; nothing
+** past that point can change the result.
+*/
+struct AABTreeClass::WideRayStruct
+{
+	WideRayStruct(const LineSegClass & ray);
+
+	int				Test_Boxes(const WideNodeStruct & wnode,float fraction) const;
+	int				Test_Tris(const WideTriBlockStruct & block,float fraction) const;
+
+	Vector3			P0;
+	Vector3			DP;
+	float				InvDP[3];
+	bool				Flat[3];				// the ray barely moves along this axis, test it as a point
+	float				Margin;
+};
+
+
+AABTreeClass::WideRayStruct::WideRayStruct(const LineSegClass & ray) :
+	P0(ray.Get_P0()),
+	DP(ray.Get_DP())
+{
+	const Vector3 & p1 = ray.Get_P1();
+	float max_coord = 0.0f;
+	int axis;
+	for (axis = 0; axis < 3; axis++) {
+		max_coord = WWMath::Max(max_coord,WWMath::Fabs(P0[axis]));
+		max_coord = WWMath::Max(max_coord,WWMath::Fabs(p1[axis]));
+	}
+	Margin = WIDE_MARGIN_ABSOLUTE + WIDE_MARGIN_RELATIVE * max_coord;
+
+	for (axis = 0; axis < 3; axis++) {
+		Flat[axis] = (WWMath::Fabs(DP[axis]) <= 0.5f * Margin);
+		InvDP[axis] = Flat[axis] ? 0.0f : 1.0f / DP[axis];
+	}
+}
+
+
+#if AABTREE_WIDE_SSE
+
+int AABTreeClass::WideRayStruct::Test_Boxes(const WideNodeStruct & wnode,float fraction) const
+{
+	const float * mins[3] = { wnode.MinX, wnode.MinY, wnode.MinZ };
+	const float * maxs[3] = { wnode.MaxX, wnode.MaxY, wnode.MaxZ };
+
+	__m128 margin = _mm_set1_ps(Margin);
+	__m128 tnear = _mm_setzero_ps();
+	__m128 tfar = _mm_set1_ps(fraction);
+	__m128 ok = _mm_cmpeq_ps(tnear,tnear);
+
+	for (int axis = 0; axis < 3; axis++) {
+		__m128 bmin = _mm_sub_ps(_mm_loadu_ps(mins[axis]),margin);
+		__m128 bmax = _mm_add_ps(_mm_loadu_ps(maxs[axis]),margin);
+		__m128 p0 = _mm_set1_ps(P0[axis]);
+
+		if (Flat[axis]) {
+			ok = _mm_and_ps(ok,_mm_and_ps(_mm_cmple_ps(bmin,p0),_mm_cmpge_ps(bmax,p0)));
+		} else {
+			__m128 inv = _mm_set1_ps(InvDP[axis]);
+			__m128 t0 = _mm_mul_ps(_mm_sub_ps(bmin,p0),inv);
+			__m128 t1 = _mm_mul_ps(_mm_sub_ps(bmax,p0),inv);
+			tnear = _mm_max_ps(tnear,_mm_min_ps(t0,t1));
+			tfar = _mm_min_ps(tfar,_mm_max_ps(t0,t1));
+		}
+	}
+
+	ok = _mm_and_ps(ok,_mm_cmple_ps(tnear,tfar));
+	return _mm_movemask_ps(ok);
+}
+
+
+int AABTreeClass::WideRayStruct::Test_Tris(const WideTriBlockStruct & block,float fraction) const
+{
+	/*
+	** Bounds of the part of the segment that is still interesting
+	*/
+	Vector3 p1 = P0 + fraction * DP;
+	Vector3 seg_min,seg_max;
+	seg_min.X = WWMath::Min(P0.X,p1.X) - Margin;	seg_max.X = WWMath::Max(P0.X,p1.X) + Margin;
+	seg_min.Y = WWMath::Min(P0.Y,p1.Y) - Margin;	seg_max.Y = WWMath::Max(P0.Y,p1.Y) + Margin;
+	seg_min.Z = WWMath::Min(P0.Z,p1.Z) - Margin;	seg_max.Z = WWMath::Max(P0.Z,p1.Z) + Margin;
+
+	__m128 ok;
+	ok = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(block.MinX),_mm_set1_ps(seg_max.X)),
+						 _mm_cmpge_ps(_mm_loadu_ps(block.MaxX),_mm_set1_ps(seg_min.X)));
+	ok = _mm_and_ps(ok,_mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(block.MinY),_mm_set1_ps(seg_max.Y)),
+											_mm_cmpge_ps(_mm_loadu_ps(block.MaxY),_mm_set1_ps(seg_min.Y))));
+	ok = _mm_and_ps(ok,_mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(block.MinZ),_mm_set1_ps(seg_max.Z)),
+											_mm_cmpge_ps(_mm_loadu_ps(block.MaxZ),_mm_set1_ps(seg_min.Z))));
+
+	/*
+	** Throw out the polygons whose plane has both ends of the segment on the same side
+	*/
+	__m128 nx = _mm_loadu_ps(block.NX);
+	__m128 ny = _mm_loadu_ps(block.NY);
+	__m128 nz = _mm_loadu_ps(block.NZ);
+	__m128 d = _mm_loadu_ps(block.D);
+
+	__m128 d0 = _mm_sub_ps(_mm_add_ps(_mm_add_ps(	_mm_mul_ps(nx,_mm_set1_ps(P0.X)),
+																	_mm_mul_ps(ny,_mm_set1_ps(P0.Y))),
+																	_mm_mul_ps(nz,_mm_set1_ps(P0.Z))),d);
+	__m128 d1 = _mm_sub_ps(_mm_add_ps(_mm_add_ps(	_mm_mul_ps(nx,_mm_set1_ps(p1.X)),
+																	_mm_mul_ps(ny,_mm_set1_ps(p1.Y))),
+																	_mm_mul_ps(nz,_mm_set1_ps(p1.Z))),d);
+
+	__m128 margin = _mm_set1_ps(Margin);
+	__m128 neg_margin = _mm_set1_ps(-Margin);
+	__m128 above = _mm_and_ps(_mm_cmpgt_ps(d0,margin),_mm_cmpgt_ps(d1,margin));
+	__m128 below = _mm_and_ps(_mm_cmplt_ps(d0,neg_margin),_mm_cmplt_ps(d1,neg_margin));
+	ok = _mm_andnot_ps(_mm_or_ps(above,below),ok);
+
+	return _mm_movemask_ps(ok);
+}
+
+#else
+
+int AABTreeClass::WideRayStruct::Test_Boxes(const WideNodeStruct & wnode,float fraction) const
+{
+	return 0xF;
+}
+
+int AABTreeClass::WideRayStruct::Test_Tris(const WideTriBlockStruct & block,float fraction) const
+{
+	return 0xF;
+}
+
+#endif
+
+
+/***********************************************************************************************
+ * AABTreeClass::Build_Wide_Tree -- Build the 4-wide copy of the tree used for ray casts       *
+ *                                                                                             *
+ * The mesh must be set and its vertices loaded.                                               *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ * Must be called again if the mesh's vertices move.                                           *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void AABTreeClass::Build_Wide_Tree(void)
+{
+	Reset_Wide_Tree();
+
+#if AABTREE_WIDE_SSE
+	if (!CPUDetectClass::Has_SSE_Instruction_Set()) {
+		return;
+	}
+	if ((Nodes == NULL) || (NodeCount == 0) || (Mesh == NULL)) {
+		return;
+	}
+
+	WWMEMLOG(MEM_CULLINGDATA);
+
+	/*
+	** Polygon blocks for every leaf, four polygons to a block
+	*/
+	WideLeafBlocks = new int[NodeCount];
+	WideTriBlockCount = 0;
+
+	int node_index;
+	for (node_index = 0; node_index < NodeCount; node_index++) {
+		if (Nodes[node_index].Is_Leaf()) {
+			WideLeafBlocks[node_index] = WideTriBlockCount;
+			WideTriBlockCount += (Nodes[node_index].Get_Poly_Count() + 3) / 4;
+		} else {
+			WideLeafBlocks[node_index] = -1;
+		}
+	}
+
+	WideTriBlocks = new WideTriBlockStruct[WideTriBlockCount + 1];
+	for (node_index = 0; node_index < NodeCount; node_index++) {
+		if (Nodes[node_index].Is_Leaf()) {
+			Build_Wide_Leaf(node_index);
+		}
+	}
+
+	/*
+	** The wide nodes.  There can't be more of them than there are non-leaf nodes.
+	*/
+	if (!Nodes[0].Is_Leaf()) {
+		WideNodes = new WideNodeStruct[NodeCount];
+		WideNodeCount = 0;
+		Build_Wide_Node_Recursive(0);
+	}
+#endif
+}
+
+
+/***********************************************************************************************
+ * AABTreeClass::Reset_Wide_Tree -- Release the 4-wide copy of the tree                        *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void AABTreeClass::Reset_Wide_Tree(void)
+{
+	WideNodeCount = 0;
+	if (WideNodes) {
+		delete[] WideNodes;
+		WideNodes = NULL;
+	}
+	WideTriBlockCount = 0;
+	if (WideTriBlocks) {
+		delete[] WideTriBlocks;
+		WideTriBlocks = NULL;
+	}
+	if (WideLeafBlocks) {
+		delete[] WideLeafBlocks;
+		WideLeafBlocks = NULL;
+	}
+}
+
+
+/***********************************************************************************************
+ * AABTreeClass::Build_Wide_Node_Recursive -- Build the wide node for a binary node            *
+ *                                                                                             *
+ * The slots are the node's children, with any non-leaf child replaced by its two children.   *
+ * They are stored front before back so the wide tree visits nodes in the same order as the    *
+ * binary tree.                                                                                *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * node_index - non-leaf node of the binary tree                                               *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ * index of the new wide node                                                                  *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+int AABTreeClass::Build_Wide_Node_Recursive(int node_index)
+{
+	WWASSERT(!Nodes[node_index].Is_Leaf());
+	WWASSERT(WideNodeCount < NodeCount);
+
+	int wide_index = WideNodeCount++;
+	WideNodeStruct * wnode = &(WideNodes[wide_index]);
+	memset(wnode,0,sizeof(WideNodeStruct));
+
+	int slot;
+	for (slot = 0; slot < 4; slot++) {
+		wnode->Node[slot] = -1;
+		wnode->Parent[slot] = -1;
+		wnode->Wide[slot] = -1;
+	}
+
+	/*
+	** Collect the slots
+	*/
+	int children[2];
+	children[0] = Nodes[node_index].Get_Front_Child();
+	children[1] = Nodes[node_index].Get_Back_Child();
+
+	int slot_count = 0;
+	for (int i = 0; i < 2; i++) {
+		CullNodeStruct * child = &(Nodes[children[i]]);
+		if (child->Is_Leaf()) {
+			wnode->Node[slot_count++] = children[i];
+		} else {
+			wnode->Parent[slot_count] = children[i];
+			wnode->Node[slot_count++] = child->Get_Front_Child();
+			wnode->Parent[slot_count] = children[i];
+			wnode->Node[slot_count++] = child->Get_Back_Child();
+		}
+	}
+
+	/*
+	** Copy their boxes and build the wide nodes below them
+	*/
+	for (slot = 0; slot < slot_count; slot++) {
+		CullNodeStruct * node = &(Nodes[wnode->Node[slot]]);
+		wnode->MinX[slot] = node->Min.X;
+		wnode->MinY[slot] = node->Min.Y;
+		wnode->MinZ[slot] = node->Min.Z;
+		wnode->MaxX[slot] = node->Max.X;
+		wnode->MaxY[slot] = node->Max.Y;
+		wnode->MaxZ[slot] = node->Max.Z;
+
+		if (!node->Is_Leaf()) {
+			wnode->Wide[slot] = Build_Wide_Node_Recursive(wnode->Node[slot]);
+		}
+	}
+
+	return wide_index;
+}
+
+
+/***********************************************************************************************
+ * AABTreeClass::Build_Wide_Leaf -- Fill in the polygon blocks for a leaf                      *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * node_index - leaf node of the binary tree                                                   *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void AABTreeClass::Build_Wide_Leaf(int node_index)
+{
+	const Vector3 * loc = Mesh->Get_Vertex_Array();
+	const TriIndex * polyverts = Mesh->Get_Polygon_Array();
+
+	int poly0 = Nodes[node_index].Get_Poly0();
+	int polycount = Nodes[node_index].Get_Poly_Count();
+	WideTriBlockStruct * block = &(WideTriBlocks[WideLeafBlocks[node_index]]);
+
+	for (int poly_counter = 0; poly_counter < polycount; poly_counter++) {
+
+		int lane = poly_counter & 3;
+		if ((poly_counter > 0) && (lane == 0)) {
+			block++;
+		}
+		if (lane == 0) {
+			memset(block,0,sizeof(WideTriBlockStruct));
+		}
+
+		int poly_index = PolyIndices[poly0 + poly_counter];
+		const Vector3 & v0 = loc[ polyverts[poly_index][0] ];
+		const Vector3 & v1 = loc[ polyverts[poly_index][1] ];
+		const Vector3 & v2 = loc[ polyverts[poly_index][2] ];
+
+		block->MinX[lane] = WWMath::Min(v0.X,WWMath::Min(v1.X,v2.X));
+		block->MinY[lane] = WWMath::Min(v0.Y,WWMath::Min(v1.Y,v2.Y));
+		block->MinZ[lane] = WWMath::Min(v0.Z,WWMath::Min(v1.Z,v2.Z));
+		block->MaxX[lane] = WWMath::Max(v0.X,WWMath::Max(v1.X,v2.X));
+		block->MaxY[lane] = WWMath::Max(v0.Y,WWMath::Max(v1.Y,v2.Y));
+		block->MaxZ[lane] = WWMath::Max(v0.Z,WWMath::Max(v1.Z,v2.Z));
+
+		/*
+		** Same plane the exact test builds.  Degenerate polygons get a zero
+		** plane, which never throws anything out.
+		*/
+		Vector3 normal;
+		Vector3::Cross_Product(v1 - v0,v2 - v0,&normal);
+		float len2 = normal.Length2();
+		if (len2 > 0.0f) {
+			normal /= WWMath::Sqrt(len2);
+		} else {
+			normal.Set(0,0,0);
+		}
+		block->NX[lane] = normal.X;
+		block->NY[lane] = normal.Y;
+		block->NZ[lane] = normal.Z;
+		block->D[lane] = Vector3::Dot_Product(normal,v0);
+	}
+}
+
+
+/***********************************************************************************************
+ * AABTreeClass::Cast_Ray_Wide -- Cast_Ray using the 4-wide tree                               *
+ *                                                                                             *
+ * Visits the same nodes and polygons in the same order as Cast_Ray_Recursive, minus the ones  *
+ * the SSE tests can prove the ray can't reach, so the results are identical.                 *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+bool AABTreeClass::Cast_Ray_Wide(RayCollisionTestClass & raytest)
+{
+	/*
+	** If the ray already started out embedded in something, Cast_Ray_To_Polys bails out
+	** after the first polygon it tests.  Leave that case to the binary tree.
+	*/
+	if (raytest.Result->StartBad) {
+		return Cast_Ray_Recursive(&(Nodes[0]),raytest);
+	}
+
+	if (raytest.Cull(Nodes[0].Min,Nodes[0].Max)) {
+		return false;
+	}
+
+	WideRayStruct ray(raytest.Ray);
+	if (Nodes[0].Is_Leaf()) {
+		return Cast_Ray_To_Polys_Wide(0,raytest,ray);
+	}
+	return Cast_Ray_Wide_Recursive(0,raytest,ray);
+}
+
+
+/***********************************************************************************************
+ * AABTreeClass::Cast_Ray_Wide_Recursive -- Internal implementation of Cast_Ray_Wide           *
+ *                                                                                             *
+ * A slot which passes the SSE test is checked with the exact cull test, after its parent if   *
+ * it is a grandchild, just as the binary tree would have.                                     *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+bool AABTreeClass::Cast_Ray_Wide_Recursive(int wide_index,RayCollisionTestClass & raytest,WideRayStruct & ray)
+{
+	const WideNodeStruct & wnode = WideNodes[wide_index];
+	int mask = ray.Test_Boxes(wnode,raytest.Result->Fraction);
+
+	bool res = false;
+	int tested_parent = -1;
+	bool parent_culled = false;
+
+	for (int slot = 0; (slot < 4) && (wnode.Node[slot] != -1); slot++) {
+
+		if ((mask & (1 << slot)) == 0) {
+			continue;
+		}
+
+		int parent = wnode.Parent[slot];
+		if (parent != -1) {
+			if (parent != tested_parent) {
+				tested_parent = parent;
+				parent_culled = raytest.Cull(Nodes[parent].Min,Nodes[parent].Max);
+			}
+			if (parent_culled) {
+				continue;
+			}
+		}
+
+		CullNodeStruct * node = &(Nodes[wnode.Node[slot]]);
+		if (raytest.Cull(node->Min,node->Max)) {
+			continue;
+		}
+
+		if (node->Is_Leaf()) {
+			res = res | Cast_Ray_To_Polys_Wide(wnode.Node[slot],raytest,ray);
+		} else {
+			res = res | Cast_Ray_Wide_Recursive(wnode.Wide[slot],raytest,ray);
+		}
+	}
+
+	return res;
+}
+
+
+/***********************************************************************************************
+ * AABTreeClass::Cast_Ray_To_Polys_Wide -- Cast the ray to the polys in a leaf                 *
+ *                                                                                             *
+ * Same as Cast_Ray_To_Polys except that polygons are first tested four at a time and only     *
+ * the ones that could be hit get the exact test.                                              *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+bool AABTreeClass::Cast_Ray_To_Polys_Wide(int node_index,RayCollisionTestClass & raytest,WideRayStruct & ray)
+{
+	CullNodeStruct * node = &(Nodes[node_index]);
+	int polycount = node->Get_Poly_Count();
+
+	if (polycount > 0) {
+
+		TriClass tri;
+
+		const Vector3 * loc = Mesh->Get_Vertex_Array();
+		const TriIndex * polyverts = Mesh->Get_Polygon_Array();
+#if (!OPTIMIZE_PLANEEQ_RAM)
+		const Vector4 * norms = Mesh->Get_Plane_Array();
+#endif
+
+		int polyhit = -1;
+		int poly0 = node->Get_Poly0();
+		const WideTriBlockStruct * block = &(WideTriBlocks[WideLeafBlocks[node_index]]);
+
+		for (int block_poly0 = 0; block_poly0 < polycount; block_poly0 += 4, block++) {
+
+			int mask = ray.Test_Tris(*block,raytest.Result->Fraction);
+			int lane_count = WWMath::Min(4,polycount - block_poly0);
+
+			for (int lane = 0; lane < lane_count; lane++) {
+
+				if ((mask & (1 << lane)) == 0) {
+					continue;
+				}
+
+				int poly_index = PolyIndices[poly0 + block_poly0 + lane];
+
+				tri.V[0] = &(loc[ polyverts[poly_index][0] ]);
+				tri.V[1] = &(loc[ polyverts[poly_index][1] ]);
+				tri.V[2] = &(loc[ polyverts[poly_index][2] ]);
+#if (!OPTIMIZE_PLANEEQ_RAM)
+				tri.N = (Vector3*)&(norms[poly_index]);
+#else
+				Vector3 normal;
+				tri.N = &normal;
+				tri.Compute_Normal();
+#endif
+				if (CollisionMath::Collide(raytest.Ray,tri,raytest.Result)) {
+					polyhit = poly_index;
+				}
+
+				if (raytest.Result->StartBad) {
+					return true;
+				}
+			}
+		}
+		if (polyhit != -1) {
+			raytest.Result->SurfaceType = Mesh->Get_Poly_Surface_Type (polyhit);
+			return true;
+		}
+	}
+	return false;
+}
@@ -40,6 +40,7 @@
  *   WW3DAssetManager::Load_3D_Assets -- Load 3D assets from a .W3D file                       *
  *   WW3DAssetManager::Load_Prototype -- loads a prototype from a W3D chunk                    *
  *   WW3DAssetManager::Create_Render_Obj -- Create a render object for the user                *
+ *   WW3DAssetManager::Create_Render_Obj -- Create a render object, looked up by atom          *
  *   WW3DAssetManager::Render_Obj_Exists -- Check whether a render object with the given name  *
  *   WW3DAssetManager::Create_Render_Obj_Iterator -- Create an iterator which can enumerate al *
  *   WW3DAssetManager::Release_Render_Obj_Iterator -- release a render object iterator         *
@@ -48,6 +49,7 @@
  *   WW3DAssetManager::Create_Material_Iterator -- Create a material iterator                  *
  *   WW3DAssetManager::Create_Font3DData_Iterator -- Create a Font3DData iterator              *
  *   WW3DAssetManager::Get_HAnim -- Returns a pointer to a names HAnim                         *
+ *   WW3DAssetManager::Get_HAnim -- Returns a pointer to a named HAnim, looked up by atom      *
  *   WW3DAssetManager::Get_HTree -- Returns a pointer to the named HTree                       *
  *   WW3DAssetManager::Get_Material -- Gets a pointer to a loaded material or creates it       *
  *   WW3DAssetManager::Get_Material -- Gets a pointer to a loaded material or creates the mate *
@@ -64,6 +66,7 @@
  *   WW3DAssetManager::Find_Prototype_Loader -- find the loader that handles this chunk type   *
  *   WW3DAssetManager::Add_Prototype -- adds the prototype to the hash table                   *
  *   WW3DAssetManager::Find_Prototype -- searches the hash table for the prototype             *
+ *   WW3DAssetManager::Find_Prototype -- searches the hash table for the prototype by atom     *
  *   WW3DAssetManager::Open_Texture_File_Cache -- Turn on the texture cache system.            * 
  *   WW3DAssetManager::Close_Texture_File_Cache -- Turn off the texture cache system.          * 
  *   CachedTextureFileClass::getMipmapData -- get data for texture - check to see if in cache. * 
@@ -122,6 +125,7 @@ WW3DAssetManager *		WW3DAssetManager::TheInstance = NULL;
 ** to always be available...
 */
 static NullPrototypeClass _NullPrototype;
+static StringAtomClass _NullPrototypeName("NULL");
 
 /*
 ** Iterator for the Render Objects in the asset manager
@@ -223,10 +227,6 @@ WW3DAssetManager::WW3DAssetManager(void) :
 	Register_Prototype_Loader(&_AggregateLoader);
 	Register_Prototype_Loader(&_NullLoader);
 	Register_Prototype_Loader(&_DazzleLoader);
-	
-	// allocate the hash table and clear it.
-	PrototypeHashTable = new PrototypeClass * [PROTOTYPE_HASH_TABLE_SIZE];
-	memset(PrototypeHashTable,0,sizeof(PrototypeClass *) * PROTOTYPE_HASH_TABLE_SIZE);		
 }
 
 
@@ -248,11 +248,6 @@ WW3DAssetManager::~WW3DAssetManager(void)
 	Free();
 	TheInstance = NULL;
 
-	// If we need to, free the hash table
-	if (PrototypeHashTable != NULL) {
-		delete [] PrototypeHashTable;
-		PrototypeHashTable = NULL;
-	}
 #ifdef WW3D_DX8
 	Close_Texture_File_Cache();
 #endif //WW3D_DX8
@@ -453,7 +448,7 @@ void WW3DAssetManager::Free_Assets(void)
 	}
 	
 	// clear the prototype hash table
-	memset(PrototypeHashTable,0,sizeof(PrototypeClass *) * PROTOTYPE_HASH_TABLE_SIZE);	
+	PrototypeHash.Remove_All();
 
 	// delete all of the anims and trees
 	HAnimManager.Free_All_Anims();
@@ -538,30 +533,57 @@ bool WW3DAssetManager::Load_3D_Assets(FileClass & w3dfile)
 		return false;
 	}
 
-	ChunkLoadClass cload(&w3dfile);
+	/*
+	** Parse the chunks from memory.  Files that don't have their contents in memory
+	** already are read in with a single read, rather than one for every chunk header
+	** and field.
+	*/
+	unsigned char * buffer = NULL;
+	int size = 0;
+	if (w3dfile.Peek_Data() == NULL) {
+		size = w3dfile.Size();
+		if (size > 0) {
+			buffer = new unsigned char[size];
+			if (w3dfile.Read(buffer,size) != size) {
+				delete [] buffer;
+				buffer = NULL;
+				w3dfile.Seek(0,SEEK_SET);
+			}
+		}
+	}
+
+	ChunkLoadClass * cload = NULL;
+	if (buffer != NULL) {
+		cload = new ChunkLoadClass(buffer,size);
+	} else {
+		cload = new ChunkLoadClass(&w3dfile);
+	}
 
-	while (cload.Open_Chunk()) {
+	while (cload->Open_Chunk()) {
 
-		switch (cload.Cur_Chunk_ID()) {
+		switch (cload->Cur_Chunk_ID()) {
 
 			case W3D_CHUNK_HIERARCHY:
-				HTreeManager.Load_Tree(cload);
+				HTreeManager.Load_Tree(*cload);
 				break;
 
 			case W3D_CHUNK_ANIMATION:
 			case W3D_CHUNK_COMPRESSED_ANIMATION:
 			case W3D_CHUNK_MORPH_ANIMATION:
-				HAnimManager.Load_Anim(cload);
+				HAnimManager.Load_Anim(*cload);
 				break;
         
 			default:
-				Load_Prototype(cload);
+				Load_Prototype(*cload);
 				break;
 		}
 
-		cload.Close_Chunk();
+		cload->Close_Chunk();
 	}
 
+	delete cload;
+	delete [] buffer;
+
 	w3dfile.Close();
 
 	return true;
@@ -708,6 +730,34 @@ RenderObjClass * WW3DAssetManager::Create_Render_Obj(const char * name)
 }
 
 
+/***********************************************************************************************
+ * WW3DAssetManager::Create_Render_Obj -- Create a render object, looked up by atom            *
+ *                                                                                             *
+ *    If the prototype isn't loaded this falls back on the named version, which handles        *
+ *    loading on demand and reporting missing assets.                                          *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+RenderObjClass * WW3DAssetManager::Create_Render_Obj(const StringAtomClass & name)
+{
+	WWPROFILE( "WW3DAssetManager::Create_Render_Obj" );
+	WWMEMLOG(MEM_GEOMETRY);
+
+	PrototypeClass * proto = Find_Prototype(name);
+	if (proto == NULL) {
+		return Create_Render_Obj(name.Get_String());
+	}
+
+	return proto->Create();
+}
+
+
 /***********************************************************************************************
  * WW3DAssetManager::Render_Obj_Exists -- Check whether a render object with the given name ex *
  *                                                                                             *
@@ -882,6 +932,34 @@ HAnimClass *	WW3DAssetManager::Get_HAnim(const char * name)
 }										 
 
 
+/***********************************************************************************************
+ * WW3DAssetManager::Get_HAnim -- Returns a pointer to a named HAnim, looked up by atom        *
+ *                                                                                             *
+ *    If the anim isn't loaded this falls back on the named version, which handles loading     *
+ *    on demand and the missing anim list.                                                     *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *    The caller must release the anim.                                                        *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+HAnimClass *	WW3DAssetManager::Get_HAnim(const StringAtomClass & name)
+{
+	WWPROFILE( "WW3DAssetManager::Get_HAnim" );
+
+	HAnimClass * anim = HAnimManager.Get_Anim(name);
+	if (anim == NULL) {
+		anim = Get_HAnim(name.Get_String());
+	}
+
+	return anim;
+}
+
+
 /***********************************************************************************************
  * WW3DAssetManager::Get_HTree -- Returns a pointer to the named HTree                         *
  *                                                                                             *
@@ -1411,9 +1489,11 @@ PrototypeLoaderClass * WW3DAssetManager::Find_Prototype_Loader(int chunk_id)
 void WW3DAssetManager::Add_Prototype(PrototypeClass * newproto)
 {
 	WWASSERT(newproto != NULL);
-	int hash = CRC_Stringi(newproto->Get_Name()) & PROTOTYPE_HASH_MASK;
-	newproto->NextHash = PrototypeHashTable[hash];
-	PrototypeHashTable[hash] = newproto;
+	StringAtomClass name(newproto->Get_Name());
+	PrototypeClass * head = NULL;
+	PrototypeHash.Get(name, head);
+	newproto->NextHash = head;
+	PrototypeHash.Set_Value(name, newproto);
 	Prototypes.Add(newproto);
 }
 
@@ -1438,31 +1518,31 @@ void WW3DAssetManager::Remove_Prototype(PrototypeClass *proto)
 		//
 		// Find the prototype in the hash table.
 		//
-		const char *pname = proto->Get_Name ();
-		bool bfound = false;
-		PrototypeClass *prev = NULL;
-		int hash = CRC_Stringi(pname) & PROTOTYPE_HASH_MASK;				
-		for (PrototypeClass *test = PrototypeHashTable[hash];
-			  (test != NULL) && (bfound == false);
-			  test = test->NextHash) {
+		StringAtomClass name = StringAtomClass::Find(proto->Get_Name ());
+		PrototypeClass *head = NULL;
+		if (PrototypeHash.Get (name, head)) {
 			
-			// Is this the prototype?
-			if (::stricmp (test->Get_Name(), pname) == 0) {
+			if (head == proto) {
 				
-				// Remove this prototype from the linked list for this hash index.
-				if (prev == NULL) {
-					PrototypeHashTable[hash] = test->NextHash;
+				// The prototype is the head of the chain for its name
+				if (proto->NextHash != NULL) {
+					PrototypeHash.Set_Value (name, proto->NextHash);
 				} else {
-					prev->NextHash = test->NextHash;
+					PrototypeHash.Remove (name);
+				}
+			} else {
+				
+				// Unlink the prototype from behind a newer prototype with the same name
+				PrototypeClass *prev = head;
+				while ((prev->NextHash != NULL) && (prev->NextHash != proto)) {
+					prev = prev->NextHash;
+				}
+				if (prev->NextHash == proto) {
+					prev->NextHash = proto->NextHash;
 				}
-
-				// Success!
-				bfound = true;
 			}
-
-			// Remember who our previous entry is
-			prev = test;
 		}
+		proto->NextHash = NULL;
 
 		// Now remove this from our vector-array of prototypes
 		Prototypes.Delete (proto);
@@ -1517,23 +1597,34 @@ void WW3DAssetManager::Remove_Prototype(const char *name)
  *   12/8/98    GTH : Renamed to simply Find_Prototype                                         *
  *=============================================================================================*/
 PrototypeClass * WW3DAssetManager::Find_Prototype(const char * name)
+{
+	// A name that was never made into an atom can't have a prototype
+	return Find_Prototype(StringAtomClass::Find(name));
+}
+
+
+/***********************************************************************************************
+ * WW3DAssetManager::Find_Prototype -- searches the hash table for the prototype by atom       *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+PrototypeClass * WW3DAssetManager::Find_Prototype(const StringAtomClass & name)
 {
 	// Special case Null render object.  So we always have it...
-	if (stricmp(name,"NULL") == 0) {
+	if (name == _NullPrototypeName) {
 		return &(_NullPrototype);
 	}
 	
 	// Find the prototype
-	int hash = CRC_Stringi(name) & PROTOTYPE_HASH_MASK;
-	PrototypeClass * test = PrototypeHashTable[hash];
-
-	while (test != NULL) {
-		if (stricmp(test->Get_Name(),name) == 0) {
-			return test;
-		}
-		test = test->NextHash;
-	}
-	return NULL;
+	PrototypeClass * proto = NULL;
+	PrototypeHash.Get(name, proto);
+	return proto;
 }
 
 /*
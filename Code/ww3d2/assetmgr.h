@@ -50,6 +50,7 @@
 #include "slist.h"
 #include "texture.h"
 #include "hashtemplate.h"
+#include "stringatom.h"
 #include "simplevec.h"
 
 class	HAnimClass;
@@ -224,6 +225,7 @@ public:
 	** create me an instance of one of the prototype render objects
 	*/
 	virtual RenderObjClass *		Create_Render_Obj(const char * name);	
+	virtual RenderObjClass *		Create_Render_Obj(const StringAtomClass & name);
 
 	/*
 	** query if there is a render object with the specified name
@@ -244,6 +246,7 @@ public:
 	*/
 	virtual AssetIterator *			Create_HAnim_Iterator(void);
 	virtual HAnimClass *				Get_HAnim(const char * name);
+	virtual HAnimClass *				Get_HAnim(const StringAtomClass & name);
 	virtual bool						Add_Anim (HAnimClass *new_anim) { return HAnimManager.Add_Anim (new_anim); }
 
 	/*
@@ -299,6 +302,7 @@ public:
 	void									Remove_Prototype(PrototypeClass *proto);
 	void									Remove_Prototype(const char *name);
 	PrototypeClass *					Find_Prototype(const char * name);
+	PrototypeClass *					Find_Prototype(const StringAtomClass & name);
 
 	/*
 	** Load on Demand
@@ -362,16 +366,11 @@ protected:
 
 	/*
 	** Prototype Hash Table
-	** This structure is simply used to speed up the name lookup for prototypes
+	** This structure is simply used to speed up the name lookup for prototypes.
+	** It maps each name to the most recently added prototype with that name, older
+	** prototypes with the same name are chained behind it through NextHash.
 	*/
-	enum 
-	{ 
-		PROTOTYPE_HASH_TABLE_SIZE =	4096, 
-		PROTOTYPE_HASH_BITS =			12, 
-		PROTOTYPE_HASH_MASK =			0x00000FFF
-	};
-
-	PrototypeClass * *												PrototypeHashTable;
+	HashTemplateClass<StringAtomClass, PrototypeClass *>		PrototypeHash;
 
 	/*
 	** managers of HTrees, HAnims, Textures....
@@ -39,6 +39,8 @@
  *   HAnimManagerClass::Get_Anim_ID -- looks up the ID of a named Hierarchy Animation          * 
  *   HAnimManagerClass::Get_Anim -- returns a pointer to the specified animation data          * 
  *   HAnimManagerClass::Get_Anim -- returns a pointer to the specified Hierarchy Animation     * 
+ *   HAnimManagerClass::Peek_Anim -- returns the named animation, looked up by atom            *
+ *   HAnimManagerClass::Get_Anim -- returns the named animation (add ref'd), looked up by atom *
  *   HAnimManagerClass::Free -- de-allocate all memory in use                                  * 
  *   HAnimManagerClass::Free_All_Anims -- de-allocate all currently loaded animations          * 
  *   HAnimManagerClass::Load_Raw_Anim -- Load a raw anim                                       *
@@ -305,6 +307,46 @@ HAnimClass * HAnimManagerClass::Get_Anim(const char * name)
 }
 
 
+/*********************************************************************************************** 
+ * HAnimManagerClass::Peek_Anim -- returns the named animation, looked up by atom              * 
+ *                                                                                             * 
+ * INPUT:                                                                                      * 
+ *                                                                                             * 
+ * OUTPUT:                                                                                     * 
+ *                                                                                             * 
+ * WARNINGS:                                                                                   * 
+ *                                                                                             * 
+ * HISTORY:                                                                                    * 
+ *=============================================================================================*/
+HAnimClass * HAnimManagerClass::Peek_Anim(const StringAtomClass & name)
+{
+	HAnimClass * anim = NULL;
+	AnimAtomTable.Get( name, anim );
+	return anim;
+}
+
+
+/*********************************************************************************************** 
+ * HAnimManagerClass::Get_Anim -- returns the named animation (add ref'd), looked up by atom   * 
+ *                                                                                             * 
+ * INPUT:                                                                                      * 
+ *                                                                                             * 
+ * OUTPUT:                                                                                     * 
+ *                                                                                             * 
+ * WARNINGS:                                                                                   * 
+ *                                                                                             * 
+ * HISTORY:                                                                                    * 
+ *=============================================================================================*/
+HAnimClass * HAnimManagerClass::Get_Anim(const StringAtomClass & name)
+{	
+	HAnimClass * anim = Peek_Anim( name );
+	if ( anim != NULL ) {
+		anim->Add_Ref();
+	}
+	return anim;
+}
+
+
 /*********************************************************************************************** 
  * HAnimManagerClass::Free_All_Anims -- de-allocate all currently loaded animations            * 
  *                                                                                             * 
@@ -326,8 +368,9 @@ void HAnimManagerClass::Free_All_Anims(void)
 		anim->Release_Ref();
 	}
 
-	// Then clear the table
+	// Then clear the tables
 	AnimPtrTable->Reset();
+	AnimAtomTable.Remove_All();
 }
 	
 
@@ -350,6 +393,7 @@ bool HAnimManagerClass::Add_Anim(HAnimClass *new_anim)
 	// Increment the refcount on the new animation and add it to our table.
 	new_anim->Add_Ref ();
 	AnimPtrTable->Add( new_anim );
+	AnimAtomTable.Set_Value( StringAtomClass( new_anim->Get_Name() ), new_anim );
 
 	//
 	//	Check to see if this animation has any embedded sounds that may
@@ -46,6 +46,7 @@
 #include "always.h"
 #include "hash.h"
 #include "wwstring.h"
+#include "stringatom.h"
 
 class HAnimClass;
 class ChunkLoadClass;
@@ -81,7 +82,9 @@ public:
 
 	int			 		Load_Anim(ChunkLoadClass & cload);
 	HAnimClass *		Get_Anim(const char * name);
+	HAnimClass *		Get_Anim(const StringAtomClass & name);
 	HAnimClass *		Peek_Anim(const char * name);
+	HAnimClass *		Peek_Anim(const StringAtomClass & name);
 	bool					Add_Anim(HAnimClass *new_anim);
 	void			 		Free_All_Anims(void);
 
@@ -97,6 +100,9 @@ private:
 	HashTableClass	*	AnimPtrTable;
 	HashTableClass	*	MissingAnimTable;
 
+	// Same anims as AnimPtrTable, keyed by name atom
+	HashTemplateClass<StringAtomClass, HAnimClass *>	AnimAtomTable;
+
 	friend	class		HAnimManagerIterator;
 };
 
@@ -110,4 +116,4 @@ public:
 	HAnimClass * Get_Current_Anim( void );
 };
 
-#endif
\ No newline at end of file
+#endif
\ No newline at end of file
@@ -1542,6 +1542,7 @@ void MeshGeometryClass::Generate_Culling_Tree(void)
 	
 		CullTree = NEW_REF(AABTreeClass,(&builder));
 		CullTree->Set_Mesh(this);
+		CullTree->Build_Wide_Tree();
 	}
 }
 
@@ -1673,6 +1674,8 @@ WW3DErrorType MeshGeometryClass::Load_W3D(ChunkLoadClass & cload)
 			(CullTree == NULL)) 
 	{
 		Generate_Culling_Tree();
+	} else if (CullTree != NULL) {
+		CullTree->Build_Wide_Tree();
 	}
 
 	return WW3D_ERROR_OK;
@@ -1773,19 +1776,18 @@ WW3DErrorType MeshGeometryClass::read_chunks(ChunkLoadClass & cload)
  *=============================================================================================*/
 WW3DErrorType MeshGeometryClass::read_vertices(ChunkLoadClass & cload)
 {
-	W3dVectorStruct vert;
 	Vector3 * loc = Vertex->Get_Array();
 	assert(loc);
 
-	for (int i=0; i<Get_Vertex_Count(); i++) {
+	const W3dVectorStruct * verts = cload.Read_Array<W3dVectorStruct>(Get_Vertex_Count());
+	if (verts == NULL) {
+		return WW3D_ERROR_LOAD_FAILED;
+	}
 
-		if (cload.Read(&vert,sizeof(W3dVectorStruct)) != sizeof(W3dVectorStruct)) {
-			return WW3D_ERROR_LOAD_FAILED;
-		}
-		
-		loc[i].X = vert.X;
-		loc[i].Y = vert.Y;
-		loc[i].Z = vert.Z;
+	for (int i=0; i<Get_Vertex_Count(); i++) {
+		loc[i].X = verts[i].X;
+		loc[i].Y = verts[i].Y;
+		loc[i].Z = verts[i].Z;
 	}
 
 	return WW3D_ERROR_OK;	
@@ -1806,16 +1808,16 @@ WW3DErrorType MeshGeometryClass::read_vertices(ChunkLoadClass & cload)
  *=============================================================================================*/
 WW3DErrorType MeshGeometryClass::read_vertex_normals(ChunkLoadClass & cload)
 {
-	W3dVectorStruct norm;
 	Vector3 * mdlnorms = get_vert_normals();
 	WWASSERT(mdlnorms);
 
-	for (int i=0; i<VertexCount; i++) {
-		if (cload.Read(&norm,sizeof(W3dVectorStruct)) != sizeof(W3dVectorStruct)) {
-			return WW3D_ERROR_LOAD_FAILED;
-		}
+	const W3dVectorStruct * norms = cload.Read_Array<W3dVectorStruct>(VertexCount);
+	if (norms == NULL) {
+		return WW3D_ERROR_LOAD_FAILED;
+	}
 
-		mdlnorms[i].Set(norm.X,norm.Y,norm.Z);
+	for (int i=0; i<VertexCount; i++) {
+		mdlnorms[i].Set(norms[i].X,norms[i].Y,norms[i].Z);
 	}
 
 	return WW3D_ERROR_OK;	
@@ -1836,20 +1838,21 @@ WW3DErrorType MeshGeometryClass::read_vertex_normals(ChunkLoadClass & cload)
  *=============================================================================================*/
 WW3DErrorType MeshGeometryClass::read_triangles(ChunkLoadClass & cload)
 {
-	W3dTriStruct tri;
-
 	// cache pointers to various arrays in the surrender mesh
 	TriIndex * vi = get_polys();
 	Set_Flag(DIRTY_PLANES,false);
 	Vector4 * peq = get_planes();
 	uint8 * surface_types = Get_Poly_Surface_Type_Array();
 
-	// read in each polygon one by one
+	// the polygons are parsed straight out of the chunk
+	const W3dTriStruct * tris = cload.Read_Array<W3dTriStruct>(Get_Polygon_Count());
+	if (tris == NULL) {
+		return WW3D_ERROR_LOAD_FAILED;
+	}
+
 	for (int i=0; i<Get_Polygon_Count(); i++) {
 
-		if (cload.Read(&tri,sizeof(W3dTriStruct)) != sizeof(W3dTriStruct)) {
-			return WW3D_ERROR_LOAD_FAILED;
-		}
+		const W3dTriStruct & tri = tris[i];
 
 		// set the vertex indices
 		vi[i].I = tri.Vindex[0];
@@ -2015,4 +2018,9 @@ void MeshGeometryClass::Scale(const Vector3 &sc)
 	}
 	// pnormals are plane equations...
 	Set_Flag(DIRTY_PLANES,true);
-}
\ No newline at end of file
+
+	// the wide cull tree keeps its own copy of the polygon bounds
+	if (CullTree && CullTree->Has_Wide_Tree()) {
+		CullTree->Build_Wide_Tree();
+	}
+}
\ No newline at end of file
@@ -400,6 +400,8 @@ WW3DErrorType MeshModelClass::Load_W3D(ChunkLoadClass & cload)
 			(CullTree == NULL)) 
 	{
 		Generate_Culling_Tree();
+	} else if (CullTree != NULL) {
+		CullTree->Build_Wide_Tree();
 	}
 
 	/*
@@ -2693,4 +2695,4 @@ WW3DErrorType MeshModelClass::write_stage_texcoords(ChunkSaveClass & csave,MeshS
 	return WW3D_ERROR_OK;
 }
 
-#endif // 0 (disabled mesh saving code)
\ No newline at end of file
+#endif // 0 (disabled mesh saving code)
\ No newline at end of file
@@ -47,6 +47,9 @@
 #include "wwstring.h"
 #include "vp.h"
 #include "meshmatdesc.h"
+#include "hashtemplate.h"
+#include "wwprofile.h"
+#include "w3d_file.h"
 #include <stdlib.h>
 
 /*
@@ -201,6 +204,55 @@ protected:
 };
 
 
+/**
+** ShatterFragmentClass
+** Compact description of one mesh fragment.  The vertices are in the original mesh's 
+** coordinate system, offset so that the fragment's bounding box is centered at the
+** origin.  Colors are stored with the DIG already multiplied in and only the color and 
+** uv arrays that the source model has are filled in.  The polygons are triangle fans,
+** FanSizes holds the vertex count of each one.
+*/
+class ShatterFragmentClass
+{
+public:
+	ShatterFragmentClass(void);
+
+	void							Reset(void);
+	void							Compact(void);
+	int							Get_Polygon_Count(void) const		{ return PolygonCount; }
+	int							Get_Vertex_Count(void) const		{ return Positions.Count(); }
+	int							Get_Memory_Size(void) const;
+
+	Vector3											Center;
+	int												PolygonCount;
+	SimpleDynVecClass<unsigned char>			FanSizes;
+	SimpleDynVecClass<Vector3>					Positions;
+	SimpleDynVecClass<Vector3>					Normals;
+	SimpleDynVecClass<unsigned>				Colors[MeshMatDescClass::MAX_PASSES];
+	SimpleDynVecClass<Vector2>					UVs[MeshMatDescClass::MAX_PASSES][MeshMatDescClass::MAX_TEX_STAGES];
+};
+
+/**
+** ShatterCacheEntryClass
+** The precomputed fragments of one model, for every shatter pattern.  The fragments 
+** of pattern 'i' are Fragments[PatternStart[i]] up to Fragments[PatternStart[i+1]].
+** The entry holds a reference to the model so that the model pointer it is filed 
+** under stays valid.
+*/
+class ShatterCacheEntryClass
+{
+public:
+	ShatterCacheEntryClass(MeshModelClass * model);
+	~ShatterCacheEntryClass(void);
+
+	int							Get_Memory_Size(void) const;
+
+	MeshModelClass *										Model;
+	SimpleDynVecClass<ShatterFragmentClass *>		Fragments;
+	SimpleDynVecClass<int>								PatternStart;
+};
+
+
 /***********************************************************************************************
 **
 ** Static Variables
@@ -209,6 +261,9 @@ protected:
 ** MeshFragments - Array of resultant clipped meshes, one per leaf 
 ** TmpVertPositions - Workspace for transforming vertex positions
 ** TmpVertNormals - Workspace for transforming vertex normals
+** TmpFragment - Workspace for building uncached mesh fragments
+** FragmentCache - Precomputed fragments, indexed by model
+** Statistics - Timing of Shatter_Mesh
 **
 ***********************************************************************************************/
 
@@ -218,6 +273,12 @@ static SimpleDynVecClass<PolygonClass>				ClipPools[MAX_MESH_FRAGMENTS];
 static SimpleDynVecClass<DynamicMeshClass	*>		MeshFragments(MAX_MESH_FRAGMENTS);
 static SimpleVecClass<Vector3>						TmpVertPositions(256);
 static SimpleVecClass<Vector3>						TmpVertNormals(256);
+static ShatterFragmentClass							TmpFragment;
+
+static bool																		FragmentCacheEnabled = false;
+static HashTemplateClass<MeshModelClass *,ShatterCacheEntryClass *>	FragmentCache;
+static SimpleDynVecClass<ShatterCacheEntryClass *>							FragmentCacheEntries;
+static ShatterSystem::StatisticsStruct										Statistics = { 0, 0, 0.0f, 0.0f, 0.0f };
 
 
 /***********************************************************************************************
@@ -241,6 +302,24 @@ static Vector3 * _get_temp_vertex_normal_array(int count)
 	return &(TmpVertNormals[0]);
 }
 
+static void _apply_shatter_scale(MeshModelClass * model,Matrix3D & Mobj_to_shatter,Matrix3D & Mshatter_to_obj)
+{
+	/*
+	** Scaling matrices.  This could be simpler if Matrix3D had a full inverse function.
+	*/
+	SphereClass sphere;
+	model->Get_Bounding_Sphere(&sphere);
+	
+	float scale_factor = 5.0f / sphere.Radius;	// mesh scales to 5x shatter pattern.
+	Matrix3D Mscale_to_shatter(1);
+	Matrix3D Mscale_from_shatter(1);
+	Mscale_to_shatter.Scale(scale_factor);
+	Mscale_from_shatter.Scale(1.0f / scale_factor);
+	
+	Matrix3D::Multiply(Mscale_to_shatter,Mobj_to_shatter,&Mobj_to_shatter);
+	Matrix3D::Multiply(Mshatter_to_obj,Mscale_from_shatter,&Mshatter_to_obj);
+}
+
 /***********************************************************************************************
 **
 ** MeshMtlParamsClass Implementation
@@ -266,6 +345,96 @@ MeshMtlParamsClass::~MeshMtlParamsClass(void)
 }
 
 
+/***********************************************************************************************
+**
+** ShatterFragmentClass Implementation
+**
+***********************************************************************************************/
+ShatterFragmentClass::ShatterFragmentClass(void) :
+	Center(0,0,0),
+	PolygonCount(0)
+{
+}
+
+void ShatterFragmentClass::Reset(void)
+{
+	// reset arrays but don't resize
+	Center.Set(0,0,0);
+	PolygonCount = 0;
+	FanSizes.Delete_All(false);
+	Positions.Delete_All(false);
+	Normals.Delete_All(false);
+	for (int ipass=0; ipass<MeshMatDescClass::MAX_PASSES; ipass++) {
+		Colors[ipass].Delete_All(false);
+		for (int istage=0; istage<MeshMatDescClass::MAX_TEX_STAGES; istage++) {
+			UVs[ipass][istage].Delete_All(false);
+		}
+	}
+}
+
+void ShatterFragmentClass::Compact(void)
+{
+	// trim the arrays down to what they hold, used on fragments that are kept in the cache
+	FanSizes.Resize(FanSizes.Count());
+	Positions.Resize(Positions.Count());
+	Normals.Resize(Normals.Count());
+	for (int ipass=0; ipass<MeshMatDescClass::MAX_PASSES; ipass++) {
+		Colors[ipass].Resize(Colors[ipass].Count());
+		for (int istage=0; istage<MeshMatDescClass::MAX_TEX_STAGES; istage++) {
+			UVs[ipass][istage].Resize(UVs[ipass][istage].Count());
+		}
+	}
+}
+
+int ShatterFragmentClass::Get_Memory_Size(void) const
+{
+	int size = sizeof(ShatterFragmentClass);
+	size += FanSizes.Length() * sizeof(unsigned char);
+	size += Positions.Length() * sizeof(Vector3);
+	size += Normals.Length() * sizeof(Vector3);
+	for (int ipass=0; ipass<MeshMatDescClass::MAX_PASSES; ipass++) {
+		size += Colors[ipass].Length() * sizeof(unsigned);
+		for (int istage=0; istage<MeshMatDescClass::MAX_TEX_STAGES; istage++) {
+			size += UVs[ipass][istage].Length() * sizeof(Vector2);
+		}
+	}
+	return size;
+}
+
+
+/***********************************************************************************************
+**
+** ShatterCacheEntryClass Implementation
+**
+***********************************************************************************************/
+ShatterCacheEntryClass::ShatterCacheEntryClass(MeshModelClass * model) :
+	Model(NULL)
+{
+	REF_PTR_SET(Model,model);
+}
+
+ShatterCacheEntryClass::~ShatterCacheEntryClass(void)
+{
+	for (int i=0; i<Fragments.Count(); i++) {
+		delete Fragments[i];
+		Fragments[i] = NULL;
+	}
+	Fragments.Delete_All();
+	REF_PTR_RELEASE(Model);
+}
+
+int ShatterCacheEntryClass::Get_Memory_Size(void) const
+{
+	int size = sizeof(ShatterCacheEntryClass);
+	size += Fragments.Length() * sizeof(ShatterFragmentClass *);
+	size += PatternStart.Length() * sizeof(int);
+	for (int i=0; i<Fragments.Count(); i++) {
+		size += Fragments[i]->Get_Memory_Size();
+	}
+	return size;
+}
+
+
 /***********************************************************************************************
 **
 ** VertexClass Implementation
@@ -832,9 +1001,10 @@ void ShatterSystem::Init(void)
 void ShatterSystem::Shutdown(void)
 {
 	/*
-	** Release all mesh fragments
+	** Release all mesh fragments and any cached fragments
 	*/
 	Release_Fragments();
+	Flush_Fragment_Cache();
 
 	/*
 	** Release any loaded BSP trees
@@ -853,9 +1023,28 @@ void ShatterSystem::Shatter_Mesh(MeshClass * mesh,const Vector3 & point,const Ve
 		return ;
 	}
 
-	int ivert,ipoly;
-	int ipass,istage;
+	WWPROFILE("ShatterSystem::Shatter_Mesh");
+
+	float shatter_time = 0.0f;
+	bool used_cache = false;
+	{
+		WWMeasureItClass measure(&shatter_time);
+		used_cache = Internal_Shatter_Mesh(mesh,point,direction);
+	}
 
+	if (MeshFragments.Count() > 0) {
+		Statistics.ShatterCount++;
+		if (used_cache) {
+			Statistics.CachedShatterCount++;
+		}
+		Statistics.LastShatterTime = shatter_time;
+		Statistics.MaxShatterTime = WWMath::Max(Statistics.MaxShatterTime,shatter_time);
+		Statistics.TotalShatterTime += shatter_time;
+	}
+}
+
+bool ShatterSystem::Internal_Shatter_Mesh(MeshClass * mesh,const Vector3 & point,const Vector3 & direction)
+{
 	/*
 	** Reset the temporary clip arrays
 	** Release any old mesh fragment render objects
@@ -865,55 +1054,56 @@ void ShatterSystem::Shatter_Mesh(MeshClass * mesh,const Vector3 & point,const Ve
 
 	/*
 	** Verify that this mesh meets the criteria for being shattered
-	** - it has a maximum of two passes
-	** - it uses only one vertex material per pass
-	** - it uses only one shader per pass
-	** - it uses only one texture per pass
 	*/
 	MeshModelClass * model = mesh->Get_Model();
-	if (model->Get_Pass_Count() > MeshMatDescClass::MAX_PASSES) {
-		WWDEBUG_SAY(("Failed to shatter model: %s.  Too many passes (%d)\n",model->Get_Name(),model->Get_Pass_Count()));
+	if (!Can_Shatter(model)) {
 		REF_PTR_RELEASE(model);
-		return;
+		return false;
 	}
-	for (ipass=0; ipass<model->Get_Pass_Count(); ipass++) {
-		if (model->Has_Material_Array(ipass) || model->Has_Shader_Array(ipass)) {
-			WWDEBUG_SAY(("Failed to shatter model: %s.  It has shader or material arrays\n",model->Get_Name()));
-			REF_PTR_RELEASE(model);
-			return;
+
+	/*
+	** Grab a random shatter pattern
+	*/
+	int pattern = rand() % ShatterPatterns.Count();
+
+	/*
+	** If the fragment cache is on, just build the stored fragments for this pattern
+	*/
+	if (FragmentCacheEnabled) {
+		ShatterCacheEntryClass * entry = NULL;
+		if (!FragmentCache.Get(model,entry)) {
+			Precache_Model(model);
+			FragmentCache.Get(model,entry);
 		}
-		
-		for (istage=0; istage<MeshMatDescClass::MAX_TEX_STAGES; istage++) {
-			if (model->Has_Texture_Array(ipass,istage)) {
-				WWDEBUG_SAY(("Failed to shatter model: %s.  Texture array in pass: %d stage: %d\n",model->Get_Name(),ipass,istage));
-				REF_PTR_RELEASE(model);
-				return;
+
+		if (entry != NULL) {
+			for (int i=entry->PatternStart[pattern]; i<entry->PatternStart[pattern+1]; i++) {
+				MeshFragments.Add(Create_Fragment_Mesh(*entry->Fragments[i],mesh,model));
 			}
+			REF_PTR_RELEASE(model);
+			return true;
 		}
 	}
 
-	/*
-	** Grab a random shatter pattern
-	*/
-	BSPClass * clipper = ShatterPatterns[rand() % ShatterPatterns.Count()];
+	BSPClass * clipper = ShatterPatterns[pattern];
 
 	/*
 	** Compute transforms which take vertices from mesh-space to shatter-space
-	** and back again.  Transform polygons into "shatter-space", clip, then 
+	** and back again.  Transform polygons into "shatter-space", clip, then
 	** transform the results back out
 	**
 	** Take vertices from obj-space to shatter space:
 	** Vshatter = Mscale-to-unit * Mworld-shatterview * Mobj-world * Vobj
-	** 
+	**
 	** Clip the polygons to the BSP
 	** Vclipped = BSP_CLIP(Vshatter)
 	**
 	** Next, take the verts back to object space:
 	** Vobjclip = Inverse(Mscale-to-unit * Mworld-shatter * Mobj-world) * Vclipped
 	**          = Inv(Mobj-world)*Inv(Mworld-shatter)*Inv(Mscl-to-unit) * Vclipped
-	** 
+	**
 	** Next, create separate, re-centered meshes
-	** Vnewobj = Mold-obj-to-new-obj * Vobjclip 
+	** Vnewobj = Mold-obj-to-new-obj * Vobjclip
 	*/
 
 	/*
@@ -937,21 +1127,74 @@ void ShatterSystem::Shatter_Mesh(MeshClass * mesh,const Vector3 & point,const Ve
 
 	Matrix3D::Multiply(Mworld_to_shatter,Mobj_to_world,&Mobj_to_shatter);
 	Mobj_to_shatter.Get_Orthogonal_Inverse(Mshatter_to_obj);
+	_apply_shatter_scale(model,Mobj_to_shatter,Mshatter_to_obj);
 
 	/*
-	** Scaling matrices.  This could be simpler if Matrix3D had a full inverse function.
+	** Build a description of the material parameters for the mesh
 	*/
-	SphereClass sphere;
-	model->Get_Bounding_Sphere(&sphere);
-	
-	float scale_factor = 5.0f / sphere.Radius;	// mesh scales to 5x shatter pattern.
-	Matrix3D Mscale_to_shatter(1);
-	Matrix3D Mscale_from_shatter(1);
-	Mscale_to_shatter.Scale(scale_factor);
-	Mscale_from_shatter.Scale(1.0f / scale_factor);
-	
-	Matrix3D::Multiply(Mscale_to_shatter,Mobj_to_shatter,&Mobj_to_shatter);
-	Matrix3D::Multiply(Mshatter_to_obj,Mscale_from_shatter,&Mshatter_to_obj);
+	MeshMtlParamsClass mtl_params(model);
+
+	/*
+	** Pass each polygon of the source model through the BSP clipper
+	*/
+	{
+		WWPROFILE("Clip");
+		Clip_Model(model,clipper,Mobj_to_shatter,mtl_params);
+	}
+
+	/*
+	** convert the clipped polygons into meshes
+	*/
+	Process_Clip_Pools(Mshatter_to_obj,mesh,mtl_params);
+
+	/*
+	** release resources
+	*/
+	REF_PTR_RELEASE(model);
+	return false;
+}
+
+bool ShatterSystem::Can_Shatter(MeshModelClass * model)
+{
+	/*
+	** Verify that this mesh meets the criteria for being shattered
+	** - it has a maximum of two passes
+	** - it uses only one vertex material per pass
+	** - it uses only one shader per pass
+	** - it uses only one texture per pass
+	*/
+	int ipass,istage;
+
+	if (model->Get_Pass_Count() > MeshMatDescClass::MAX_PASSES) {
+		WWDEBUG_SAY(("Failed to shatter model: %s.  Too many passes (%d)\n",model->Get_Name(),model->Get_Pass_Count()));
+		return false;
+	}
+	for (ipass=0; ipass<model->Get_Pass_Count(); ipass++) {
+		if (model->Has_Material_Array(ipass) || model->Has_Shader_Array(ipass)) {
+			WWDEBUG_SAY(("Failed to shatter model: %s.  It has shader or material arrays\n",model->Get_Name()));
+			return false;
+		}
+
+		for (istage=0; istage<MeshMatDescClass::MAX_TEX_STAGES; istage++) {
+			if (model->Has_Texture_Array(ipass,istage)) {
+				WWDEBUG_SAY(("Failed to shatter model: %s.  Texture array in pass: %d stage: %d\n",model->Get_Name(),ipass,istage));
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+void ShatterSystem::Clip_Model
+(
+	MeshModelClass * model,
+	BSPClass * clipper,
+	const Matrix3D & Mobj_to_shatter,
+	MeshMtlParamsClass & mtl_params
+)
+{
+	int ivert,ipoly;
+	int ipass,istage;
 
 	/*
 	** Grab the arrays out of the mesh and transform verts and vnorms
@@ -964,12 +1207,6 @@ void ShatterSystem::Shatter_Mesh(MeshClass * mesh,const Vector3 & point,const Ve
 	Vector3 * verts = _get_temp_vertex_position_array(model->Get_Vertex_Count());
 	VectorProcessorClass::Transform(verts,src_verts,Mobj_to_shatter,model->Get_Vertex_Count());
 
-	/*
-	** Build a description of the material parameters for the mesh
-	*/
-	MeshMtlParamsClass mtl_params(model);
-
-	
 	SHATTER_DEBUG_SAY(("****************************************************\n"));
 	SHATTER_DEBUG_SAY((" Clipping model: %s\n",model->Get_Name()));
 	SHATTER_DEBUG_SAY(("****************************************************\n"));
@@ -984,21 +1221,21 @@ void ShatterSystem::Shatter_Mesh(MeshClass * mesh,const Vector3 & point,const Ve
 		*/
 		SHATTER_DEBUG_SAY(("Passing polygon %d to clipper.\n",ipoly));
 		PolygonClass polygon;
-		for (ivert=0; ivert<3; ivert++) { 
-			
+		for (ivert=0; ivert<3; ivert++) {
+
 			int vert_index = polys[ipoly][ivert];
 			polygon.Verts[ivert].PassCount = mtl_params.PassCount;
 			polygon.Verts[ivert].Position = verts[vert_index];
 			polygon.Verts[ivert].Normal = src_vnorms[vert_index];
 			SHATTER_DEBUG_SAY(("position: %f %f %f\n",verts[vert_index].X,verts[vert_index].Y,verts[vert_index].Z));
 			SHATTER_DEBUG_SAY(("normal: %f %f %f\n",src_vnorms[vert_index].X,src_vnorms[vert_index].Y,src_vnorms[vert_index].Z));
-			
+
 			for (ipass=0; ipass<MeshMatDescClass::MAX_PASSES; ipass++) {
 				if (mtl_params.DCG[ipass] != NULL) {
 					polygon.Verts[ivert].DCG[ipass] = mtl_params.DCG[ipass][vert_index];
 					SHATTER_DEBUG_SAY(("DCG: pass: %d : %f %f %f\n",ipass,mtl_params.DCG[ipass][vert_index].X,mtl_params.DCG[ipass][vert_index].Y,mtl_params.DCG[ipass][vert_index].Z));
 				}
-				
+
 				if (mtl_params.DIG[ipass] != NULL) {
 					polygon.Verts[ivert].DIG[ipass] = mtl_params.DIG[ipass][vert_index];
 					SHATTER_DEBUG_SAY(("DIG: pass: %d : %f %f %f\n",ipass,mtl_params.DIG[ipass][vert_index].X,mtl_params.DIG[ipass][vert_index].Y,mtl_params.DIG[ipass][vert_index].Z));
@@ -1026,16 +1263,6 @@ void ShatterSystem::Shatter_Mesh(MeshClass * mesh,const Vector3 & point,const Ve
 		*/
 		clipper->Clip_Polygon(polygon);
 	}
-
-	/*
-	** convert the clipped polygons into meshes
-	*/
-	Process_Clip_Pools(Mshatter_to_obj,mesh,mtl_params);
-
-	/*
-	** release resources
-	*/
-	REF_PTR_RELEASE(model);
 }
 
 int ShatterSystem::Get_Fragment_Count(void)
@@ -1062,16 +1289,16 @@ void ShatterSystem::Release_Fragments(void)
 	for (int i=0; i<MeshFragments.Count(); i++) {
 		REF_PTR_RELEASE(MeshFragments[i]);
 	}
-	
+
 	// reset array but don't resize
-	MeshFragments.Delete_All(false);					
+	MeshFragments.Delete_All(false);
 }
 
 void ShatterSystem::Reset_Clip_Pools(void)
 {
 	for (int i=0; i<MAX_MESH_FRAGMENTS; i++) {
 		// reset array but don't resize
-		ClipPools[i].Delete_All(false);				
+		ClipPools[i].Delete_All(false);
 	}
 }
 
@@ -1082,11 +1309,13 @@ void ShatterSystem::Process_Clip_Pools
 	MeshMtlParamsClass & mtl_params
 )
 {
+	WWPROFILE("Build Fragments");
+
 	/*
 	** Release any render objects we currently have and reset the array count
 	*/
 	Release_Fragments();
-	
+
 	/*
 	** Grab the model
 	*/
@@ -1097,166 +1326,348 @@ void ShatterSystem::Process_Clip_Pools
 	** Loop over all ClipPools and build a mesh for any that contain polygons
 	*/
 	for (int ipool=0; ipool<MAX_MESH_FRAGMENTS; ipool++) {
-
 		if (ClipPools[ipool].Count() > 0) {
-
-			int ivert,ipoly,ipass,istage;
+			Build_Fragment(ipool,Mshatter_to_mesh,mtl_params,&TmpFragment);
 
 			/*
-			** Count the verts and polys
+			** Install it in the mesh fragment pool, transferring our reference
+			** to the fragment array...
 			*/
-			int pcount = 0;
-			int vcount = 0;
-			for (ipoly=0;ipoly<ClipPools[ipool].Count();ipoly++) {
-				int poly_vert_count = ClipPools[ipool][ipoly].Get_Vertex_Count();
-				vcount += poly_vert_count;
-				pcount += poly_vert_count-2;
-			}
+			MeshFragments.Add(Create_Fragment_Mesh(TmpFragment,mesh,model));
+		}
+	}
+	REF_PTR_RELEASE(model);
+}
 
-			SHATTER_DEBUG_SAY(("****************************************************\n"));
-			SHATTER_DEBUG_SAY((" Reassembling fragment %d of model: %s\n",ipool,model->Get_Name()));
-			SHATTER_DEBUG_SAY((" polycount = %d   vertexcount = %d\n",pcount,vcount));
-			SHATTER_DEBUG_SAY(("****************************************************\n"));
+void ShatterSystem::Build_Fragment
+(
+	int ipool,
+	const Matrix3D & Mshatter_to_mesh,
+	MeshMtlParamsClass & mtl_params,
+	ShatterFragmentClass * fragment
+)
+{
+	int ivert,ipoly,ipass,istage;
 
-			/*
-			** Create the new mesh, install materials
-			*/
-			DynamicMeshClass * new_mesh = NEW_REF(DynamicMeshClass,(pcount,vcount));
-			MaterialInfoClass * matinfo = NEW_REF(MaterialInfoClass,());
+	fragment->Reset();
 
-			if (model->Get_Flag(MeshModelClass::SORT)) {
-				new_mesh->Enable_Sort();
-			}
-			new_mesh->Set_Pass_Count(mtl_params.PassCount);
-			
-			bool has_textures = false;
-			for (ipass=0; ipass<model->Get_Pass_Count(); ipass++) {
-				if (model->Peek_Single_Material(ipass) != NULL) {
-					matinfo->Add_Vertex_Material(model->Peek_Single_Material(ipass));
+	SHATTER_DEBUG_SAY(("****************************************************\n"));
+	SHATTER_DEBUG_SAY((" Reassembling fragment %d\n",ipool));
+	SHATTER_DEBUG_SAY(("****************************************************\n"));
+
+	/*
+	** Add the polygons and vertices to the fragment, transform the vertices
+	** back into the original mesh's coordinate system as we do this
+	*/
+	for (ipoly=0; ipoly<ClipPools[ipool].Count(); ipoly++) {
+
+		PolygonClass & poly = ClipPools[ipool][ipoly];
+		fragment->FanSizes.Add((unsigned char)poly.Get_Vertex_Count());
+		fragment->PolygonCount += poly.Get_Vertex_Count() - 2;
+
+		for(ivert=0; ivert<poly.Get_Vertex_Count(); ivert++) {
+
+			Vector3 pos;
+			VertexClass & vert = poly[ivert];
+
+			Matrix3D::Transform_Vector(Mshatter_to_mesh,vert.Position,&pos);
+			fragment->Positions.Add(pos);
+			fragment->Normals.Add(vert.Normal);
+
+			for (ipass=0; ipass<mtl_params.PassCount; ipass++) {
+
+				unsigned mycolor=0;
+
+				/*
+				** If there were vertex colors for this pass in the original mesh, then
+				** copy the color out of the vertex into the new mesh.
+				*/
+				if (mtl_params.DCG[ipass] != NULL) {
+					mycolor=vert.DCG[ipass];
+				}
+
+				// HY- Multiplying DIG with DCG as in meshmdlio
+				if (mtl_params.DIG[ipass] != NULL) {
+					Vector4 mc=DX8Wrapper::Convert_Color(mycolor);
+					Vector4 dc=DX8Wrapper::Convert_Color(vert.DIG[ipass]);
+					mc=Vector4(mc.X*dc.X,mc.Y*dc.Y,mc.Z*dc.Z,mc.W);
+					mycolor=DX8Wrapper::Convert_Color(mc);
+				}
+
+				if ((mtl_params.DCG[ipass] != NULL) || (mtl_params.DIG[ipass] != NULL)) {
+					fragment->Colors[ipass].Add(mycolor);
 				}
-				for (int istage=0; istage<MeshMatDescClass::MAX_TEX_STAGES; istage++) {
-					if (model->Peek_Single_Texture(ipass,istage) != NULL) {
-						matinfo->Add_Texture(model->Peek_Single_Texture(ipass,istage));
-						has_textures = true;
+
+				/*
+				** If there were UV coordinates in the original mesh for either stage,
+				** then copy the vertex's uv's into into the new mesh.
+				*/
+				for (istage=0; istage<MeshMatDescClass::MAX_TEX_STAGES; istage++) {
+					if (mtl_params.UV[ipass][istage] != NULL) {
+						fragment->UVs[ipass][istage].Add(vert.TexCoord[ipass][istage]);
 					}
 				}
 			}
-			new_mesh->Set_Material_Info(matinfo);
-			
+		}
+	}
+
+	/*
+	** Offset all vertices so that the bounding box center is 0,0,0 and
+	** remember the offset for the transform of the mesh
+	*/
+	Vector3 min,max;
+	VectorProcessorClass::MinMax(&(fragment->Positions[0]),min,max,fragment->Positions.Count());
+	fragment->Center = (min + max) / 2.0f;
+
+	for (ivert=0; ivert<fragment->Positions.Count(); ivert++) {
+		fragment->Positions[ivert] -= fragment->Center;
+	}
+
+	SHATTER_DEBUG_SAY((" polycount = %d   vertexcount = %d\n",fragment->Get_Polygon_Count(),fragment->Get_Vertex_Count()));
+}
+
+DynamicMeshClass * ShatterSystem::Create_Fragment_Mesh
+(
+	const ShatterFragmentClass & fragment,
+	MeshClass * mesh,
+	MeshModelClass * model
+)
+{
+	int ipass,istage;
+
+	/*
+	** Create the new mesh, install materials
+	*/
+	DynamicMeshClass * new_mesh = NEW_REF(DynamicMeshClass,(fragment.Get_Polygon_Count(),fragment.Get_Vertex_Count()));
+	MaterialInfoClass * matinfo = NEW_REF(MaterialInfoClass,());
+
+	if (model->Get_Flag(MeshModelClass::SORT)) {
+		new_mesh->Enable_Sort();
+	}
+	new_mesh->Set_Pass_Count(model->Get_Pass_Count());
+
+	for (ipass=0; ipass<model->Get_Pass_Count(); ipass++) {
+		if (model->Peek_Single_Material(ipass) != NULL) {
+			matinfo->Add_Vertex_Material(model->Peek_Single_Material(ipass));
+		}
+		for (istage=0; istage<MeshMatDescClass::MAX_TEX_STAGES; istage++) {
+			if (model->Peek_Single_Texture(ipass,istage) != NULL) {
+				matinfo->Add_Texture(model->Peek_Single_Texture(ipass,istage));
+			}
+		}
+	}
+	new_mesh->Set_Material_Info(matinfo);
+
+	for (ipass=0; ipass<model->Get_Pass_Count(); ipass++) {
+		new_mesh->Set_Vertex_Material(model->Peek_Single_Material(ipass),false,ipass);
+		new_mesh->Set_Shader(model->Get_Single_Shader(ipass),ipass);
+
+		for (istage=0; istage<MeshMatDescClass::MAX_TEX_STAGES; istage++) {
+			TextureClass * tex = model->Peek_Single_Texture(ipass,istage);
+			if (tex != NULL) {
+				new_mesh->Peek_Model()->Set_Single_Texture(tex,ipass,istage);
+			}
+		}
+	}
+
+	REF_PTR_RELEASE(matinfo);
+
+	/*
+	** Add the triangle fans
+	*/
+	int vert_index = 0;
+	for (int ifan=0; ifan<fragment.FanSizes.Count(); ifan++) {
+
+		new_mesh->Begin_Tri_Fan();
+
+		for (int ivert=0; ivert<fragment.FanSizes[ifan]; ivert++) {
+
+			const Vector3 & pos = fragment.Positions[vert_index];
+			const Vector3 & norm = fragment.Normals[vert_index];
+
+			new_mesh->Begin_Vertex();
+			new_mesh->Location_Inline(pos.X,pos.Y,pos.Z);
+			new_mesh->Normal(norm.X,norm.Y,norm.Z);
+
 			for (ipass=0; ipass<model->Get_Pass_Count(); ipass++) {
-				new_mesh->Set_Vertex_Material(model->Peek_Single_Material(ipass),false,ipass);
-				new_mesh->Set_Shader(model->Get_Single_Shader(ipass),ipass);
-				
+
+				unsigned color = 0;
+				if (fragment.Colors[ipass].Count() > 0) {
+					color = fragment.Colors[ipass][vert_index];
+				}
+				new_mesh->Color(color);
+
+				#pragma MESSAGE("HY- Naty, will dynamesh support multiple stages of UV?")
 				for (istage=0; istage<MeshMatDescClass::MAX_TEX_STAGES; istage++) {
-					TextureClass * tex = model->Peek_Single_Texture(ipass,istage);	
-					if (tex != NULL) {
-						new_mesh->Peek_Model()->Set_Single_Texture(tex,ipass,istage);
+					if (fragment.UVs[ipass][istage].Count() > 0) {
+						const Vector2 & uv = fragment.UVs[ipass][istage][vert_index];
+						new_mesh->UV(uv.U,uv.V,istage);
 					}
 				}
 			}
-			
-			REF_PTR_RELEASE(matinfo);
 
+			new_mesh->End_Vertex();
+			vert_index++;
+		}
+		new_mesh->End_Tri_Fan();
+	}
 
-			/*
-			** Add the polygons and vertices to the mesh, transform the vertices
-			** back into the original mesh's coordinate system as we do this
-			*/
-			for (ipoly=0; ipoly<ClipPools[ipool].Count(); ipoly++) {
-				
-				PolygonClass & poly = ClipPools[ipool][ipoly];
-				
-				new_mesh->Begin_Tri_Fan();
-				SHATTER_DEBUG_SAY(("Begin Tri Fan\n"));
-
-				for(ivert=0; ivert<poly.Get_Vertex_Count(); ivert++) {
-
-					Vector3 pos,norm;
-					VertexClass & vert = poly[ivert];
-				
-					Matrix3D::Transform_Vector(Mshatter_to_mesh,vert.Position,&pos);
-					norm = vert.Normal;
-
-					SHATTER_DEBUG_SAY(("Begin Vertex:\n"));
-					new_mesh->Begin_Vertex();
-					SHATTER_DEBUG_SAY(("postion: %f %f %f\n",pos.X,pos.Y,pos.Z));
-					new_mesh->Location_Inline(pos);
-					new_mesh->Normal(norm);
-
-					for (ipass=0; ipass<mtl_params.PassCount; ipass++) {
-
-						unsigned mycolor=0;
-						
-						/*
-						** If there were vertex colors for this pass in the original mesh, then
-						** copy the color out of the vertex into the new mesh.
-						*/
-						if (mtl_params.DCG[ipass] != NULL) {
-							SHATTER_DEBUG_SAY(("DCG: pass:%d: %f %f %f\n",ipass,vert.DCG[ipass].X,vert.DCG[ipass].Y,vert.DCG[ipass].Z));
-							/* OLD CODE
-							new_mesh->DCG(Vector3(vert.DCG[ipass].X,vert.DCG[ipass].Y,vert.DCG[ipass].Z),ipass);
-							new_mesh->Alpha(vert.DCG[ipass].W,ipass);
-							*/
-							mycolor=vert.DCG[ipass];							
-						}
-						
-						// HY- Multiplying DIG with DCG as in meshmdlio
-						if (mtl_params.DIG[ipass] != NULL) {
-							SHATTER_DEBUG_SAY(("DIG: pass:%d: %f %f %f\n",ipass,vert.DIG[ipass].X,vert.DIG[ipass].Y,vert.DIG[ipass].Z));
-							Vector4 mc=DX8Wrapper::Convert_Color(mycolor);
-							Vector4 dc=DX8Wrapper::Convert_Color(vert.DIG[ipass]);
-							mc=Vector4(mc.X*dc.X,mc.Y*dc.Y,mc.Z*dc.Z,mc.W);
-							mycolor=DX8Wrapper::Convert_Color(mc);
-						}
-
-						new_mesh->Color(mycolor);
-
-						/*
-						** If there were UV coordinates in the original mesh for either stage,
-						** then copy the vertex's uv's into into the new mesh.
-						*/
-						#pragma MESSAGE("HY- Naty, will dynamesh support multiple stages of UV?")
-						for (istage=0; istage<MeshMatDescClass::MAX_TEX_STAGES; istage++) {
-							if (mtl_params.UV[ipass][istage] != NULL) {
-								SHATTER_DEBUG_SAY(("UV: pass:%d stage: %d: %f %f\n",ipass,istage,vert.TexCoord[ipass][istage].X,vert.TexCoord[ipass][istage].Y));
-								new_mesh->UV(vert.TexCoord[ipass][istage],istage);
-							}
-						}
-					}
+	/*
+	** The vertices are centered on the fragment, record its offset into the transform
+	*/
+	Matrix3D tm(1);
+	tm.Translate(fragment.Center);
+	Matrix3D::Multiply(tm,mesh->Get_Transform(),&tm);
+	new_mesh->Set_Transform(tm);
 
-					new_mesh->End_Vertex();
-			
-				}
-				new_mesh->End_Tri_Fan();
-			}
+	/*
+	** We gave it good vertex normals so clear their dirty flag
+	*/
+	new_mesh->Set_Dirty_Bounds();
+	new_mesh->Set_Dirty_Planes();
+	new_mesh->Clear_Dirty_Vertex_Normals();
 
-			/*
-			** Offset all vertices so that the bounding box center is 0,0,0 and
-			** record that offset into the transform of the mesh
-			*/
-			new_mesh->Set_Dirty_Bounds();
-			Vector3 center = new_mesh->Get_Bounding_Box().Center;
+	return new_mesh;
+}
 
-			new_mesh->Translate_Vertices(-center);
-			
-			Matrix3D tm(1);// = mesh->Get_Transform();
-			tm.Translate(center);
-			Matrix3D::Multiply(tm,mesh->Get_Transform(),&tm);
-			new_mesh->Set_Transform(tm);
-			
-			/*
-			** We gave it good vertex normals so clear their dirty flag
-			*/
-			new_mesh->Set_Dirty_Bounds();
-			new_mesh->Set_Dirty_Planes();
-			new_mesh->Clear_Dirty_Vertex_Normals();
+void ShatterSystem::Enable_Fragment_Cache(bool onoff)
+{
+	FragmentCacheEnabled = onoff;
+	if (FragmentCacheEnabled == false) {
+		Flush_Fragment_Cache();
+	}
+}
 
-			/*
-			** Install it in the mesh fragment pool, transferring our reference
-			** to the fragment array...
-			*/
-			MeshFragments.Add(new_mesh);
+bool ShatterSystem::Is_Fragment_Cache_Enabled(void)
+{
+	return FragmentCacheEnabled;
+}
+
+void ShatterSystem::Precache_Model(MeshModelClass * model)
+{
+	if ((model == NULL) || (ShatterPatterns.Count() == 0) || FragmentCache.Exists(model)) {
+		return;
+	}
+	if (!Can_Shatter(model)) {
+		return;
+	}
+
+	ShatterCacheEntryClass * entry = Build_Cache_Entry(model);
+	FragmentCache.Insert(model,entry);
+	FragmentCacheEntries.Add(entry);
+}
+
+void ShatterSystem::Precache_Render_Object(RenderObjClass * robj)
+{
+	if (robj == NULL) {
+		return;
+	}
+
+	if (robj->Class_ID() == RenderObjClass::CLASSID_MESH) {
+		MeshClass * mesh = (MeshClass *)robj;
+		if (mesh->Get_W3D_Flags() & W3D_MESH_FLAG_SHATTERABLE) {
+			MeshModelClass * model = mesh->Get_Model();
+			Precache_Model(model);
+			REF_PTR_RELEASE(model);
 		}
 	}
-	REF_PTR_RELEASE(model);
+
+	for (int i=0; i<robj->Get_Num_Sub_Objects(); i++) {
+		RenderObjClass * sub_obj = robj->Get_Sub_Object(i);
+		Precache_Render_Object(sub_obj);
+		REF_PTR_RELEASE(sub_obj);
+	}
+}
+
+void ShatterSystem::Flush_Fragment_Cache(void)
+{
+	for (int i=0; i<FragmentCacheEntries.Count(); i++) {
+		delete FragmentCacheEntries[i];
+		FragmentCacheEntries[i] = NULL;
+	}
+	FragmentCacheEntries.Delete_All();
+	FragmentCache.Remove_All();
+}
+
+int ShatterSystem::Get_Fragment_Cache_Model_Count(void)
+{
+	return FragmentCacheEntries.Count();
+}
+
+int ShatterSystem::Get_Fragment_Cache_Bytes(void)
+{
+	int bytes = 0;
+	for (int i=0; i<FragmentCacheEntries.Count(); i++) {
+		bytes += FragmentCacheEntries[i]->Get_Memory_Size();
+	}
+	return bytes;
+}
+
+ShatterCacheEntryClass * ShatterSystem::Build_Cache_Entry(MeshModelClass * model)
+{
+	WWPROFILE("ShatterSystem::Build_Cache_Entry");
+
+	/*
+	** The impact point isn't known ahead of time so the fragments are cut in a
+	** fixed shatter frame; centered on the model and looking down its thinnest
+	** axis, which for a pane of glass is the surface normal.
+	*/
+	AABoxClass box;
+	model->Get_Bounding_Box(&box);
+
+	Vector3 axis(1,0,0);
+	if ((box.Extent.Y < box.Extent.X) && (box.Extent.Y <= box.Extent.Z)) {
+		axis.Set(0,1,0);
+	} else if ((box.Extent.Z < box.Extent.X) && (box.Extent.Z < box.Extent.Y)) {
+		axis.Set(0,0,1);
+	}
+
+	Matrix3D Mshatter_to_obj;
+	Matrix3D Mobj_to_shatter;
+	Mshatter_to_obj.Look_At(box.Center,box.Center + axis,0.0f);
+	Mshatter_to_obj.Get_Orthogonal_Inverse(Mobj_to_shatter);
+	_apply_shatter_scale(model,Mobj_to_shatter,Mshatter_to_obj);
+
+	MeshMtlParamsClass mtl_params(model);
+	ShatterCacheEntryClass * entry = new ShatterCacheEntryClass(model);
+
+	/*
+	** Clip against each pattern and keep compact copies of the fragments
+	*/
+	for (int ipattern=0; ipattern<ShatterPatterns.Count(); ipattern++) {
+
+		entry->PatternStart.Add(entry->Fragments.Count());
+
+		Reset_Clip_Pools();
+		Clip_Model(model,ShatterPatterns[ipattern],Mobj_to_shatter,mtl_params);
+
+		for (int ipool=0; ipool<MAX_MESH_FRAGMENTS; ipool++) {
+			if (ClipPools[ipool].Count() > 0) {
+				ShatterFragmentClass * fragment = new ShatterFragmentClass;
+				Build_Fragment(ipool,Mshatter_to_obj,mtl_params,fragment);
+				fragment->Compact();
+				entry->Fragments.Add(fragment);
+			}
+		}
+	}
+	entry->PatternStart.Add(entry->Fragments.Count());
+	entry->Fragments.Resize(entry->Fragments.Count());
+	entry->PatternStart.Resize(entry->PatternStart.Count());
+
+	Reset_Clip_Pools();
+	return entry;
+}
+
+const ShatterSystem::StatisticsStruct & ShatterSystem::Get_Statistics(void)
+{
+	return Statistics;
+}
+
+void ShatterSystem::Reset_Statistics(void)
+{
+	Statistics.ShatterCount = 0;
+	Statistics.CachedShatterCount = 0;
+	Statistics.LastShatterTime = 0.0f;
+	Statistics.MaxShatterTime = 0.0f;
+	Statistics.TotalShatterTime = 0.0f;
 }
@@ -47,11 +47,16 @@
 
 
 class MeshClass;
+class MeshModelClass;
+class DynamicMeshClass;
 class PhysicsSceneClass;
 class RenderObjClass;
 class Vector3;
 class Matrix3D;
 class MeshMtlParamsClass;
+class BSPClass;
+class ShatterFragmentClass;
+class ShatterCacheEntryClass;
 
 
 /**
@@ -89,10 +94,52 @@ public:
 	static RenderObjClass *	Peek_Fragment(int fragment_index);
 	static void		Release_Fragments(void);
 
+	/*
+	** Fragment cache.  Clipping a mesh against a shatter pattern is expensive and
+	** happens right when the glass breaks.  When the cache is enabled, each shatterable
+	** model is clipped against every pattern once (at load time through the Precache
+	** functions, or the first time it shatters) and Shatter_Mesh just builds the 
+	** stored fragments.  Cached fragments are cut in a fixed frame centered on the
+	** model and facing along its thinnest axis rather than at the actual impact point.
+	** Precache_Render_Object precaches every mesh flagged as shatterable in the 
+	** given render object.  The cache holds a reference to each model so it has to be 
+	** flushed when the level is unloaded (the physics scene does this in Remove_All).
+	** Disabling the cache flushes it.
+	*/
+	static void		Enable_Fragment_Cache(bool onoff);
+	static bool		Is_Fragment_Cache_Enabled(void);
+	static void		Precache_Model(MeshModelClass * model);
+	static void		Precache_Render_Object(RenderObjClass * robj);
+	static void		Flush_Fragment_Cache(void);
+	static int		Get_Fragment_Cache_Model_Count(void);
+	static int		Get_Fragment_Cache_Bytes(void);
+
+	/*
+	** Timing of Shatter_Mesh, use this to measure the cost of breaking glass
+	** with and without the fragment cache.  Times are in seconds.
+	*/
+	struct StatisticsStruct
+	{
+		int				ShatterCount;				// meshes shattered since the last reset
+		int				CachedShatterCount;		// how many of those used cached fragments
+		float				LastShatterTime;
+		float				MaxShatterTime;
+		float				TotalShatterTime;
+	};
+
+	static const StatisticsStruct &	Get_Statistics(void);
+	static void		Reset_Statistics(void);
+
 protected:
 
+	static bool		Internal_Shatter_Mesh(MeshClass * mesh,const Vector3 & point,const Vector3 & direction);
+	static bool		Can_Shatter(MeshModelClass * model);
+	static void		Clip_Model(MeshModelClass * model,BSPClass * clipper,const Matrix3D & Mobj_to_shatter,MeshMtlParamsClass & mtl_params);
 	static void		Reset_Clip_Pools(void);
 	static void		Process_Clip_Pools(const Matrix3D &Mshatter_to_mesh,MeshClass * mesh,MeshMtlParamsClass & mtl_params);
+	static void		Build_Fragment(int pool_index,const Matrix3D & Mshatter_to_mesh,MeshMtlParamsClass & mtl_params,ShatterFragmentClass * fragment);
+	static DynamicMeshClass *	Create_Fragment_Mesh(const ShatterFragmentClass & fragment,MeshClass * mesh,MeshModelClass * model);
+	static ShatterCacheEntryClass *	Build_Cache_Entry(MeshModelClass * model);
 
 
 };
@@ -0,0 +1,812 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/***********************************************************************************************
+ ***              C O N F I D E N T I A L  ---  W E S T W O O D  S T U D I O S               ***
+ ***********************************************************************************************
+ *                                                                                             *
+ *                 Project Name : WWLib                                                        *
+ *                                                                                             *
+ *                     $Archive:: /Commando/Code/wwlib/asyncfileio.cpp                        $*
+ *                                                                                             *
+ *---------------------------------------------------------------------------------------------*
+ * Functions:                                                                                  *
+ *   AsyncReadClass::Add_Ref -- adds a reference to the read                                   *
+ *   AsyncReadClass::Release_Ref -- removes a reference, deleting the read with the last one   *
+ *   AsyncReadClass::Detach_Data -- takes ownership of the data                                *
+ *   AsyncReadClass::Cancel -- cancels the read                                                *
+ *   AsyncReadClass::Execute -- does the read                                                  *
+ *   AsyncFileIOClass::Init -- sets up the worker threads                                      *
+ *   AsyncFileIOClass::Start_Threads -- starts the worker threads                              *
+ *   AsyncFileIOClass::Shutdown -- stops the workers and cancels the outstanding reads         *
+ *   AsyncFileIOClass::Read_File -- queues a read of a whole file                              *
+ *   AsyncFileIOClass::Read_File -- queues a read of part of an open file                      *
+ *   AsyncFileIOClass::Wait -- blocks until a read is done                                     *
+ *   AsyncFileIOClass::Update -- calls the callbacks of finished main thread reads             *
+ *   AsyncFileIOClass::Process_Read -- does a read and hands it to its callback                *
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+#include "asyncfileio.h"
+#include "ffactory.h"
+#include "wwfile.h"
+#include "thread.h"
+#include "mutex.h"
+#include "vector.h"
+#include "wwdebug.h"
+
+#ifndef _UNIX
+#include <windows.h>
+#endif
+
+
+/*
+** Intrusive list of reads, one per priority for the reads waiting to be done and one for
+** the finished main thread reads.  Only used with _QueueLock held.
+*/
+class AsyncReadListClass
+{
+public:
+	AsyncReadListClass (void) : Head (NULL), Tail (NULL)	{ }
+
+	bool Is_Empty (void) const				{ return Head == NULL; }
+
+	void Push_Back (AsyncReadClass *read)
+	{
+		read->Prev = Tail;
+		read->Next = NULL;
+		read->List = this;
+		if (Tail != NULL) {
+			Tail->Next = read;
+		} else {
+			Head = read;
+		}
+		Tail = read;
+	}
+
+	void Remove (AsyncReadClass *read)
+	{
+		WWASSERT (read->List == this);
+		if (read->Prev != NULL) {
+			read->Prev->Next = read->Next;
+		} else {
+			Head = read->Next;
+		}
+		if (read->Next != NULL) {
+			read->Next->Prev = read->Prev;
+		} else {
+			Tail = read->Prev;
+		}
+		read->Prev = NULL;
+		read->Next = NULL;
+		read->List = NULL;
+	}
+
+	AsyncReadClass * Pop_Front (void)
+	{
+		AsyncReadClass *read = Head;
+		if (read != NULL) {
+			Remove (read);
+		}
+		return read;
+	}
+
+private:
+	AsyncReadClass *	Head;
+	AsyncReadClass *	Tail;
+};
+
+
+/*
+** Worker thread, waits for reads to be queued and does them.
+*/
+class AsyncIOThreadClass : public ThreadClass
+{
+public:
+	AsyncIOThreadClass (void) : ThreadClass ("Async file I/O thread")	{ }
+
+	void Thread_Function (void);
+};
+
+
+static FastCriticalSectionClass						_QueueLock;
+static AsyncReadListClass								_PendingQueue[AsyncReadClass::PRIORITY_COUNT];
+static AsyncReadListClass								_CompletedQueue;
+static int													_PendingCount = 0;
+static DynamicVectorClass<AsyncIOThreadClass *>	_ThreadList;
+static int													_ThreadCount = 0;
+static bool													_ThreadsStarted = false;
+
+#ifndef _UNIX
+static HANDLE												_WorkSemaphore = NULL;
+#endif
+
+
+static inline long Atomic_Increment (volatile long *value)
+{
+#ifdef _UNIX
+	return ++(*value);
+#else
+	return ::InterlockedIncrement ((long *)value);
+#endif
+}
+
+static inline long Atomic_Decrement (volatile long *value)
+{
+#ifdef _UNIX
+	return --(*value);
+#else
+	return ::InterlockedDecrement ((long *)value);
+#endif
+}
+
+static inline void Atomic_Set (volatile long *value, long new_value)
+{
+#ifdef _UNIX
+	*value = new_value;
+#else
+	::InterlockedExchange ((long *)value, new_value);
+#endif
+}
+
+
+/***********************************************************************************************
+ * AsyncReadClass::AsyncReadClass -- constructor                                               *
+ *=============================================================================================*/
+AsyncReadClass::AsyncReadClass (void) :
+	NumRefs (1),
+	State (STATE_PENDING),
+	IsCancelled (false),
+	IsDelivered (false),
+	Factory (NULL),
+	File (NULL),
+	Offset (0),
+	RequestSize (-1),
+	Data (NULL),
+	OwnsData (false),
+	Size (0),
+	Priority (PRIORITY_NORMAL),
+	Completion (COMPLETE_ON_MAIN_THREAD),
+	Callback (NULL),
+	UserData (NULL),
+	Prev (NULL),
+	Next (NULL),
+	List (NULL)
+{
+}
+
+
+/***********************************************************************************************
+ * AsyncReadClass::~AsyncReadClass -- destructor                                               *
+ *=============================================================================================*/
+AsyncReadClass::~AsyncReadClass (void)
+{
+	WWASSERT (List == NULL);
+	if (OwnsData) {
+		delete [] Data;
+	}
+	Data = NULL;
+}
+
+
+/***********************************************************************************************
+ * AsyncReadClass::Add_Ref -- adds a reference to the read                                     *
+ *                                                                                             *
+ * Reads are shared between the caller and the worker threads, so the count is changed with    *
+ * interlocked operations.                                                                     *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void AsyncReadClass::Add_Ref (void)
+{
+	Atomic_Increment (&NumRefs);
+}
+
+
+/***********************************************************************************************
+ * AsyncReadClass::Release_Ref -- removes a reference, deleting the read with the last one     *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void AsyncReadClass::Release_Ref (void)
+{
+	WWASSERT (NumRefs > 0);
+	if (Atomic_Decrement (&NumRefs) == 0) {
+		delete this;
+	}
+}
+
+
+/***********************************************************************************************
+ * AsyncReadClass::Detach_Data -- takes ownership of the data                                  *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ * the data, which the caller must now delete [] (if the read allocated it), or NULL if the    *
+ * read isn't done                                                                             *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+unsigned char * AsyncReadClass::Detach_Data (void)
+{
+	if (Is_Done () == false) {
+		return NULL;
+	}
+
+	unsigned char *data = Data;
+	Data = NULL;
+	OwnsData = false;
+	return data;
+}
+
+
+/***********************************************************************************************
+ * AsyncReadClass::Cancel -- cancels the read                                                  *
+ *                                                                                             *
+ * A read that is still queued is removed from the queue.  A read that is being done is left   *
+ * to finish, but its data is thrown away and its callback isn't called.                       *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ * true if the callback is guaranteed not to be called.  Main thread reads cancelled from      *
+ * the main thread always return true unless the callback has already been called.             *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+bool AsyncReadClass::Cancel (void)
+{
+	return AsyncFileIOClass::Cancel (this);
+}
+
+
+/***********************************************************************************************
+ * AsyncReadClass::Execute -- does the read                                                    *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void AsyncReadClass::Execute (void)
+{
+	Atomic_Set (&State, STATE_READING);
+	if (IsCancelled) {
+		Atomic_Set (&State, STATE_CANCELLED);
+		return ;
+	}
+
+	bool ok = false;
+	FileClass *file = File;
+	if (file == NULL && Factory != NULL) {
+		file = Factory->Get_File (Filename);
+	}
+
+	if (file != NULL && file->Is_Available ()) {
+		bool was_open = file->Is_Open ();
+		if (was_open || file->Open ()) {
+
+			int size = RequestSize;
+			if (size < 0) {
+				size = file->Size () - Offset;
+			}
+
+			if (size >= 0) {
+				if (Data == NULL) {
+					Data = new unsigned char[size];
+					OwnsData = true;
+				}
+				file->Seek (Offset, SEEK_SET);
+				Size = file->Read (Data, size);
+				ok = (Size == size);
+			}
+
+			if (was_open == false) {
+				file->Close ();
+			}
+		}
+	}
+
+	if (File == NULL && file != NULL) {
+		Factory->Return_File (file);
+	}
+
+	if (IsCancelled) {
+		if (OwnsData) {
+			delete [] Data;
+			Data = NULL;
+			OwnsData = false;
+		}
+		Atomic_Set (&State, STATE_CANCELLED);
+	} else {
+		Atomic_Set (&State, ok ? STATE_COMPLETE : STATE_FAILED);
+	}
+}
+
+
+/***********************************************************************************************
+ * AsyncIOThreadClass::Thread_Function -- worker loop                                          *
+ *=============================================================================================*/
+void AsyncIOThreadClass::Thread_Function (void)
+{
+#ifndef _UNIX
+	while (running) {
+
+		//
+		//	Wake up now and again to check for being stopped
+		//
+		if (::WaitForSingleObject (_WorkSemaphore, 100) != WAIT_OBJECT_0) {
+			continue;
+		}
+
+		AsyncReadClass *read = AsyncFileIOClass::Pop_Next_Read ();
+		if (read != NULL) {
+			AsyncFileIOClass::Process_Read (read);
+		}
+	}
+#endif
+}
+
+
+/***********************************************************************************************
+ * AsyncFileIOClass::Init -- sets up the worker threads                                        *
+ *                                                                                             *
+ * The threads aren't started until the first read is submitted.                               *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * thread_count - number of workers. Reads mostly wait on the disk, so a couple is plenty.     *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void AsyncFileIOClass::Init (int thread_count)
+{
+	WWASSERT (_ThreadList.Count () == 0);
+
+#ifndef _UNIX
+	_WorkSemaphore = ::CreateSemaphore (NULL, 0, 0x7FFFFFFF, NULL);
+	WWASSERT (_WorkSemaphore != NULL);
+	_ThreadCount = thread_count;
+#endif
+	_ThreadsStarted = false;
+}
+
+
+/***********************************************************************************************
+ * AsyncFileIOClass::Start_Threads -- starts the worker threads                                *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ * Only called once, by the Submit that set _ThreadsStarted.                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void AsyncFileIOClass::Start_Threads (void)
+{
+#ifndef _UNIX
+	for (int index = 0; index < _ThreadCount; index ++) {
+		AsyncIOThreadClass *thread = new AsyncIOThreadClass;
+		thread->Execute ();
+		_ThreadList.Add (thread);
+	}
+#endif
+}
+
+
+/***********************************************************************************************
+ * AsyncFileIOClass::Shutdown -- stops the workers and cancels the outstanding reads           *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ * The callbacks of reads that were still queued, or finished but not yet handed out by        *
+ * Update, are not called.                                                                     *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void AsyncFileIOClass::Shutdown (void)
+{
+	int index;
+	for (index = 0; index < _ThreadList.Count (); index ++) {
+		_ThreadList[index]->Stop ();
+		delete _ThreadList[index];
+	}
+	_ThreadList.Delete_All ();
+	_ThreadCount = 0;
+	_ThreadsStarted = false;
+
+#ifndef _UNIX
+	if (_WorkSemaphore != NULL) {
+		::CloseHandle (_WorkSemaphore);
+		_WorkSemaphore = NULL;
+	}
+#endif
+
+	//
+	//	Nothing else can touch the queues now
+	//
+	AsyncReadClass *read = NULL;
+	while ((read = Pop_Next_Read ()) != NULL) {
+		read->IsCancelled = true;
+		Atomic_Set (&read->State, AsyncReadClass::STATE_CANCELLED);
+		_PendingCount --;
+		read->Release_Ref ();
+	}
+
+	while ((read = _CompletedQueue.Pop_Front ()) != NULL) {
+		_PendingCount --;
+		read->Release_Ref ();
+	}
+}
+
+
+/***********************************************************************************************
+ * AsyncFileIOClass::Read_File -- queues a read of a whole file                                *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * filename - file to read, opened through the factory                                         *
+ * callback - called when the read is done (whether it worked or not), or NULL                 *
+ * user_data - passed to the callback                                                          *
+ * priority - reads are done highest priority first                                            *
+ * completion - which thread the callback is called on                                         *
+ * factory - factory to open the file with, NULL for _TheFileFactory                           *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ * the read, with a reference for the caller                                                   *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+AsyncReadClass * AsyncFileIOClass::Read_File
+(
+	const char *							filename,
+	AsyncReadClass::CallbackType		callback,
+	void *									user_data,
+	AsyncReadClass::PriorityType		priority,
+	AsyncReadClass::CompletionType	completion,
+	FileFactoryClass *					factory
+)
+{
+	AsyncReadClass *read = new AsyncReadClass;
+	read->Filename		= filename;
+	read->Factory		= (factory != NULL) ? factory : _TheFileFactory;
+	read->Priority		= priority;
+	read->Completion	= completion;
+	read->Callback		= callback;
+	read->UserData		= user_data;
+	return Submit (read);
+}
+
+
+/***********************************************************************************************
+ * AsyncFileIOClass::Read_File -- queues a read of part of an open file                        *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * file - the file to read, which the caller keeps and must not use until the read is done     *
+ * offset - where to start reading                                                             *
+ * size - bytes to read, -1 to read to the end of the file                                     *
+ * buffer - where to read to (at least size bytes), NULL to allocate a buffer                  *
+ * the rest are as for the other Read_File                                                     *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ * the read, with a reference for the caller                                                   *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+AsyncReadClass * AsyncFileIOClass::Read_File
+(
+	FileClass *								file,
+	int										offset,
+	int										size,
+	void *									buffer,
+	AsyncReadClass::CallbackType		callback,
+	void *									user_data,
+	AsyncReadClass::PriorityType		priority,
+	AsyncReadClass::CompletionType	completion
+)
+{
+	WWASSERT (file != NULL);
+	WWASSERT (buffer == NULL || size >= 0);
+
+	AsyncReadClass *read = new AsyncReadClass;
+	read->Filename		= file->File_Name ();
+	read->File			= file;
+	read->Offset		= offset;
+	read->RequestSize	= size;
+	read->Data			= (unsigned char *)buffer;
+	read->Priority		= priority;
+	read->Completion	= completion;
+	read->Callback		= callback;
+	read->UserData		= user_data;
+	return Submit (read);
+}
+
+
+/*
+**	Queues the read.  The service keeps the reference the read was made with, and the
+** caller gets a new one.
+*/
+AsyncReadClass * AsyncFileIOClass::Submit (AsyncReadClass *read)
+{
+	read->Add_Ref ();
+
+	bool start_threads = false;
+	{
+		FastCriticalSectionClass::LockClass lock (_QueueLock);
+		_PendingQueue[read->Priority].Push_Back (read);
+		_PendingCount ++;
+
+		if (_ThreadsStarted == false && _ThreadCount > 0) {
+			_ThreadsStarted = true;
+			start_threads = true;
+		}
+	}
+
+	if (start_threads) {
+		Start_Threads ();
+	}
+
+#ifndef _UNIX
+	if (_WorkSemaphore != NULL) {
+		::ReleaseSemaphore (_WorkSemaphore, 1, NULL);
+	}
+#endif
+
+	return read;
+}
+
+
+/*
+**	Takes the next read to do off the queues, highest priority first.
+*/
+AsyncReadClass * AsyncFileIOClass::Pop_Next_Read (void)
+{
+	FastCriticalSectionClass::LockClass lock (_QueueLock);
+
+	for (int priority = AsyncReadClass::PRIORITY_COUNT - 1; priority >= 0; priority --) {
+		if (_PendingQueue[priority].Is_Empty () == false) {
+			return _PendingQueue[priority].Pop_Front ();
+		}
+	}
+
+	return NULL;
+}
+
+
+/***********************************************************************************************
+ * AsyncFileIOClass::Process_Read -- does a read and hands it to its callback                  *
+ *                                                                                             *
+ * Worker thread reads call their callback here; main thread reads go onto the completed       *
+ * queue for Update.                                                                           *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * read - a read that has been taken off the queues                                            *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void AsyncFileIOClass::Process_Read (AsyncReadClass *read)
+{
+	read->Execute ();
+
+	if (read->Completion == AsyncReadClass::COMPLETE_ON_MAIN_THREAD) {
+		FastCriticalSectionClass::LockClass lock (_QueueLock);
+		if (read->IsCancelled == false) {
+			_CompletedQueue.Push_Back (read);
+			return ;
+		}
+	}
+
+	if (read->IsCancelled == false && read->Callback != NULL) {
+		read->IsDelivered = true;
+		read->Callback (read, read->UserData);
+	}
+
+	{
+		FastCriticalSectionClass::LockClass lock (_QueueLock);
+		_PendingCount --;
+	}
+	read->Release_Ref ();
+}
+
+
+/*
+**	See AsyncReadClass::Cancel.
+*/
+bool AsyncFileIOClass::Cancel (AsyncReadClass *read)
+{
+	bool release = false;
+	bool retval = false;
+
+	{
+		FastCriticalSectionClass::LockClass lock (_QueueLock);
+
+		if (read->IsDelivered) {
+			return false;
+		}
+		read->IsCancelled = true;
+
+		if (read->List == &_CompletedQueue) {
+
+			//
+			//	Finished but not handed out yet, throw the data away
+			//
+			_CompletedQueue.Remove (read);
+			if (read->OwnsData) {
+				delete [] read->Data;
+				read->Data = NULL;
+				read->OwnsData = false;
+			}
+			Atomic_Set (&read->State, AsyncReadClass::STATE_CANCELLED);
+			_PendingCount --;
+			release = true;
+			retval = true;
+
+		} else if (read->List != NULL) {
+
+			//
+			//	Still waiting to be done
+			//
+			((AsyncReadListClass *)read->List)->Remove (read);
+			Atomic_Set (&read->State, AsyncReadClass::STATE_CANCELLED);
+			_PendingCount --;
+			release = true;
+			retval = true;
+
+		} else {
+
+			//
+			//	Being read right now, the worker will see the flag.  A worker thread callback
+			// may already be on its way.
+			//
+			retval = (read->Completion == AsyncReadClass::COMPLETE_ON_MAIN_THREAD);
+		}
+	}
+
+	if (release) {
+		read->Release_Ref ();
+	}
+	return retval;
+}
+
+
+/***********************************************************************************************
+ * AsyncFileIOClass::Wait -- blocks until a read is done                                       *
+ *                                                                                             *
+ * A read that is still queued is taken off the queue and done on this thread rather than      *
+ * waiting behind the other reads.  The callback of a main thread read is still called from    *
+ * Update.                                                                                     *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * read - the read to wait for                                                                 *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void AsyncFileIOClass::Wait (AsyncReadClass *read)
+{
+	bool do_it_here = false;
+
+	{
+		FastCriticalSectionClass::LockClass lock (_QueueLock);
+		if (read->State == AsyncReadClass::STATE_PENDING && read->List != NULL && read->List != &_CompletedQueue) {
+			((AsyncReadListClass *)read->List)->Remove (read);
+			do_it_here = true;
+		}
+	}
+
+	if (do_it_here) {
+		Process_Read (read);
+	}
+
+	while (read->Is_Done () == false) {
+		ThreadClass::Switch_Thread ();
+	}
+}
+
+
+/***********************************************************************************************
+ * AsyncFileIOClass::Update -- calls the callbacks of finished main thread reads               *
+ *                                                                                             *
+ * Call once a frame from the main loop.  Without worker threads this also does the reads      *
+ * that are waiting.                                                                           *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void AsyncFileIOClass::Update (void)
+{
+	AsyncReadClass *read = NULL;
+
+	if (_ThreadCount == 0) {
+		while ((read = Pop_Next_Read ()) != NULL) {
+			Process_Read (read);
+		}
+	}
+
+	for (;;) {
+		{
+			FastCriticalSectionClass::LockClass lock (_QueueLock);
+			read = _CompletedQueue.Pop_Front ();
+			if (read == NULL) {
+				break;
+			}
+			read->IsDelivered = true;
+			_PendingCount --;
+		}
+
+		//
+		//	The lock is released for the callback, so it can queue more reads
+		//
+		if (read->Callback != NULL) {
+			read->Callback (read, read->UserData);
+		}
+		read->Release_Ref ();
+	}
+}
+
+
+/***********************************************************************************************
+ * AsyncFileIOClass::Get_Pending_Count -- number of reads not yet handed to their callbacks    *
+ *=============================================================================================*/
+int AsyncFileIOClass::Get_Pending_Count (void)
+{
+	FastCriticalSectionClass::LockClass lock (_QueueLock);
+	return _PendingCount;
+}
@@ -0,0 +1,206 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/***********************************************************************************************
+ ***              C O N F I D E N T I A L  ---  W E S T W O O D  S T U D I O S               ***
+ ***********************************************************************************************
+ *                                                                                             *
+ *                 Project Name : WWLib                                                        *
+ *                                                                                             *
+ *                     $Archive:: /Commando/Code/wwlib/asyncfileio.h                          $*
+ *                                                                                             *
+ *---------------------------------------------------------------------------------------------*
+ * Functions:                                                                                  *
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#ifndef ASYNCFILEIO_H
+#define ASYNCFILEIO_H
+
+#include "always.h"
+#include "wwstring.h"
+
+class FileClass;
+class FileFactoryClass;
+
+
+/**********************************************************************************************
+** AsyncReadClass
+**
+** One read submitted to AsyncFileIOClass.  The read is reference counted: the caller gets
+** a reference from Read_File and must Release_Ref it when done with it (straight away, if
+** only the callback is of interest).  The data is valid once Is_Done returns true and
+** Succeeded is true; it belongs to the read unless it was read into a caller's buffer or
+** taken with Detach_Data.
+**
+**********************************************************************************************/
+class AsyncReadClass
+{
+public:
+
+	enum StateType
+	{
+		STATE_PENDING = 0,		// waiting in the queue
+		STATE_READING,				// being read by a worker
+		STATE_COMPLETE,			// all the data was read
+		STATE_FAILED,				// the file couldn't be opened, or was short
+		STATE_CANCELLED,
+	};
+
+	enum PriorityType
+	{
+		PRIORITY_LOW = 0,			// streaming ahead, prefetching
+		PRIORITY_NORMAL,
+		PRIORITY_HIGH,				// something is waiting on it
+		PRIORITY_COUNT
+	};
+
+	enum CompletionType
+	{
+		COMPLETE_ON_MAIN_THREAD = 0,	// the callback is called from AsyncFileIOClass::Update
+		COMPLETE_ON_WORKER,				// the callback is called on the thread that did the read
+	};
+
+	typedef void (*CallbackType) (AsyncReadClass *read, void *user_data);
+
+	void					Add_Ref (void);
+	void					Release_Ref (void);
+
+	StateType			Get_State (void) const			{ return (StateType)State; }
+	bool					Is_Done (void) const				{ return State >= STATE_COMPLETE; }
+	bool					Succeeded (void) const			{ return State == STATE_COMPLETE; }
+
+	const char *		Get_Filename (void) const		{ return Filename; }
+	PriorityType		Get_Priority (void) const		{ return Priority; }
+	void *				Get_User_Data (void) const		{ return UserData; }
+
+	unsigned char *	Peek_Data (void) const			{ return Data; }
+	int					Get_Size (void) const			{ return Size; }
+	unsigned char *	Detach_Data (void);
+
+	//	Returns true if the callback is guaranteed not to be called.
+	bool					Cancel (void);
+
+protected:
+
+	AsyncReadClass (void);
+	~AsyncReadClass (void);
+
+	void					Execute (void);
+
+	volatile long		NumRefs;
+	volatile long		State;
+	volatile bool		IsCancelled;
+	bool					IsDelivered;			// the callback has been called
+
+	StringClass			Filename;
+	FileFactoryClass *	Factory;
+	FileClass *			File;						// the caller's file, or NULL to open Filename
+	int					Offset;
+	int					RequestSize;			// -1 reads to the end of the file
+
+	unsigned char *	Data;
+	bool					OwnsData;
+	int					Size;						// bytes actually read
+
+	PriorityType		Priority;
+	CompletionType		Completion;
+	CallbackType		Callback;
+	void *				UserData;
+
+	//	Queue links, protected by the service's lock
+	AsyncReadClass *	Prev;
+	AsyncReadClass *	Next;
+	void *				List;
+
+	friend class AsyncFileIOClass;
+	friend class AsyncReadListClass;
+};
+
+
+/**********************************************************************************************
+** AsyncFileIOClass
+**
+** A shared service that reads files on a pool of worker threads, so that level loads,
+** texture loads and streamed audio don't each have to block or run their own thread.
+** Reads are taken highest priority first, in the order they were submitted.  A read can
+** be of a whole file opened through a file factory (so mix file contents work the same as
+** loose files) or of part of a file the caller already has.
+**
+** Callbacks for COMPLETE_ON_MAIN_THREAD reads are called from Update, which the main loop
+** calls once a frame.  Without worker threads (Init not called, or a build with no thread
+** support) the reads are done on the calling thread, in Update or Wait.  The workers are
+** started by the first read, so a game that never reads through the service doesn't pay
+** for idle threads.
+**
+** The workers open files through the factory, so the factory must be safe to use from
+** another thread (FileFactoryListClass and SimpleFileFactoryClass lock).  A factory, or a
+** mix file in the factory list, mustn't be removed while reads through it are outstanding.
+**
+**********************************************************************************************/
+class AsyncFileIOClass
+{
+public:
+
+	static void					Init (int thread_count = 2);
+	static void					Shutdown (void);
+
+	//	Read a whole file through a file factory (_TheFileFactory if NULL).
+	static AsyncReadClass *	Read_File (	const char *filename,
+													AsyncReadClass::CallbackType callback = NULL,
+													void *user_data = NULL,
+													AsyncReadClass::PriorityType priority = AsyncReadClass::PRIORITY_NORMAL,
+													AsyncReadClass::CompletionType completion = AsyncReadClass::COMPLETE_ON_MAIN_THREAD,
+													FileFactoryClass *factory = NULL);
+
+	//	Read part of a file the caller has. The caller must not use the file until the read
+	// is done. A size of -1 reads to the end of the file, a NULL buffer allocates one.
+	static AsyncReadClass *	Read_File (	FileClass *file,
+													int offset,
+													int size,
+													void *buffer,
+													AsyncReadClass::CallbackType callback = NULL,
+													void *user_data = NULL,
+													AsyncReadClass::PriorityType priority = AsyncReadClass::PRIORITY_NORMAL,
+													AsyncReadClass::CompletionType completion = AsyncReadClass::COMPLETE_ON_MAIN_THREAD);
+
+	//	Blocks until the read is done. A read still in the queue is done on the calling thread.
+	static void					Wait (AsyncReadClass *read);
+
+	//	Calls the callbacks of finished main thread reads.
+	static void					Update (void);
+
+	static int					Get_Pending_Count (void);
+
+protected:
+
+	static AsyncReadClass *	Submit (AsyncReadClass *read);
+	static void					Start_Threads (void);
+	static AsyncReadClass *	Pop_Next_Read (void);
+	static void					Process_Read (AsyncReadClass *read);
+	static bool					Cancel (AsyncReadClass *read);
+
+	friend class AsyncReadClass;
+	friend class AsyncIOThreadClass;
+};
+
+
+#endif // ASYNCFILEIO_H
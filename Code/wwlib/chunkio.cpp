@@ -45,6 +45,8 @@
  *   ChunkSaveClass::Write -- write an IOQuaternionStruct                                      *
  *   ChunkSaveClass::Cur_Chunk_Depth -- returns the current chunk recursion depth (debugging)  * 
  *   ChunkLoadClass::ChunkLoadClass -- Constructor                                             * 
+ *   ChunkLoadClass::ChunkLoadClass -- Constructor for parsing a block of memory               *
+ *   ChunkLoadClass::~ChunkLoadClass -- Destructor                                             *
  *   ChunkLoadClass::Open_Chunk -- Open a chunk in the file, reads in the chunk header         * 
  *   ChunkLoadClass::Peek_Next_Chunk -- sneak peek into the next chunk that will be opened     *
  *   ChunkLoadClass::Close_Chunk -- Close a chunk, seeks to the end if needed                  * 
@@ -61,6 +63,9 @@
  *   ChunkLoadClass::Read -- read an IOVector3Struct                                           *
  *   ChunkLoadClass::Read -- read an IOVector4Struct                                           *
  *   ChunkLoadClass::Read -- read an IOQuaternionStruct                                        *
+ *   ChunkLoadClass::Read_Span -- returns a pointer to the next bytes in the chunk             *
+ *   ChunkLoadClass::Read_Bytes -- reads from the memory or the file                           *
+ *   ChunkLoadClass::Skip_Bytes -- skips over bytes in the memory or the file                  *
  * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
 
 #include "chunkio.h"
@@ -388,6 +393,11 @@ int ChunkSaveClass::Cur_Chunk_Depth(void)
  *=============================================================================================*/
 ChunkLoadClass::ChunkLoadClass(FileClass * file) :
 	File(file),
+	Buffer(NULL),
+	BufferSize(0),
+	BufferPos(0),
+	SpanBuffer(NULL),
+	SpanBufferSize(0),
 	StackIndex(0),
 	InMicroChunk(false),
 	MicroChunkPosition(0)
@@ -395,6 +405,69 @@ ChunkLoadClass::ChunkLoadClass(FileClass * file) :
 	memset(PositionStack,0,sizeof(PositionStack));
 	memset(HeaderStack,0,sizeof(HeaderStack));
 	memset(&MCHeader,0,sizeof(MCHeader));
+
+	/*
+	** If the file's contents are already in memory, parse them from there
+	*/
+	if ((File != NULL) && File->Is_Open() && (File->Peek_Data() != NULL)) {
+		Buffer = (const uint8 *)File->Peek_Data();
+		BufferSize = File->Size();
+		BufferPos = File->Tell();
+		if (BufferPos > BufferSize) {
+			BufferPos = BufferSize;
+		}
+	}
+}
+
+
+/***********************************************************************************************
+ * ChunkLoadClass::ChunkLoadClass -- Constructor for parsing a block of memory                 *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * buffer - the chunk data, which must stay valid for the life of the loader                   *
+ * size - size of the data                                                                     *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+ChunkLoadClass::ChunkLoadClass(const void * buffer, uint32 size) :
+	File(NULL),
+	Buffer((const uint8 *)buffer),
+	BufferSize(size),
+	BufferPos(0),
+	SpanBuffer(NULL),
+	SpanBufferSize(0),
+	StackIndex(0),
+	InMicroChunk(false),
+	MicroChunkPosition(0)
+{
+	assert(buffer != NULL);
+	memset(PositionStack,0,sizeof(PositionStack));
+	memset(HeaderStack,0,sizeof(HeaderStack));
+	memset(&MCHeader,0,sizeof(MCHeader));
+}
+
+
+/***********************************************************************************************
+ * ChunkLoadClass::~ChunkLoadClass -- Destructor                                               *
+ *                                                                                             *
+ * The file is not touched, it is often closed before the loader goes out of scope.            *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+ChunkLoadClass::~ChunkLoadClass(void)
+{
+	delete [] SpanBuffer;
+	SpanBuffer = NULL;
 }
 
 
@@ -424,7 +497,7 @@ bool ChunkLoadClass::Open_Chunk()
 	}
 
 	// read the chunk header
-	if (File->Read(&HeaderStack[StackIndex],sizeof(ChunkHeader)) != sizeof(ChunkHeader)) {
+	if (!Read_Bytes(&HeaderStack[StackIndex],sizeof(ChunkHeader))) {
 		return false;
 	}
 
@@ -461,12 +534,19 @@ bool ChunkLoadClass::Peek_Next_Chunk(uint32 * set_id,uint32 * set_size)
 
 	// peek at the next chunk header, return false if the read fails
 	ChunkHeader temp_header;
-	if (File->Read(&temp_header,sizeof(ChunkHeader)) != sizeof(ChunkHeader)) {
-		return false;
-	}
+	if (Buffer != NULL) {
+		if (BufferSize - BufferPos < sizeof(ChunkHeader)) {
+			return false;
+		}
+		memcpy(&temp_header,Buffer + BufferPos,sizeof(ChunkHeader));
+	} else {
+		if (File->Read(&temp_header,sizeof(ChunkHeader)) != sizeof(ChunkHeader)) {
+			return false;
+		}
 
-	int seek_offset = sizeof(ChunkHeader);
-	File->Seek(-seek_offset,SEEK_CUR);
+		int seek_offset = sizeof(ChunkHeader);
+		File->Seek(-seek_offset,SEEK_CUR);
+	}
 	
 	if (set_id != NULL) {
 		*set_id = temp_header.Get_Type();
@@ -502,7 +582,7 @@ bool ChunkLoadClass::Close_Chunk()
 	int pos = PositionStack[StackIndex-1];
 	
 	if (pos < csize) {
-		File->Seek(csize - pos,SEEK_CUR);
+		Skip_Bytes(csize - pos);
 	}
 
 	StackIndex--;
@@ -638,7 +718,7 @@ bool ChunkLoadClass::Close_Micro_Chunk()
 	// seek the file past this micro chunk 
 	if (pos < csize) {
 
-		File->Seek(csize - pos,SEEK_CUR);
+		Skip_Bytes(csize - pos);
 		
 		// update the tracking variables for where we are in the normal chunk.
 		if (StackIndex > 0) {
@@ -706,9 +786,15 @@ uint32 ChunkLoadClass::Seek(uint32 nbytes)
 		return 0;
 	}
 	
-	uint32 curpos=File->Tell();
-	if (File->Seek(nbytes,SEEK_CUR)-curpos != (int)nbytes) {
-		return 0;
+	if (Buffer != NULL) {
+		if (!Skip_Bytes(nbytes)) {
+			return 0;
+		}
+	} else {
+		uint32 curpos=File->Tell();
+		if (File->Seek(nbytes,SEEK_CUR)-curpos != (int)nbytes) {
+			return 0;
+		}
 	}
 
 	// Update our position in the chunk
@@ -748,7 +834,7 @@ uint32 ChunkLoadClass::Read(void * buf,uint32 nbytes)
 		return 0;
 	}
 	
-	if (File->Read(buf,nbytes) != (int)nbytes) {
+	if (!Read_Bytes(buf,nbytes)) {
 		return 0;
 	}
 
@@ -839,3 +925,129 @@ uint32 ChunkLoadClass::Read(IOQuaternionStruct * q)
 	return Read(q,sizeof(q));
 }
 
+
+/***********************************************************************************************
+ * ChunkLoadClass::Read_Span -- returns a pointer to the next bytes in the chunk               *
+ *                                                                                             *
+ * Lets the chunk payload (vertex arrays, polygon lists...) be parsed where it is rather than  *
+ * being copied into a temporary buffer first.                                                 *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * nbytes - number of bytes to read                                                            *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ * pointer to the bytes, or NULL if they go past the end of the chunk or micro chunk           *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ * When the loader is reading through File->Read the bytes are copied into a buffer owned by   *
+ * the loader, which the next call to Read_Span overwrites.                                    *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+const void * ChunkLoadClass::Read_Span(uint32 nbytes)
+{
+	assert(StackIndex >= 1);
+
+	// Don't read if we would go past the end of the current chunk
+	if (PositionStack[StackIndex-1] + nbytes > (int)HeaderStack[StackIndex-1].Get_Size()) {
+		return NULL;
+	}
+
+	// Don't read if we are in a micro chunk and would go past the end of it
+	if (InMicroChunk && MicroChunkPosition + nbytes > MCHeader.Get_Size()) {
+		return NULL;
+	}
+
+	const void * span = NULL;
+	if (Buffer != NULL) {
+
+		span = Buffer + BufferPos;
+		if (!Skip_Bytes(nbytes)) {
+			return NULL;
+		}
+
+	} else {
+
+		if ((SpanBuffer == NULL) || (nbytes > SpanBufferSize)) {
+			delete [] SpanBuffer;
+			SpanBuffer = new uint8[nbytes + 1];		// so that empty spans aren't NULL
+			SpanBufferSize = nbytes;
+		}
+
+		span = SpanBuffer;
+		if (!Read_Bytes(SpanBuffer,nbytes)) {
+			return NULL;
+		}
+	}
+
+	// Update our position in the chunk
+	PositionStack[StackIndex-1] += nbytes;
+
+	// Update our position in the micro chunk if we are in one
+	if (InMicroChunk) {
+		MicroChunkPosition += nbytes;
+	}
+
+	return span;
+}
+
+
+/***********************************************************************************************
+ * ChunkLoadClass::Read_Bytes -- reads from the memory or the file                             *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ * true if all the bytes were read                                                             *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+bool ChunkLoadClass::Read_Bytes(void * buf,uint32 nbytes)
+{
+	if (Buffer == NULL) {
+		return (File->Read(buf,nbytes) == (int)nbytes);
+	}
+
+	if (nbytes > BufferSize - BufferPos) {
+		return false;
+	}
+
+	memcpy(buf,Buffer + BufferPos,nbytes);
+	return Skip_Bytes(nbytes);
+}
+
+
+/***********************************************************************************************
+ * ChunkLoadClass::Skip_Bytes -- skips over bytes in the memory or the file                    *
+ *                                                                                             *
+ * When parsing a file's memory the file position is moved too, it's just a few assignments    *
+ * for the files that have their contents in memory.                                           *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ * true if the bytes were skipped, files are not checked                                      *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+bool ChunkLoadClass::Skip_Bytes(uint32 nbytes)
+{
+	if (Buffer == NULL) {
+		File->Seek(nbytes,SEEK_CUR);
+		return true;
+	}
+
+	if (nbytes > BufferSize - BufferPos) {
+		return false;
+	}
+
+	BufferPos += nbytes;
+	if (File != NULL) {
+		File->Seek(BufferPos,SEEK_SET);
+	}
+	return true;
+}
@@ -178,12 +178,21 @@ private:
 ** wrap an instance of one of these objects around an opened file
 ** to easily parse the chunks in the file
 **
+** The loader can also parse a block of memory.  Files that have their contents in
+** memory already (RAM files, views into memory mapped mix files; see
+** FileClass::Peek_Data) are parsed straight from that memory rather than through
+** File->Read, with the file position kept in step so the file can still be used
+** afterwards.  Read_Span gives a pointer to the next bytes of the chunk without
+** copying them when the loader is reading memory.
+**
 **************************************************************************************/
 class ChunkLoadClass
 {
 public:
 
 	ChunkLoadClass(FileClass * file);
+	ChunkLoadClass(const void * buffer, uint32 size);
+	~ChunkLoadClass();
 
 	// Chunk methods
 	bool					Open_Chunk();
@@ -209,16 +218,45 @@ public:
 	// Seek over a block of bytes in the stream (same as Read but don't copy the data to a buffer)
 	uint32				Seek(uint32 nbytes);
 
+	// Read a block of bytes without copying it.  Returns NULL under the same conditions
+	// as Read returns 0.  The pointer is into the loader's memory if it has any, and
+	// stays valid as long as that memory does; otherwise it is a copy that is only valid
+	// until the next call.  The data is not aligned.
+	const void *		Read_Span(uint32 nbytes);
+
+	// Read_Span of count elements.  Returns NULL for a count whose size in bytes doesn't
+	// fit in 32 bits, so a corrupt count can't wrap to a small read.
+	template <class T>
+	const T *			Read_Array(uint32 count)		{ return (count > 0xFFFFFFFF / sizeof(T)) ? NULL : (const T *)Read_Span(count * sizeof(T)); }
+
+	// True if the loader is parsing memory rather than reading through File->Read
+	bool					Is_Memory_Backed() const		{ return Buffer != NULL; }
+
 	// Sneak peek at the next chunk that will be opened.  Beware, if you need
 	// this, then you are probably hacking so be careful!
 	bool					Peek_Next_Chunk(uint32 * set_id,uint32 * set_size);
 
 private:
 
+	ChunkLoadClass(const ChunkLoadClass &);
+	ChunkLoadClass & operator = (const ChunkLoadClass &);
+
+	bool					Read_Bytes(void * buf, uint32 nbytes);
+	bool					Skip_Bytes(uint32 nbytes);
+
 	enum { MAX_STACK_DEPTH = 256 };
 
 	FileClass *			File;
 
+	// Memory reading support, Buffer is NULL when reading through File->Read
+	const uint8 *		Buffer;
+	uint32				BufferSize;
+	uint32				BufferPos;
+
+	// Copy returned by Read_Span when there is no memory to point into
+	uint8 *				SpanBuffer;
+	uint32				SpanBufferSize;
+
 	// Chunk reading support
 	int					StackIndex;
 	uint32				PositionStack[MAX_STACK_DEPTH];
@@ -381,4 +419,4 @@ private:
 
 
 
-#endif CHUNKIO_H
\ No newline at end of file
+#endif CHUNKIO_H
\ No newline at end of file
@@ -0,0 +1,480 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/***********************************************************************************************
+ ***              C O N F I D E N T I A L  ---  W E S T W O O D  S T U D I O S               ***
+ ***********************************************************************************************
+ *                                                                                             *
+ *                 Project Name : WWLib                                                        *
+ *                                                                                             *
+ *                     $Archive:: /Commando/Code/wwlib/compressedfile.cpp                     $*
+ *                                                                                             *
+ *---------------------------------------------------------------------------------------------*
+ * Functions:                                                                                  *
+ *   CompressedFileClass::CompressedFileClass -- Constructs a file over compressed data.       *
+ *   CompressedFileClass::~CompressedFileClass -- Destructor for the compressed file.          *
+ *   CompressedFileClass::Set_Name -- Sets the name reported by File_Name.                     *
+ *   CompressedFileClass::Is_Available -- Checks that the compressed data is there.            *
+ *   CompressedFileClass::Open -- Opens the file for reading.                                  *
+ *   CompressedFileClass::Close -- Closes the file.                                            *
+ *   CompressedFileClass::Read -- Decompresses data out of the file.                           *
+ *   CompressedFileClass::Seek -- Moves the read position.                                     *
+ *   CompressedFileClass::Bias -- Restricts the file to a part of itself.                      *
+ *   CompressedFileClass::Load_Block_Table -- Reads and checks the block offsets.              *
+ *   CompressedFileClass::Load_Block -- Decompresses one block.                                *
+ *   CompressedFileClass::Block_Length -- Returns the uncompressed size of a block.            *
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+#include "compressedfile.h"
+#include "ffactory.h"
+#include "lzo.h"
+#include "wwdebug.h"
+#include <string.h>
+
+
+/***********************************************************************************************
+ * CompressedFileClass::CompressedFileClass -- Constructs a file over compressed data.         *
+ *                                                                                             *
+ * INPUT:   source         -- The file holding the block table and the compressed blocks.      *
+ *                                                                                             *
+ *          source_factory -- The factory to return the source to, or NULL to delete it.       *
+ *                                                                                             *
+ *          size           -- The size of the file once it is uncompressed.                    *
+ *                                                                                             *
+ *          block_size     -- The uncompressed size of each block.                             *
+ *                                                                                             *
+ *          filename       -- The name reported by File_Name, or NULL.                         *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   The file owns the source from here on.                                          *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+CompressedFileClass::CompressedFileClass(FileClass * source, FileFactoryClass * source_factory, int size, int block_size, char const * filename) :
+	Source(source),
+	SourceFactory(source_factory),
+	FileSize(size),
+	BlockSize(block_size),
+	BlockCount(0),
+	BlockOffsets(NULL),
+	BiasStart(0),
+	Length(size),
+	Offset(0),
+	Cache(NULL),
+	CachedBlock(-1),
+	StoredBuffer(NULL),
+	IsOpen(false),
+	Filename(filename)
+{
+	WWASSERT(size >= 0);
+	WWASSERT(block_size > 0);
+
+	if (BlockSize > 0) {
+		BlockCount = (FileSize + BlockSize - 1) / BlockSize;
+	}
+}
+
+
+/***********************************************************************************************
+ * CompressedFileClass::~CompressedFileClass -- Destructor for the compressed file.            *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+CompressedFileClass::~CompressedFileClass(void)
+{
+	Close();
+
+	delete [] BlockOffsets;
+	delete [] Cache;
+	delete [] StoredBuffer;
+	BlockOffsets = NULL;
+	Cache = NULL;
+	StoredBuffer = NULL;
+
+	if (Source != NULL) {
+		if (SourceFactory != NULL) {
+			SourceFactory->Return_File(Source);
+		} else {
+			delete Source;
+		}
+		Source = NULL;
+	}
+}
+
+
+/***********************************************************************************************
+ * CompressedFileClass::Set_Name -- Sets the name reported by File_Name.                       *
+ *                                                                                             *
+ * INPUT:   filename -- The new name.                                                          *
+ *                                                                                             *
+ * OUTPUT:  Returns with the name.                                                             *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+char const * CompressedFileClass::Set_Name(char const * filename)
+{
+	Filename = filename;
+	return(Filename);
+}
+
+
+/***********************************************************************************************
+ * CompressedFileClass::Is_Available -- Checks that the compressed data is there.              *
+ *                                                                                             *
+ * INPUT:   forced   -- Passed on to the source.                                               *
+ *                                                                                             *
+ * OUTPUT:  bool; Can the file be opened?                                                      *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+bool CompressedFileClass::Is_Available(int forced)
+{
+	return(Source != NULL && BlockSize > 0 && Source->Is_Available(forced));
+}
+
+
+/***********************************************************************************************
+ * CompressedFileClass::Open -- Opens the file for reading.                                    *
+ *                                                                                             *
+ * INPUT:   filename -- Ignored, the file is always the data it was made with.                 *
+ *                                                                                             *
+ *          access   -- Only READ is allowed.                                                  *
+ *                                                                                             *
+ * OUTPUT:  bool; Was the file opened? It isn't if the block table is damaged.                 *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+int CompressedFileClass::Open(char const *, int access)
+{
+	return(Open(access));
+}
+
+int CompressedFileClass::Open(int access)
+{
+	if (Source == NULL || BlockSize <= 0 || Is_Open() || (access & WRITE) != 0) {
+		return(false);
+	}
+
+	if (!Source->Is_Open() && !Source->Open(READ)) {
+		return(false);
+	}
+
+	if (!Load_Block_Table()) {
+		WWDEBUG_SAY(("CompressedFileClass: %s is damaged\n", (const char *)Filename));
+		Source->Close();
+		return(false);
+	}
+
+	Offset = 0;
+	IsOpen = true;
+	return(true);
+}
+
+
+/***********************************************************************************************
+ * CompressedFileClass::Close -- Closes the file.                                              *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void CompressedFileClass::Close(void)
+{
+	if (IsOpen) {
+		Source->Close();
+		IsOpen = false;
+	}
+}
+
+
+/***********************************************************************************************
+ * CompressedFileClass::Read -- Decompresses data out of the file.                             *
+ *                                                                                             *
+ *    Like the other file classes, reading a closed file opens it for the read and closes it   *
+ *    again afterwards.                                                                        *
+ *                                                                                             *
+ * INPUT:   buffer   -- Where to copy the data to.                                             *
+ *                                                                                             *
+ *          size     -- The number of bytes to read.                                           *
+ *                                                                                             *
+ * OUTPUT:  Returns with the number of bytes read. This is short if a block is damaged.        *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+int CompressedFileClass::Read(void * buffer, int size)
+{
+	if (buffer == NULL || size <= 0) {
+		return(0);
+	}
+
+	bool hasopened = false;
+	if (!Is_Open()) {
+		if (!Open(READ)) {
+			return(0);
+		}
+		hasopened = true;
+	}
+
+	unsigned char * dest = (unsigned char *)buffer;
+	int total = 0;
+
+	while (size > 0 && Offset < Length) {
+		int pos = BiasStart + Offset;
+		int block = pos / BlockSize;
+		int in_block = pos - (block * BlockSize);
+		int block_len = Block_Length(block);
+
+		int amount = block_len - in_block;
+		if (amount > size) amount = size;
+		if (amount > Length - Offset) amount = Length - Offset;
+
+		if (block == CachedBlock) {
+			memcpy(dest, &Cache[in_block], amount);
+		} else if (in_block == 0 && amount == block_len) {
+
+			/*
+			**	The caller wants the whole block, decompress it straight into their buffer.
+			*/
+			if (!Load_Block(block, dest)) {
+				break;
+			}
+		} else {
+			if (Cache == NULL) {
+				Cache = new unsigned char[BlockSize];
+			}
+			CachedBlock = -1;
+			if (!Load_Block(block, Cache)) {
+				break;
+			}
+			CachedBlock = block;
+			memcpy(dest, &Cache[in_block], amount);
+		}
+
+		dest += amount;
+		size -= amount;
+		Offset += amount;
+		total += amount;
+	}
+
+	if (hasopened) {
+		Close();
+	}
+	return(total);
+}
+
+
+/***********************************************************************************************
+ * CompressedFileClass::Seek -- Moves the read position.                                       *
+ *                                                                                             *
+ *    Seeking only moves the position, nothing is decompressed until it is read.               *
+ *                                                                                             *
+ * INPUT:   pos   -- The position, relative to dir.                                            *
+ *                                                                                             *
+ *          dir   -- SEEK_SET, SEEK_CUR or SEEK_END.                                           *
+ *                                                                                             *
+ * OUTPUT:  Returns with the new read position, which is kept within the file.                 *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+int CompressedFileClass::Seek(int pos, int dir)
+{
+	if (!Is_Open()) {
+		return(Offset);
+	}
+
+	switch (dir) {
+		case SEEK_CUR:
+			Offset += pos;
+			break;
+
+		case SEEK_SET:
+			Offset = pos;
+			break;
+
+		case SEEK_END:
+			Offset = Length + pos;
+			break;
+	}
+
+	if (Offset < 0) Offset = 0;
+	if (Offset > Length) Offset = Length;
+	return(Offset);
+}
+
+
+/***********************************************************************************************
+ * CompressedFileClass::Bias -- Restricts the file to a part of itself.                        *
+ *                                                                                             *
+ *    This is how a mix file stored in a compressed mix file gets at its own contents.         *
+ *                                                                                             *
+ * INPUT:   start    -- Offset of the part, from the start of the file as it is now.           *
+ *                                                                                             *
+ *          length   -- Size of the part, or -1 for the rest of the file.                      *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   Unlike RawFileClass, a bias can't be undone.                                    *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void CompressedFileClass::Bias(int start, int length)
+{
+	if (start < 0) start = 0;
+	if (start > Length) start = Length;
+
+	BiasStart += start;
+	Length -= start;
+	if (length >= 0 && length < Length) {
+		Length = length;
+	}
+
+	Offset = 0;
+}
+
+
+/***********************************************************************************************
+ * CompressedFileClass::Load_Block_Table -- Reads and checks the block offsets.                *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  bool; Is the table there and does it make sense?                                   *
+ *                                                                                             *
+ * WARNINGS:   The source must be open.                                                        *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+bool CompressedFileClass::Load_Block_Table(void)
+{
+	if (BlockOffsets != NULL) {
+		return(true);
+	}
+
+	int table_size = (BlockCount + 1) * sizeof(uint32);
+	uint32 * table = new uint32[BlockCount + 1];
+
+	Source->Seek(0, SEEK_SET);
+	bool ok = (Source->Read(table, table_size) == table_size);
+
+	/*
+	**	The blocks must follow the table in order, fit in the source, and never be
+	**	stored bigger than they really are.
+	*/
+	if (ok) {
+		ok = (table[0] == (uint32)table_size) && (table[BlockCount] <= (uint32)Source->Size());
+	}
+	for (int index = 0; ok && index < BlockCount; index++) {
+		ok = (table[index + 1] >= table[index]) && (table[index + 1] - table[index] <= (uint32)Block_Length(index));
+	}
+
+	if (!ok) {
+		delete [] table;
+		return(false);
+	}
+
+	BlockOffsets = table;
+	return(true);
+}
+
+
+/***********************************************************************************************
+ * CompressedFileClass::Load_Block -- Decompresses one block.                                  *
+ *                                                                                             *
+ * INPUT:   block -- The block to decompress.                                                  *
+ *                                                                                             *
+ *          dest  -- Where to decompress it to, which must have room for the whole block.      *
+ *                                                                                             *
+ * OUTPUT:  bool; Was the block read and decompressed without errors?                          *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+bool CompressedFileClass::Load_Block(int block, unsigned char * dest)
+{
+	WWASSERT(block >= 0 && block < BlockCount);
+
+	uint32 start = BlockOffsets[block];
+	int stored = BlockOffsets[block + 1] - start;
+	int block_len = Block_Length(block);
+
+	/*
+	**	Use the stored block where it is if the source is in memory, otherwise read it.
+	** Blocks that didn't compress are read straight into the destination.
+	*/
+	const unsigned char * data = (const unsigned char *)Source->Peek_Data();
+	if (data != NULL) {
+		data += start;
+	} else {
+		unsigned char * target = dest;
+		if (stored != block_len) {
+			if (StoredBuffer == NULL) {
+				StoredBuffer = new unsigned char[BlockSize];
+			}
+			target = StoredBuffer;
+		}
+
+		Source->Seek(start, SEEK_SET);
+		if (Source->Read(target, stored) != stored) {
+			return(false);
+		}
+		if (stored == block_len) {
+			return(true);
+		}
+		data = target;
+	}
+
+	if (stored == block_len) {
+		memcpy(dest, data, block_len);
+		return(true);
+	}
+
+	lzo_uint out_len = block_len;
+	int result = lzo1x_decompress_x(data, stored, dest, &out_len, NULL);
+	return(result == LZO_E_OK && out_len == (lzo_uint)block_len);
+}
+
+
+/***********************************************************************************************
+ * CompressedFileClass::Block_Length -- Returns the uncompressed size of a block.              *
+ *=============================================================================================*/
+int CompressedFileClass::Block_Length(int block) const
+{
+	int remaining = FileSize - (block * BlockSize);
+	return((remaining < BlockSize) ? remaining : BlockSize);
+}
@@ -0,0 +1,124 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/***********************************************************************************************
+ ***              C O N F I D E N T I A L  ---  W E S T W O O D  S T U D I O S               ***
+ ***********************************************************************************************
+ *                                                                                             *
+ *                 Project Name : WWLib                                                        *
+ *                                                                                             *
+ *                     $Archive:: /Commando/Code/wwlib/compressedfile.h                       $*
+ *                                                                                             *
+ *---------------------------------------------------------------------------------------------*
+ * Functions:                                                                                  *
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#ifndef COMPRESSEDFILE_H
+#define COMPRESSEDFILE_H
+
+#include "always.h"
+#include "wwfile.h"
+#include "wwstring.h"
+#include "bittype.h"
+
+class FileFactoryClass;
+
+
+/*
+**	A read-only file whose contents are stored in another file as a series of independently
+**	LZO compressed blocks. The stored data starts with a table of block offsets:
+**
+**		uint32	BlockOffsets[block count + 1];		// from the start of the stored data
+**
+**	followed by the blocks. Every block but the last holds block_size bytes of the file.
+**	A block whose stored size is the same as its real size is not compressed.
+**
+**	Only the blocks that are read are decompressed, so any part of the file can be read
+**	without decompressing what comes before it. A read that covers whole blocks decompresses
+**	them straight into the caller's buffer; anything else goes through a one block cache.
+**	The blocks are decompressed with the checked LZO decoder, so a damaged file gives read
+**	errors rather than overrunning memory.
+*/
+class CompressedFileClass : public FileClass
+{
+	public:
+		CompressedFileClass(FileClass * source, FileFactoryClass * source_factory, int size, int block_size, char const * filename=NULL);
+		virtual ~CompressedFileClass(void);
+
+		virtual char const * File_Name(void) const {return(Filename);}
+		virtual char const * Set_Name(char const * filename);
+		virtual int Create(void) {return(false);}
+		virtual int Delete(void) {return(false);}
+		virtual bool Is_Available(int forced=false);
+		virtual bool Is_Open(void) const {return(IsOpen);}
+		virtual int Open(char const * filename, int access=READ);
+		virtual int Open(int access=READ);
+		virtual int Read(void * buffer, int size);
+		virtual int Seek(int pos, int dir=SEEK_CUR);
+		virtual int Size(void) {return(Length);}
+		virtual int Write(void const * , int ) {return(0);}
+		virtual void Close(void);
+		virtual void Error(int , int = false, char const * =NULL) {}
+		virtual void Bias(int start, int length=-1);
+
+	private:
+
+		bool Load_Block_Table(void);
+		bool Load_Block(int block, unsigned char * dest);
+		int Block_Length(int block) const;
+
+		/*
+		**	Where the compressed data comes from. If there is a source factory the source is
+		**	returned to it when this file is destroyed, otherwise the source is deleted.
+		*/
+		FileClass * Source;
+		FileFactoryClass * SourceFactory;
+
+		/*
+		**	The size of the uncompressed file and of each block.
+		*/
+		int FileSize;
+		int BlockSize;
+		int BlockCount;
+		uint32 * BlockOffsets;
+
+		/*
+		**	The part of the file that is visible after any bias, and the read position in it.
+		*/
+		int BiasStart;
+		int Length;
+		int Offset;
+
+		/*
+		**	The last block decompressed for a partial read, and a buffer for reading stored
+		**	blocks when the source isn't in memory. Both are allocated when first needed.
+		*/
+		unsigned char * Cache;
+		int CachedBlock;
+		unsigned char * StoredBuffer;
+
+		bool IsOpen;
+		StringClass Filename;
+};
+
+
+#endif
@@ -64,6 +64,10 @@ public:
 	virtual ~FileFactoryClass(void){};
 	virtual FileClass * Get_File( char const *filename ) = 0;
 	virtual void Return_File( FileClass *file ) = 0;
+
+	// Factories that know every file they hold up front (mix files) add the CRC_Stringi of
+	// each name to the list and return true. Others (directories on disk) return false.
+	virtual bool Get_CRC_List( DynamicVectorClass<unsigned long> &list ) { return false; }
 };
 
 
@@ -0,0 +1,255 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/***********************************************************************************************
+ ***              C O N F I D E N T I A L  ---  W E S T W O O D  S T U D I O S               ***
+ ***********************************************************************************************
+ *                                                                                             *
+ *                 Project Name : WWLib                                                        *
+ *                                                                                             *
+ *                     $Archive:: /Commando/Code/wwlib/framearena.cpp                         $*
+ *                                                                                             *
+ *---------------------------------------------------------------------------------------------*
+ * Functions:                                                                                  *
+ *   FrameArenaClass::FrameArenaClass -- constructor                                           *
+ *   FrameArenaClass::~FrameArenaClass -- destructor                                           *
+ *   FrameArenaClass::Reset -- rewinds the arena, releasing everything allocated from it       *
+ *   FrameArenaClass::Allocate_From_New_Chunk -- starts a new chunk for an allocation          *
+ *   FrameArenaClass::Allocate_Chunk -- allocates a chunk from the heap                        *
+ *   FrameArenaClass::Free_Chunks -- returns all chunks to the heap                            *
+ *   FrameArenaClass::Get_Thread_Arena -- returns the calling thread's arena                   *
+ *   FrameArenaClass::End_Frame -- marks the end of a frame                                    *
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+#include "framearena.h"
+#include "wwmemlog.h"
+
+
+volatile unsigned FrameArenaClass::CurrentFrame = 0;
+
+
+/***********************************************************************************************
+ * FrameArenaClass::FrameArenaClass -- constructor                                             *
+ *                                                                                             *
+ * No memory is allocated until the first call to Allocate.                                    *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * chunk_size - minimum size of each chunk the arena takes from the heap                       *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+FrameArenaClass::FrameArenaClass(int chunk_size) :
+	Chunks(NULL),
+	Cursor(NULL),
+	End(NULL),
+	ChunkSize(chunk_size),
+	OldChunkBytesUsed(0),
+	PeakBytesUsed(0),
+	Capacity(0),
+	ChunkAllocationCount(0),
+	UserCount(0),
+	Frame(CurrentFrame)
+{
+}
+
+
+/***********************************************************************************************
+ * FrameArenaClass::~FrameArenaClass -- destructor                                             *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+FrameArenaClass::~FrameArenaClass(void)
+{
+	WWASSERT(UserCount == 0);
+	Free_Chunks();
+}
+
+
+/***********************************************************************************************
+ * FrameArenaClass::Reset -- rewinds the arena, releasing everything allocated from it         *
+ *                                                                                             *
+ * If the last frame spilled into more than one chunk, the chunks are replaced by a single     *
+ * chunk big enough to hold all of them.                                                       *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ * Any memory handed out by the arena is invalid after this call                               *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void FrameArenaClass::Reset(void)
+{
+	WWASSERT(UserCount == 0);
+
+	int used = Get_Bytes_Used();
+	if (used > PeakBytesUsed) {
+		PeakBytesUsed = used;
+	}
+
+	if ((Chunks != NULL) && (Chunks->Next != NULL)) {
+		int capacity = Capacity;
+		Free_Chunks();
+		Chunks = Allocate_Chunk(capacity);
+	}
+
+	if (Chunks != NULL) {
+		Cursor = Get_Chunk_Data(Chunks);
+		End = Cursor + Chunks->Size;
+	}
+	OldChunkBytesUsed = 0;
+	Frame = CurrentFrame;
+}
+
+
+/***********************************************************************************************
+ * FrameArenaClass::Allocate_From_New_Chunk -- starts a new chunk for an allocation            *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * size - size of the allocation, already rounded up to ALIGNMENT                              *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void * FrameArenaClass::Allocate_From_New_Chunk(int size)
+{
+	if (Chunks != NULL) {
+		OldChunkBytesUsed += (int)(Cursor - Get_Chunk_Data(Chunks));
+	}
+
+	ChunkStruct * chunk = Allocate_Chunk((size > ChunkSize) ? size : ChunkSize);
+	chunk->Next = Chunks;
+	Chunks = chunk;
+
+	Cursor = Get_Chunk_Data(chunk) + size;
+	End = Get_Chunk_Data(chunk) + chunk->Size;
+	return Get_Chunk_Data(chunk);
+}
+
+
+/***********************************************************************************************
+ * FrameArenaClass::Allocate_Chunk -- allocates a chunk from the heap                          *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * size - number of usable bytes in the chunk                                                  *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+FrameArenaClass::ChunkStruct * FrameArenaClass::Allocate_Chunk(int size)
+{
+	WWMEMLOG(MEM_GAMEDATA);
+
+	ChunkStruct * chunk = (ChunkStruct *)(new char[sizeof(ChunkStruct) + size]);
+	chunk->Next = NULL;
+	chunk->Size = size;
+	chunk->Pad = 0;
+
+	Capacity += size;
+	ChunkAllocationCount++;
+	return chunk;
+}
+
+
+/***********************************************************************************************
+ * FrameArenaClass::Free_Chunks -- returns all chunks to the heap                              *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void FrameArenaClass::Free_Chunks(void)
+{
+	while (Chunks != NULL) {
+		ChunkStruct * next = Chunks->Next;
+		delete[] (char *)Chunks;
+		Chunks = next;
+	}
+	Cursor = NULL;
+	End = NULL;
+	Capacity = 0;
+	OldChunkBytesUsed = 0;
+}
+
+
+/***********************************************************************************************
+ * FrameArenaClass::Get_Thread_Arena -- returns the calling thread's arena                     *
+ *                                                                                             *
+ * The arena is rewound here if a frame has ended since it was last rewound and nothing is     *
+ * using it.                                                                                   *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+FrameArenaClass & FrameArenaClass::Get_Thread_Arena(void)
+{
+	static thread_local FrameArenaClass _arena;
+
+	if ((_arena.Frame != CurrentFrame) && (_arena.UserCount == 0)) {
+		_arena.Reset();
+	}
+	return _arena;
+}
+
+
+/***********************************************************************************************
+ * FrameArenaClass::End_Frame -- marks the end of a frame                                      *
+ *                                                                                             *
+ * Called once per frame by the main loop.  The calling thread's arena is rewound right away,  *
+ * the other threads' arenas are rewound the next time they are used.                          *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void FrameArenaClass::End_Frame(void)
+{
+	CurrentFrame++;
+	Get_Thread_Arena();
+}
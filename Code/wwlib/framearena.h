@@ -0,0 +1,342 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/***********************************************************************************************
+ ***              C O N F I D E N T I A L  ---  W E S T W O O D  S T U D I O S               ***
+ ***********************************************************************************************
+ *                                                                                             *
+ *                 Project Name : WWLib                                                        *
+ *                                                                                             *
+ *                     $Archive:: /Commando/Code/wwlib/framearena.h                           $*
+ *                                                                                             *
+ *---------------------------------------------------------------------------------------------*
+ * Functions:                                                                                  *
+ *   FrameDynamicVectorClass::Resize -- resizes the vector using memory from the arena         *
+ *   FrameSimpleDynVecClass::Resize -- resizes the vector using memory from the arena          *
+ *   FrameSimpleDynVecClass::Uninitialised_Grow -- grows the vector without copying            *
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#ifndef FRAMEARENA_H
+#define FRAMEARENA_H
+
+#include "always.h"
+#include "vector.h"
+#include "simplevec.h"
+#include "wwdebug.h"
+#include <string.h>
+
+
+/**********************************************************************************************
+** FrameArenaClass
+**
+** A bump allocator for temporary data that only has to live until the end of the frame.
+** Allocating just moves a pointer and nothing is ever freed individually; the whole arena
+** is rewound at once.  When a frame needs more than one chunk, the chunks are merged into
+** a single larger chunk when the arena is rewound, so after a few frames the arena stops
+** touching the heap altogether.
+**
+** Each thread has its own arena (Get_Thread_Arena).  End_Frame is called once per frame
+** by the main loop; every thread's arena is rewound the next time that thread asks for it.
+** An arena is never rewound while something is still using it (see Begin_Use / End_Use),
+** the rewind is simply put off until the last user is gone.
+**
+**********************************************************************************************/
+class FrameArenaClass
+{
+public:
+
+	enum
+	{
+		DEFAULT_CHUNK_SIZE =	256 * 1024,
+		ALIGNMENT =				8,
+	};
+
+	FrameArenaClass(int chunk_size = DEFAULT_CHUNK_SIZE);
+	~FrameArenaClass(void);
+
+	void *						Allocate(int size);
+	void							Reset(void);
+
+	void							Begin_Use(void)							{ UserCount++; }
+	void							End_Use(void)								{ WWASSERT(UserCount > 0); UserCount--; }
+
+	int							Get_Bytes_Used(void) const;
+	int							Get_Peak_Bytes_Used(void) const		{ return PeakBytesUsed; }
+	int							Get_Capacity(void) const				{ return Capacity; }
+	int							Get_Chunk_Allocation_Count(void) const	{ return ChunkAllocationCount; }
+
+	static FrameArenaClass &	Get_Thread_Arena(void);
+	static void						End_Frame(void);
+	static unsigned				Get_Frame(void)							{ return CurrentFrame; }
+
+protected:
+
+	struct ChunkStruct
+	{
+		ChunkStruct *		Next;
+		int					Size;
+		int					Pad;
+	};
+
+	static char *				Get_Chunk_Data(ChunkStruct * chunk)	{ return (char *)(chunk + 1); }
+
+	void *						Allocate_From_New_Chunk(int size);
+	ChunkStruct *				Allocate_Chunk(int size);
+	void							Free_Chunks(void);
+
+	ChunkStruct *				Chunks;						// current chunk is at the head
+	char *						Cursor;
+	char *						End;
+	int							ChunkSize;
+	int							OldChunkBytesUsed;		// bytes used in the chunks behind the head
+	int							PeakBytesUsed;
+	int							Capacity;
+	int							ChunkAllocationCount;
+	int							UserCount;
+	unsigned						Frame;
+
+	static volatile unsigned	CurrentFrame;
+
+private:
+
+	// not implemented
+	FrameArenaClass(const FrameArenaClass &);
+	FrameArenaClass & operator = (const FrameArenaClass &);
+};
+
+
+inline void * FrameArenaClass::Allocate(int size)
+{
+	size = (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+	if (size > End - Cursor) {
+		return Allocate_From_New_Chunk(size);
+	}
+	void * mem = Cursor;
+	Cursor += size;
+	return mem;
+}
+
+inline int FrameArenaClass::Get_Bytes_Used(void) const
+{
+	if (Chunks == NULL) return 0;
+	return OldChunkBytesUsed + (int)(Cursor - Get_Chunk_Data(Chunks));
+}
+
+
+/**********************************************************************************************
+** FrameDynamicVectorClass
+**
+** A DynamicVectorClass whose storage comes out of a FrameArenaClass (the calling thread's
+** arena unless one is given).  The vector keeps the arena from being rewound for as long as
+** it exists, so it should only ever be a local variable; never make one static or keep one
+** across frames.  The storage is abandoned rather than deleted, so just like the array form
+** of DynamicVectorClass the elements should be pointers or simple structs.  The vector
+** grows by doubling since every growth leaves the old storage behind in the arena.
+**
+**********************************************************************************************/
+template<class T>
+class FrameDynamicVectorClass : public DynamicVectorClass<T>
+{
+public:
+
+	FrameDynamicVectorClass(int size = 0,FrameArenaClass * arena = NULL);
+	virtual ~FrameDynamicVectorClass(void);
+
+	virtual bool	Resize(int newsize, T const * array=0);
+
+protected:
+
+	FrameArenaClass *		Arena;
+
+private:
+
+	// not implemented
+	FrameDynamicVectorClass(const FrameDynamicVectorClass<T> &);
+	FrameDynamicVectorClass<T> & operator = (const FrameDynamicVectorClass<T> &);
+};
+
+
+template<class T>
+inline FrameDynamicVectorClass<T>::FrameDynamicVectorClass(int size,FrameArenaClass * arena) :
+	DynamicVectorClass<T>(0),
+	Arena(arena)
+{
+	if (Arena == NULL) {
+		Arena = &FrameArenaClass::Get_Thread_Arena();
+	}
+	Arena->Begin_Use();
+
+	if (size > 0) {
+		Resize(size);
+	}
+}
+
+template<class T>
+inline FrameDynamicVectorClass<T>::~FrameDynamicVectorClass(void)
+{
+	Arena->End_Use();
+}
+
+
+/***********************************************************************************************
+ * FrameDynamicVectorClass::Resize -- resizes the vector using memory from the arena           *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * newsize - new number of elements                                                            *
+ * array - optional memory to use instead of the arena                                         *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+template<class T>
+inline bool FrameDynamicVectorClass<T>::Resize(int newsize, T const * array)
+{
+	if ((array == NULL) && (newsize > 0)) {
+		if ((newsize > Length()) && (newsize < 2 * Length())) {
+			newsize = 2 * Length();
+		}
+		array = (T const *)Arena->Allocate(newsize * sizeof(T));
+	}
+	return DynamicVectorClass<T>::Resize(newsize,array);
+}
+
+
+/**********************************************************************************************
+** FrameSimpleDynVecClass
+**
+** A SimpleDynVecClass whose storage comes out of a FrameArenaClass.  The same rules as
+** FrameDynamicVectorClass apply: local variables only and memcopy-able types only (which
+** SimpleDynVecClass requires anyway).
+**
+**********************************************************************************************/
+template<class T>
+class FrameSimpleDynVecClass : public SimpleDynVecClass<T>
+{
+public:
+
+	FrameSimpleDynVecClass(int size = 0,FrameArenaClass * arena = NULL);
+	virtual ~FrameSimpleDynVecClass(void);
+
+	virtual bool	Resize(int newsize);
+	virtual bool	Uninitialised_Grow(int newsize);
+
+protected:
+
+	FrameArenaClass *		Arena;
+
+private:
+
+	// not implemented
+	FrameSimpleDynVecClass(const FrameSimpleDynVecClass<T> &);
+	FrameSimpleDynVecClass<T> & operator = (const FrameSimpleDynVecClass<T> &);
+};
+
+
+template<class T>
+inline FrameSimpleDynVecClass<T>::FrameSimpleDynVecClass(int size,FrameArenaClass * arena) :
+	SimpleDynVecClass<T>(0),
+	Arena(arena)
+{
+	if (Arena == NULL) {
+		Arena = &FrameArenaClass::Get_Thread_Arena();
+	}
+	Arena->Begin_Use();
+
+	if (size > 0) {
+		Resize(size);
+	}
+}
+
+template<class T>
+inline FrameSimpleDynVecClass<T>::~FrameSimpleDynVecClass(void)
+{
+	// The storage belongs to the arena, don't let the base classes delete it
+	Vector = NULL;
+	VectorMax = 0;
+	Arena->End_Use();
+}
+
+
+/***********************************************************************************************
+ * FrameSimpleDynVecClass::Resize -- resizes the vector using memory from the arena            *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+template<class T>
+inline bool FrameSimpleDynVecClass<T>::Resize(int newsize)
+{
+	if (newsize == VectorMax) {
+		return true;
+	}
+
+	if (newsize > 0) {
+		T * newptr = (T *)Arena->Allocate(newsize * sizeof(T));
+		if (Vector != NULL) {
+			int copycount = (newsize < VectorMax) ? newsize : VectorMax;
+			memcpy(newptr,Vector,copycount * sizeof(T));
+		}
+		Vector = newptr;
+		VectorMax = newsize;
+	} else {
+		Vector = NULL;
+		VectorMax = 0;
+	}
+
+	if (Length() < ActiveCount) ActiveCount = Length();
+	return true;
+}
+
+
+/***********************************************************************************************
+ * FrameSimpleDynVecClass::Uninitialised_Grow -- grows the vector without copying              *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+template<class T>
+inline bool FrameSimpleDynVecClass<T>::Uninitialised_Grow(int newsize)
+{
+	if (newsize <= VectorMax) {
+		return true;
+	}
+	Vector = (T *)Arena->Allocate(newsize * sizeof(T));
+	VectorMax = newsize;
+	return true;
+}
+
+
+#endif //FRAMEARENA_H
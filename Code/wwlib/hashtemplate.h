@@ -44,6 +44,18 @@
 
 #include "always.h"
 #include "wwstring.h"
+#include <string.h>
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)) || defined(__SSE2__)
+#define HASHTEMPLATE_SSE2	1
+#include <emmintrin.h>
+#else
+#define HASHTEMPLATE_SSE2	0
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 // Class for providing hash values
 
@@ -69,18 +81,121 @@ template <> inline unsigned int HashTemplateKeyClass<float>::Get_Hash_Value (con
 	return ((z>>22)+(z>>12)+(z));
 }
 
+
+// Control byte group operations
+//
+// The slots of a HashTemplateClass are split into groups of WIDTH slots and every slot has a
+// control byte which is either EMPTY, DELETED or, for a slot in use, the low 7 bits of its
+// key's hash.  These functions test all of the control bytes of a group at once and return
+// a mask with one bit per matching slot.  SSE2 is used where it is available, otherwise the
+// group is 8 bytes tested as two dwords.  Match may report a few extra slots in use (never
+// empty or deleted ones) in the dword version, which is fine since the keys are compared
+// anyway.
+
+class HashTemplateGroupClass
+{
+public:
+
+	enum
+	{
+#if HASHTEMPLATE_SSE2
+		WIDTH		= 16,
+#else
+		WIDTH		= 8,
+#endif
+		EMPTY		= 0x80,
+		DELETED	= 0xFE,
+		HASH_MASK	= 0x7F
+	};
+
+	static inline unsigned int Match (const unsigned char* ctrl, unsigned char h2);
+	static inline unsigned int Match_Empty (const unsigned char* ctrl);
+	static inline unsigned int Match_Free (const unsigned char* ctrl);		// empty or deleted
+	static inline int Lowest_Bit (unsigned int mask);
+
+private:
+#if !HASHTEMPLATE_SSE2
+	static inline unsigned int Load (const unsigned char* ctrl)			{ unsigned int w; memcpy(&w,ctrl,4); return w; }
+	static inline unsigned int Pack (unsigned int lo, unsigned int hi)	{ return (((((lo >> 7) * 0x00204081) >> 21) & 0xF) | (((((hi >> 7) * 0x00204081) >> 21) & 0xF) << 4)); }
+#endif
+};
+
+#if HASHTEMPLATE_SSE2
+
+inline unsigned int HashTemplateGroupClass::Match (const unsigned char* ctrl, unsigned char h2)
+{
+	__m128i group = _mm_loadu_si128((const __m128i*)ctrl);
+	return (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8((char)h2),group));
+}
+
+inline unsigned int HashTemplateGroupClass::Match_Empty (const unsigned char* ctrl)
+{
+	__m128i group = _mm_loadu_si128((const __m128i*)ctrl);
+	return (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8((char)EMPTY),group));
+}
+
+inline unsigned int HashTemplateGroupClass::Match_Free (const unsigned char* ctrl)
+{
+	return (unsigned int)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)ctrl));
+}
+
+#else
+
+inline unsigned int HashTemplateGroupClass::Match (const unsigned char* ctrl, unsigned char h2)
+{
+	unsigned int pattern = 0x01010101 * h2;
+	unsigned int lo = Load(ctrl) ^ pattern;
+	unsigned int hi = Load(ctrl+4) ^ pattern;
+	return Pack((lo - 0x01010101) & ~lo & 0x80808080,(hi - 0x01010101) & ~hi & 0x80808080);
+}
+
+inline unsigned int HashTemplateGroupClass::Match_Empty (const unsigned char* ctrl)
+{
+	unsigned int lo = Load(ctrl);
+	unsigned int hi = Load(ctrl+4);
+	return Pack(lo & ~(lo << 6) & 0x80808080,hi & ~(hi << 6) & 0x80808080);
+}
+
+inline unsigned int HashTemplateGroupClass::Match_Free (const unsigned char* ctrl)
+{
+	return Pack(Load(ctrl) & 0x80808080,Load(ctrl+4) & 0x80808080);
+}
+
+#endif
+
+inline int HashTemplateGroupClass::Lowest_Bit (unsigned int mask)
+{
+#if defined(_MSC_VER)
+	unsigned long index;
+	_BitScanForward(&index,mask);
+	return (int)index;
+#else
+	return __builtin_ctz(mask);
+#endif
+}
+
+
 // Hash class
+//
+// Open addressing: the entries live directly in a table of slots (a power of two, at most
+// 7/8 full) with a parallel array of control bytes.  A lookup hashes the key to a starting
+// group, compares the 7 hash bits stored for every slot in the group at once and only looks
+// at the keys whose bits match.  If the group has an empty slot the key isn't in the table,
+// otherwise the search moves on to the next group.  Removed slots become DELETED markers
+// (or EMPTY when no search can pass through their group) and are reused by Insert.
+//
+// Like before, Insert doesn't replace an entry that is already there (use Set_Value for
+// that).  With duplicate keys the newest entry shadows the older ones: Get returns the most
+// recently inserted entry, and once that is removed the next newest one.  Insert keeps
+// entries with the same key in that order along their probe sequence and Re_Hash keeps it
+// when it moves them.
+
 template <class KeyType, class ValueType> 
 class HashTemplateClass
 {
 	struct Entry;
 public:
 
-	enum 
-	{
-		NIL = -1								// internal enumeration for representing a NULL link
-	};
-
 	HashTemplateClass(void);
 	~HashTemplateClass(void);
 
@@ -93,37 +208,39 @@ public:
 	bool Exists(const KeyType& s) const;
 	bool Exists(const KeyType& s, const ValueType& d) const;
 	void Remove_All(void);
-	unsigned int Get_Size(void) const;
+	unsigned int Get_Size(void) const;				// number of slots
+	unsigned int Get_Count(void) const;				// number of entries
+	unsigned int Get_Memory_Usage(void) const { return Size * (sizeof(unsigned char) + sizeof(Entry)); }
 
-	int* Get_Hash() { return Hash; }
+	const unsigned char* Get_Control() { return Control; }
 	Entry* Get_Table() { return Table; }
 
 private:
 	HashTemplateClass (const HashTemplateClass&);	// not allowed
 	HashTemplateClass& operator= (const HashTemplateClass&);	// not allowed
-	static unsigned int Get_Hash_Val(const KeyType& s, const unsigned int hash_array_size);
+	static unsigned int Get_Hash_Val(const KeyType& s);
+	int Find(const KeyType& s, const ValueType* d) const;
+	int Find_Free_Slot(unsigned int hval) const;
+	void Erase(int index);
 	void Re_Hash(void);
 
-	int Alloc_Entry(void);
-
 	struct Entry
 	{
-		int Next;						// next pointer in linked list
 		KeyType Key;							// key
 		ValueType Value;					// value
 	};
 
-	int* Hash;							// hash pointers
-	Entry* Table;						// allocation table
-	int First;							// handle of first free entry
-	unsigned int Size;				// size of hash table
+	unsigned char* Control;				// control byte for each slot
+	Entry* Table;						// slots
+	unsigned int Size;				// number of slots
+	unsigned int Count;				// number of slots in use
+	unsigned int GrowthLeft;		// empty slots that can be filled before re-hashing
 };
 
 template <class KeyType, class ValueType>
 class HashTemplateIterator
 {
-	int HashIndex;					// index to hash pointer table
-	int Handle;
+	int HashIndex;					// index of the current slot
 	HashTemplateClass<KeyType,ValueType>& HashTable;
 
 public:
@@ -136,23 +253,16 @@ public:
 
 	void First()
 	{
-		Handle=HashTemplateClass<KeyType,ValueType>::NIL;
-		int size=HashTable.Get_Size();
-		for (HashIndex=0;HashIndex<size;++HashIndex) {
-			Handle = HashTable.Get_Hash()[HashIndex];
-			if (Handle!=HashTemplateClass<KeyType,ValueType>::NIL) break;
-		}
+		HashIndex=-1;
+		Next();
 	}
 
 	void Next()
 	{
-		Handle=HashTable.Get_Table()[Handle].Next;
-		if (Handle==HashTemplateClass<KeyType,ValueType>::NIL) {
-			int size=HashTable.Get_Size();
-			for (++HashIndex;HashIndex<size;++HashIndex) {
-				Handle = HashTable.Get_Hash()[HashIndex];
-				if (Handle!=HashTemplateClass<KeyType,ValueType>::NIL) break;
-			}
+		int size=HashTable.Get_Size();
+		const unsigned char* control=HashTable.Get_Control();
+		for (++HashIndex;HashIndex<size;++HashIndex) {
+			if ((control[HashIndex] & HashTemplateGroupClass::EMPTY) == 0) break;
 		}
 	}
 
@@ -163,12 +273,12 @@ public:
 
 	ValueType& Peek_Value()
 	{
-		return HashTable.Get_Table()[Handle].Value;
+		return HashTable.Get_Table()[HashIndex].Value;
 	}
 
 	const KeyType& Peek_Key()
 	{
-		return HashTable.Get_Table()[Handle].Key;
+		return HashTable.Get_Table()[HashIndex].Key;
 	}
 
 };
@@ -179,13 +289,51 @@ public:
 
 template <class KeyType, class ValueType> inline void HashTemplateClass<KeyType,ValueType>::Insert(const KeyType& s, const ValueType& d)
 {
-	int h;
-	h				= Alloc_Entry();
-	unsigned int hval	= Get_Hash_Val(s,Size);
-	Table[h].Key	= s;
-	Table[h].Value	= d;
-	Table[h].Next	= Hash[hval];
-	Hash[hval]		= h;
+	if (GrowthLeft == 0)
+		Re_Hash();
+
+	unsigned int hval			= Get_Hash_Val(s);
+	unsigned char h2			= (unsigned char)(hval & HashTemplateGroupClass::HASH_MASK);
+	unsigned int group_mask	= Size/HashTemplateGroupClass::WIDTH - 1;
+	unsigned int group		= (hval >> 7) & group_mask;
+
+	// The new entry goes in the first free slot of the probe sequence, unless an entry with
+	// the same key comes before it.  Then the new entry takes that slot and the older one
+	// moves on, so the entries with one key stay in newest first order.
+	Entry pending;
+	pending.Key		= s;
+	pending.Value	= d;
+
+	for (unsigned int step = 1; ; ++step)
+	{
+		const unsigned char* ctrl = Control + group*HashTemplateGroupClass::WIDTH;
+		unsigned int free_mask = HashTemplateGroupClass::Match_Free(ctrl);
+		unsigned int match = HashTemplateGroupClass::Match(ctrl,h2);
+		if (free_mask)
+			match &= (free_mask & (0-free_mask)) - 1;
+		while (match)
+		{
+			int h = group*HashTemplateGroupClass::WIDTH + HashTemplateGroupClass::Lowest_Bit(match);
+			if (Table[h].Key == s)
+			{
+				Entry older	= Table[h];
+				Table[h]		= pending;
+				pending		= older;
+			}
+			match &= match-1;
+		}
+		if (free_mask)
+		{
+			int h = group*HashTemplateGroupClass::WIDTH + HashTemplateGroupClass::Lowest_Bit(free_mask);
+			if (Control[h] == HashTemplateGroupClass::EMPTY)
+				GrowthLeft--;
+			Control[h]	= h2;
+			Table[h]		= pending;
+			Count++;
+			return;
+		}
+		group = (group + step) & group_mask;
+	}
 }
 
 template <class KeyType, class ValueType> inline unsigned int HashTemplateClass<KeyType,ValueType>::Get_Size (void) const
@@ -193,217 +341,213 @@ template <class KeyType, class ValueType> inline unsigned int HashTemplateClass<
 	return Size;
 }
 
+template <class KeyType, class ValueType> inline unsigned int HashTemplateClass<KeyType,ValueType>::Get_Count (void) const
+{
+	return Count;
+}
+
 template <class KeyType, class ValueType> inline void HashTemplateClass<KeyType,ValueType>::Remove_All (void)
 {
-	for (unsigned int i = 0; i < Size; i++)
-	{
-		int f = Hash[i];
-		if (f!=NIL)
-		{
-			int h = f;
-			while (Table[h].Next != NIL)
-				h = Table[h].Next;
-			Table[h].Next = First;		// link to first free
-			First = f;					// link to beginning
-			Hash[i] = NIL;				// kill entry in hash
-		}
-	}
+	if (Control)
+		memset(Control,HashTemplateGroupClass::EMPTY,Size);
+	Count = 0;
+	GrowthLeft = Size - Size/8;
 }
 
 template <class KeyType, class ValueType> inline void HashTemplateClass<KeyType,ValueType>::Remove	(const KeyType& s)
 {
-	if (!Hash) return;
-	unsigned int hval = Get_Hash_Val(s,Size);
-	int  prev = NIL;
-	int	h	 = Hash[hval];
-
-	while (h != NIL)
-	{
-		if (Table[h].Key == s)
-		{
-			if (prev!=NIL)
-				Table[prev].Next = Table[h].Next;
-			else
-				Hash[hval] = Table[h].Next;
-			Table[h].Next = First;
-			First = h;
-			return;
-		}
-		prev = h;
-		h    = Table[h].Next;
-	}
+	int h = Find(s,NULL);
+	if (h >= 0)
+		Erase(h);
 }
 
 template <class KeyType, class ValueType> inline void HashTemplateClass<KeyType,ValueType>::Remove (const KeyType& s, const ValueType& d)
 {
-	if (!Hash) return;
-	unsigned int hval = Get_Hash_Val(s,Size);
-	int  prev = NIL;
-	int	h	 = Hash[hval];
-
-	while (h != NIL)
-	{
-		if (Table[h].Key == s && Table[h].Value == d)
-		{
-			if (prev!=NIL)
-				Table[prev].Next = Table[h].Next;
-			else
-				Hash[hval] = Table[h].Next;
-			Table[h].Next = First;
-			First = h;
-			return;
-		}
-		prev = h;
-		h    = Table[h].Next;
-	}
+	int h = Find(s,&d);
+	if (h >= 0)
+		Erase(h);
 }
 
 // Set the value at existing key, or if not found insert a new value
 template <class KeyType, class ValueType> inline void HashTemplateClass<KeyType,ValueType>::Set_Value (const KeyType& s, const ValueType& v)
 {
-	if (Hash) {
-		int  h = Hash[Get_Hash_Val(s,Size)];
-		while (h!=NIL)	{
-			if (Table[h].Key == s) {
-				Table[h].Value=v;
-				return;
-			}
-			h = Table[h].Next;
-		}
+	int h = Find(s,NULL);
+	if (h >= 0) {
+		Table[h].Value=v;
+		return;
 	}
 	Insert(s,v);
 }
 
 template <class KeyType, class ValueType> inline ValueType HashTemplateClass<KeyType,ValueType>::Get (const KeyType& s) const
 {
-	if (Hash) {
-		int  h = Hash[Get_Hash_Val(s,Size)];
-		while (h!=NIL)
-		{
-			if (Table[h].Key == s)
-				return Table[h].Value;
-			h = Table[h].Next;
-		}
-	}
+	int h = Find(s,NULL);
+	if (h >= 0)
+		return Table[h].Value;
 	return ValueType(0);
 }
 
 template <class KeyType, class ValueType> inline bool HashTemplateClass<KeyType,ValueType>::Get(const KeyType& s, ValueType& d) const
 {
-	if (Hash) {
-		int  h = Hash[Get_Hash_Val(s,Size)];
-		while (h!=NIL)
-		{
-			if (Table[h].Key == s)
-			{
-				d = Table[h].Value;
-				return true;
-			}
-			h = Table[h].Next;
-		}
+	int h = Find(s,NULL);
+	if (h >= 0)
+	{
+		d = Table[h].Value;
+		return true;
 	}
 	return false;
 }
 
 template <class KeyType, class ValueType> inline bool HashTemplateClass<KeyType,ValueType>::Exists(const KeyType& s) const
 {
-	if (Hash) {
-		int  h = Hash[Get_Hash_Val(s,Size)];
-		while (h!=NIL)
-		{
-			if (Table[h].Key == s)
-				return true;
-			h = Table[h].Next;
-		}
-	}
-	return false;
+	return Find(s,NULL) >= 0;
 }
 
 template <class KeyType, class ValueType> inline bool HashTemplateClass<KeyType,ValueType>::Exists(const KeyType& s, const ValueType& d) const
 {
-	if (Hash) {
-		int  h = Hash[Get_Hash_Val(s,Size)];
-		while (h!=NIL)
-		{
-			if (Table[h].Key == s && Table[h].Value == d)
-				return true;
-			h = Table[h].Next;
-		}
-	}
-	return false;
+	return Find(s,&d) >= 0;
 }
 
-template <class KeyType, class ValueType> inline unsigned int HashTemplateClass<KeyType,ValueType>::Get_Hash_Val(const KeyType& s, const unsigned int hash_array_size)
+// The user hash functions are cheap and often leave the low bits poorly mixed, so the
+// result is run through a finalizer before being split into the group and the control bits.
+template <class KeyType, class ValueType> inline unsigned int HashTemplateClass<KeyType,ValueType>::Get_Hash_Val(const KeyType& s)
 {
-	return HashTemplateKeyClass<KeyType>::Get_Hash_Value (s) & (hash_array_size-1);
+	unsigned int h = HashTemplateKeyClass<KeyType>::Get_Hash_Value (s);
+	h ^= h >> 16;
+	h *= 0x85EBCA6B;
+	h ^= h >> 13;
+	h *= 0xC2B2AE35;
+	h ^= h >> 16;
+	return h;
 }
 
-template <class KeyType, class ValueType> inline void HashTemplateClass<KeyType,ValueType>::Re_Hash()
+// Returns the slot holding s (and d, if given) or -1
+template <class KeyType, class ValueType> inline int HashTemplateClass<KeyType,ValueType>::Find(const KeyType& s, const ValueType* d) const
 {
-	unsigned int new_size = Size*2;
-	if (new_size < 4)
-		new_size = 4;
+	if (!Count) return -1;
 
-	Entry  *new_table = new Entry[new_size];
-	int *new_hash  = new int[new_size];
+	unsigned int hval			= Get_Hash_Val(s);
+	unsigned char h2			= (unsigned char)(hval & HashTemplateGroupClass::HASH_MASK);
+	unsigned int group_mask	= Size/HashTemplateGroupClass::WIDTH - 1;
+	unsigned int group		= (hval >> 7) & group_mask;
 
-	int cnt = 0;
-	int	i;
+	for (unsigned int step = 1; ; ++step)
+	{
+		const unsigned char* ctrl = Control + group*HashTemplateGroupClass::WIDTH;
+		unsigned int match = HashTemplateGroupClass::Match(ctrl,h2);
+		while (match)
+		{
+			int h = group*HashTemplateGroupClass::WIDTH + HashTemplateGroupClass::Lowest_Bit(match);
+			if (Table[h].Key == s && (d == NULL || Table[h].Value == *d))
+				return h;
+			match &= match-1;
+		}
+		if (HashTemplateGroupClass::Match_Empty(ctrl))
+			return -1;
+		group = (group + step) & group_mask;
+	}
+}
+
+// Returns the first empty or deleted slot along the probe sequence for hval
+template <class KeyType, class ValueType> inline int HashTemplateClass<KeyType,ValueType>::Find_Free_Slot(unsigned int hval) const
+{
+	unsigned int group_mask	= Size/HashTemplateGroupClass::WIDTH - 1;
+	unsigned int group		= (hval >> 7) & group_mask;
 
-	for (i = 0; i < (int)new_size; i++)
+	for (unsigned int step = 1; ; ++step)
 	{
-		new_table[i].Next	= NIL;
-		new_hash[i]			= NIL;
+		unsigned int match = HashTemplateGroupClass::Match_Free(Control + group*HashTemplateGroupClass::WIDTH);
+		if (match)
+			return group*HashTemplateGroupClass::WIDTH + HashTemplateGroupClass::Lowest_Bit(match);
+		group = (group + step) & group_mask;
 	}
+}
 
-	if (Size)											// if we have existing data, it needs to be rehashed
+// If the slot's group still has an empty slot, no search has ever gone past this group
+// so the slot can go straight back to empty.  Otherwise it has to be marked as deleted.
+template <class KeyType, class ValueType> inline void HashTemplateClass<KeyType,ValueType>::Erase(int h)
+{
+	const unsigned char* ctrl = Control + (h & ~(HashTemplateGroupClass::WIDTH-1));
+	if (HashTemplateGroupClass::Match_Empty(ctrl))
+	{
+		Control[h] = HashTemplateGroupClass::EMPTY;
+		GrowthLeft++;
+	}
+	else
+	{
+		Control[h] = HashTemplateGroupClass::DELETED;
+	}
+	Count--;
+}
+
+template <class KeyType, class ValueType> inline void HashTemplateClass<KeyType,ValueType>::Re_Hash()
+{
+	// Grow unless most of the used-up room is deleted slots, then just clean up at the same size
+	unsigned int new_size = Size;
+	if (Count >= (Size - Size/8)/2)
+		new_size = Size*2;
+	if (new_size < HashTemplateGroupClass::WIDTH)
+		new_size = HashTemplateGroupClass::WIDTH;
+
+	unsigned char* old_control = Control;
+	Entry* old_table = Table;
+	unsigned int old_size = Size;
+
+	Control	= new unsigned char[new_size];
+	Table		= new Entry[new_size];
+	Size		= new_size;
+	memset(Control,HashTemplateGroupClass::EMPTY,new_size);
+
+	// Move all the entries with a slot's key at once, in the order they have along the old
+	// probe sequence.  A fresh table has no deleted slots, so Find_Free_Slot hands them out
+	// in the same order along the new one.  Moved slots are marked deleted, which keeps the
+	// old probe sequences intact.
+	unsigned int old_group_mask = old_size/HashTemplateGroupClass::WIDTH - 1;
+	for (unsigned int i = 0; i < old_size; i++)
 	{
-		for (i = 0; i < (int)Size; i++)						// step through each old hash set
+		if ((old_control[i] & HashTemplateGroupClass::EMPTY) == 0)
 		{
-			int	h = Hash[i];
-			while (h != NIL)
+			const KeyType& key	= old_table[i].Key;
+			unsigned int hval		= Get_Hash_Val(key);
+			unsigned char h2		= old_control[i];
+			unsigned int group	= (hval >> 7) & old_group_mask;
+
+			for (unsigned int step = 1; ; ++step)
 			{
-				unsigned int hVal		= Get_Hash_Val(Table[h].Key, new_size);
-				new_table[cnt].Key	= Table[h].Key;
-				new_table[cnt].Value = Table[h].Value;
-				new_table[cnt].Next	= new_hash[hVal];
-				new_hash[hVal]		= cnt;
-				cnt++;
-				h = Table[h].Next;
+				const unsigned char* ctrl = old_control + group*HashTemplateGroupClass::WIDTH;
+				unsigned int match = HashTemplateGroupClass::Match(ctrl,h2);
+				while (match)
+				{
+					int j = group*HashTemplateGroupClass::WIDTH + HashTemplateGroupClass::Lowest_Bit(match);
+					if (old_table[j].Key == key)
+					{
+						int h				= Find_Free_Slot(hval);
+						Control[h]		= h2;
+						Table[h]			= old_table[j];
+						old_control[j]	= HashTemplateGroupClass::DELETED;
+					}
+					match &= match-1;
+				}
+				if (HashTemplateGroupClass::Match_Empty(ctrl))
+					break;
+				group = (group + step) & old_group_mask;
 			}
 		}
-		delete[] Hash;
-		delete[] Table;
 	}
+	GrowthLeft = new_size - new_size/8 - Count;
 
-	for (i = cnt; i < (int)new_size; i++)
-		new_table[i].Next = i+1;
-	new_table[new_size-1].Next = NIL;
-
-	First	= cnt;
-	Hash	= new_hash;
-	Table	= new_table;
-	Size	= new_size;
-}
-
-template <class KeyType, class ValueType> inline int HashTemplateClass<KeyType,ValueType>::Alloc_Entry()
-{
-	if (First == NIL)					// need to re-alloc and re-hash tables
-		Re_Hash();						
-	int h	= First;
-	First	= Table[First].Next;
-	return h;
+	delete[] old_control;
+	delete[] old_table;
 }
 
-template <class KeyType, class ValueType> inline HashTemplateClass<KeyType,ValueType>::HashTemplateClass() : Hash(0),Table(0),First(NIL),Size(0)
+template <class KeyType, class ValueType> inline HashTemplateClass<KeyType,ValueType>::HashTemplateClass() : Control(0),Table(0),Size(0),Count(0),GrowthLeft(0)
 {
-//	Re_Hash();
 }
 
 template <class KeyType, class ValueType> inline HashTemplateClass<KeyType,ValueType>::~HashTemplateClass()
 {
-	if (Hash)
-		delete[] Hash;
+	if (Control)
+		delete[] Control;
 	if (Table)
 		delete[] Table;
 }
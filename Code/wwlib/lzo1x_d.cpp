@@ -219,6 +219,189 @@ eof_found:
 }
 
 
+/***********************************************************************
+// decompress a block of data, checking every read and write.
+//
+// On entry *out_len is the size of the output buffer.  Damaged or
+// hostile input makes this return an error rather than run off the
+// end of either buffer.  It is slower than lzo1x_decompress, use it
+// for data that didn't come from our own compressor.
+************************************************************************/
+
+#define NEED_IP(x)	if ((lzo_uint)(ip_end - ip) < (lzo_uint)(x)) goto input_overrun
+#define NEED_OP(x)	if ((lzo_uint)(op_end - op) < (lzo_uint)(x)) goto output_overrun
+#define TEST_LB(m)	if ((m) < out || (m) >= op) goto lookbehind_overrun
+
+int lzo1x_decompress_x   ( const lzo_byte * in, lzo_uint  in_len,
+                                 lzo_byte * out, lzo_uint * out_len,
+                                 lzo_voidp )
+{
+	register lzo_byte *op;
+	register const lzo_byte *ip;
+	register lzo_uint t;
+	register const lzo_byte *m_pos;
+	const lzo_byte * const ip_end = in + in_len;
+	lzo_byte * const op_end = out + *out_len;
+
+	*out_len = 0;
+
+	op = out;
+	ip = in;
+
+	NEED_IP(1);
+	if (*ip > 17) {
+		t = *ip++ - 17;
+		goto first_literal_run;
+	}
+
+	for (;;) {
+		NEED_IP(1);
+		t = *ip++;
+		if (t >= 16)
+			goto match;
+		/* a literal run */
+		if (t == 0) {
+			t = 15;
+			NEED_IP(1);
+			while (*ip == 0) {
+				t += 255, ip++;
+				NEED_IP(1);
+			}
+			t += *ip++;
+		}
+		/* copy literals */
+		NEED_OP(3);
+		NEED_IP(3);
+		*op++ = *ip++; *op++ = *ip++; *op++ = *ip++;
+first_literal_run:
+		NEED_OP(t);
+		NEED_IP(t + 1);
+		do *op++ = *ip++; while (--t > 0);
+
+
+		t = *ip++;
+
+		if (t >= 16) {
+			goto match;
+		}
+#if defined(LZO1X)
+		m_pos = op - 1 - 0x800;
+#elif defined(LZO1Y)
+		m_pos = op - 1 - 0x400;
+#endif
+		m_pos -= t >> 2;
+		NEED_IP(1);
+		m_pos -= *ip++ << 2;
+		TEST_LB(m_pos);
+		NEED_OP(3);
+		*op++ = *m_pos++;
+		*op++ = *m_pos++;
+		*op++ = *m_pos;
+		goto match_done;
+
+
+		/* handle matches */
+		for (;;) {
+			if (t < 16) {						/* a M1 match */
+				m_pos = op - 1;
+				m_pos -= t >> 2;
+				NEED_IP(1);
+				m_pos -= *ip++ << 2;
+				TEST_LB(m_pos);
+				NEED_OP(2);
+				*op++ = *m_pos++;
+				*op++ = *m_pos;
+			} else {
+match:
+				if (t >= 64) {				/* a M2 match */
+					m_pos = op - 1;
+					NEED_IP(1);
+#if defined(LZO1X)
+					m_pos -= (t >> 2) & 7;
+					m_pos -= *ip++ << 3;
+					t = (t >> 5) - 1;
+#elif defined(LZO1Y)
+					m_pos -= (t >> 2) & 3;
+					m_pos -= *ip++ << 2;
+					t = (t >> 4) - 3;
+#endif
+				} else {
+					if (t >= 32) {			/* a M3 match */
+						t &= 31;
+						if (t == 0) {
+							t = 31;
+							NEED_IP(1);
+							while (*ip == 0) {
+								t += 255, ip++;
+								NEED_IP(1);
+							}
+							t += *ip++;
+						}
+						NEED_IP(2);
+						m_pos = op - 1;
+						m_pos -= *ip++ >> 2;
+						m_pos -= *ip++ << 6;
+					} else {						/* a M4 match */
+						m_pos = op;
+						m_pos -= (t & 8) << 11;
+						t &= 7;
+						if (t == 0) {
+							t = 7;
+							NEED_IP(1);
+							while (*ip == 0) {
+								t += 255, ip++;
+								NEED_IP(1);
+							}
+							t += *ip++;
+						}
+						NEED_IP(2);
+						m_pos -= *ip++ >> 2;
+						m_pos -= *ip++ << 6;
+						if (m_pos == op) {
+							goto eof_found;
+						}
+						m_pos -= 0x4000;
+					}
+				}
+				TEST_LB(m_pos);
+				NEED_OP(t + 2);
+				*op++ = *m_pos++; *op++ = *m_pos++;
+				do *op++ = *m_pos++; while (--t > 0);
+			}
+
+match_done:
+			t = ip[-2] & 3;
+			if (t == 0)
+				break;
+			/* copy literals */
+			NEED_OP(t);
+			NEED_IP(t + 1);
+			do *op++ = *ip++; while (--t > 0);
+			t = *ip++;
+		}
+	}
+
+eof_found:
+	*out_len = op - out;
+	return (ip == ip_end ? LZO_E_OK : LZO_E_ERROR);
+
+input_overrun:
+	*out_len = op - out;
+	return LZO_E_INPUT_OVERRUN;
+
+output_overrun:
+	*out_len = op - out;
+	return LZO_E_OUTPUT_OVERRUN;
+
+lookbehind_overrun:
+	*out_len = op - out;
+	return LZO_E_LOOKBEHIND_OVERRUN;
+}
+
+#undef NEED_IP
+#undef NEED_OP
+#undef TEST_LB
+
 /*
 vi:ts=4
 */
@@ -0,0 +1,390 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/***********************************************************************************************
+ ***              C O N F I D E N T I A L  ---  W E S T W O O D  S T U D I O S               ***
+ ***********************************************************************************************
+ *                                                                                             *
+ *                 Project Name : WWLib                                                        *
+ *                                                                                             *
+ *                     $Archive:: /Commando/Code/wwlib/mappedfile.cpp                         $*
+ *                                                                                             *
+ *---------------------------------------------------------------------------------------------*
+ * Functions:                                                                                  *
+ *   FileMappingClass::FileMappingClass -- Constructor for an empty mapping.                   *
+ *   FileMappingClass::~FileMappingClass -- Destructor, unmaps the file.                       *
+ *   FileMappingClass::Map -- Maps an open file into memory.                                   *
+ *   FileMappingClass::Unmap -- Releases the mapping.                                          *
+ *   MappedFileClass::MappedFileClass -- Constructs a file over a block of memory.             *
+ *   MappedFileClass::~MappedFileClass -- Destructor for the mapped file.                      *
+ *   MappedFileClass::Set_Name -- Sets the name reported by File_Name.                         *
+ *   MappedFileClass::Open -- Opens the file for reading.                                      *
+ *   MappedFileClass::Read -- Copies data out of the file.                                     *
+ *   MappedFileClass::Seek -- Moves the read position.                                         *
+ *   MappedFileClass::Bias -- Restricts the file to a part of itself.                          *
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+#include "mappedfile.h"
+#include "rawfile.h"
+#include "wwdebug.h"
+#include <string.h>
+
+#ifdef _UNIX
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#else
+#include "win.h"
+#endif
+
+
+/***********************************************************************************************
+ * FileMappingClass::FileMappingClass -- Constructor for an empty mapping.                     *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+FileMappingClass::FileMappingClass(void) :
+	View(NULL),
+	ViewSize(0),
+	Data(NULL),
+	Size(0)
+{
+}
+
+
+/***********************************************************************************************
+ * FileMappingClass::~FileMappingClass -- Destructor, unmaps the file.                         *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   Any MappedFileClass objects made over this mapping become invalid.              *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+FileMappingClass::~FileMappingClass(void)
+{
+	Unmap();
+}
+
+
+/***********************************************************************************************
+ * FileMappingClass::Map -- Maps an open file into memory.                                     *
+ *                                                                                             *
+ *    Only the part of the file the file object covers is mapped, so a file biased to a part   *
+ *    of a larger file maps just that part. The file can be closed again once this returns.   *
+ *                                                                                             *
+ * INPUT:   file  -- The file to map. It must be open.                                         *
+ *                                                                                             *
+ * OUTPUT:  bool; Was the file mapped? An empty file can't be mapped.                          *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+bool FileMappingClass::Map(RawFileClass & file)
+{
+	Unmap();
+
+	if (!file.Is_Open() || file.Size() <= 0) {
+		return(false);
+	}
+
+	int size = file.Size();
+	unsigned long start = file.BiasStart;
+
+#ifdef _UNIX
+	FILE * handle = (FILE *)file.Get_File_Handle();
+	if (handle == NULL) {
+		return(false);
+	}
+
+	unsigned long granularity = (unsigned long)sysconf(_SC_PAGESIZE);
+	unsigned long view_start = start - (start % granularity);
+	unsigned long view_size = (start - view_start) + size;
+
+	void * view = mmap(NULL, view_size, PROT_READ, MAP_SHARED, fileno(handle), view_start);
+	if (view == MAP_FAILED) {
+		return(false);
+	}
+#else
+	HANDLE handle = (HANDLE)file.Get_File_Handle();
+	if (handle == INVALID_HANDLE_VALUE) {
+		return(false);
+	}
+
+	SYSTEM_INFO info;
+	::GetSystemInfo(&info);
+	unsigned long granularity = info.dwAllocationGranularity;
+	unsigned long view_start = start - (start % granularity);
+	unsigned long view_size = (start - view_start) + size;
+
+	/*
+	**	The view keeps the mapping object alive, so the mapping handle can be closed as
+	**	soon as the view exists.
+	*/
+	HANDLE mapping = ::CreateFileMapping(handle, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (mapping == NULL) {
+		return(false);
+	}
+	void * view = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, view_start, view_size);
+	::CloseHandle(mapping);
+	if (view == NULL) {
+		return(false);
+	}
+#endif
+
+	View = view;
+	ViewSize = view_size;
+	Data = (const unsigned char *)view + (start - view_start);
+	Size = size;
+	return(true);
+}
+
+
+/***********************************************************************************************
+ * FileMappingClass::Unmap -- Releases the mapping.                                            *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   Any MappedFileClass objects made over this mapping become invalid.              *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void FileMappingClass::Unmap(void)
+{
+	if (View != NULL) {
+#ifdef _UNIX
+		munmap(View, ViewSize);
+#else
+		::UnmapViewOfFile(View);
+#endif
+	}
+
+	View = NULL;
+	ViewSize = 0;
+	Data = NULL;
+	Size = 0;
+}
+
+
+/***********************************************************************************************
+ * MappedFileClass::MappedFileClass -- Constructs a file over a block of memory.               *
+ *                                                                                             *
+ * INPUT:   data     -- The file contents. They must stay valid for the life of this object.   *
+ *                                                                                             *
+ *          size     -- The size of the file contents.                                         *
+ *                                                                                             *
+ *          filename -- The name reported by File_Name, or NULL.                               *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+MappedFileClass::MappedFileClass(void const * data, int size, char const * filename) :
+	Data((const unsigned char *)data),
+	Length(size),
+	Offset(0),
+	IsOpen(false),
+	Filename(filename)
+{
+}
+
+
+/***********************************************************************************************
+ * MappedFileClass::~MappedFileClass -- Destructor for the mapped file.                        *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+MappedFileClass::~MappedFileClass(void)
+{
+	Close();
+}
+
+
+/***********************************************************************************************
+ * MappedFileClass::Set_Name -- Sets the name reported by File_Name.                           *
+ *                                                                                             *
+ *    The name is only a label, the contents of the file don't change.                         *
+ *                                                                                             *
+ * INPUT:   filename -- The new name.                                                          *
+ *                                                                                             *
+ * OUTPUT:  Returns with the name.                                                             *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+char const * MappedFileClass::Set_Name(char const * filename)
+{
+	Filename = filename;
+	return(Filename);
+}
+
+
+/***********************************************************************************************
+ * MappedFileClass::Open -- Opens the file for reading.                                        *
+ *                                                                                             *
+ * INPUT:   filename -- Ignored, the file is always the block of memory it was made with.      *
+ *                                                                                             *
+ *          access   -- Only READ is allowed.                                                  *
+ *                                                                                             *
+ * OUTPUT:  bool; Was the file opened?                                                         *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+int MappedFileClass::Open(char const *, int access)
+{
+	return(Open(access));
+}
+
+int MappedFileClass::Open(int access)
+{
+	if (Data == NULL || Is_Open() || (access & WRITE) != 0) {
+		return(false);
+	}
+
+	Offset = 0;
+	IsOpen = true;
+	return(true);
+}
+
+
+/***********************************************************************************************
+ * MappedFileClass::Read -- Copies data out of the file.                                       *
+ *                                                                                             *
+ *    Like the other file classes, reading a closed file opens it for the read and closes it   *
+ *    again afterwards.                                                                        *
+ *                                                                                             *
+ * INPUT:   buffer   -- Where to copy the data to.                                             *
+ *                                                                                             *
+ *          size     -- The number of bytes to read.                                           *
+ *                                                                                             *
+ * OUTPUT:  Returns with the number of bytes read.                                             *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+int MappedFileClass::Read(void * buffer, int size)
+{
+	if (Data == NULL || buffer == NULL || size <= 0) {
+		return(0);
+	}
+
+	bool hasopened = false;
+	if (!Is_Open()) {
+		Open(READ);
+		hasopened = true;
+	}
+
+	int tocopy = (size < (Length-Offset)) ? size : (Length-Offset);
+	memcpy(buffer, &Data[Offset], tocopy);
+	Offset += tocopy;
+
+	if (hasopened) {
+		Close();
+	}
+	return(tocopy);
+}
+
+
+/***********************************************************************************************
+ * MappedFileClass::Seek -- Moves the read position.                                           *
+ *                                                                                             *
+ * INPUT:   pos   -- The position, relative to dir.                                            *
+ *                                                                                             *
+ *          dir   -- SEEK_SET, SEEK_CUR or SEEK_END.                                           *
+ *                                                                                             *
+ * OUTPUT:  Returns with the new read position, which is kept within the file.                 *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+int MappedFileClass::Seek(int pos, int dir)
+{
+	if (Data == NULL || !Is_Open()) {
+		return(Offset);
+	}
+
+	switch (dir) {
+		case SEEK_CUR:
+			Offset += pos;
+			break;
+
+		case SEEK_SET:
+			Offset = pos;
+			break;
+
+		case SEEK_END:
+			Offset = Length + pos;
+			break;
+	}
+
+	if (Offset < 0) Offset = 0;
+	if (Offset > Length) Offset = Length;
+	return(Offset);
+}
+
+
+/***********************************************************************************************
+ * MappedFileClass::Bias -- Restricts the file to a part of itself.                            *
+ *                                                                                             *
+ * INPUT:   start    -- Offset of the part, from the start of the file as it is now.           *
+ *                                                                                             *
+ *          length   -- Size of the part, or -1 for the rest of the file.                      *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   Unlike RawFileClass, a bias can't be undone.                                    *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void MappedFileClass::Bias(int start, int length)
+{
+	if (start < 0) start = 0;
+	if (start > Length) start = Length;
+
+	Data += start;
+	Length -= start;
+	if (length >= 0 && length < Length) {
+		Length = length;
+	}
+
+	Offset = 0;
+}
@@ -0,0 +1,129 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/***********************************************************************************************
+ ***              C O N F I D E N T I A L  ---  W E S T W O O D  S T U D I O S               ***
+ ***********************************************************************************************
+ *                                                                                             *
+ *                 Project Name : WWLib                                                        *
+ *                                                                                             *
+ *                     $Archive:: /Commando/Code/wwlib/mappedfile.h                           $*
+ *                                                                                             *
+ *---------------------------------------------------------------------------------------------*
+ * Functions:                                                                                  *
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include "always.h"
+#include "wwfile.h"
+#include "wwstring.h"
+
+class RawFileClass;
+
+
+/*
+**	A read-only memory mapping of a file (or of the biased part of a file) on disk. The
+**	mapping stays valid after the file it was made from is closed, until Unmap is called
+**	or the mapping object is destroyed.
+*/
+class FileMappingClass
+{
+	public:
+		FileMappingClass(void);
+		~FileMappingClass(void);
+
+		bool Map(RawFileClass & file);
+		void Unmap(void);
+
+		bool Is_Mapped(void) const {return(Data != NULL);}
+		const unsigned char * Get_Data(void) const {return(Data);}
+		int Get_Size(void) const {return(Size);}
+
+	private:
+
+		/*
+		**	The mapped view. The view starts on an allocation boundary, so the file data
+		**	may start part way into it.
+		*/
+		void * View;
+		unsigned long ViewSize;
+
+		/*
+		**	The file data within the view.
+		*/
+		const unsigned char * Data;
+		int Size;
+
+		FileMappingClass(FileMappingClass const &);
+		FileMappingClass & operator = (FileMappingClass const &);
+};
+
+
+/*
+**	A read-only file over a block of memory that something else owns, normally part of a
+**	FileMappingClass. Opening, reading and seeking never touch the operating system, and
+**	Peek_Data gives the caller the file contents directly.
+*/
+class MappedFileClass : public FileClass
+{
+	public:
+		MappedFileClass(void const * data, int size, char const * filename=NULL);
+		virtual ~MappedFileClass(void);
+
+		virtual char const * File_Name(void) const {return(Filename);}
+		virtual char const * Set_Name(char const * filename);
+		virtual int Create(void) {return(false);}
+		virtual int Delete(void) {return(false);}
+		virtual bool Is_Available(int forced=false) {return(Data != NULL);}
+		virtual bool Is_Open(void) const {return(IsOpen);}
+		virtual int Open(char const * filename, int access=READ);
+		virtual int Open(int access=READ);
+		virtual int Read(void * buffer, int size);
+		virtual int Seek(int pos, int dir=SEEK_CUR);
+		virtual int Size(void) {return(Length);}
+		virtual int Write(void const * , int ) {return(0);}
+		virtual void Close(void) {IsOpen = false;}
+		virtual void Error(int , int = false, char const * =NULL) {}
+		virtual void Bias(int start, int length=-1);
+		virtual const void * Peek_Data(void) {return(Data);}
+
+	private:
+
+		/*
+		**	The file contents and their size.
+		*/
+		const unsigned char * Data;
+		int Length;
+
+		/*
+		**	The current read position.
+		*/
+		int Offset;
+
+		bool IsOpen;
+		StringClass Filename;
+};
+
+
+#endif
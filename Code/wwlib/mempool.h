@@ -38,6 +38,11 @@
  *   ObjectPoolClass::Free_Object -- releases obj back into the pool                           *
  *   ObjectPoolClass::Allocate_Object_Memory -- internal function which returns memory for an  *
  *   ObjectPoolClass::Free_Object_Memory -- internal function, returns object's memory to the  *
+ *   ObjectPoolClass::Refill_Magazine -- moves a batch of free objects into a magazine         *
+ *   ObjectPoolClass::Drain_Magazine -- moves objects from a magazine back to the pool         *
+ *   ObjectPoolClass::Allocate_Block -- allocates another block of objects                     *
+ *   ObjectPoolMagazineClass::Allocate_Object_Memory -- returns memory for an object           *
+ *   ObjectPoolMagazineClass::Free_Object_Memory -- caches the memory of a freed object        *
  *   AutoPoolClass::operator new -- overriden new which calls the internal ObjectPool          *
  *   AutoPoolClass::operator delete -- overriden delete which calls the internal ObjectPool    *
  * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
@@ -58,6 +63,8 @@
 #include <stddef.h>
 
 
+template<class T,int BLOCK_SIZE> class ObjectPoolMagazineClass;
+
 
 /**********************************************************************************************
 ** ObjectPoolClass
@@ -73,6 +80,10 @@
 ** ListNodeClass * node = NodePool.Allocate_Object();
 ** NodePool.Free_Object(node);
 **
+** Every call to Allocate_Object_Memory and Free_Object_Memory takes the pool's lock.  Code
+** which uses a pool from several threads can go through an ObjectPoolMagazineClass (below)
+** instead, which only takes the lock once per batch of objects.
+**
 **********************************************************************************************/
 template<class T,int BLOCK_SIZE = 64> 
 class ObjectPoolClass
@@ -88,17 +99,74 @@ public:
 	T *		Allocate_Object_Memory(void);
 	void		Free_Object_Memory(T * obj);
 
+	void		Attach_Magazine(ObjectPoolMagazineClass<T,BLOCK_SIZE> & magazine);
+	void		Detach_Magazine(ObjectPoolMagazineClass<T,BLOCK_SIZE> & magazine);
+	void		Refill_Magazine(ObjectPoolMagazineClass<T,BLOCK_SIZE> & magazine);
+	void		Drain_Magazine(ObjectPoolMagazineClass<T,BLOCK_SIZE> & magazine,int count);
+
+	// Statistics, objects held in magazines are counted as in use
+	int		Get_Free_Object_Count(void) const		{ return FreeObjectCount; }
+	int		Get_Total_Object_Count(void) const		{ return TotalObjectCount; }
+	int		Get_Magazine_Refill_Count(void) const	{ return RefillCount; }
+	int		Get_Magazine_Drain_Count(void) const	{ return DrainCount; }
+	int		Get_Magazine_Count(void) const			{ return MagazineCount; }
+
 protected:
 
+	void		Allocate_Block(void);
+
 	T	*		FreeListHead;			
 	uint32 *	BlockListHead;			
 	int		FreeObjectCount;
 	int		TotalObjectCount;
+	int		RefillCount;
+	int		DrainCount;
+	int		MagazineCount;			// magazines attached to this pool
 	FastCriticalSectionClass ObjectPoolCS;
 
 };
 
 
+/**********************************************************************************************
+** ObjectPoolMagazineClass
+**
+** A private stack of free objects for one thread.  Allocating from and freeing to a magazine
+** doesn't take any lock; when the magazine runs dry it grabs BLOCK_SIZE objects from the pool
+** at once and when it holds more than twice that it gives half of them back.  An object can
+** be freed to a different magazine (or thread) than the one it was allocated from.
+**
+** A magazine attaches to the first pool it is used with.  Flush (and the destructor) gives
+** everything it holds back and detaches it; the pool only checks for leaks when no
+** magazines are attached since it can't count the objects they hold.  A magazine must not 
+** be used once it has been destroyed, see AutoPoolClass for how thread-local magazines 
+** deal with that.
+**
+**********************************************************************************************/
+template<class T,int BLOCK_SIZE> 
+class ObjectPoolMagazineClass
+{
+public:
+
+	ObjectPoolMagazineClass(void) : Pool(NULL), Head(NULL), Count(0), Limit(2 * BLOCK_SIZE) { }
+	~ObjectPoolMagazineClass(void)									{ Flush(); }
+
+	T *		Allocate_Object_Memory(ObjectPoolClass<T,BLOCK_SIZE> & pool);
+	void		Free_Object_Memory(ObjectPoolClass<T,BLOCK_SIZE> & pool,T * obj);
+	void		Flush(void)													{ if (Pool != NULL) Pool->Detach_Magazine(*this); }
+
+	int		Get_Object_Count(void) const							{ return Count; }
+
+protected:
+
+	ObjectPoolClass<T,BLOCK_SIZE> *	Pool;
+	T *										Head;
+	int										Count;
+	int										Limit;
+
+	friend class ObjectPoolClass<T,BLOCK_SIZE>;
+};
+
+
 
 /**********************************************************************************************
 ** AutoPoolClass
@@ -113,6 +181,10 @@ protected:
 ** - You must define the instance of the static object pool (Allocator)
 ** - You can't derive a class from a class that is derived from AutoPoolClass 
 **   because its size won't match but it will try to use the same pool...
+** - Each thread allocates and frees through its own magazine so the common case
+**   doesn't touch the pool's lock.  Once a thread's magazine has been destroyed
+**   (objects freed by other thread-local destructors) that thread goes straight
+**   to the pool, and a magazine destroyed after the pool just forgets its objects.
 **
 ** Example Usage:
 ** --------------
@@ -147,18 +219,55 @@ private:
 	static void *	operator new [] (size_t size);
 	static void		operator delete[] (void * memory);
 
+	/*
+	** The pool and the magazines record their own destruction in plain flags, which
+	** are never destroyed, so that late frees can tell whether it's safe to use them.
+	*/
+	class AllocatorClass : public ObjectPoolClass<T,BLOCK_SIZE>
+	{
+	public:
+		~AllocatorClass(void)		{ AllocatorDestroyed = true; }
+	};
+
+	class MagazineClass : public ObjectPoolMagazineClass<T,BLOCK_SIZE>
+	{
+	public:
+		~MagazineClass(void)
+		{
+			MagazineDestroyed = true;
+			if (AllocatorDestroyed) {
+				this->Pool = NULL;		// the pool's memory is gone along with our objects
+				this->Head = NULL;
+				this->Count = 0;
+			}
+		}
+	};
+
 	// This must be staticly declared by user
-	static ObjectPoolClass<T,BLOCK_SIZE>	Allocator;
+	static AllocatorClass					Allocator;
+	static bool									AllocatorDestroyed;
+
+	static thread_local MagazineClass	Magazine;
+	static thread_local bool				MagazineDestroyed;
 
 };
 
+template<class T, int BLOCK_SIZE>
+bool AutoPoolClass<T,BLOCK_SIZE>::AllocatorDestroyed = false;
+
+template<class T, int BLOCK_SIZE>
+thread_local typename AutoPoolClass<T,BLOCK_SIZE>::MagazineClass AutoPoolClass<T,BLOCK_SIZE>::Magazine;
+
+template<class T, int BLOCK_SIZE>
+thread_local bool AutoPoolClass<T,BLOCK_SIZE>::MagazineDestroyed = false;
+
 /*
 ** DEFINE_AUTO_POOL(T,BLOCKSIZE)
 ** Macro to declare the allocator for your class.  Put this in the cpp file for
 ** the class.
 */
 #define DEFINE_AUTO_POOL(T,BLOCKSIZE) \
-ObjectPoolClass<T,BLOCKSIZE> AutoPoolClass<T,BLOCKSIZE>::Allocator;
+AutoPoolClass<T,BLOCKSIZE>::AllocatorClass AutoPoolClass<T,BLOCKSIZE>::Allocator;
 
 
 /***********************************************************************************************
@@ -179,7 +288,10 @@ ObjectPoolClass<T,BLOCK_SIZE>::ObjectPoolClass(void) :
 	FreeListHead(NULL),
 	BlockListHead(NULL),
 	FreeObjectCount(0),
-	TotalObjectCount(0) 
+	TotalObjectCount(0),
+	RefillCount(0),
+	DrainCount(0),
+	MagazineCount(0)
 { 
 }
 	
@@ -199,8 +311,10 @@ ObjectPoolClass<T,BLOCK_SIZE>::ObjectPoolClass(void) :
 template<class T,int BLOCK_SIZE> 
 ObjectPoolClass<T,BLOCK_SIZE>::~ObjectPoolClass(void)
 {
-	// assert that the user gave back all of the memory he was using
-	WWASSERT(FreeObjectCount == TotalObjectCount);
+	// assert that the user gave back all of the memory he was using.  Objects cached in
+	// the magazines of threads that are still running can't be counted so the check is
+	// only made once every magazine has been flushed.
+	WWASSERT((MagazineCount > 0) || (FreeObjectCount == TotalObjectCount));
 
 	// delete all of the blocks we allocated
 	int block_count = 0;
@@ -279,22 +393,7 @@ T * ObjectPoolClass<T,BLOCK_SIZE>::Allocate_Object_Memory(void)
 	FastCriticalSectionClass::LockClass lock(ObjectPoolCS);
 
 	if ( FreeListHead == 0 ) {  
-
-		// No free objects, allocate another block
-		uint32 * tmp_block_head = BlockListHead;
-		BlockListHead = (uint32*)::operator new( sizeof(T) * BLOCK_SIZE + sizeof(uint32 *));
-		// Link this block into the block list
-		*(void **)BlockListHead = tmp_block_head;
-
-		// Link the objects in the block into the free object list
-		FreeListHead = (T*)(BlockListHead + 1);
-		for ( int i = 0; i < BLOCK_SIZE; i++ ) {	
-			*(T**)(&(FreeListHead[i])) = &(FreeListHead[i+1]);	// link up the elements
-		}
-		*(T**)(&(FreeListHead[BLOCK_SIZE-1])) = 0;				// Mark the end
-
-		FreeObjectCount += BLOCK_SIZE;
-		TotalObjectCount += BLOCK_SIZE;
+		Allocate_Block();
 	}
 
 	T * obj = FreeListHead;						// Get the next free object
@@ -329,6 +428,228 @@ void ObjectPoolClass<T,BLOCK_SIZE>::Free_Object_Memory(T * obj)
 }
 
 
+/***********************************************************************************************
+ * ObjectPoolClass::Attach_Magazine -- starts tracking a magazine                              *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ * The magazine must belong to the calling thread                                              *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+template<class T,int BLOCK_SIZE> 
+void ObjectPoolClass<T,BLOCK_SIZE>::Attach_Magazine(ObjectPoolMagazineClass<T,BLOCK_SIZE> & magazine)
+{
+	FastCriticalSectionClass::LockClass lock(ObjectPoolCS);
+
+	WWASSERT(magazine.Pool == NULL);
+	magazine.Pool = this;
+	MagazineCount++;
+}
+
+
+/***********************************************************************************************
+ * ObjectPoolClass::Detach_Magazine -- takes back everything in a magazine and forgets it      *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ * The magazine must belong to the calling thread                                              *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+template<class T,int BLOCK_SIZE> 
+void ObjectPoolClass<T,BLOCK_SIZE>::Detach_Magazine(ObjectPoolMagazineClass<T,BLOCK_SIZE> & magazine)
+{
+	WWASSERT(magazine.Pool == this);
+	Drain_Magazine(magazine,magazine.Count);
+
+	FastCriticalSectionClass::LockClass lock(ObjectPoolCS);
+	magazine.Pool = NULL;
+	MagazineCount--;
+}
+
+
+/***********************************************************************************************
+ * ObjectPoolClass::Refill_Magazine -- moves a batch of free objects into a magazine           *
+ *                                                                                             *
+ * Up to BLOCK_SIZE objects are unlinked from the free list (allocating a new block if there   *
+ * are none) and pushed onto the magazine.                                                     *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+template<class T,int BLOCK_SIZE> 
+void ObjectPoolClass<T,BLOCK_SIZE>::Refill_Magazine(ObjectPoolMagazineClass<T,BLOCK_SIZE> & magazine)
+{
+	FastCriticalSectionClass::LockClass lock(ObjectPoolCS);
+
+	if ( FreeListHead == 0 ) {  
+		Allocate_Block();
+	}
+
+	int count = (FreeObjectCount < BLOCK_SIZE) ? FreeObjectCount : BLOCK_SIZE;
+	T * head = FreeListHead;
+	T * tail = head;
+	for ( int i = 1; i < count; i++ ) {
+		tail = *(T**)(tail);
+	}
+
+	FreeListHead = *(T**)(tail);				// Unlink the batch
+	*(T**)(tail) = magazine.Head;				// and push it onto the magazine
+	magazine.Head = head;
+	magazine.Count += count;
+
+	FreeObjectCount -= count;
+	RefillCount++;
+}
+
+
+/***********************************************************************************************
+ * ObjectPoolClass::Drain_Magazine -- moves objects from a magazine back to the pool           *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * magazine - magazine to take the objects from                                                *
+ * count - number of objects to move                                                           *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ * The magazine must belong to the calling thread                                              *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+template<class T,int BLOCK_SIZE> 
+void ObjectPoolClass<T,BLOCK_SIZE>::Drain_Magazine(ObjectPoolMagazineClass<T,BLOCK_SIZE> & magazine,int count)
+{
+	WWASSERT(count <= magazine.Count);
+	if (count <= 0) return;
+
+	// Find the end of the batch without holding the lock
+	T * head = magazine.Head;
+	T * tail = head;
+	for ( int i = 1; i < count; i++ ) {
+		tail = *(T**)(tail);
+	}
+	magazine.Head = *(T**)(tail);
+	magazine.Count -= count;
+
+	FastCriticalSectionClass::LockClass lock(ObjectPoolCS);
+	*(T**)(tail) = FreeListHead;				// Splice the batch onto the free list
+	FreeListHead = head;
+	FreeObjectCount += count;
+	DrainCount++;
+}
+
+
+/***********************************************************************************************
+ * ObjectPoolClass::Allocate_Block -- allocates another block of objects                       *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ * The caller must hold ObjectPoolCS and the free list must be empty                           *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *   7/29/99    GTH : Created.                                                                 *
+ *=============================================================================================*/
+template<class T,int BLOCK_SIZE> 
+void ObjectPoolClass<T,BLOCK_SIZE>::Allocate_Block(void)
+{
+	WWASSERT(FreeListHead == 0);
+
+	uint32 * tmp_block_head = BlockListHead;
+	BlockListHead = (uint32*)::operator new( sizeof(T) * BLOCK_SIZE + sizeof(uint32 *));
+	// Link this block into the block list
+	*(void **)BlockListHead = tmp_block_head;
+
+	// Link the objects in the block into the free object list
+	FreeListHead = (T*)(BlockListHead + 1);
+	for ( int i = 0; i < BLOCK_SIZE; i++ ) {	
+		*(T**)(&(FreeListHead[i])) = &(FreeListHead[i+1]);	// link up the elements
+	}
+	*(T**)(&(FreeListHead[BLOCK_SIZE-1])) = 0;				// Mark the end
+
+	FreeObjectCount += BLOCK_SIZE;
+	TotalObjectCount += BLOCK_SIZE;
+}
+
+
+/***********************************************************************************************
+ * ObjectPoolMagazineClass::Allocate_Object_Memory -- returns memory for an object             *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * pool - the pool this magazine refills from                                                  *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+template<class T,int BLOCK_SIZE> 
+T * ObjectPoolMagazineClass<T,BLOCK_SIZE>::Allocate_Object_Memory(ObjectPoolClass<T,BLOCK_SIZE> & pool)
+{
+	if ( Head == 0 ) {
+		if ( Pool == NULL ) {
+			pool.Attach_Magazine(*this);
+		}
+		WWASSERT(Pool == &pool);
+		pool.Refill_Magazine(*this);
+	}
+
+	T * obj = Head;
+	Head = *(T**)(Head);
+	Count--;
+
+	return obj;
+}
+
+
+/***********************************************************************************************
+ * ObjectPoolMagazineClass::Free_Object_Memory -- caches the memory of a freed object          *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * pool - the pool this magazine drains into                                                   *
+ * obj - object being freed                                                                    *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+template<class T,int BLOCK_SIZE> 
+void ObjectPoolMagazineClass<T,BLOCK_SIZE>::Free_Object_Memory(ObjectPoolClass<T,BLOCK_SIZE> & pool,T * obj)
+{
+	WWASSERT(obj != NULL);
+	if ( Pool == NULL ) {
+		pool.Attach_Magazine(*this);
+	}
+	WWASSERT(Pool == &pool);
+
+	*(T**)(obj) = Head;
+	Head = obj;
+	Count++;
+
+	if ( Count > Limit ) {
+		pool.Drain_Magazine(*this,Count - Limit / 2);
+	}
+}
+
+
 /***********************************************************************************************
  * AutoPoolClass::operator new -- overriden new which calls the internal ObjectPool            *
  *                                                                                             *
@@ -345,7 +666,10 @@ template<class T, int BLOCK_SIZE>
 void * AutoPoolClass<T,BLOCK_SIZE>::operator new( size_t size ) 
 {
 	WWASSERT(size == sizeof(T));
-	return (void *)(Allocator.Allocate_Object_Memory());
+	if ( MagazineDestroyed ) {
+		return (void *)(Allocator.Allocate_Object_Memory());
+	}
+	return (void *)(Magazine.Allocate_Object_Memory(Allocator));
 }
 
 
@@ -365,7 +689,11 @@ template<class T, int BLOCK_SIZE>
 void AutoPoolClass<T,BLOCK_SIZE>::operator delete( void * memory ) 
 {
 	if ( memory == 0 ) return;
-	Allocator.Free_Object_Memory((T*)memory);
+	if ( MagazineDestroyed ) {
+		Allocator.Free_Object_Memory((T*)memory);
+		return;
+	}
+	Magazine.Free_Object_Memory(Allocator,(T*)memory);
 }
  
 
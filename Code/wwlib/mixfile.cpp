@@ -39,9 +39,13 @@
 #include "ffactory.h"
 #include "wwfile.h"
 #include "realcrc.h"
+#include "stringatom.h"
 #include "rawfile.h"
+#include "compressedfile.h"
+#include "lzo.h"
 #include "win.h"
 #include "bittype.h"
+#include <limits.h>
 
 /*
 **
@@ -54,6 +58,15 @@ typedef struct
 
 } MIXFILE_HEADER;
 
+//
+//	MIX2 files have the same layout as MIX1 files, except that the word after the header
+// (unused in MIX1 files) holds the compression block size, and each entry in the index
+// has a fourth word with its stored size. An entry whose stored size is less than its
+// size is compressed.
+//
+#define	MIX2_MIN_BLOCK_SIZE		0x1000
+#define	MIX2_MAX_BLOCK_SIZE		0x1000000
+
 typedef struct
 {
 	long	file_count;
@@ -61,12 +74,28 @@ typedef struct
 } MIXFILE_DATA_HEADER;
 
 
+bool MixFileFactoryClass::UseMemoryMapping = false;
+
+
+/*
+**	Checks that an entry's stored data lies inside a mix file of the given size. The
+** sums are never formed, so huge offsets and sizes can't wrap around and pass.
+*/
+static inline bool Entry_In_Bounds( unsigned long offset, unsigned long stored_size, unsigned long base_offset, unsigned long size )
+{
+	return	base_offset <= size &&
+				offset <= size - base_offset &&
+				stored_size <= size - base_offset - offset;
+}
+
+
 /*
 **
 */					
 MixFileFactoryClass::MixFileFactoryClass( const char * mix_filename, FileFactoryClass * factory )	:
 	FileCount (0),
 	NamesOffset (0),
+	BlockSize (0),
 	IsValid (false),
 	BaseOffset (0),
 	Factory (NULL),
@@ -97,8 +126,20 @@ MixFileFactoryClass::MixFileFactoryClass( const char * mix_filename, FileFactory
 		//
 		//	Validate the file header
 		//
+		bool compressed = false;
 		if ( IsValid ) {
-			IsValid = (::memcmp( header.signature, "MIX1", sizeof ( header.signature ) ) == 0);
+			compressed = (::memcmp( header.signature, "MIX2", sizeof ( header.signature ) ) == 0);
+			IsValid = compressed || (::memcmp( header.signature, "MIX1", sizeof ( header.signature ) ) == 0);
+		}
+
+		//
+		//	Compressed mix files keep their block size after the header
+		//
+		if ( IsValid && compressed ) {
+			long block_size = 0;
+			IsValid = ( file->Read( &block_size, sizeof( block_size ) ) == sizeof( block_size ) );
+			IsValid = IsValid && ( block_size >= MIX2_MIN_BLOCK_SIZE ) && ( block_size <= MIX2_MAX_BLOCK_SIZE );
+			BlockSize = IsValid ? block_size : 0;
 		}
 
 		//
@@ -114,9 +155,7 @@ MixFileFactoryClass::MixFileFactoryClass( const char * mix_filename, FileFactory
 		//	Read the array of data headers
 		//
 		if ( IsValid ) {
-			FileInfo.Resize( FileCount );
-			int size = FileCount * sizeof( FileInfoStruct );
-			IsValid = ( file->Read( &FileInfo[0], size ) == size );
+			IsValid = Read_File_Info( *file );
 		}
 
 		//
@@ -126,6 +165,17 @@ MixFileFactoryClass::MixFileFactoryClass( const char * mix_filename, FileFactory
 			BaseOffset	= 0;
 			NamesOffset	= header.names_offset;
 			WWDEBUG_SAY(( "MixFileFactory( %s ) loaded successfully  %d files\n", MixFilename, FileInfo.Length() ));
+
+			//
+			//	Map the mix file if it is a file on disk. A mix file that is already in
+			// memory (inside another mapped mix file), or is compressed inside another mix
+			// file, is read through its parent.
+			//
+			if ( UseMemoryMapping && file->Peek_Data() == NULL && file->Get_File_Handle() != reinterpret_cast<void *>(-1) ) {
+				if ( Mapping.Map( *(RawFileClass *)file ) == false ) {
+					WWDEBUG_SAY(( "MixFileFactory( %s ) could not be memory mapped\n", mix_filename ));
+				}
+			}
 		} else {
 			FileInfo.Resize(0);
 		}	
@@ -139,6 +189,7 @@ MixFileFactoryClass::MixFileFactoryClass( const char * mix_filename, FileFactory
 
 MixFileFactoryClass::~MixFileFactoryClass( void )
 {
+	Mapping.Unmap();
 	FileInfo.Resize(0);
 }
 
@@ -148,6 +199,15 @@ bool	MixFileFactoryClass::Build_Filename_List (DynamicVectorClass<StringClass> &
 		return false;
 	}
 
+	//
+	//	Read the names straight out of the mapping if there is one
+	//
+	if ( Mapping.Is_Mapped() ) {
+		MappedFileClass file( Mapping.Get_Data(), Mapping.Get_Size(), MixFilename );
+		file.Open( FileClass::READ );
+		return Read_Filename_List( file, list );
+	}
+
 	bool retval = false;
 
 	//
@@ -155,54 +215,96 @@ bool	MixFileFactoryClass::Build_Filename_List (DynamicVectorClass<StringClass> &
 	//
 	RawFileClass *file = (RawFileClass *)Factory->Get_File( MixFilename );
 	if ( file != NULL && file->Open ( RawFileClass::READ ) ) {
+		retval = Read_Filename_List( *file, list );
 
 		//
-		//	Seek to the names offset header
+		//	Close the file
 		//
-		file->Seek (NamesOffset, SEEK_SET);
-		retval = true;
-		
+		Factory->Return_File( file );
+	}
+
+	return retval;
+}
+
+bool	MixFileFactoryClass::Read_Filename_List (FileClass &file, DynamicVectorClass<StringClass> &list)
+{
+	//
+	//	Seek to the names offset header
+	//
+	file.Seek (NamesOffset, SEEK_SET);
+	
+	//
+	//	Read the count of files
+	//
+	int file_count = 0;
+	if (file.Read( &file_count, sizeof( file_count) ) == sizeof( file_count )) {
+
 		//
-		//	Read the count of files
+		//	Loop over each saved filename
 		//
-		int file_count = 0;
-		if (file->Read( &file_count, sizeof( file_count) ) == sizeof( file_count )) {
-
+		bool keep_going = true;
+		for (int index = 0; index < file_count && keep_going; index ++) {
+			keep_going = false;
+			
 			//
-			//	Loop over each saved filename
+			//	Get the length of the filename
 			//
-			bool keep_going = true;
-			for (int index = 0; index < file_count && keep_going; index ++) {
-				keep_going = false;
+			uint8 name_len = 0;
+			if (file.Read( &name_len, sizeof( name_len ) ) == sizeof( name_len )) {
 				
 				//
-				//	Get the length of the filename
+				//	Read the filename
 				//
-				uint8 name_len = 0;
-				if (file->Read( &name_len, sizeof( name_len ) ) == sizeof( name_len )) {
+				StringClass filename;
+				if (file.Read( filename.Get_Buffer( name_len ), name_len ) == name_len ) {
 					
 					//
-					//	Read the filename
+					//	Add the filename to our list
 					//
-					StringClass filename;
-					if (file->Read( filename.Get_Buffer( name_len ), name_len ) == name_len ) {
-						
-						//
-						//	Add the filename to our list
-						//
-						list.Add( filename );
-						keep_going = true;
-					}
+					list.Add( filename );
+					keep_going = true;
 				}
 			}
 		}
+	}
 
-		//
-		//	Close the file
-		//
-		Factory->Return_File( file );
+	return true;
+}
+
+bool	MixFileFactoryClass::Read_File_Info (FileClass &file)
+{
+	//
+	//	MIX1 entries are the CRC, offset and size, MIX2 entries add the stored size
+	//
+	int fields = (BlockSize != 0) ? 4 : 3;
+	if (FileCount < 0 || FileCount > file.Size() / (int)(fields * sizeof( uint32 ))) {
+		return false;
+	}
+
+	unsigned long file_size = (unsigned long)file.Size();
+	int size = FileCount * fields * sizeof( uint32 );
+	uint32 *entries = new uint32[ FileCount * fields + 1 ];
+	bool retval = ( file.Read( entries, size ) == size );
+
+	if (retval) {
+		FileInfo.Resize( FileCount );
+		for (int index = 0; index < FileCount && retval; index ++) {
+			const uint32 *entry = &entries[ index * fields ];
+			FileInfo[index].CRC			= entry[0];
+			FileInfo[index].Offset		= entry[1];
+			FileInfo[index].Size			= entry[2];
+			FileInfo[index].StoredSize	= (fields == 4) ? entry[3] : entry[2];
+
+			//
+			//	Sizes are handed out as ints, and the data has to be inside the file
+			//
+			retval =	(FileInfo[index].Size <= INT_MAX) &&
+						(FileInfo[index].StoredSize <= FileInfo[index].Size) &&
+						Entry_In_Bounds( FileInfo[index].Offset, FileInfo[index].StoredSize, BaseOffset, file_size );
+		}
 	}
 
+	delete [] entries;
 	return retval;
 }
 
@@ -213,10 +315,23 @@ FileClass * MixFileFactoryClass::Get_File( char const *filename )
 	}
 //	WWDEBUG_SAY(( "MixFileFactoryClass::Get_File( %s )\n", filename ));
 
-	RawFileClass *file = NULL;
-
 	//	Create the key block that will be used to binary search for the file.
-	unsigned long crc = CRC_Stringi( filename );
+	return Get_File_By_CRC( CRC_Stringi( filename ), filename );
+}
+
+FileClass * MixFileFactoryClass::Get_File( const StringAtomClass &filename )
+{
+	if ( FileInfo.Length() == 0 || filename.Is_Empty() ) {
+		return NULL;
+	}
+
+	//	The atom already carries the CRC_Stringi of its name
+	return Get_File_By_CRC( filename.Get_CRC(), filename.Get_String() );
+}
+
+FileClass * MixFileFactoryClass::Get_File_By_CRC( unsigned long crc, const char *filename )
+{
+	RawFileClass *file = NULL;
 
 	//	Binary search for the file in this mixfile. If it is found, then create the file
 	FileInfoStruct * info = NULL;
@@ -237,27 +352,83 @@ FileClass * MixFileFactoryClass::Get_File( char const *filename )
 		}
 	}		
 
-	if ( info != NULL) {
-//		WWDEBUG_SAY(( "MixFileFactoryClass::Get_File( %s ) FOUND\n", filename ));
+	if ( info == NULL ) {
+		return NULL;
+	}
+
+	//
+	//	A mapped mix file hands out views on the mapping, no file is opened
+	//
+	FileClass *stored = NULL;
+	if ( Mapping.Is_Mapped() ) {
+		if ( Entry_In_Bounds( info->Offset, info->StoredSize, BaseOffset, Mapping.Get_Size() ) == false ) {
+			WWDEBUG_SAY(( "MixFileFactory( %s ) entry %s is past the end of the file\n", MixFilename, filename ));
+			return NULL;
+		}
+		stored = new MappedFileClass( Mapping.Get_Data() + BaseOffset + info->Offset, info->StoredSize, filename );
+	} else {
 		file = (RawFileClass *)Factory->Get_File( MixFilename );
 		if ( file ) {
-			file->Bias( BaseOffset + info->Offset, info->Size );
+			file->Bias( BaseOffset + info->Offset, info->StoredSize );
 		}
-//		WWDEBUG_SAY(( "MixFileFactoryClass::Get_File( %s ) FOUND\n", filename ));
-	} else {
-//		WWDEBUG_SAY(( "MixFileFactoryClass::Get_File( %s ) NOT FOUND\n", filename ));
+		stored = file;
 	}
 
-	return file;
+	//
+	//	Compressed entries are decompressed as they are read. The compressed file owns
+	// the stored data and gives it back when it is returned.
+	//
+	if ( stored != NULL && info->StoredSize < info->Size ) {
+		FileFactoryClass *source_factory = Mapping.Is_Mapped() ? NULL : Factory;
+		CompressedFileClass *compressed = new CompressedFileClass( stored, source_factory, info->Size, BlockSize, filename );
+
+		FastCriticalSectionClass::LockClass lock( CompressedFilesLock );
+		CompressedFiles.Add( compressed );
+		return compressed;
+	}
+
+	return stored;
 }
 
 void	MixFileFactoryClass::Return_File( FileClass * file )
 {
 	if ( file != NULL ) {
-		Factory->Return_File( file );
+
+		//
+		//	Views on our own mapping are ours to delete
+		//
+		const unsigned char *data = (const unsigned char *)file->Peek_Data();
+		if ( data != NULL && data >= Mapping.Get_Data() && data <= Mapping.Get_Data() + Mapping.Get_Size() ) {
+			delete file;
+			return ;
+		}
+
+		//
+		//	So are the compressed files, which give their stored data back themselves.
+		// Anything else came from the factory the mix file was opened with.
+		//
+		bool is_compressed = false;
+		{
+			FastCriticalSectionClass::LockClass lock( CompressedFilesLock );
+			is_compressed = CompressedFiles.Delete( file );
+		}
+
+		if ( is_compressed ) {
+			delete file;
+		} else {
+			Factory->Return_File( file );
+		}
 	}
 }
 
+bool	MixFileFactoryClass::Get_CRC_List( DynamicVectorClass<unsigned long> &list )
+{
+	for ( int index = 0; index < FileInfo.Length(); index++ ) {
+		list.Add( FileInfo[index].CRC );
+	}
+	return true;
+}
+
 
 /*
 **
@@ -322,7 +493,7 @@ MixFileFactoryClass::Flush_Changes (void)
 	//
 	StringClass full_path;
 	if (Get_Temp_Filename (path, full_path)) {
-		MixFileCreator new_mix_file (full_path);
+		MixFileCreator new_mix_file (full_path, Is_Compressed ());
 
 		//
 		//	Add all the remaining files from our file set
@@ -360,8 +531,10 @@ MixFileFactoryClass::Flush_Changes (void)
 	}
 
 	//
-	//	Delete the old mix file and rename the new one
+	//	Delete the old mix file and rename the new one. The old file can't be deleted
+	// while it is mapped, so from here on it is read through file handles.
 	//
+	Mapping.Unmap ();
 	::DeleteFile (MixFilename);
 	::MoveFile (full_path, MixFilename);
 
@@ -405,20 +578,21 @@ MixFileFactoryClass::Get_Temp_Filename (const char *path, StringClass &full_path
 */
 SimpleFileFactoryClass _SimpleFileFactory;
 
-MixFileCreator::MixFileCreator( const char * filename )
+MixFileCreator::MixFileCreator( const char * filename, bool compressed )	:
+	IsCompressed( compressed )
 {
 	WWDEBUG_SAY(( "Creating Mix File %s\n", filename ));
 
 	MixFile = _SimpleFileFactory.Get_File(filename);
 	if ( MixFile != NULL ) {
 		MixFile->Open( FileClass::WRITE );
-		MixFile->Write( "MIX1", 4 );
+		MixFile->Write( IsCompressed ? "MIX2" : "MIX1", 4 );
 		long	header_offset = 0;
 		MixFile->Write( &header_offset, sizeof( header_offset ) );
 		long	names_offset = 0;
 		MixFile->Write( &names_offset, sizeof( names_offset ) );
-		long	unused = 0;
-		MixFile->Write( &unused, sizeof( unused ) );
+		long	block_size = IsCompressed ? COMPRESSED_BLOCK_SIZE : 0;		// unused in MIX1 files
+		MixFile->Write( &block_size, sizeof( block_size ) );
 	}
 }
 
@@ -448,11 +622,14 @@ MixFileCreator::~MixFileCreator( void )
 		   qsort( &FileInfo[0], num_files, sizeof(FileInfo[0]), &File_Info_Compare);
 		}
 
-		// Save file info (CRC, Offset, Size )
+		// Save file info (CRC, Offset, Size, and StoredSize for MIX2 )
 		for ( i = 0; i < num_files; i++ ) {
 			MixFile->Write( &FileInfo[i].CRC, 4 );
 			MixFile->Write( &FileInfo[i].Offset, 4 );
 			MixFile->Write( &FileInfo[i].Size, 4 );
+			if ( IsCompressed ) {
+				MixFile->Write( &FileInfo[i].StoredSize, 4 );
+			}
 //			WWDEBUG_SAY(( "Write CRC %08X\n", FileInfo[i].CRC ));
 		}
 
@@ -507,38 +684,7 @@ void	MixFileCreator::Add_File( const char * source_filename, const char * saved_
 		if ( file && file->Is_Available() ) {
 
 			file->Open();
-
-			MixFileCreator::FileInfoStruct info;
-			info.CRC			= CRC_Stringi( saved_filename );
-			info.Offset		= MixFile->Tell();
-			info.Size		= file->Size();
-			FileInfo.Add( info );
-			FileInfo[ FileInfo.Count()-1 ].Filename = saved_filename;
-
-			WWDEBUG_SAY(( "Saving File %s CRC %08X Offset %d (0x%08X) Size %d (0x%08X)\n",
-					saved_filename, info.CRC, info.Offset, info.Offset, info.Size, info.Size ));
-
-			int size = file->Size();
-			while ( size ) {
-				char buffer[ 4096 ];
-				int amount = MIN( sizeof( buffer ), size );
-				size -= amount;
-				file->Read( buffer, amount );
-				if ( MixFile->Write( buffer, amount ) != amount ) {
-					WWDEBUG_SAY(( "Failed to write MixFile\n" ));
-				}
-			}
-
-			// Pad the MixFile to make DWord Aligned
-			int offset = MixFile->Tell();
-			offset = (8-(offset & 7)) & 7;
-			if ( offset != 0 ) {
-				char zeros[8] = {0,0,0,0,0,0,0,0};
-				if ( MixFile->Write( zeros, offset ) != offset ) {
-					WWDEBUG_SAY(( "Failed to write padding\n" ));
-				}
-			}
-
+			Write_File_Data( saved_filename, file );
 			file->Close();
 			_SimpleFileFactory.Return_File( file );
 
@@ -552,16 +698,35 @@ void	MixFileCreator::Add_File( const char * source_filename, const char * saved_
 void	MixFileCreator::Add_File( const char * filename, FileClass *file )
 {
 	if ( MixFile != NULL ) {
+		Write_File_Data( filename, file );
+	}
 
-		MixFileCreator::FileInfoStruct info;
-		info.CRC			= CRC_Stringi( filename );
-		info.Offset		= MixFile->Tell();
-		info.Size		= file->Size();
-		FileInfo.Add( info );
-		FileInfo[ FileInfo.Count()-1 ].Filename = filename;
+	return ;
+}
 
-		WWDEBUG_SAY(( "Saving File %s CRC %08X Offset %d (0x%08X) Size %d (0x%08X)\n",
-				filename, info.CRC, info.Offset, info.Offset, info.Size, info.Size ));
+
+void	MixFileCreator::Write_File_Data( const char * filename, FileClass *file )
+{
+	MixFileCreator::FileInfoStruct info;
+	info.CRC			= CRC_Stringi( filename );
+	info.Offset		= MixFile->Tell();
+	info.Size		= file->Size();
+	info.StoredSize	= info.Size;
+
+	if ( IsCompressed ) {
+
+		//
+		//	Compress the whole file, it is stored as is if that doesn't make it smaller
+		//
+		int size = file->Size();
+		unsigned char *data = new unsigned char[ size + 1 ];
+		if ( file->Read( data, size ) != size ) {
+			WWDEBUG_SAY(( "Failed to read %s\n", filename ));
+		}
+		info.StoredSize = Write_Compressed( data, size );
+		delete [] data;
+
+	} else {
 
 		int size = file->Size();
 		while ( size ) {
@@ -573,19 +738,69 @@ void	MixFileCreator::Add_File( const char * filename, FileClass *file )
 				WWDEBUG_SAY(( "Failed to write MixFile\n" ));
 			}
 		}
+	}
 
-		// Pad the MixFile to make DWord Aligned
-		int offset = MixFile->Tell();
-		offset = (8-(offset & 7)) & 7;
-		if ( offset != 0 ) {
-			char zeros[8] = {0,0,0,0,0,0,0,0};
-			if ( MixFile->Write( zeros, offset ) != offset ) {
-				WWDEBUG_SAY(( "Failed to write padding\n" ));
-			}
+	FileInfo.Add( info );
+	FileInfo[ FileInfo.Count()-1 ].Filename = filename;
+
+	WWDEBUG_SAY(( "Saving File %s CRC %08X Offset %d (0x%08X) Size %d (0x%08X) Stored %d\n",
+			filename, info.CRC, info.Offset, info.Offset, info.Size, info.Size, info.StoredSize ));
+
+	// Pad the MixFile to make DWord Aligned
+	int offset = MixFile->Tell();
+	offset = (8-(offset & 7)) & 7;
+	if ( offset != 0 ) {
+		char zeros[8] = {0,0,0,0,0,0,0,0};
+		if ( MixFile->Write( zeros, offset ) != offset ) {
+			WWDEBUG_SAY(( "Failed to write padding\n" ));
 		}
 	}
+}
 
-	return ;
+
+/*
+**	Writes a file as a block offset table followed by LZO compressed blocks, in the layout
+** CompressedFileClass reads. Blocks that don't compress are stored as is, and if the whole
+** thing isn't smaller than the file the file is written as is. Returns the bytes written.
+*/
+int	MixFileCreator::Write_Compressed( const unsigned char *data, int size )
+{
+	int block_count = (size + COMPRESSED_BLOCK_SIZE - 1) / COMPRESSED_BLOCK_SIZE;
+	int table_size = (block_count + 1) * sizeof( uint32 );
+
+	uint32 *table = new uint32[ block_count + 1 ];
+	unsigned char *blocks = new unsigned char[ LZO_BUFFER_SIZE( size ) + block_count * 16 + 1 ];
+
+	int stored_size = table_size;
+	int index;
+	for ( index = 0; index < block_count; index++ ) {
+		const unsigned char *block = data + index * COMPRESSED_BLOCK_SIZE;
+		int block_len = MIN( COMPRESSED_BLOCK_SIZE, size - index * COMPRESSED_BLOCK_SIZE );
+		unsigned char *dest = blocks + (stored_size - table_size);
+
+		table[index] = stored_size;
+
+		lzo_uint compressed_len = 0;
+		int result = LZOCompressor::Compress( block, block_len, dest, &compressed_len );
+		if ( result != LZO_E_OK || (int)compressed_len >= block_len ) {
+			::memcpy( dest, block, block_len );
+			compressed_len = block_len;
+		}
+		stored_size += compressed_len;
+	}
+	table[block_count] = stored_size;
+
+	if ( stored_size < size ) {
+		MixFile->Write( table, table_size );
+		MixFile->Write( blocks, stored_size - table_size );
+	} else {
+		MixFile->Write( data, size );
+		stored_size = size;
+	}
+
+	delete [] blocks;
+	delete [] table;
+	return stored_size;
 }
 
 
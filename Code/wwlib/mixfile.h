@@ -50,8 +50,11 @@
 #endif
 
 #include "vector.h"
+#include "mappedfile.h"
+#include "mutex.h"
 
 class FileClass;
+class StringAtomClass;
 
 /*
 **
@@ -67,6 +70,12 @@ public:
 	//
 	virtual FileClass * Get_File( char const *filename );
 	virtual void Return_File( FileClass *file );
+	virtual bool Get_CRC_List( DynamicVectorClass<unsigned long> &list );
+
+	//
+	//	Lookup by atom, skips hashing the name
+	//
+	FileClass *	Get_File( const StringAtomClass &filename );
 
 	//
 	//	Filename access
@@ -87,6 +96,16 @@ public:
 	//	Information
 	//
 	bool		Is_Valid (void) const	{ return IsValid; }
+	bool		Is_Memory_Mapped (void) const	{ return Mapping.Is_Mapped (); }
+	bool		Is_Compressed (void) const		{ return BlockSize != 0; }
+
+	//
+	//	Memory mapping. Mix files opened while this is enabled are mapped into memory
+	// once, and their contents are returned as views on the mapping rather than as
+	// file handles. Off by default, since each mix file takes up its size in address space.
+	//
+	static void	Enable_Memory_Mapping (bool onoff)	{ UseMemoryMapping = onoff; }
+	static bool	Is_Memory_Mapping_Enabled (void)		{ return UseMemoryMapping; }
 
 private:
 
@@ -94,6 +113,9 @@ private:
 	//	Utility functions
 	//
 	bool		Get_Temp_Filename (const char *path, StringClass &full_path);
+	FileClass *	Get_File_By_CRC (unsigned long crc, const char *filename);
+	bool		Read_File_Info (FileClass &file);
+	bool		Read_Filename_List (FileClass &file, DynamicVectorClass<StringClass> &list);
 
 	struct FileInfoStruct {
 		bool operator== (const FileInfoStruct &src)	{ return false; }
@@ -102,6 +124,7 @@ private:
 		unsigned long CRC;				// CRC code for embedded file.
 		unsigned long Offset;			// Offset from start of data section.
 		unsigned long Size;				// Size of data subfile.
+		unsigned long StoredSize;		// Size in the mix file, less than Size if compressed.
 	};
 
 	struct AddInfoStruct {
@@ -119,11 +142,19 @@ private:
 
 	int											FileCount;
 	int											NamesOffset;
+	int											BlockSize;			// 0 for MIX1 files
 	bool											IsValid;
 	DynamicVectorClass<StringClass>		FilenameList;
 
 	DynamicVectorClass<AddInfoStruct>	PendingAddFileList;
 	bool											IsModified;
+
+	FileMappingClass							Mapping;
+
+	DynamicVectorClass<FileClass *>		CompressedFiles;	// handed out and not yet returned
+	FastCriticalSectionClass				CompressedFilesLock;
+
+	static bool									UseMemoryMapping;
 };
 
 /*
@@ -132,7 +163,13 @@ private:
 class	MixFileCreator {
 
 public:
-	MixFileCreator( const char * filename );
+	//
+	//	A compressed creator writes a MIX2 file, with each entry stored as LZO compressed
+	// blocks (see CompressedFileClass). Entries that don't get smaller are stored as is.
+	//
+	enum { COMPRESSED_BLOCK_SIZE = 0x10000 };
+
+	MixFileCreator( const char * filename, bool compressed = false );
 	~MixFileCreator( void );
 
 	void	Add_File( const char * source_filename, const char * saved_filename = NULL );
@@ -142,6 +179,9 @@ private:
 
 	static int File_Info_Compare(const void * a, const void * b);
 
+	void	Write_File_Data( const char * filename, FileClass *file );
+	int	Write_Compressed( const unsigned char *data, int size );
+
 	struct FileInfoStruct {
 		bool operator== (const FileInfoStruct &src)	{ return false; }
 		bool operator!= (const FileInfoStruct &src)	{ return true; }
@@ -149,11 +189,13 @@ private:
 		unsigned long	CRC;				// CRC code for embedded file.
 		unsigned long	Offset;			// Offset from start of data section.
 		unsigned long	Size;				// Size of data subfile.
+		unsigned long	StoredSize;		// Size in the mix file.
 		StringClass		Filename;
 	};
 
 	DynamicVectorClass<FileInfoStruct>	FileInfo;
 	FileClass								*	MixFile;
+	bool											IsCompressed;
 };
 
 /*
@@ -161,4 +203,4 @@ private:
 */
 void	Setup_Mix_File( void );
 
-#endif
\ No newline at end of file
+#endif
\ No newline at end of file
@@ -63,6 +63,7 @@ class RAMFileClass : public FileClass
 		virtual bool Set_Date_Time(unsigned long ) {return(true);}
 		virtual void Error(int , int = false, char const * =NULL) {}
 		virtual void Bias(int start, int length=-1);
+		virtual const void * Peek_Data(void) {return(Buffer);}
 
 		operator char const * () {return File_Name();}
 
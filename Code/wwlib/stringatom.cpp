@@ -0,0 +1,181 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/***********************************************************************************************
+ ***              C O N F I D E N T I A L  ---  W E S T W O O D  S T U D I O S               ***
+ ***********************************************************************************************
+ *                                                                                             *
+ *                 Project Name : WWLib                                                        *
+ *                                                                                             *
+ *                     $Archive:: /Commando/Code/wwlib/stringatom.cpp                         $*
+ *                                                                                             *
+ *---------------------------------------------------------------------------------------------*
+ * Functions:                                                                                  *
+ *   StringAtomClass::StringAtomClass -- returns the atom for a name, adding it if needed      *
+ *   StringAtomClass::Find -- returns the atom for a name if it has one                        *
+ *   StringAtomClass::Get_Atom_Count -- returns the number of names in the table               *
+ *   StringAtomClass::Find_Entry -- looks a name up in the table                               *
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+#include "stringatom.h"
+#include "realcrc.h"
+#include "mutex.h"
+#include "wwmemlog.h"
+#include <string.h>
+
+
+/*
+** Table key: the name, pointing either into the entry (lower case, for keys in the table)
+** or at the caller's string, in any case, for the name being looked up.
+*/
+struct AtomKeyStruct
+{
+	const char *		String;
+	unsigned long		CRC;
+
+	bool operator == (const AtomKeyStruct & src) const	{ return (CRC == src.CRC) && (::stricmp(String, src.String) == 0); }
+	bool operator != (const AtomKeyStruct & src) const	{ return !(*this == src); }
+};
+
+template <> inline unsigned int HashTemplateKeyClass<AtomKeyStruct>::Get_Hash_Value(const AtomKeyStruct & key)
+{
+	return key.CRC;
+}
+
+
+static FastCriticalSectionClass		_AtomLock;
+static int									_AtomCount = 0;
+
+
+/***********************************************************************************************
+ * StringAtomClass::StringAtomClass -- returns the atom for a name, adding it if needed        *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * name - the name, in any case.  NULL or "" gives the empty atom.                             *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+StringAtomClass::StringAtomClass(const char * name) :
+	Entry(Find_Entry(name, true))
+{
+}
+
+
+/***********************************************************************************************
+ * StringAtomClass::Find -- returns the atom for a name if it has one                          *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * name - the name, in any case                                                                *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ * the atom, or the empty atom if the name has never been made into an atom                    *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+StringAtomClass StringAtomClass::Find(const char * name)
+{
+	StringAtomClass atom;
+	atom.Entry = Find_Entry(name, false);
+	return atom;
+}
+
+
+/***********************************************************************************************
+ * StringAtomClass::Get_Atom_Count -- returns the number of names in the table                 *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+int StringAtomClass::Get_Atom_Count(void)
+{
+	return _AtomCount;
+}
+
+
+/***********************************************************************************************
+ * StringAtomClass::Find_Entry -- looks a name up in the table                                 *
+ *                                                                                             *
+ * The table is allocated on first use and never freed, so atoms can be made and looked up     *
+ * from static constructors and destructors.                                                   *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * name - the name, in any case                                                                *
+ * create - add the name to the table if it isn't there                                        *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ * the entry, or NULL                                                                          *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+const StringAtomClass::EntryStruct * StringAtomClass::Find_Entry(const char * name, bool create)
+{
+	if ((name == NULL) || (name[0] == 0)) {
+		return NULL;
+	}
+
+	//
+	//	CRC_Stringi and the key compare ignore case, so a lookup works on the
+	// caller's string and doesn't need a lower case copy of it
+	//
+	AtomKeyStruct key;
+	key.String = name;
+	key.CRC = CRC_Stringi(name);
+
+	FastCriticalSectionClass::LockClass lock(_AtomLock);
+
+	static HashTemplateClass<AtomKeyStruct, const EntryStruct *> * _table = NULL;
+	if (_table == NULL) {
+		WWMEMLOG(MEM_STRINGS);
+		_table = new HashTemplateClass<AtomKeyStruct, const EntryStruct *>;
+	}
+
+	const EntryStruct * entry = NULL;
+	if (_table->Get(key, entry) || (create == false)) {
+		return entry;
+	}
+
+	//
+	//	New name, the entry and its string are allocated together
+	//
+	WWMEMLOG(MEM_STRINGS);
+	int length = ::strlen(name);
+	EntryStruct * new_entry = (EntryStruct *)(new char[sizeof(EntryStruct) + length]);
+	new_entry->CRC = key.CRC;
+	new_entry->Length = length;
+	::memcpy(new_entry->String, name, length + 1);
+	::_strlwr(new_entry->String);
+
+	key.String = new_entry->String;
+	_table->Insert(key, new_entry);
+	_AtomCount++;
+
+	return new_entry;
+}
@@ -0,0 +1,108 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/***********************************************************************************************
+ ***              C O N F I D E N T I A L  ---  W E S T W O O D  S T U D I O S               ***
+ ***********************************************************************************************
+ *                                                                                             *
+ *                 Project Name : WWLib                                                        *
+ *                                                                                             *
+ *                     $Archive:: /Commando/Code/wwlib/stringatom.h                           $*
+ *                                                                                             *
+ *---------------------------------------------------------------------------------------------*
+ * Functions:                                                                                  *
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#ifndef STRINGATOM_H
+#define STRINGATOM_H
+
+#include "always.h"
+#include "hashtemplate.h"
+#include <string.h>
+
+
+/**********************************************************************************************
+** StringAtomClass
+**
+** A handle to an interned, case-insensitive name (asset names, animation names, preset
+** names...).  Every spelling of a name ("Box.W3D", "box.w3d") maps to the same atom, so
+** once a name has been turned into an atom, comparing and hashing it is just comparing and
+** hashing a pointer.  The atom keeps the lower case form of the name and its CRC_Stringi
+** value, which is also the key mix files use for their contents.
+**
+** Atoms are created by the constructor, which adds the name to the global table if it is not
+** there yet.  Find only looks the name up; use it for lookups that are expected to miss so
+** the table doesn't fill up with names nothing is registered under.  Names are never removed
+** from the table, an atom stays valid for the life of the program.  The table is protected
+** by a lock, the atoms themselves are read-only and can be used from any thread.
+**
+**********************************************************************************************/
+class StringAtomClass
+{
+public:
+
+	StringAtomClass(void) : Entry(NULL)													{ }
+	explicit StringAtomClass(const char * name);
+	StringAtomClass(const StringAtomClass & src) : Entry(src.Entry)				{ }
+
+	StringAtomClass & operator = (const StringAtomClass & src)					{ Entry = src.Entry; return *this; }
+	bool operator == (const StringAtomClass & src) const							{ return Entry == src.Entry; }
+	bool operator != (const StringAtomClass & src) const							{ return Entry != src.Entry; }
+
+	bool						Is_Empty(void) const										{ return Entry == NULL; }
+	const char *			Get_String(void) const									{ return (Entry != NULL) ? Entry->String : ""; }
+	int						Get_Length(void) const									{ return (Entry != NULL) ? Entry->Length : 0; }
+	unsigned long			Get_CRC(void) const										{ return (Entry != NULL) ? Entry->CRC : 0; }
+
+	// Keeps a cached atom in step with a name that can change (an edited definition field for
+	// instance).  The name is only looked up again when it no longer matches the atom.
+	const StringAtomClass &	Refresh(const char * name)								{ if (::stricmp(Get_String(), (name != NULL) ? name : "") != 0) Entry = Find_Entry(name, true); return *this; }
+
+	static StringAtomClass	Find(const char * name);
+	static int					Get_Atom_Count(void);
+
+protected:
+
+	struct EntryStruct
+	{
+		unsigned long		CRC;					// CRC_Stringi of the name
+		int					Length;
+		char					String[1];			// lower case, allocated with the entry
+	};
+
+	static const EntryStruct *	Find_Entry(const char * name, bool create);
+
+	const EntryStruct *		Entry;
+};
+
+
+/*
+** Atoms hash on their CRC and compare by identity.
+*/
+template <> inline unsigned int HashTemplateKeyClass<StringAtomClass>::Get_Hash_Value(const StringAtomClass & atom)
+{
+	return atom.Get_CRC();
+}
+
+
+#endif // STRINGATOM_H
@@ -35,13 +35,20 @@
  *   VectorClass<T>::VectorClass -- Constructor for vector class.                              *
  *   VectorClass<T>::~VectorClass -- Default destructor for vector class.                      *
  *   VectorClass<T>::VectorClass -- Copy constructor for vector object.                        *
+ *   VectorClass<T>::VectorClass -- Move constructor for vector object.                        *
  *   VectorClass<T>::operator = -- The assignment operator.                                    *
+ *   VectorClass<T>::operator = -- The move assignment operator.                               *
  *   VectorClass<T>::operator == -- Equality operator for vector objects.                      *
  *   VectorClass<T>::Clear -- Frees and clears the vector.                                     *
  *   VectorClass<T>::Resize -- Changes the size of the vector.                                 *
  *   DynamicVectorClass<T>::DynamicVectorClass -- Constructor for dynamic vector.              *
+ *   DynamicVectorClass<T>::DynamicVectorClass -- Copy constructor for dynamic vector.         *
+ *   DynamicVectorClass<T>::DynamicVectorClass -- Move constructor for dynamic vector.         *
+ *   DynamicVectorClass<T>::operator = -- The move assignment operator.                        *
+ *   DynamicVectorClass<T>::Grow_Length -- Size to grow the vector to when it is full.         *
  *   DynamicVectorClass<T>::Resize -- Changes the size of a dynamic vector.                    *
  *   DynamicVectorClass<T>::Add -- Add an element to the vector.                               *
+ *   DynamicVectorClass<T>::Add -- Move an element into the vector.                            *
  *   DynamicVectorClass<T>::Delete -- Remove the specified object from the vector.             *
  *   DynamicVectorClass<T>::Delete -- Deletes the specified index from the vector.             *
  *   VectorClass<T>::ID -- Pointer based conversion to index number.                           *
@@ -62,6 +69,8 @@
 #include	<stdlib.h>
 #include <string.h>
 #include <new.h>
+#include <utility>
+#include <type_traits>
 
 #ifdef _MSC_VER
 #pragma warning (disable : 4702) // unreachable code, happens with some uses of these templates
@@ -69,6 +78,43 @@
 
 class	NoInitClass;
 
+
+/**************************************************************************
+**	Element copying and moving for the vector classes. Types that can be
+**	copied with memcpy are handled a block at a time, anything else an
+**	element at a time through its assignment operator. Moving uses the move
+**	assignment operator, which falls back on the copy assignment operator
+**	for types that don't have one. The source and destination ranges of a
+**	move may overlap.
+*/
+template<class T>
+inline void Vector_Copy_Elements(T * dest, T const * src, int count)
+{
+	if (std::is_trivially_copyable<T>::value) {
+		if (count > 0) memcpy(dest, src, count * sizeof(T));
+	} else {
+		for (int index = 0; index < count; index++) {
+			dest[index] = src[index];
+		}
+	}
+}
+
+template<class T>
+inline void Vector_Move_Elements(T * dest, T * src, int count)
+{
+	if (std::is_trivially_copyable<T>::value) {
+		if (count > 0) memmove(dest, src, count * sizeof(T));
+	} else if (dest < src) {
+		for (int index = 0; index < count; index++) {
+			dest[index] = std::move(src[index]);
+		}
+	} else {
+		for (int index = count - 1; index >= 0; index--) {
+			dest[index] = std::move(src[index]);
+		}
+	}
+}
+
 /**************************************************************************
 **	This is a general purpose vector class. A vector is defined by this
 **	class, as an array of arbitrary objects where the array can be dynamically
@@ -91,12 +137,14 @@ class VectorClass
 		WWINLINE VectorClass(NoInitClass const &) {};
 		VectorClass(int size=0, T const * array=0);
 		VectorClass(VectorClass<T> const &);		// Copy constructor.
+		VectorClass(VectorClass<T> &&);				// Move constructor.
 		virtual ~VectorClass(void);
 
 		WWINLINE T & operator[](int index) {  assert(unsigned(index) < unsigned(VectorMax));return(Vector[index]); } 
 		WWINLINE T const & operator[](int index) const { assert(unsigned(index) < unsigned(VectorMax));return(Vector[index]);  }
 	
 		VectorClass<T> & operator = (VectorClass<T> const &); // Assignment operator.
+		VectorClass<T> & operator = (VectorClass<T> &&);		// Move assignment operator.
 
 		virtual bool operator == (VectorClass<T> const &) const;	// Equality operator.
 
@@ -251,9 +299,7 @@ VectorClass<T> & VectorClass<T>::operator =(VectorClass<T> const & vector)
 			Vector = new T[VectorMax];
 			if (Vector) {
 				IsAllocated = true;
-				for (int index = 0; index < VectorMax; index++) {
-					Vector[index] = vector[index];
-				}
+				Vector_Copy_Elements(Vector, &vector[0], VectorMax);
 			}
 		} else {
 			Vector = 0;
@@ -264,6 +310,63 @@ VectorClass<T> & VectorClass<T>::operator =(VectorClass<T> const & vector)
 }
 
 
+/***********************************************************************************************
+ * VectorClass<T>::VectorClass -- Move constructor for vector object.                          *
+ *                                                                                             *
+ * INPUT:   vector   -- Reference to the vector to take the elements from.                     *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+template<class T>
+VectorClass<T>::VectorClass(VectorClass<T> && vector) :
+	Vector(0),
+	VectorMax(0),
+	IsValid(true),
+	IsAllocated(false)
+{
+	*this = std::move(vector);
+}
+
+
+/***********************************************************************************************
+ * VectorClass<T>::operator = -- The move assignment operator.                                 *
+ *                                                                                             *
+ *    If the other vector allocated its own array, the array is simply handed over and the     *
+ *    other vector is left empty. Otherwise the elements are copied.                           *
+ *                                                                                             *
+ * INPUT:   vector   -- The vector to take the elements from.                                  *
+ *                                                                                             *
+ * OUTPUT:  Returns with reference to this vector.                                             *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+template<class T>
+VectorClass<T> & VectorClass<T>::operator =(VectorClass<T> && vector)
+{
+	if (this != &vector) {
+		if (vector.IsAllocated) {
+			Clear();
+			Vector = vector.Vector;
+			VectorMax = vector.VectorMax;
+			IsAllocated = true;
+
+			vector.Vector = 0;
+			vector.VectorMax = 0;
+			vector.IsAllocated = false;
+		} else {
+			*this = static_cast<VectorClass<T> const &>(vector);
+		}
+	}
+	return(*this);
+}
+
+
 /***********************************************************************************************
  * VectorClass<T>::operator == -- Equality operator for vector objects.                        *
  *                                                                                             *
@@ -436,11 +539,14 @@ bool VectorClass<T>::Resize(int newsize, T const * array)
 			/*
 			**	Copy as much of the old vector into the new vector as possible. This
 			**	presumes that there is a functional assignment operator for each
-			**	of the objects in the vector.
+			**	of the objects in the vector. If the old vector is about to be deleted,
+			**	its elements are moved rather than copied.
 			*/
 			int copycount = (newsize < VectorMax) ? newsize : VectorMax;
-			for (int index = 0; index < copycount; index++) {
-				newptr[index] = Vector[index];
+			if (IsAllocated) {
+				Vector_Move_Elements(newptr, Vector, copycount);
+			} else {
+				Vector_Copy_Elements(newptr, Vector, copycount);
 			}
 
 			/*
@@ -488,6 +594,8 @@ class DynamicVectorClass : public VectorClass<T>
 {
 	public:
 		DynamicVectorClass(unsigned size=0, T const * array=0);
+		DynamicVectorClass(DynamicVectorClass<T> const &);
+		DynamicVectorClass(DynamicVectorClass<T> &&);
 
 		// Stubbed equality operators so you can have dynamic vectors of dynamic vectors
 		bool operator== (const DynamicVectorClass &src)	{ return false; }
@@ -508,6 +616,7 @@ class DynamicVectorClass : public VectorClass<T>
 
 		// Add object to vector (growing as necessary).
 		bool Add(T const & object);
+		bool Add(T && object);
 		bool Add_Head(T const & object);
 		bool Insert(int index,T const & object);
 
@@ -526,6 +635,13 @@ class DynamicVectorClass : public VectorClass<T>
 		// Fetch current growth step rate.
 		int Growth_Step(void) {return GrowthStep;};
 
+		// Set the percentage of its current size that the vector grows by, if that
+		// is more than the growth step. Zero makes the vector grow by the step only.
+		int Set_Growth_Percent(int percent) {return(GrowthPercent = percent);};
+
+		// Fetch current growth percentage.
+		int Growth_Percent(void) {return GrowthPercent;};
+
 		virtual int ID(T const * ptr) {return(VectorClass<T>::ID(ptr));};
 		virtual int ID(T const & ptr);
 
@@ -533,8 +649,10 @@ class DynamicVectorClass : public VectorClass<T>
 			VectorClass<T>::operator = (rvalue);
 			ActiveCount = rvalue.ActiveCount;
 			GrowthStep = rvalue.GrowthStep;
+			GrowthPercent = rvalue.GrowthPercent;
 			return(*this);
 		}
+		DynamicVectorClass<T> & operator =(DynamicVectorClass<T> && rvalue);
 
       // Uninitialized Add - does everything an Add does, except copying an
       // object into the 'new' spot in the array. It returns a pointer to
@@ -545,6 +663,9 @@ class DynamicVectorClass : public VectorClass<T>
 
 	protected:
 
+		// Size to grow the vector to when it is full.
+		int Grow_Length(void) const;
+
 		/*
 		**	This is a count of the number of active objects in this
 		**	vector. The memory array often times is bigger than this
@@ -559,6 +680,14 @@ class DynamicVectorClass : public VectorClass<T>
 		**	the Set_Growth_Step() function.
 		*/
 		int GrowthStep;
+
+		/*
+		**	A full vector grows by this percentage of its current size when
+		**	that is more than the growth step, so large vectors grow
+		**	geometrically. This is controlled by the Set_Growth_Percent()
+		**	function.
+		*/
+		int GrowthPercent;
 };
 
 
@@ -587,7 +716,104 @@ DynamicVectorClass<T>::DynamicVectorClass(unsigned size, T const * array)
 	: VectorClass<T>(size, array)
 {
 	GrowthStep = 10;
+	GrowthPercent = 50;
+	ActiveCount = 0;
+}
+
+
+/***********************************************************************************************
+ * DynamicVectorClass<T>::DynamicVectorClass -- Copy constructor for dynamic vector.           *
+ *                                                                                             *
+ * INPUT:   vector   -- Reference to the vector to use as a copy.                              *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+template<class T>
+DynamicVectorClass<T>::DynamicVectorClass(DynamicVectorClass<T> const & vector)
+	: VectorClass<T>(vector)
+{
+	GrowthStep = vector.GrowthStep;
+	GrowthPercent = vector.GrowthPercent;
+	ActiveCount = vector.ActiveCount;
+}
+
+
+/***********************************************************************************************
+ * DynamicVectorClass<T>::DynamicVectorClass -- Move constructor for dynamic vector.           *
+ *                                                                                             *
+ * INPUT:   vector   -- Reference to the vector to take the elements from.                     *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+template<class T>
+DynamicVectorClass<T>::DynamicVectorClass(DynamicVectorClass<T> && vector)
+	: VectorClass<T>(0)
+{
+	GrowthStep = vector.GrowthStep;
+	GrowthPercent = vector.GrowthPercent;
 	ActiveCount = 0;
+	*this = std::move(vector);
+}
+
+
+/***********************************************************************************************
+ * DynamicVectorClass<T>::operator = -- The move assignment operator.                          *
+ *                                                                                             *
+ * INPUT:   rvalue   -- The vector to take the elements from.                                  *
+ *                                                                                             *
+ * OUTPUT:  Returns with reference to this vector.                                             *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+template<class T>
+DynamicVectorClass<T> & DynamicVectorClass<T>::operator =(DynamicVectorClass<T> && rvalue)
+{
+	if (this != &rvalue) {
+		int count = rvalue.ActiveCount;
+		VectorClass<T>::operator = (std::move(rvalue));
+		ActiveCount = count;
+		GrowthStep = rvalue.GrowthStep;
+		GrowthPercent = rvalue.GrowthPercent;
+
+		/*
+		**	If the array was handed over, the other vector is now empty.
+		*/
+		if (rvalue.Length() < rvalue.ActiveCount) rvalue.ActiveCount = rvalue.Length();
+	}
+	return(*this);
+}
+
+
+/***********************************************************************************************
+ * DynamicVectorClass<T>::Grow_Length -- Size to grow the vector to when it is full.           *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  Returns with the new maximum size for the vector.                                  *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+template<class T>
+inline int DynamicVectorClass<T>::Grow_Length(void) const
+{
+	int step = GrowthStep;
+	if (GrowthPercent > 0) {
+		int percent_step = (Length() * GrowthPercent) / 100;
+		if (percent_step > step) step = percent_step;
+	}
+	return(Length() + step);
 }
 
 
@@ -671,7 +897,7 @@ bool DynamicVectorClass<T>::Add(T const & object)
 {
 	if (ActiveCount >= Length()) {
 		if ((IsAllocated || !VectorMax) && GrowthStep > 0) {
-			if (!Resize(Length() + GrowthStep)) {
+			if (!Resize(Grow_Length())) {
 
 				/*
 				**	Failure to increase the size of the vector is an error condition.
@@ -697,6 +923,39 @@ bool DynamicVectorClass<T>::Add(T const & object)
 }
 
 
+/***********************************************************************************************
+ * DynamicVectorClass<T>::Add -- Move an element into the vector.                              *
+ *                                                                                             *
+ *    Same as the other Add, except that the object is moved into the vector rather than       *
+ *    copied.                                                                                  *
+ *                                                                                             *
+ * INPUT:   object   -- Reference to the object that will be moved into the vector.            *
+ *                                                                                             *
+ * OUTPUT:  bool; Was the object added successfully? If so, the object is added to the end     *
+ *          of the vector.                                                                     *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+template<class T>
+bool DynamicVectorClass<T>::Add(T && object)
+{
+	if (ActiveCount >= Length()) {
+		if ((IsAllocated || !VectorMax) && GrowthStep > 0) {
+			if (!Resize(Grow_Length())) {
+				return(false);
+			}
+		} else {
+			return(false);
+		}
+	}
+
+	(*this)[ActiveCount++] = std::move(object);
+	return(true);
+}
+
+
 /***********************************************************************************************
  * DynamicVectorClass<T>::Add_Head -- Adds element to head of the list.                        *
  *                                                                                             *
@@ -717,7 +976,7 @@ bool DynamicVectorClass<T>::Add_Head(T const & object)
 {
 	if (ActiveCount >= Length()) {
 		if ((IsAllocated || !VectorMax) && GrowthStep > 0) {
-			if (!Resize(Length() + GrowthStep)) {
+			if (!Resize(Grow_Length())) {
 
 				/*
 				**	Failure to increase the size of the vector is an error condition.
@@ -739,7 +998,7 @@ bool DynamicVectorClass<T>::Add_Head(T const & object)
 	**	There is room for the new object now. Add it to the end of the object vector.
 	*/
 	if (ActiveCount) {
-		memmove(&(*this)[1], &(*this)[0], ActiveCount * sizeof(T));
+		Vector_Move_Elements(&(*this)[1], &(*this)[0], ActiveCount);
 	}
 	(*this)[0] = object;
 	ActiveCount++;
@@ -769,7 +1028,7 @@ bool DynamicVectorClass<T>::Insert(int index,T const & object)
 
 	if (ActiveCount >= Length()) {
 		if ((IsAllocated || !VectorMax) && GrowthStep > 0) {
-			if (!Resize(Length() + GrowthStep)) {
+			if (!Resize(Grow_Length())) {
 
 				/*
 				**	Failure to increase the size of the vector is an error condition.
@@ -791,7 +1050,7 @@ bool DynamicVectorClass<T>::Insert(int index,T const & object)
 	**	There is room for the new object now. Add it at the desired position.
 	*/
 	if (index < ActiveCount) {
-		memmove(&(*this)[index+1], &(*this)[index], (ActiveCount-index) * sizeof(T));
+		Vector_Move_Elements(&(*this)[index+1], &(*this)[index], ActiveCount-index);
 	}
 	(*this)[index] = object;
 	ActiveCount++;
@@ -850,14 +1109,14 @@ bool DynamicVectorClass<T>::Delete(int index)
 		ActiveCount--;
 
 		/*
-		**	If there are any objects past the index that was deleted, copy those
+		**	If there are any objects past the index that was deleted, move those
 		**	objects down in order to fill the hole. A simple memory copy is
 		**	not sufficient since the vector could contain class objects that
 		**	need to use the assignment operator for movement.
 		*/
 //		(&(*this)[index])->~ T ();
-		for (int i = index; i < ActiveCount; i++) {
-			(*this)[i] = (*this)[i+1];
+		if (index < ActiveCount) {
+			Vector_Move_Elements(&(*this)[index], &(*this)[index+1], ActiveCount-index);
 		}
 		return(true);
 	}
@@ -899,7 +1158,7 @@ T * DynamicVectorClass<T>::Uninitialized_Add(void)
 	if (ActiveCount >= Length()) {
 //		if ((IsAllocated || !VectorMax) && GrowthStep > 0) {
 		if (GrowthStep > 0) {
-			if (!Resize(Length() + GrowthStep)) {
+			if (!Resize(Grow_Length())) {
 
 				/*
 				**	Failure to increase the size of the vector is an error condition.
@@ -92,6 +92,10 @@ class FileClass
 		virtual bool Set_Date_Time(unsigned long ) {return(false);}
 		virtual void Error(int error, int canretry = false, char const * filename=NULL) = 0;
 		virtual void * Get_File_Handle(void) { return reinterpret_cast<void *>(-1); } 
+
+		// Returns the whole contents of the file if they are already in memory (so can be used
+		// without reading them), NULL otherwise. The pointer is valid until the file is returned.
+		virtual const void * Peek_Data(void) { return NULL; }
 		virtual void Bias(int start, int length=-1) = 0;
 
 		operator char const * ()
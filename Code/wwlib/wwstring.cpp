@@ -197,10 +197,8 @@ StringClass::Free_String (void)
 {
 	if (m_Buffer != m_EmptyString) {
 
-		unsigned buffer_base=reinterpret_cast<unsigned>(m_Buffer-sizeof (StringClass::_HEADER));
-		unsigned temp_base=reinterpret_cast<unsigned>(m_TempStrings+MAX_TEMP_BYTES*MAX_TEMP_STRING);
-
-		if ((buffer_base>>11)==(temp_base>>11)) {
+		if (Is_Temp_Buffer ()) {
+			unsigned buffer_base=reinterpret_cast<unsigned>(m_Buffer-sizeof (StringClass::_HEADER));
 			m_Buffer[0] = 0;
 
 			//
@@ -232,6 +230,24 @@ StringClass::Free_String (void)
 }
 
 
+///////////////////////////////////////////////////////////////////
+//
+//	Is_Temp_Buffer
+//
+//	The temporary buffers all live in one 2K aligned block, so any
+// buffer whose header is in the same block is one of them.
+//
+///////////////////////////////////////////////////////////////////
+bool
+StringClass::Is_Temp_Buffer (void) const
+{
+	unsigned buffer_base=reinterpret_cast<unsigned>(m_Buffer-sizeof (StringClass::_HEADER));
+	unsigned temp_base=reinterpret_cast<unsigned>(m_TempStrings+MAX_TEMP_BYTES*MAX_TEMP_STRING);
+
+	return ((buffer_base>>11)==(temp_base>>11));
+}
+
+
 ///////////////////////////////////////////////////////////////////
 //
 //	Format
@@ -338,4 +354,4 @@ bool StringClass::Copy_Wide (const WCHAR *source)
 
 	// Failure.
 	return (false);
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -78,6 +78,7 @@ public:
 	StringClass (bool hint_temporary);
 	StringClass (int initial_len = 0, bool hint_temporary = false);
 	StringClass (const StringClass &string, bool hint_temporary = false);
+	StringClass (StringClass &&string);
 	StringClass (const TCHAR *string, bool hint_temporary = false);
 	StringClass (TCHAR ch, bool hint_temporary = false);
 	StringClass (const WCHAR *string, bool hint_temporary = false);
@@ -90,6 +91,7 @@ public:
 	bool operator!= (const TCHAR *rvalue) const;
 
 	inline const StringClass &operator= (const StringClass &string);
+	inline const StringClass &operator= (StringClass &&string);
 	inline const StringClass &operator= (const TCHAR *string);
 	inline const StringClass &operator= (TCHAR ch);
 	inline const StringClass &operator= (const WCHAR *string);
@@ -169,6 +171,7 @@ private:
 	void			Resize (int size);
 	void			Uninitialised_Grow (int length);
 	void			Free_String (void);
+	bool			Is_Temp_Buffer (void) const;
 
 	inline void	Store_Length (int length);
 	inline void	Store_Allocated_Length (int allocated_length);
@@ -209,6 +212,28 @@ StringClass::operator= (const StringClass &string)
 
 }
 
+///////////////////////////////////////////////////////////////////
+//	operator=
+//
+//	Takes the other string's buffer rather than copying it, unless
+// the buffer is one of the shared temporary buffers.
+///////////////////////////////////////////////////////////////////
+inline const StringClass &
+StringClass::operator= (StringClass &&string)
+{
+	if (&string != this) {
+		if (string.m_Buffer == m_EmptyString || string.Is_Temp_Buffer ()) {
+			(*this) = (const StringClass &)string;
+		} else {
+			Free_String ();
+			m_Buffer = string.m_Buffer;
+			string.m_Buffer = m_EmptyString;
+		}
+	}
+
+	return (*this);
+}
+
 ///////////////////////////////////////////////////////////////////
 //	operator=
 ///////////////////////////////////////////////////////////////////
@@ -310,6 +335,17 @@ StringClass::StringClass (const StringClass &string, bool hint_temporary)
 	return ;
 }
 
+///////////////////////////////////////////////////////////////////
+//	StringClass
+///////////////////////////////////////////////////////////////////
+inline
+StringClass::StringClass (StringClass &&string)
+ 	:	m_Buffer (m_EmptyString)
+{
+	(*this) = static_cast<StringClass &&>(string);
+	return ;
+}
+
 ///////////////////////////////////////////////////////////////////
 //	StringClass
 ///////////////////////////////////////////////////////////////////
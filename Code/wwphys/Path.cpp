@@ -50,6 +50,7 @@
 #include "persistfactory.h"
 #include "assetmgr.h"
 #include "wwmemlog.h"
+#include "framearena.h"
 
 
 ////////////////////////////////////////////////////////////////
@@ -220,7 +221,7 @@ PathClass::Initialize (PathSolveClass &path_solve)
 	m_EndTime				= 1.0F;
 	m_IsLooping				= false;
 
-	DynamicVectorClass<PATH_NODE> node_list;
+	FrameDynamicVectorClass<PATH_NODE> node_list;
 
 	//
 	//	Get the raw path data from the solver, and convert it into
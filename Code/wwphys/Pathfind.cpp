@@ -113,7 +113,8 @@ PathfindClass::PathfindClass (void)
 		m_SectorList(1000),		// 1000's of these
 		m_PortalList(5000),		// 10.000's of these
 		m_SectorDisplayList(1000),	// 1000's of these (debug only)
-		m_WaypathList(30)		// 5-30 of these?
+		m_WaypathList(30),		// 5-30 of these?
+		m_GraphRevision (0)
 {
 	WWASSERT (_Pathfinder == NULL);
 	_Pathfinder = this;
@@ -179,6 +180,7 @@ PathfindClass::Add_Sector (PathfindSectorClass *sector, bool add_to_tree)
 		//	Add this sector to our linear list (for housekeeping)
 		//
 		m_SectorList.Add (sector);
+		Invalidate_Graph ();
 
 		//
 		//	For debugging purposes, add this object to our
@@ -210,6 +212,7 @@ PathfindClass::Add_Portal (PathfindPortalClass *portal)
 	//
 	int portal_id = m_PortalList.Count () - 1;
 	portal->Set_ID (portal_id);
+	Invalidate_Graph ();
 
 	//
 	//	Add the size of this portal to the pool.
@@ -239,6 +242,7 @@ PathfindClass::Add_Waypath_Portal (PathfindWaypathPortalClass *portal)
 	//
 	int portal_id = (m_WaypathPortalList.Count () - 1) + WAYPATH_PORTAL_ID_START;
 	portal->Set_ID (portal_id);
+	Invalidate_Graph ();
 
 	//
 	//	Add the size of this portal to the pool.
@@ -304,6 +308,7 @@ PathfindClass::Add_Temporary_Portal
 			//
 			m_TemporaryPortalList.Add (new_portal);
 			sector_from->Add_Portal (new_portal->Get_ID ());
+			Invalidate_Graph ();
 
 			//
 			//	Add the size of this portal to the pool.
@@ -852,6 +857,7 @@ PathfindClass::Reset_Sectors (void)
 	}
 
 	m_SectorList.Delete_All ();
+	Invalidate_Graph ();
 
 	_MemoryFootprint = 0;
 	return ;
@@ -898,6 +904,7 @@ PathfindClass::Reset_Portals (void)
 	m_PortalList.Delete_All ();
 	m_TemporaryPortalList.Delete_All ();
 	m_WaypathPortalList.Delete_All ();
+	Invalidate_Graph ();
 
 	//
 	//	Reset the starting IDs
@@ -999,6 +1006,7 @@ PathfindClass::Add_Waypath (WaypathClass *waypath)
 	if (waypath != NULL) {
 		waypath->Add_Ref ();
 		m_WaypathList.Add (waypath);
+		m_WaypathIndex.Add (waypath);
 	}
 
 	return ;
@@ -1027,6 +1035,7 @@ PathfindClass::Remove_Waypath (WaypathClass *waypath)
 			// hold on it.
 			//
 			if (curr_waypath == waypath) {
+				m_WaypathIndex.Remove (waypath);
 				REF_PTR_RELEASE (waypath);
 				m_WaypathList.Delete (index);
 				retval = true;
@@ -1046,25 +1055,11 @@ PathfindClass::Remove_Waypath (WaypathClass *waypath)
 WaypathClass *
 PathfindClass::Find_Waypath (int id) const
 {
-	WaypathClass *waypath = NULL;
-
 	//
-	//	Loop over all the paths in our list until we've
-	// found the one are looking for.
+	//	The index keeps the most recently added waypath for each ID
+	// at the front, which matches the old back-to-front list search.
 	//
-	int index = m_WaypathList.Count ();
-	while (index -- && (waypath == NULL)) {
-		WaypathClass *curr_waypath = m_WaypathList[index];
-		
-		//
-		//	Is this the waypath we are looking for?
-		//
-		if (curr_waypath->Get_ID () == id) {
-			waypath = curr_waypath;
-		}
-	}		
-
-	return waypath;
+	return m_WaypathIndex.Find (id);
 }
 
 ///////////////////////////////////////////////////////////////////////////
@@ -1075,17 +1070,11 @@ PathfindClass::Find_Waypath (int id) const
 int PathfindClass::Count_Waypaths_Starting_In_Box (const AABoxClass & box)
 {
 	//
-	//	Loop over all the paths in our list counting the ones whose 
-	// start points are contained inside the given box.
+	//	Count the paths whose start points are contained inside the given box.
+	// The index keeps the last result, so a following Get_Waypath_Starting_In_Box
+	// with the same box doesn't redo the query.
 	//
-	int count = 0;
-	for (int index=0; index<m_WaypathList.Count(); index++) {
-		WaypathClass *curr_waypath = m_WaypathList[index];
-		if (CollisionMath::Overlap_Test(box,curr_waypath->Get_Point(0)->Get_Position()) == CollisionMath::INSIDE) {
-			count++;
-		}
-	}
-	return count;
+	return m_WaypathIndex.Count_Starting_In_Box (box);
 }
 
 ///////////////////////////////////////////////////////////////////////////
@@ -1096,30 +1085,64 @@ int PathfindClass::Count_Waypaths_Starting_In_Box (const AABoxClass & box)
 WaypathClass * PathfindClass::Get_Waypath_Starting_In_Box (const AABoxClass & box,int i)
 {
 	//
-	//	Loop over all the paths in our list counting down until
-	// we get to the i'th one that starts in the given box.
+	//	Return the i'th path (in the order they were added) that starts
+	// in the given box.
 	//
-	WaypathClass * path = NULL;
-	int count = i;
-	for (int index=0; index<m_WaypathList.Count(); index++) {
-		WaypathClass *curr_waypath = m_WaypathList[index];
-		
-		if (CollisionMath::Overlap_Test(box,curr_waypath->Get_Point(0)->Get_Position()) == CollisionMath::INSIDE) {
-			if (count == 0) {
-				path = curr_waypath;
-				break;
-			} else {
-				count--;
-			}
-		}
-	}
-	
+	WaypathClass * path = m_WaypathIndex.Get_Starting_In_Box (box, i);
+
 	if (path != NULL) {
 		path->Add_Ref();
 	}
 	return path;
 }
 
+///////////////////////////////////////////////////////////////////////////
+//
+//	Collect_Waypaths_Starting_In_Box
+//
+///////////////////////////////////////////////////////////////////////////
+void
+PathfindClass::Collect_Waypaths_Starting_In_Box
+(
+	const AABoxClass &						box,
+	DynamicVectorClass<WaypathClass *> &	list
+)
+{
+	//
+	//	Callers that want to walk every match should use this rather
+	// than calling Get_Waypath_Starting_In_Box once per index.
+	//
+	m_WaypathIndex.Collect_Starting_In_Box (box, list);
+	return ;
+}
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Collect_Waypaths_In_Box
+//
+///////////////////////////////////////////////////////////////////////////
+void
+PathfindClass::Collect_Waypaths_In_Box
+(
+	const AABoxClass &						box,
+	DynamicVectorClass<WaypathClass *> &	list
+)
+{
+	m_WaypathIndex.Collect_In_Box (box, list);
+	return ;
+}
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Find_Nearest_Waypath_Start
+//
+///////////////////////////////////////////////////////////////////////////
+WaypathClass *
+PathfindClass::Find_Nearest_Waypath_Start (const Vector3 &pos, float max_dist)
+{
+	return m_WaypathIndex.Find_Nearest_Start (pos, max_dist);
+}
+
 ///////////////////////////////////////////////////////////////////////////
 //
 //	Reset_Waypaths
@@ -1141,6 +1164,7 @@ PathfindClass::Reset_Waypaths (void)
 	//	Remove all the waypaths from our list
 	//
 	m_WaypathList.Delete_All ();
+	m_WaypathIndex.Reset ();
 	return ;
 }
 
@@ -1488,6 +1512,7 @@ PathfindClass::Free_Waypath_Sectors_And_Portals (void)
 	//	Reset the portal list
 	//
 	m_WaypathPortalList.Delete_All ();	
+	Invalidate_Graph ();
 	return ;
 }
 
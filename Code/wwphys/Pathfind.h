@@ -44,6 +44,7 @@
 #include "aabtreecull.h"
 #include "pathfindsector.h"
 #include "widgetuser.h"
+#include "waypathindex.h"
 
 
 /////////////////////////////////////////////////////////////////////////
@@ -121,6 +122,9 @@ class PathfindClass
 
 		int							Count_Waypaths_Starting_In_Box (const AABoxClass & box);
 		WaypathClass *				Get_Waypath_Starting_In_Box (const AABoxClass & box,int i);
+		void							Collect_Waypaths_Starting_In_Box (const AABoxClass &box, DynamicVectorClass<WaypathClass *> &list);
+		void							Collect_Waypaths_In_Box (const AABoxClass &box, DynamicVectorClass<WaypathClass *> &list);
+		WaypathClass *				Find_Nearest_Waypath_Start (const Vector3 &pos, float max_dist = FLT_MAX);
 
 		//
 		//	Waypath integration
@@ -153,6 +157,14 @@ class PathfindClass
 		//	Sector list access
 		//
 		void							Get_Sector_List (DynamicVectorClass<PathfindSectorClass *> &list) { list = m_SectorList; }
+		int							Get_Sector_Count (void) const		{ return m_SectorList.Count (); }
+
+		//
+		//	Graph revision (bumped whenever sectors or portals are added or removed,
+		// so cached data such as flow fields can tell when it has gone stale).
+		//
+		uint32						Get_Graph_Revision (void) const	{ return m_GraphRevision; }
+		void							Invalidate_Graph (void)				{ m_GraphRevision ++; }
 
 		//
 		//	Intersection methods
@@ -208,6 +220,7 @@ class PathfindClass
 		PORTAL_LIST				m_PortalList;
 		DISPLAY_LIST			m_SectorDisplayList;
 		WAYPATH_LIST			m_WaypathList;
+		WaypathIndexClass		m_WaypathIndex;
 		bool						m_SectorsDisplayed;
 		bool						m_PortalsDisplayed;
 		PathDebugPlotterClass *m_Plotter;
@@ -217,6 +230,7 @@ class PathfindClass
 
 		WidgetUserClass		m_SectorDisplayWidgets;
 		WidgetUserClass		m_PortalDisplayWidgets;
+		uint32					m_GraphRevision;
 };
 
 
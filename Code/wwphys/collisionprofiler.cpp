@@ -0,0 +1,466 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/***********************************************************************************************
+ ***              C O N F I D E N T I A L  ---  W E S T W O O D  S T U D I O S               ***
+ ***********************************************************************************************
+ *                                                                                             *
+ *                 Project Name : WWPhys                                                       *
+ *                                                                                             *
+ *                     $Archive:: /Commando/Code/wwphys/collisionprofiler.cpp                 $*
+ *                                                                                             *
+ *---------------------------------------------------------------------------------------------*
+ * Functions:                                                                                  *
+ *   CollisionProfilerClass::CollisionProfilerClass -- Constructor                             *
+ *   CollisionProfilerClass::~CollisionProfilerClass -- Destructor                             *
+ *   CollisionProfilerClass::Begin_Collecting -- Start recording collision queries             *
+ *   CollisionProfilerClass::End_Collecting -- Stop recording and write out the report         *
+ *   CollisionProfilerClass::Push_Category -- Enter a caller category                          *
+ *   CollisionProfilerClass::Pop_Category -- Leave a caller category                           *
+ *   CollisionProfilerClass::Begin_Query -- Called when the scene starts a collision query     *
+ *   CollisionProfilerClass::End_Query -- Record a finished collision query                    *
+ *   CollisionProfilerClass::Reset -- Throw away everything that was recorded                  *
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+#include "collisionprofiler.h"
+#include "colmath.h"
+#include "ffactory.h"
+#include "wwfile.h"
+#include "wwstring.h"
+#include "wwmath.h"
+#include "wwdebug.h"
+#include <string.h>
+
+
+/*
+** Instantiate the collision profiler
+*/
+CollisionProfilerClass _CollisionProfiler;
+
+thread_local bool CollisionProfilerClass::IsCollectingThread = false;
+
+
+/*
+** Names used in the report
+*/
+static const char * _QueryTypeNames[CollisionProfilerClass::QUERY_TYPE_COUNT] =
+{
+	"Ray",
+	"AABox",
+	"OBBox",
+	"Intersect",
+};
+
+static const char * _UnknownCategory = "Uncategorized";
+
+
+/***********************************************************************************************
+ * CollisionProfilerClass::CollisionProfilerClass -- Constructor                               *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+CollisionProfilerClass::CollisionProfilerClass(void) :
+	Collecting(false),
+	QueryDepth(0),
+	NodeCounter(0),
+	StartNodes(0),
+	StartTriangles(0),
+	CategoryDepth(0),
+	CategoryCount(0),
+	GridMin(0,0,0),
+	CellSize(1.0f),
+	CellsX(0),
+	CellsY(0),
+	Cells(NULL)
+{
+	Reset();
+}
+
+
+/***********************************************************************************************
+ * CollisionProfilerClass::~CollisionProfilerClass -- Destructor                               *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+CollisionProfilerClass::~CollisionProfilerClass(void)
+{
+	Reset();
+}
+
+
+/***********************************************************************************************
+ * CollisionProfilerClass::Begin_Collecting -- Start recording collision queries               *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * min,max - area covered by the heatmap grid, normally the level extents                      *
+ * cell_size - size of a grid cell in x and y.  Grown if needed to keep the grid reasonable    *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void CollisionProfilerClass::Begin_Collecting(const Vector3 & min,const Vector3 & max,float cell_size)
+{
+	Reset();
+
+	GridMin = min;
+	CellSize = WWMath::Max(cell_size,0.1f);
+
+	Vector3 size = max - min;
+	CellsX = WWMath::Float_To_Int_Floor(size.X / CellSize) + 1;
+	CellsY = WWMath::Float_To_Int_Floor(size.Y / CellSize) + 1;
+	while (CellsX * CellsY > MAX_GRID_CELLS) {
+		CellSize *= 2.0f;
+		CellsX = WWMath::Float_To_Int_Floor(size.X / CellSize) + 1;
+		CellsY = WWMath::Float_To_Int_Floor(size.Y / CellSize) + 1;
+	}
+
+	Cells = new TotalsStruct[CellsX * CellsY];
+	for (int i=0; i<CellsX * CellsY; i++) {
+		Clear_Totals(Cells[i]);
+	}
+
+	Collecting = true;
+	IsCollectingThread = true;
+}
+
+
+/***********************************************************************************************
+ * CollisionProfilerClass::End_Collecting -- Stop recording and write out the report           *
+ *                                                                                             *
+ * The report lists the totals for each category, query type and collision group, then the     *
+ * hottest cells and finally the whole grid (milliseconds per cell, one row per line, rows     *
+ * running from min y to max y).                                                               *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * filename - file to write the report to, NULL to just stop collecting                        *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void CollisionProfilerClass::End_Collecting(const char * filename)
+{
+	if (!Collecting) {
+		return;
+	}
+	WWASSERT(IsCollectingThread);
+	Collecting = false;
+	IsCollectingThread = false;
+
+	FileClass * file = NULL;
+	if (filename != NULL) {
+		file = _TheWritingFileFactory->Get_File(filename);
+	}
+
+	if (file != NULL) {
+
+		file->Open(FileClass::WRITE);
+
+		int i,type;
+		StringClass str;
+
+		/*
+		** Totals by caller category and query type
+		*/
+		str.Format("COLLISION PROFILE\r\n\r\nCATEGORIES\r\n%-24s %-10s %10s %12s %12s %12s\r\n","Category","Query","Count","Nodes","Triangles","Time(ms)");
+		file->Write(str.Peek_Buffer(),str.Get_Length());
+
+		for (i=0; i<CategoryCount; i++) {
+			for (type=0; type<QUERY_TYPE_COUNT; type++) {
+				const TotalsStruct & totals = Categories[i].Totals[type];
+				if (totals.Queries > 0) {
+					str.Format("%-24s %-10s %10d %12d %12d %12.3f\r\n",Categories[i].Name,_QueryTypeNames[type],totals.Queries,totals.Nodes,totals.Triangles,totals.Time * 1000.0f);
+					file->Write(str.Peek_Buffer(),str.Get_Length());
+				}
+			}
+		}
+
+		/*
+		** Totals by collision group
+		*/
+		str.Format("\r\nCOLLISION GROUPS\r\n%-6s %10s %12s %12s %12s\r\n","Group","Count","Nodes","Triangles","Time(ms)");
+		file->Write(str.Peek_Buffer(),str.Get_Length());
+
+		for (i=0; i<MAX_GROUPS; i++) {
+			if (GroupTotals[i].Queries > 0) {
+				str.Format("%-6d %10d %12d %12d %12.3f\r\n",i,GroupTotals[i].Queries,GroupTotals[i].Nodes,GroupTotals[i].Triangles,GroupTotals[i].Time * 1000.0f);
+				file->Write(str.Peek_Buffer(),str.Get_Length());
+			}
+		}
+
+		/*
+		** The most expensive cells, found by repeatedly picking the most expensive cell
+		** that is cheaper than the last one picked.
+		*/
+		str.Format("\r\nHOTTEST CELLS\r\n%10s %10s %10s %10s %10s %12s %12s %12s\r\n","CellX","CellY","MinX","MinY","Count","Nodes","Triangles","Time(ms)");
+		file->Write(str.Peek_Buffer(),str.Get_Length());
+
+		int last_hot = -1;
+		for (int rank=0; rank<HOTTEST_CELL_COUNT; rank++) {
+			int hot = -1;
+			for (i=0; i<CellsX * CellsY; i++) {
+				if (Cells[i].Queries == 0) continue;
+				if (last_hot != -1) {
+					if (Cells[i].Time > Cells[last_hot].Time) continue;
+					if ((Cells[i].Time == Cells[last_hot].Time) && (i <= last_hot)) continue;
+				}
+				if ((hot == -1) || (Cells[i].Time > Cells[hot].Time)) {
+					hot = i;
+				}
+			}
+			if (hot == -1) {
+				break;
+			}
+			int x = hot % CellsX;
+			int y = hot / CellsX;
+			str.Format("%10d %10d %10.1f %10.1f %10d %12d %12d %12.3f\r\n",x,y,GridMin.X + x * CellSize,GridMin.Y + y * CellSize,Cells[hot].Queries,Cells[hot].Nodes,Cells[hot].Triangles,Cells[hot].Time * 1000.0f);
+			file->Write(str.Peek_Buffer(),str.Get_Length());
+			last_hot = hot;
+		}
+
+		/*
+		** The heatmap itself
+		*/
+		str.Format("\r\nHEATMAP %d %d %f %f %f\r\n",CellsX,CellsY,GridMin.X,GridMin.Y,CellSize);
+		file->Write(str.Peek_Buffer(),str.Get_Length());
+
+		for (int y=0; y<CellsY; y++) {
+			StringClass row;
+			for (int x=0; x<CellsX; x++) {
+				str.Format((x == 0) ? "%.3f" : " %.3f",Cells[x + y * CellsX].Time * 1000.0f);
+				row += str;
+			}
+			row += "\r\n";
+			file->Write(row.Peek_Buffer(),row.Get_Length());
+		}
+
+		file->Close();
+		_TheWritingFileFactory->Return_File(file);
+	}
+
+	Reset();
+}
+
+
+/***********************************************************************************************
+ * CollisionProfilerClass::Push_Category -- Enter a caller category                            *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void CollisionProfilerClass::Push_Category(const char * name)
+{
+	if (CategoryDepth < MAX_CATEGORY_DEPTH) {
+		CategoryStack[CategoryDepth] = name;
+	}
+	CategoryDepth++;
+}
+
+
+/***********************************************************************************************
+ * CollisionProfilerClass::Pop_Category -- Leave a caller category                             *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void CollisionProfilerClass::Pop_Category(void)
+{
+	WWASSERT(CategoryDepth > 0);
+	CategoryDepth--;
+}
+
+
+/***********************************************************************************************
+ * CollisionProfilerClass::Internal_Begin_Query -- Called when the scene starts a query        *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ * true if the query is to be recorded                                                         *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+bool CollisionProfilerClass::Internal_Begin_Query(void)
+{
+	if (!Collecting || (QueryDepth > 0)) {
+		return false;
+	}
+	QueryDepth = 1;
+	StartNodes = NodeCounter;
+	StartTriangles = Get_Triangle_Counter();
+	return true;
+}
+
+
+/***********************************************************************************************
+ * CollisionProfilerClass::End_Query -- Record a finished collision query                      *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * type - kind of query                                                                        *
+ * collision_group - collision group of the query                                              *
+ * position - where the query started, used to pick the grid cell                              *
+ * time - seconds the query took                                                               *
+ * batch_count - number of tests in the batch the query was part of                            *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void CollisionProfilerClass::End_Query(QueryType type,int collision_group,const Vector3 & position,float time,int batch_count)
+{
+	QueryDepth = 0;
+	if (!Collecting) {
+		return;
+	}
+
+	int nodes = NodeCounter - StartNodes;
+	int triangles = Get_Triangle_Counter() - StartTriangles;
+	if (batch_count > 1) {
+		nodes /= batch_count;
+		triangles /= batch_count;
+		time /= (float)batch_count;
+	}
+
+	/*
+	** Charge the innermost category
+	*/
+	const char * name = _UnknownCategory;
+	if ((CategoryDepth > 0) && (CategoryDepth <= MAX_CATEGORY_DEPTH)) {
+		name = CategoryStack[CategoryDepth - 1];
+	}
+	Add_Sample(Find_Category(name)->Totals[type],nodes,triangles,time);
+
+	if ((collision_group >= 0) && (collision_group < MAX_GROUPS)) {
+		Add_Sample(GroupTotals[collision_group],nodes,triangles,time);
+	}
+
+	/*
+	** Charge the grid cell the query started in
+	*/
+	int x = WWMath::Float_To_Int_Floor((position.X - GridMin.X) / CellSize);
+	int y = WWMath::Float_To_Int_Floor((position.Y - GridMin.Y) / CellSize);
+	x = WWMath::Clamp_Int(x,0,CellsX - 1);
+	y = WWMath::Clamp_Int(y,0,CellsY - 1);
+	Add_Sample(Cells[x + y * CellsX],nodes,triangles,time);
+}
+
+
+/***********************************************************************************************
+ * CollisionProfilerClass::Reset -- Throw away everything that was recorded                    *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void CollisionProfilerClass::Reset(void)
+{
+	QueryDepth = 0;
+	CategoryCount = 0;
+	delete [] Cells;
+	Cells = NULL;
+	CellsX = 0;
+	CellsY = 0;
+	for (int i=0; i<MAX_GROUPS; i++) {
+		Clear_Totals(GroupTotals[i]);
+	}
+}
+
+
+int CollisionProfilerClass::Get_Triangle_Counter(void)
+{
+	const CollisionMath::ColmathStatsStruct & stats = CollisionMath::Get_Current_Stats();
+	return stats.CollisionRayTriCount + stats.CollisionAABoxTriCount + stats.CollisionOBBoxTriCount;
+}
+
+
+CollisionProfilerClass::CategoryStruct * CollisionProfilerClass::Find_Category(const char * name)
+{
+	int i;
+	for (i=0; i<CategoryCount; i++) {
+		if ((Categories[i].Name == name) || (strcmp(Categories[i].Name,name) == 0)) {
+			return &(Categories[i]);
+		}
+	}
+
+	/*
+	** Out of slots, lump the rest together with the uncategorized queries
+	*/
+	if (CategoryCount == MAX_CATEGORIES) {
+		return (name != _UnknownCategory) ? Find_Category(_UnknownCategory) : &(Categories[MAX_CATEGORIES - 1]);
+	}
+
+	CategoryStruct & category = Categories[CategoryCount++];
+	category.Name = name;
+	for (i=0; i<QUERY_TYPE_COUNT; i++) {
+		Clear_Totals(category.Totals[i]);
+	}
+	return &category;
+}
+
+
+void CollisionProfilerClass::Add_Sample(TotalsStruct & totals,int nodes,int triangles,float time)
+{
+	totals.Queries++;
+	totals.Nodes += nodes;
+	totals.Triangles += triangles;
+	totals.Time += time;
+}
+
+
+void CollisionProfilerClass::Clear_Totals(TotalsStruct & totals)
+{
+	totals.Queries = 0;
+	totals.Nodes = 0;
+	totals.Triangles = 0;
+	totals.Time = 0.0f;
+}
@@ -0,0 +1,195 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/***********************************************************************************************
+ ***              C O N F I D E N T I A L  ---  W E S T W O O D  S T U D I O S               ***
+ ***********************************************************************************************
+ *                                                                                             *
+ *                 Project Name : WWPhys                                                       *
+ *                                                                                             *
+ *                     $Archive:: /Commando/Code/wwphys/collisionprofiler.h                   $*
+ *                                                                                             *
+ *---------------------------------------------------------------------------------------------*
+ * Functions:                                                                                  *
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#ifndef COLLISIONPROFILER_H
+#define COLLISIONPROFILER_H
+
+#include "always.h"
+#include "vector3.h"
+
+
+/******************************************************************************************
+**
+** CollisionProfilerClass
+** Opt-in instrumentation for the collision queries in PhysicsSceneClass (Cast_Ray, 
+** Cast_AABox, Cast_OBBox and Intersection_Test).  While collecting, every query records
+** its time, the culling tree nodes it visited and the triangles it tested.  The results 
+** are added up by caller category, by collision group and into a grid of cells over the 
+** level (in x and y) so that the expensive parts of a map stand out.  End_Collecting 
+** writes everything out as a text report with the grid as a heatmap.
+**
+** Callers name themselves with COLLISION_PROFILE_CATEGORY, the innermost category is 
+** charged for the query.  Queries made while another query is running (from inside an
+** object's collision code) are charged to the outer query.
+**
+** Only the thread that called Begin_Collecting is profiled.  Everything the scene and the
+** culling trees call on every query checks a thread local flag first, so when nothing is
+** being collected (or on any other thread, such as the pathfind probe threads) the profiler
+** costs one test and touches no shared data.
+**
+** Triangle counts come from the CollisionMath statistics, which are only tracked when 
+** COLMATH_STAT_TRACKING is defined (debug builds).
+**
+******************************************************************************************/
+class CollisionProfilerClass
+{
+public:
+
+	enum QueryType
+	{
+		QUERY_RAY = 0,
+		QUERY_AABOX,
+		QUERY_OBBOX,
+		QUERY_INTERSECTION,
+		QUERY_TYPE_COUNT
+	};
+
+	CollisionProfilerClass(void);
+	~CollisionProfilerClass(void);
+
+	void						Begin_Collecting(const Vector3 & min,const Vector3 & max,float cell_size);
+	void						End_Collecting(const char * filename);
+	bool						Is_Collecting(void) const										{ return Collecting; }
+
+	/*
+	** True only on the collecting thread, while collecting
+	*/
+	static bool				Is_Collecting_Thread(void)										{ return IsCollectingThread; }
+
+	/*
+	** Caller categories, use COLLISION_PROFILE_CATEGORY rather than calling these
+	*/
+	void						Push_Category(const char * name);
+	void						Pop_Category(void);
+
+	/*
+	** Called by the scene around each query.  Begin_Query returns true if the query
+	** should be recorded, in which case End_Query must be called when it is done.  For a
+	** batched cast End_Query is called once for each test in the batch with the time of the
+	** whole batch, and each test is charged an equal share of it.
+	*/
+	bool						Begin_Query(void)													{ return IsCollectingThread && Internal_Begin_Query(); }
+	void						End_Query(QueryType type,int collision_group,const Vector3 & position,float time,int batch_count = 1);
+
+	/*
+	** Called by the culling trees for each node a collision query visits
+	*/
+	void						Count_Node(void)													{ if (IsCollectingThread) NodeCounter++; }
+
+protected:
+
+	struct TotalsStruct
+	{
+		int						Queries;
+		int						Nodes;
+		int						Triangles;
+		float						Time;
+	};
+
+	struct CategoryStruct
+	{
+		const char *			Name;
+		TotalsStruct			Totals[QUERY_TYPE_COUNT];
+	};
+
+	enum 
+	{ 
+		MAX_CATEGORY_DEPTH = 16,
+		MAX_CATEGORIES = 32,
+		MAX_GROUPS = 16,
+		MAX_GRID_CELLS = 256 * 256,
+		HOTTEST_CELL_COUNT = 20,
+	};
+
+	bool						Internal_Begin_Query(void);
+	void						Reset(void);
+	int						Get_Triangle_Counter(void);
+	CategoryStruct *		Find_Category(const char * name);
+	static void				Add_Sample(TotalsStruct & totals,int nodes,int triangles,float time);
+	static void				Clear_Totals(TotalsStruct & totals);
+
+	bool										Collecting;
+	int										QueryDepth;
+	int										NodeCounter;
+	int										StartNodes;
+	int										StartTriangles;
+
+	const char *							CategoryStack[MAX_CATEGORY_DEPTH];
+	int										CategoryDepth;
+
+	CategoryStruct							Categories[MAX_CATEGORIES];
+	int										CategoryCount;
+	TotalsStruct							GroupTotals[MAX_GROUPS];
+
+	Vector3									GridMin;
+	float										CellSize;
+	int										CellsX;
+	int										CellsY;
+	TotalsStruct *							Cells;
+
+	static thread_local bool			IsCollectingThread;
+};
+
+
+/*
+** _CollisionProfiler - global instance of the collision query profiler
+*/
+extern CollisionProfilerClass _CollisionProfiler;
+
+
+/*
+** CollisionProfileCategoryClass - charges the collision queries made in a scope to a category.
+** The name must be a string literal (or otherwise outlive the profiling session).
+*/
+class CollisionProfileCategoryClass
+{
+public:
+	CollisionProfileCategoryClass(const char * name) : Pushed(CollisionProfilerClass::Is_Collecting_Thread())
+	{
+		if (Pushed) _CollisionProfiler.Push_Category(name);
+	}
+	~CollisionProfileCategoryClass(void)
+	{
+		if (Pushed) _CollisionProfiler.Pop_Category();
+	}
+
+private:
+	bool		Pushed;
+};
+
+#define COLLISION_PROFILE_CATEGORY(name)	CollisionProfileCategoryClass _collision_profile_category(name)
+
+
+#endif
@@ -89,18 +89,22 @@ DynamicAABTreeCullClass::DynamicAABTreeCullClass(PhysicsSceneClass * pscene) :
 	PhysAABTreeCullClass(pscene),
 	MaxObjRadius(DEFUALT_MAXOBJRADIUS),
 	RenderBox(NULL),
-	DebugIterator(this)
+	DebugIterator(this),
+	Coherency(NULL)
 {
 	/*
 	** Modify the root node so that any object can be added into the tree
 	*/
 	WWASSERT(RootNode != NULL);
 	RootNode->Box.Extent.Set(FLT_MAX/4.0f,FLT_MAX/4.0f,FLT_MAX/4.0f);
+
+	Reset_Lookup_Statistics();
 }
 
 DynamicAABTreeCullClass::~DynamicAABTreeCullClass(void)
 {
 	REF_PTR_RELEASE(RenderBox);
+	invalidate_coherency_table();
 }
 
 void DynamicAABTreeCullClass::Add_Object(PhysClass * obj)
@@ -132,9 +136,9 @@ void DynamicAABTreeCullClass::Update_Culling(CullableClass * obj)
 	node->Remove_Object(obj);
 
 	/*
-	** link it back into the tree
+	** link it back into the tree, starting the search from the node it was in
 	*/
-	int node_index = find_insertion_node(obj);
+	int node_index = find_insertion_node(obj,node->Index);
 	WWASSERT(node_index < NodeCount);
 	IndexedNodes[node_index]->Add_Object(obj,false);
 }
@@ -187,13 +191,22 @@ uint32 DynamicAABTreeCullClass::Get_Dynamic_Object_Vis_ID(const AABoxClass & obj
 
 	/*
 	** Step 2: Now recurse down the tree to find the node this object should derive its visibility
-	** from
+	** from.  Unlike the coherency code above, find_coherent_node only skips the search when 
+	** the search is guaranteed to end up in the same node.
 	*/
-	int node_index = 0;
-	if (is_big_obj) {
-		find_optimal_node(start_node,obj_bounds,node_index);
-	} else {
-		find_optimal_deflated_node(start_node,obj_bounds.Center,node_index);
+	LookupStats.Lookups++;
+	int node_index = -1;
+	if (!is_big_obj && (node_id != NULL)) {
+		node_index = find_coherent_node(obj_bounds.Center,*node_id);
+	}
+
+	if (node_index == -1) {
+		node_index = 0;
+		if (is_big_obj) {
+			find_optimal_node(start_node,obj_bounds,node_index);
+		} else {
+			find_optimal_deflated_node(start_node,obj_bounds.Center,node_index);
+		}
 	}
 
 	/*
@@ -219,6 +232,7 @@ void DynamicAABTreeCullClass::Re_Partition
 	** Remember the max object radius
 	*/
 	MaxObjRadius = max_obj_radius;
+	invalidate_coherency_table();
 
 	/*
 	** Determine the grid parameters for the world.  We want to get the grid cell size
@@ -422,6 +436,7 @@ void DynamicAABTreeCullClass::Save_Static_Data(ChunkSaveClass & csave)
 void DynamicAABTreeCullClass::Load_Static_Data(ChunkLoadClass & cload)
 {
 	WWMEMLOG(MEM_CULLINGDATA);
+	invalidate_coherency_table();
 	while (cload.Open_Chunk()) {
 		switch(cload.Cur_Chunk_ID()) {
 
@@ -554,8 +569,9 @@ AABoxRenderObjClass * DynamicAABTreeCullClass::get_render_box(void)
 }
 
 
-int DynamicAABTreeCullClass::find_insertion_node(CullableClass * obj)
+int DynamicAABTreeCullClass::find_insertion_node(CullableClass * obj,int hint_node)
 {	
+	LookupStats.Lookups++;
 	int node_index = 0;
 	const AABoxClass & cullbox = obj->Get_Cull_Box();
 	if (	(cullbox.Extent.X > MaxObjRadius) || 
@@ -564,11 +580,54 @@ int DynamicAABTreeCullClass::find_insertion_node(CullableClass * obj)
 	{
 		find_optimal_node(RootNode,cullbox,node_index);
 	} else {
-		find_optimal_deflated_node(RootNode,cullbox.Center,node_index);
+		int coherent_node = find_coherent_node(cullbox.Center,hint_node);
+		if (coherent_node != -1) {
+			node_index = coherent_node;
+		} else {
+			find_optimal_deflated_node(RootNode,cullbox.Center,node_index);
+		}
 	}
 	return node_index;
 }
 
+int DynamicAABTreeCullClass::find_coherent_node(const Vector3 & center,int hint_node)
+{
+	/*
+	** find_optimal_deflated_node would end up right back in the hint node if the search 
+	** reaches the hint node (the point is in its deflated box and all of its ancestors') 
+	** and can't reach any of its rivals.
+	*/
+	if ((hint_node <= 0) || (hint_node >= NodeCount)) {
+		return -1;
+	}
+
+	if (Coherency == NULL) {
+		build_coherency_table();
+	}
+
+	const CoherencyStruct & entry = Coherency[hint_node];
+	if (entry.RivalCount < 0) {
+		return -1;
+	}
+
+	AABTreeNodeClass * node = IndexedNodes[hint_node];
+	while (node != RootNode) {
+		if (!deflated_box_contains_point(node->Box,center)) {
+			return -1;
+		}
+		node = node->Parent;
+	}
+
+	for (int i=0; i<entry.RivalCount; i++) {
+		if (deflated_box_contains_point(Rivals[entry.FirstRival + i]->Box,center)) {
+			return -1;
+		}
+	}
+
+	LookupStats.CoherentLookups++;
+	return hint_node;
+}
+
 void DynamicAABTreeCullClass::find_optimal_node
 (
 	AABTreeNodeClass * node,
@@ -616,6 +675,7 @@ void DynamicAABTreeCullClass::find_optimal_deflated_node
 	** We want to find the smallest "de-flated" leaf node that contains the 
 	** given center point.
 	*/
+	LookupStats.NodesSearched++;
 	int input_node_index = node_index;
 
 	if (node->Front) {
@@ -838,6 +898,7 @@ void DynamicAABTreeCullClass::render_visible_cells_recursive
 
 void DynamicAABTreeCullClass::Prune_Redundant_Leaf_Nodes(VisOptimizationContextClass & context)
 {
+	invalidate_coherency_table();
 	prune_redundant_leaf_nodes_recursive(RootNode,context);
 }
 
@@ -956,3 +1017,106 @@ void DynamicAABTreeCullClass::Merge_Vis_Object_IDs(uint32 id0,uint32 id1)
 	}
 }
 
+
+void DynamicAABTreeCullClass::Reset_Lookup_Statistics(void)
+{
+	LookupStats.Lookups = 0;
+	LookupStats.CoherentLookups = 0;
+	LookupStats.NodesSearched = 0;
+	LookupStats.CoherentNodeCount = 0;
+
+	if (Coherency != NULL) {
+		for (int i=0; i<NodeCount; i++) {
+			if (Coherency[i].RivalCount >= 0) {
+				LookupStats.CoherentNodeCount++;
+			}
+		}
+	}
+}
+
+void DynamicAABTreeCullClass::invalidate_coherency_table(void)
+{
+	if (Coherency != NULL) {
+		delete[] Coherency;
+		Coherency = NULL;
+	}
+	Rivals.Delete_All();
+}
+
+/*
+** Nodes with more rivals than this just use the normal search
+*/
+const int MAX_RIVALS = 32;
+
+void DynamicAABTreeCullClass::build_coherency_table(void)
+{
+	/*
+	** find_optimal_deflated_node(RootNode,point) only visits children whose deflated box
+	** contains the point and its answer is the smallest node it visited without visiting
+	** anything below it that was smaller still.  So for a point in the deflated box of a
+	** node and each of its ancestors, the search returns that node unless:
+	** - the node isn't smaller than the root, which is the starting answer.
+	** - the search visits some node that isn't one of its ancestors.  Such a node's deflated
+	**   box contains the point so it touches the node's deflated box.  Those are the 
+	**   node's rivals and a lookup that finds the point in any of them gives up.
+	** The tree doesn't change once the level is loaded so this is done once.
+	*/
+	WWMEMLOG(MEM_CULLINGDATA);
+	invalidate_coherency_table();
+	Coherency = new CoherencyStruct[NodeCount];
+
+	float root_size = IndexedNodes[0]->Box.Extent.Quick_Length();
+	for (int i=0; i<NodeCount; i++) {
+
+		AABTreeNodeClass * node = IndexedNodes[i];
+		Coherency[i].FirstRival = Rivals.Count();
+		Coherency[i].RivalCount = -1;
+
+		if (	(node == RootNode) || 
+				(node->Box.Extent.Quick_Length() >= root_size) ||
+				!deflated_boxes_overlap(node->Box,node->Box)	) 
+		{
+			continue;
+		}
+
+		collect_rivals_recursive(RootNode,node);
+		int count = Rivals.Count() - Coherency[i].FirstRival;
+		if (count <= MAX_RIVALS) {
+			Coherency[i].RivalCount = count;
+		} else {
+			while (Rivals.Count() > Coherency[i].FirstRival) {
+				Rivals.Delete(Rivals.Count() - 1);
+			}
+		}
+	}
+	Reset_Lookup_Statistics();
+}
+
+void DynamicAABTreeCullClass::collect_rivals_recursive(AABTreeNodeClass * node,AABTreeNodeClass * target)
+{
+	/*
+	** The search can only get below a node that touches the target's deflated box, so 
+	** there's no need to look under anything else.
+	*/
+	AABTreeNodeClass * children[2] = { node->Front, node->Back };
+	for (int i=0; i<2; i++) {
+		AABTreeNodeClass * child = children[i];
+		if ((child != NULL) && deflated_boxes_overlap(child->Box,target->Box)) {
+			if (!is_ancestor_or_self(child,target)) {
+				Rivals.Add(child);
+			}
+			collect_rivals_recursive(child,target);
+		}
+	}
+}
+
+bool DynamicAABTreeCullClass::is_ancestor_or_self(AABTreeNodeClass * node,AABTreeNodeClass * target)
+{
+	while (target != NULL) {
+		if (target == node) {
+			return true;
+		}
+		target = target->Parent;
+	}
+	return false;
+}
@@ -146,6 +146,22 @@ public:
 	virtual void		Save_Static_Data(ChunkSaveClass & csave);
 	virtual void		Load_Static_Data(ChunkLoadClass & cload);
 
+	/*
+	** Lookup statistics.  A coherent lookup is answered from the node the object was in 
+	** last time; the others search down from the root.  Coherent nodes are the ones that 
+	** can answer a coherent lookup (see build_coherency_table).
+	*/
+	struct LookupStatsStruct
+	{
+		int				Lookups;
+		int				CoherentLookups;
+		int				NodesSearched;
+		int				CoherentNodeCount;
+	};
+
+	void					Reset_Lookup_Statistics(void);
+	const LookupStatsStruct & Get_Lookup_Statistics(void)		{ return LookupStats; }
+
 protected:
 
 	/*
@@ -180,11 +196,18 @@ protected:
 	bool					subtree_is_visible(AABTreeNodeClass * node,VisRenderContextClass & context);
 	void					set_tree_visibility(AABTreeNodeClass * node,VisRenderContextClass & context,bool onoff);
 
-	int					find_insertion_node(CullableClass * obj);
+	int					find_insertion_node(CullableClass * obj,int hint_node = -1);
+	int					find_coherent_node(const Vector3 & center,int hint_node);
 	void					find_optimal_node(AABTreeNodeClass * node,const AABoxClass & box,int & node_index);
 	void					find_optimal_deflated_node(AABTreeNodeClass * node,const Vector3 & center,int & node_index);
 	
 	bool					deflated_box_contains_point(const AABoxClass & box,const Vector3 & point);
+	bool					deflated_boxes_overlap(const AABoxClass & box0,const AABoxClass & box1);
+
+	void					build_coherency_table(void);
+	void					invalidate_coherency_table(void);
+	void					collect_rivals_recursive(AABTreeNodeClass * node,AABTreeNodeClass * target);
+	bool					is_ancestor_or_self(AABTreeNodeClass * node,AABTreeNodeClass * target);
 	void					prune_redundant_leaf_nodes_recursive(AABTreeNodeClass * node,VisOptimizationContextClass & context);
 	void					prune_child(AABTreeNodeClass * parent,AABTreeNodeClass * child,VisOptimizationContextClass & context);
 
@@ -196,6 +219,21 @@ protected:
 	float					MaxObjRadius;		// Object "inflation" radius used when the tree was created.
 	AABoxRenderObjClass * RenderBox;		// Used to render nodes when debugging
 	AABTreeIterator	DebugIterator;		// Used to walk the tree while debugging.  Render_Visible.. starts from this node
+	LookupStatsStruct	LookupStats;
+
+	/*
+	** Coherency table, built on demand.  For each node, the nodes that could win a lookup
+	** for a point inside it (see build_coherency_table).  RivalCount is -1 for nodes
+	** that can't answer coherent lookups.
+	*/
+	struct CoherencyStruct
+	{
+		int				FirstRival;
+		int				RivalCount;
+	};
+
+	CoherencyStruct *	Coherency;
+	DynamicVectorClass<AABTreeNodeClass *>	Rivals;
 
 	/*
 	** Making Physics Scene a friend so that some of the more ugly vis-system interfaces
@@ -221,4 +259,26 @@ inline bool DynamicAABTreeCullClass::deflated_box_contains_point
 	return true;
 }
 
-#endif //DYNAMICAABTREECULL_H
\ No newline at end of file
+/*
+** Only used to build the coherency table so it errs on the safe side by 
+** DEFLATED_BOX_EPSILON; it may say two deflated boxes touch when they don't but never
+** the other way around.
+*/
+const float DEFLATED_BOX_EPSILON = 0.01f;
+
+inline bool DynamicAABTreeCullClass::deflated_boxes_overlap
+(
+	const AABoxClass & box0,
+	const AABoxClass & box1
+)
+{
+	for (int i=0; i<3; i++) {
+		float extent0 = box0.Extent[i] - MaxObjRadius;
+		float extent1 = box1.Extent[i] - MaxObjRadius;
+		if ((extent0 < 0.0f) || (extent1 < 0.0f)) return false;
+		if (WWMath::Fabs(box0.Center[i] - box1.Center[i]) > extent0 + extent1 + DEFLATED_BOX_EPSILON) return false;
+	}
+	return true;
+}
+
+#endif //DYNAMICAABTREECULL_H
\ No newline at end of file
@@ -93,6 +93,11 @@ public:
 	FloodfillBoxClass *	Find_Box (const Vector3 &pos);
 	int						Compute_Box_Count(const AABoxClass & vol);
 
+	//
+	//	Tiling methods (used to split the grid into work units)
+	//
+	int						Get_Tile_Index (const Vector3 &pos, int tile_cells);
+
 	//
 	// Accessors
 	//
@@ -171,6 +176,26 @@ FloodfillGridClass::Point_To_Cell (const Vector3 &pos, int *cell_x, int *cell_y)
 }
 
 
+////////////////////////////////////////////////////////////////////
+// Get_Tile_Index
+////////////////////////////////////////////////////////////////////
+inline int
+FloodfillGridClass::Get_Tile_Index (const Vector3 &pos, int tile_cells)
+{
+	int cell_x = 0;
+	int cell_y = 0;
+	Point_To_Cell (pos, &cell_x, &cell_y);
+
+	//
+	//	Tiles are square blocks of 'tile_cells' x 'tile_cells' grid cells,
+	// numbered in row-major order.
+	//
+	tile_cells		= max (tile_cells, 1);
+	int tiles_x		= (m_CellsX + tile_cells - 1) / tile_cells;
+	return ((cell_y / tile_cells) * tiles_x) + (cell_x / tile_cells);
+}
+
+
 ////////////////////////////////////////////////////////////////////
 // Get_Cell_Index
 ////////////////////////////////////////////////////////////////////
@@ -0,0 +1,709 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/***********************************************************************************************
+ ***              C O N F I D E N T I A L  ---  W E S T W O O D  S T U D I O S               ***
+ ***********************************************************************************************
+ *                                                                                             *
+ *                 Project Name : wwphys																		  *
+ *                                                                                             *
+ *                     $Archive:: /Commando/Code/wwphys/pathfindflowfield.cpp                 $*
+ *                                                                                             *
+ *---------------------------------------------------------------------------------------------*
+ * Functions:                                                                                  *
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+
+#include "pathfindflowfield.h"
+#include "pathfind.h"
+#include "pathfindportal.h"
+#include "pathsolve.h"
+#include "binheap.h"
+#include "wwmemlog.h"
+#include "systimer.h"
+
+
+///////////////////////////////////////////////////////////////////////////
+//	External prototypes (pathsolve.cpp)
+///////////////////////////////////////////////////////////////////////////
+bool Does_Object_Fit_Through_Portal (const PathObjectClass &object, PathfindSectorClass *sector, PathfindPortalClass *portal);
+
+
+///////////////////////////////////////////////////////////////////////////
+//	Constants
+///////////////////////////////////////////////////////////////////////////
+const int	MAX_CACHED_FIELDS				= 8;
+const uint32	MAX_FIELD_AGE					= 10000;
+const float	UNREACHABLE_COST				= 1.0E30F;
+
+
+///////////////////////////////////////////////////////////////////////////
+//	Static member initialization
+///////////////////////////////////////////////////////////////////////////
+DynamicVectorClass<PathfindFlowFieldClass *>	PathfindFlowFieldMgrClass::FieldList;
+bool														PathfindFlowFieldMgrClass::IsEnabled		= false;
+int														PathfindFlowFieldMgrClass::MinGroupSize	= 3;
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	FlowHeapNodeClass
+//
+//		Thin wrapper that lets the flow field edges live in the same
+// BinaryHeapClass the A-Star solver uses.
+//
+///////////////////////////////////////////////////////////////////////////
+class FlowHeapNodeClass : public HeapNodeClass<float>
+{
+public:
+	FlowHeapNodeClass (void)
+		:	Cost (UNREACHABLE_COST),
+			HeapLocation (0),
+			IsClosed (false)		{ }
+
+	uint32		Get_Heap_Location (void) const			{ return HeapLocation; }
+	void			Set_Heap_Location (uint32 location)		{ HeapLocation = location; }
+	float			Heap_Key (void) const						{ return Cost; }
+
+	float			Cost;
+	uint32		HeapLocation;
+	bool			IsClosed;
+};
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Get_Portal_Center
+//
+///////////////////////////////////////////////////////////////////////////
+static inline Vector3
+Get_Portal_Center (PathfindPortalClass *portal)
+{
+	AABoxClass portal_box;
+	portal->Get_Bounding_Box (portal_box);
+	return portal_box.Center;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Get_Flat_Distance
+//
+///////////////////////////////////////////////////////////////////////////
+static inline float
+Get_Flat_Distance (const Vector3 &p0, const Vector3 &p1)
+{
+	Vector3 delta	= p1 - p0;
+	delta.Z			= 0;
+	return delta.Length ();
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	PathfindFlowFieldClass
+//
+///////////////////////////////////////////////////////////////////////////
+PathfindFlowFieldClass::PathfindFlowFieldClass (void)
+	:	m_DestSector (NULL),
+		m_DestPos (0, 0, 0),
+		m_GraphRevision (0),
+		m_BuildTime (0),
+		m_LastUsedTime (0)
+{
+	m_SectorList.Set_Growth_Step (500);
+	m_EdgeList.Set_Growth_Step (2500);
+	m_InEdgeList.Set_Growth_Step (2500);
+	m_InEdgeStart.Set_Growth_Step (500);
+	return ;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	~PathfindFlowFieldClass
+//
+///////////////////////////////////////////////////////////////////////////
+PathfindFlowFieldClass::~PathfindFlowFieldClass (void)
+{
+	Reset ();
+	return ;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Reset
+//
+///////////////////////////////////////////////////////////////////////////
+void
+PathfindFlowFieldClass::Reset (void)
+{
+	m_DestSector		= NULL;
+	m_GraphRevision	= 0;
+	m_SectorList.Delete_All ();
+	m_EdgeList.Delete_All ();
+	m_InEdgeList.Delete_All ();
+	m_InEdgeStart.Delete_All ();
+	m_SectorIndexMap.Remove_All ();
+	return ;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Build
+//
+///////////////////////////////////////////////////////////////////////////
+bool
+PathfindFlowFieldClass::Build
+(
+	PathfindSectorClass *		dest_sector,
+	const Vector3 &				dest_pos,
+	const PathObjectClass &		path_object
+)
+{
+	WWMEMLOG(MEM_PATHFIND);
+	Reset ();
+
+	PathfindClass *pathfind = PathfindClass::Get_Instance ();
+	if (pathfind == NULL || dest_sector == NULL) {
+		return false;
+	}
+
+	m_DestSector		= dest_sector;
+	m_DestPos			= dest_pos;
+	m_PathObject		= path_object;
+	m_GraphRevision	= pathfind->Get_Graph_Revision ();
+	m_BuildTime			= TIMEGETTIME ();
+	m_LastUsedTime		= m_BuildTime;
+
+	//
+	//	Flatten the sector/portal graph into edge lists, run the search
+	// backwards from the destination and then pick an exit for every sector.
+	//
+	Build_Graph ();
+	if (Find_Sector_Index (m_DestSector) == -1) {
+		Reset ();
+		return false;
+	}
+
+	Solve ();
+	Select_Sector_Exits ();
+	return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Build_Graph
+//
+///////////////////////////////////////////////////////////////////////////
+void
+PathfindFlowFieldClass::Build_Graph (void)
+{
+	PathfindClass *pathfind	= PathfindClass::Get_Instance ();
+	int sector_count			= pathfind->Get_Sector_Count ();
+
+	//
+	//	Record each sector and remember its index so we can go from a
+	// sector pointer to its slot without scanning.
+	//
+	int index;
+	for (index = 0; index < sector_count; index ++) {
+		FlowSectorStruct info;
+		info.Sector			= pathfind->Peek_Sector (index);
+		info.FirstOutEdge	= 0;
+		info.OutEdgeCount	= 0;
+		info.BestEdge		= NO_EDGE;
+		info.Cost			= UNREACHABLE_COST;
+		m_SectorList.Add (info);
+		m_SectorIndexMap.Insert (info.Sector, index);
+	}
+
+	//
+	//	Every (sector, portal) pair becomes an edge.  The outgoing edges of
+	// a sector are stored contiguously.
+	//
+	for (index = 0; index < sector_count; index ++) {
+		PathfindSectorClass *sector = m_SectorList[index].Sector;
+		m_SectorList[index].FirstOutEdge = m_EdgeList.Count ();
+
+		int portal_count = sector->Get_Portal_Count ();
+		for (int portal_index = 0; portal_index < portal_count; portal_index ++) {
+			PathfindPortalClass *portal = sector->Peek_Portal (portal_index);
+			if (portal == NULL) {
+				continue;
+			}
+
+			PathfindSectorClass *dest_sector = portal->Peek_Dest_Sector (sector);
+			int dest_index							= Find_Sector_Index (dest_sector);
+			if (dest_index == -1) {
+				continue;
+			}
+
+			FlowEdgeStruct edge;
+			edge.Portal			= portal;
+			edge.FromSector	= sector;
+			edge.ToSector		= dest_sector;
+			edge.FromIndex		= index;
+			edge.ToIndex		= dest_index;
+			edge.NextEdge		= NO_EDGE;
+			edge.Cost			= UNREACHABLE_COST;
+
+			//
+			//	Can our object use this portal at all?
+			//
+			edge.IsUsable = PathSolveClass::Does_Object_Have_Access_To_Portal (m_PathObject, portal);
+			if (edge.IsUsable && portal->Does_Size_Matter ()) {
+				edge.IsUsable = ::Does_Object_Fit_Through_Portal (m_PathObject, sector, portal);
+			}
+
+			m_EdgeList.Add (edge);
+			m_SectorList[index].OutEdgeCount ++;
+		}
+	}
+
+	//
+	//	Build the reverse adjacency (edges entering each sector) using a
+	// counting sort so the search can walk predecessors quickly.
+	//
+	int edge_count = m_EdgeList.Count ();
+	m_InEdgeStart.Resize (sector_count + 1);
+	for (index = 0; index <= sector_count; index ++) {
+		m_InEdgeStart.Add (0);
+	}
+
+	for (index = 0; index < edge_count; index ++) {
+		m_InEdgeStart[m_EdgeList[index].ToIndex + 1] ++;
+	}
+
+	for (index = 0; index < sector_count; index ++) {
+		m_InEdgeStart[index + 1] += m_InEdgeStart[index];
+	}
+
+	m_InEdgeList.Resize (edge_count);
+	for (index = 0; index < edge_count; index ++) {
+		m_InEdgeList.Add (0);
+	}
+
+	DynamicVectorClass<int> fill_list;
+	fill_list = m_InEdgeStart;
+	for (index = 0; index < edge_count; index ++) {
+		int sector_index = m_EdgeList[index].ToIndex;
+		m_InEdgeList[fill_list[sector_index] ++] = index;
+	}
+
+	return ;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Solve
+//
+//		Reverse Dijkstra.  The cost of an edge is the distance from its
+// portal to the destination, given the unit has just crossed that portal.
+//
+///////////////////////////////////////////////////////////////////////////
+void
+PathfindFlowFieldClass::Solve (void)
+{
+	int edge_count = m_EdgeList.Count ();
+	if (edge_count == 0) {
+		return ;
+	}
+
+	FlowHeapNodeClass *heap_nodes = new FlowHeapNodeClass[edge_count];
+	BinaryHeapClass<float> heap (edge_count + 2);
+
+	//
+	//	Seed the search with every usable portal that enters the destination
+	//
+	int dest_index = Find_Sector_Index (m_DestSector);
+	int index;
+	for (index = m_InEdgeStart[dest_index]; index < m_InEdgeStart[dest_index + 1]; index ++) {
+		int edge_index			= m_InEdgeList[index];
+		FlowEdgeStruct &edge	= m_EdgeList[edge_index];
+
+		if (edge.IsUsable) {
+			heap_nodes[edge_index].Cost = ::Get_Flat_Distance (::Get_Portal_Center (edge.Portal), m_DestPos);
+			edge.Cost = heap_nodes[edge_index].Cost;
+			heap.Insert (&heap_nodes[edge_index]);
+		}
+	}
+
+	//
+	//	Expand outward until every reachable edge is settled
+	//
+	FlowHeapNodeClass *node = NULL;
+	while ((node = (FlowHeapNodeClass *)heap.Remove_Min ()) != NULL) {
+		int curr_index					= (node - heap_nodes);
+		FlowEdgeStruct &curr_edge	= m_EdgeList[curr_index];
+		node->IsClosed					= true;
+
+		Vector3 curr_center					= ::Get_Portal_Center (curr_edge.Portal);
+		PathfindSectorClass *from_sector	= curr_edge.FromSector;
+		int from_index							= curr_edge.FromIndex;
+
+		//
+		//	Any edge that enters our 'from' sector can continue through us,
+		// provided the sector lets it get from that portal to ours.
+		//
+		for (index = m_InEdgeStart[from_index]; index < m_InEdgeStart[from_index + 1]; index ++) {
+			int prev_index				= m_InEdgeList[index];
+			FlowEdgeStruct &prev_edge	= m_EdgeList[prev_index];
+			FlowHeapNodeClass &prev_node	= heap_nodes[prev_index];
+
+			if (	prev_node.IsClosed ||
+					prev_edge.IsUsable == false ||
+					prev_edge.ToSector == m_DestSector ||
+					from_sector->Can_Access_Portal (prev_edge.Portal, curr_edge.Portal) == false)
+			{
+				continue;
+			}
+
+			float cost = node->Cost + ::Get_Flat_Distance (::Get_Portal_Center (prev_edge.Portal), curr_center);
+			if (cost < prev_node.Cost) {
+				prev_node.Cost			= cost;
+				prev_edge.Cost			= cost;
+				prev_edge.NextEdge	= curr_index;
+
+				if (prev_node.HeapLocation > 0) {
+					heap.Percolate_Up (prev_node.HeapLocation);
+				} else {
+					heap.Insert (&prev_node);
+				}
+			}
+		}
+	}
+
+	delete [] heap_nodes;
+	return ;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Select_Sector_Exits
+//
+///////////////////////////////////////////////////////////////////////////
+void
+PathfindFlowFieldClass::Select_Sector_Exits (void)
+{
+	for (int index = 0; index < m_SectorList.Count (); index ++) {
+		FlowSectorStruct &info = m_SectorList[index];
+
+		if (info.Sector == m_DestSector) {
+			info.Cost		= 0;
+			info.BestEdge	= NO_EDGE;
+			continue;
+		}
+
+		//
+		//	Pick the exit with the cheapest total cost from the sector center
+		//
+		const Vector3 &center = info.Sector->Get_Bounding_Box ().Center;
+		for (int edge_index = info.FirstOutEdge; edge_index < info.FirstOutEdge + info.OutEdgeCount; edge_index ++) {
+			const FlowEdgeStruct &edge = m_EdgeList[edge_index];
+			if (edge.IsUsable && edge.Cost < UNREACHABLE_COST) {
+
+				float cost = edge.Cost + ::Get_Flat_Distance (center, ::Get_Portal_Center (edge.Portal));
+				if (cost < info.Cost) {
+					info.Cost		= cost;
+					info.BestEdge	= edge_index;
+				}
+			}
+		}
+	}
+
+	return ;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Find_Sector_Index
+//
+///////////////////////////////////////////////////////////////////////////
+int
+PathfindFlowFieldClass::Find_Sector_Index (PathfindSectorClass *sector) const
+{
+	int index = -1;
+	if (sector != NULL && m_SectorIndexMap.Get (sector, index) == false) {
+		index = -1;
+	}
+
+	return index;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Is_Valid
+//
+///////////////////////////////////////////////////////////////////////////
+bool
+PathfindFlowFieldClass::Is_Valid (void) const
+{
+	PathfindClass *pathfind = PathfindClass::Get_Instance ();
+
+	return (	m_DestSector != NULL &&
+				pathfind != NULL &&
+				pathfind->Get_Graph_Revision () == m_GraphRevision);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Can_Share_Field
+//
+//		Two objects can follow the same field when the portal access and
+// size checks made during the build would give the same answers.
+//
+///////////////////////////////////////////////////////////////////////////
+bool
+PathfindFlowFieldClass::Can_Share_Field
+(
+	const PathObjectClass &	object1,
+	const PathObjectClass &	object2
+)
+{
+	return (	object1.Get_Flags () == object2.Get_Flags () &&
+				object1.Get_Key_Ring () == object2.Get_Key_Ring () &&
+				WWMath::Fabs (object1.Get_Width () - object2.Get_Width ()) < 0.01F);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Can_Reach_Destination
+//
+///////////////////////////////////////////////////////////////////////////
+bool
+PathfindFlowFieldClass::Can_Reach_Destination (PathfindSectorClass *sector) const
+{
+	return (Get_Cost (sector) < UNREACHABLE_COST);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Get_Cost
+//
+///////////////////////////////////////////////////////////////////////////
+float
+PathfindFlowFieldClass::Get_Cost (PathfindSectorClass *sector) const
+{
+	float cost	= UNREACHABLE_COST;
+	int index	= Find_Sector_Index (sector);
+	if (index != -1) {
+		cost = m_SectorList[index].Cost;
+	}
+
+	return cost;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Get_First_Edge
+//
+///////////////////////////////////////////////////////////////////////////
+int
+PathfindFlowFieldClass::Get_First_Edge (PathfindSectorClass *sector) const
+{
+	int edge_index	= NO_EDGE;
+	int index		= Find_Sector_Index (sector);
+	if (index != -1) {
+		edge_index = m_SectorList[index].BestEdge;
+	}
+
+	return edge_index;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Peek_Next_Portal
+//
+///////////////////////////////////////////////////////////////////////////
+PathfindPortalClass *
+PathfindFlowFieldClass::Peek_Next_Portal (PathfindSectorClass *sector) const
+{
+	PathfindPortalClass *portal	= NULL;
+	int edge_index						= Get_First_Edge (sector);
+	if (edge_index != NO_EDGE) {
+		portal = m_EdgeList[edge_index].Portal;
+	}
+
+	return portal;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Touch
+//
+///////////////////////////////////////////////////////////////////////////
+void
+PathfindFlowFieldClass::Touch (void)
+{
+	m_LastUsedTime = TIMEGETTIME ();
+	return ;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Shutdown
+//
+///////////////////////////////////////////////////////////////////////////
+void
+PathfindFlowFieldMgrClass::Shutdown (void)
+{
+	Flush ();
+	return ;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Flush
+//
+///////////////////////////////////////////////////////////////////////////
+void
+PathfindFlowFieldMgrClass::Flush (void)
+{
+	for (int index = 0; index < FieldList.Count (); index ++) {
+		PathfindFlowFieldClass *field = FieldList[index];
+		REF_PTR_RELEASE (field);
+	}
+
+	FieldList.Delete_All ();
+	return ;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Free_Stale_Fields
+//
+///////////////////////////////////////////////////////////////////////////
+void
+PathfindFlowFieldMgrClass::Free_Stale_Fields (void)
+{
+	uint32 curr_time = TIMEGETTIME ();
+
+	for (int index = FieldList.Count () - 1; index >= 0; index --) {
+		PathfindFlowFieldClass *field = FieldList[index];
+
+		if (	field->Is_Valid () == false ||
+				(curr_time - field->Get_Build_Time ()) > MAX_FIELD_AGE)
+		{
+			FieldList.Delete (index);
+			REF_PTR_RELEASE (field);
+		}
+	}
+
+	return ;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Peek_Field
+//
+///////////////////////////////////////////////////////////////////////////
+PathfindFlowFieldClass *
+PathfindFlowFieldMgrClass::Peek_Field
+(
+	PathfindSectorClass *		dest_sector,
+	const PathObjectClass &		path_object
+)
+{
+	Free_Stale_Fields ();
+
+	PathfindFlowFieldClass *retval = NULL;
+	for (int index = 0; index < FieldList.Count (); index ++) {
+		PathfindFlowFieldClass *field = FieldList[index];
+
+		if (	field->Peek_Dest_Sector () == dest_sector &&
+				field->Is_Compatible (path_object))
+		{
+			field->Touch ();
+			retval = field;
+			break;
+		}
+	}
+
+	return retval;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Build_Field
+//
+///////////////////////////////////////////////////////////////////////////
+PathfindFlowFieldClass *
+PathfindFlowFieldMgrClass::Build_Field
+(
+	PathfindSectorClass *		dest_sector,
+	const Vector3 &				dest_pos,
+	const PathObjectClass &		path_object
+)
+{
+	WWMEMLOG(MEM_PATHFIND);
+
+	//
+	//	Reuse an existing field if we have one
+	//
+	PathfindFlowFieldClass *field = Peek_Field (dest_sector, path_object);
+	if (field != NULL) {
+		return field;
+	}
+
+	field = new PathfindFlowFieldClass;
+	if (field->Build (dest_sector, dest_pos, path_object) == false) {
+		REF_PTR_RELEASE (field);
+		return NULL;
+	}
+
+	//
+	//	Make room by throwing away the least recently used field
+	//
+	if (FieldList.Count () >= MAX_CACHED_FIELDS) {
+		int oldest_index = 0;
+		for (int index = 1; index < FieldList.Count (); index ++) {
+			if (FieldList[index]->Get_Last_Used_Time () < FieldList[oldest_index]->Get_Last_Used_Time ()) {
+				oldest_index = index;
+			}
+		}
+
+		PathfindFlowFieldClass *oldest_field = FieldList[oldest_index];
+		FieldList.Delete (oldest_index);
+		REF_PTR_RELEASE (oldest_field);
+	}
+
+	//
+	//	The cache inherits the reference from the allocation
+	//
+	FieldList.Add (field);
+	return field;
+}
@@ -0,0 +1,236 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/***********************************************************************************************
+ ***              C O N F I D E N T I A L  ---  W E S T W O O D  S T U D I O S               ***
+ ***********************************************************************************************
+ *                                                                                             *
+ *                 Project Name : wwphys																		  *
+ *                                                                                             *
+ *                     $Archive:: /Commando/Code/wwphys/pathfindflowfield.h                   $*
+ *                                                                                             *
+ *---------------------------------------------------------------------------------------------*
+ * Functions:                                                                                  *
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#ifndef __PATHFIND_FLOW_FIELD_H
+#define __PATHFIND_FLOW_FIELD_H
+
+
+#include "refcount.h"
+#include "vector.h"
+#include "vector3.h"
+#include "hashtemplate.h"
+#include "PathObject.h"
+
+
+/////////////////////////////////////////////////////////////////////////
+// Forward declarations
+/////////////////////////////////////////////////////////////////////////
+class PathfindSectorClass;
+class PathfindPortalClass;
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	PathfindFlowFieldClass
+//
+//		A flow field is the result of a single reverse Dijkstra search over
+//	the sector/portal graph, seeded from a destination.  Once built, any
+// sector can look up the portal that leads it toward the destination in
+// constant time, so a group of units sharing a destination only pays for
+// one search.
+//
+/////////////////////////////////////////////////////////////////////////
+class PathfindFlowFieldClass : public RefCountClass
+{
+public:
+
+	/////////////////////////////////////////////////////////////////////////
+	// Public constructors/destructors
+	/////////////////////////////////////////////////////////////////////////
+	PathfindFlowFieldClass (void);
+	~PathfindFlowFieldClass (void);
+
+	/////////////////////////////////////////////////////////////////////////
+	// Public methods
+	/////////////////////////////////////////////////////////////////////////
+
+	//
+	//	Construction
+	//
+	bool						Build (PathfindSectorClass *dest_sector, const Vector3 &dest_pos, const PathObjectClass &path_object);
+	void						Reset (void);
+
+	//
+	//	Field queries
+	//
+	bool						Is_Valid (void) const;
+	bool						Is_Compatible (const PathObjectClass &path_object) const	{ return Can_Share_Field (m_PathObject, path_object); }
+	static bool				Can_Share_Field (const PathObjectClass &object1, const PathObjectClass &object2);
+	bool						Can_Reach_Destination (PathfindSectorClass *sector) const;
+	float						Get_Cost (PathfindSectorClass *sector) const;
+
+	//
+	//	Route queries.  The first portal is chosen from the sector alone, every
+	// portal after that is chosen knowing which portal the unit entered through.
+	//
+	PathfindPortalClass *Peek_Next_Portal (PathfindSectorClass *sector) const;
+	int						Get_First_Edge (PathfindSectorClass *sector) const;
+	int						Get_Next_Edge (int edge_index) const			{ return m_EdgeList[edge_index].NextEdge; }
+	PathfindPortalClass *Peek_Edge_Portal (int edge_index) const		{ return m_EdgeList[edge_index].Portal; }
+	PathfindSectorClass *Peek_Edge_Dest_Sector (int edge_index) const	{ return m_EdgeList[edge_index].ToSector; }
+	int						Get_Edge_Count (void) const						{ return m_EdgeList.Count (); }
+
+	//
+	//	Destination access
+	//
+	PathfindSectorClass *Peek_Dest_Sector (void) const		{ return m_DestSector; }
+	const Vector3 &		Get_Dest_Pos (void) const			{ return m_DestPos; }
+
+	//
+	//	Cache bookkeeping
+	//
+	uint32					Get_Build_Time (void) const		{ return m_BuildTime; }
+	uint32					Get_Last_Used_Time (void) const	{ return m_LastUsedTime; }
+	void						Touch (void);
+
+	/////////////////////////////////////////////////////////////////////////
+	// Public constants
+	/////////////////////////////////////////////////////////////////////////
+	enum
+	{
+		NO_EDGE			= -1
+	};
+
+protected:
+
+	/////////////////////////////////////////////////////////////////////////
+	// Protected data types
+	/////////////////////////////////////////////////////////////////////////
+	struct FlowEdgeStruct
+	{
+		PathfindPortalClass *	Portal;
+		PathfindSectorClass *	FromSector;
+		PathfindSectorClass *	ToSector;
+		int							FromIndex;
+		int							ToIndex;
+		int							NextEdge;
+		float							Cost;
+		bool							IsUsable;
+
+		bool operator== (const FlowEdgeStruct &src) { return false; }
+		bool operator!= (const FlowEdgeStruct &src) { return true; }
+	};
+
+	struct FlowSectorStruct
+	{
+		PathfindSectorClass *	Sector;
+		int							FirstOutEdge;
+		int							OutEdgeCount;
+		int							BestEdge;
+		float							Cost;
+
+		bool operator== (const FlowSectorStruct &src) { return false; }
+		bool operator!= (const FlowSectorStruct &src) { return true; }
+	};
+
+	/////////////////////////////////////////////////////////////////////////
+	// Protected methods
+	/////////////////////////////////////////////////////////////////////////
+	void						Build_Graph (void);
+	void						Solve (void);
+	void						Select_Sector_Exits (void);
+	int						Find_Sector_Index (PathfindSectorClass *sector) const;
+
+private:
+
+	/////////////////////////////////////////////////////////////////////////
+	// Private member data
+	/////////////////////////////////////////////////////////////////////////
+	PathfindSectorClass *								m_DestSector;
+	Vector3													m_DestPos;
+	PathObjectClass										m_PathObject;
+	uint32													m_GraphRevision;
+	uint32													m_BuildTime;
+	uint32													m_LastUsedTime;
+
+	DynamicVectorClass<FlowSectorStruct>			m_SectorList;
+	DynamicVectorClass<FlowEdgeStruct>				m_EdgeList;
+	DynamicVectorClass<int>								m_InEdgeList;
+	DynamicVectorClass<int>								m_InEdgeStart;
+	HashTemplateClass<PathfindSectorClass *, int>	m_SectorIndexMap;
+};
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	PathfindFlowFieldMgrClass
+//
+//		Keeps a small cache of flow fields keyed on destination sector and
+// path object.  Fields are thrown away when the pathfind graph changes or
+// when they grow old enough that door and elevator lock states may have
+// changed underneath them.
+//
+/////////////////////////////////////////////////////////////////////////
+class PathfindFlowFieldMgrClass
+{
+public:
+
+	/////////////////////////////////////////////////////////////////////////
+	// Public methods
+	/////////////////////////////////////////////////////////////////////////
+	static void								Shutdown (void);
+
+	//
+	//	Configuration.  Flow fields are off unless turned on, since they change
+	// the routes of grouped units.
+	//
+	static void								Enable (bool onoff)						{ IsEnabled = onoff; if (onoff == false) Flush (); }
+	static bool								Is_Enabled (void)							{ return IsEnabled; }
+	static void								Set_Min_Group_Size (int count)		{ MinGroupSize = count; }
+	static int								Get_Min_Group_Size (void)				{ return MinGroupSize; }
+
+	//
+	//	Field access
+	//
+	static PathfindFlowFieldClass *	Peek_Field (PathfindSectorClass *dest_sector, const PathObjectClass &path_object);
+	static PathfindFlowFieldClass *	Build_Field (PathfindSectorClass *dest_sector, const Vector3 &dest_pos, const PathObjectClass &path_object);
+	static void								Flush (void);
+
+private:
+
+	/////////////////////////////////////////////////////////////////////////
+	// Private methods
+	/////////////////////////////////////////////////////////////////////////
+	static void								Free_Stale_Fields (void);
+
+	/////////////////////////////////////////////////////////////////////////
+	// Private member data
+	/////////////////////////////////////////////////////////////////////////
+	static DynamicVectorClass<PathfindFlowFieldClass *>	FieldList;
+	static bool															IsEnabled;
+	static int															MinGroupSize;
+};
+
+
+#endif //__PATHFIND_FLOW_FIELD_H
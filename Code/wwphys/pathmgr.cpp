@@ -37,6 +37,7 @@
 
 #include "pathmgr.h"
 #include "pathsolve.h"
+#include "pathfindflowfield.h"
 #include "chunkio.h"
 #include "win.h"
 #include "wwmemlog.h"
@@ -98,6 +99,7 @@ void
 PathMgrClass::Shutdown (void)
 {
 	Free_Objects ();
+	PathfindFlowFieldMgrClass::Shutdown ();
 	return ;
 }
 
@@ -424,6 +426,14 @@ PathMgrClass::Activate_New_Priority_Path (const Vector3 &camera_pos)
 		}
 	}
 
+	//
+	//	If a group of units is waiting on paths to the same destination, then
+	// build a flow field for it so each of them can read its path out of one search.
+	//
+	if (ActivePath != NULL) {
+		Prepare_Flow_Field (ActivePath);
+	}
+
 	//
 	//	Kick off the pathfind
 	//
@@ -432,4 +442,50 @@ PathMgrClass::Activate_New_Priority_Path (const Vector3 &camera_pos)
 	}
 
 	return ;
-}
\ No newline at end of file
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	Prepare_Flow_Field
+//
+////////////////////////////////////////////////////////////////////////////////////////////
+void
+PathMgrClass::Prepare_Flow_Field (PathSolveClass *path)
+{
+	if (	PathfindFlowFieldMgrClass::Is_Enabled () == false ||
+			path->m_DestSector == NULL ||
+			path->m_StartSector == path->m_DestSector)
+	{
+		return ;
+	}
+
+	//
+	//	Is there already a field we can use?
+	//
+	if (PathfindFlowFieldMgrClass::Peek_Field (path->m_DestSector, path->m_PathObject) != NULL) {
+		return ;
+	}
+
+	//
+	//	Count the pending paths that share this path's destination and
+	// would be able to use the same field.
+	//
+	int group_size = 0;
+	for (int index = 0; index < UsedPathList.Count (); index ++) {
+		PathSolveClass *other = UsedPathList[index];
+
+		if (	other->Get_State () == PathSolveClass::THINKING &&
+				other->m_DestSector == path->m_DestSector &&
+				PathfindFlowFieldClass::Can_Share_Field (other->m_PathObject, path->m_PathObject))
+		{
+			group_size ++;
+		}
+	}
+
+	if (group_size >= PathfindFlowFieldMgrClass::Get_Min_Group_Size ()) {
+		PathfindFlowFieldMgrClass::Build_Field (path->m_DestSector, path->m_DestPos, path->m_PathObject);
+	}
+
+	return ;
+}
@@ -100,6 +100,7 @@ private:
 	static void						Allocate_Objects (void);
 	static void						Free_Objects (void);
 	static void						Activate_New_Priority_Path (const Vector3 &camera_pos);
+	static void						Prepare_Flow_Field (PathSolveClass *path);
 
 	/////////////////////////////////////////////////////////////////////////
 	// Private member data
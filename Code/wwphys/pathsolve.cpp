@@ -46,8 +46,10 @@
 #include "accessiblephys.h"
 #include "chunkio.h"
 #include "pathmgr.h"
+#include "pathfindflowfield.h"
 #include "wwmemlog.h"
 #include "systimer.h"
+#include "framearena.h"
 
 
 
@@ -210,7 +212,8 @@ PathSolveClass::PathSolveClass (void)
 		m_State (ERROR_INVALID_START_POS),
 		m_BinaryHeap (10000),
 		m_Priority (0.5F),
-		m_BirthTime (0)
+		m_BirthTime (0),
+		m_ExpandedNodeCount (0)
 {
 	//
 	//	Determine how many performance-counter ticks
@@ -240,7 +243,8 @@ PathSolveClass::PathSolveClass (const Vector3 &start, const Vector3 &dest)
 		m_State (ERROR_INVALID_START_POS),
 		m_BinaryHeap (10000),
 		m_Priority (0.5F),
-		m_BirthTime (0)
+		m_BirthTime (0),
+		m_ExpandedNodeCount (0)
 {
 	//
 	//	Determine how many performance-counter ticks
@@ -381,6 +385,7 @@ PathSolveClass::Resolve_Path (unsigned int milliseconds)
 			Post_Process_Path ();
 
 		} else {
+			m_ExpandedNodeCount ++;
 			Process_Portals (node);
 		}
 
@@ -427,9 +432,10 @@ PathSolveClass::Timestep (unsigned int milliseconds)
 void
 PathSolveClass::Initialize (float sector_fudge)
 {
-	m_State				= THINKING;
-	m_CompletedNode	= NULL;
-	m_BirthTime			= TIMEGETTIME ();
+	m_State					= THINKING;
+	m_CompletedNode		= NULL;
+	m_BirthTime				= TIMEGETTIME ();
+	m_ExpandedNodeCount	= 0;
 
 	//
 	//	Lookup the start and destination sectors
@@ -473,6 +479,17 @@ PathSolveClass::Process_Initial_Sector (void)
 		return ;
 	}
 
+	//
+	//	If a flow field has already been built toward our destination (a group
+	// of units heading to the same spot), then simply read the path out of it.
+	//
+	if (PathfindFlowFieldMgrClass::Is_Enabled () && m_StartSector != m_DestSector) {
+		PathfindFlowFieldClass *field = PathfindFlowFieldMgrClass::Peek_Field (m_DestSector, m_PathObject);
+		if (field != NULL && Solve_From_Flow_Field (*field)) {
+			return ;
+		}
+	}
+
 	//
 	//	Create a set of path 'nodes' that represent all the portals of the
 	//	starting sector.
@@ -838,6 +855,22 @@ Does_Object_Fit_Through_Portal
 ///////////////////////////////////////////////////////////////////////////
 bool
 PathSolveClass::Does_Object_Have_Access_To_Portal (PathfindPortalClass *portal)
+{
+	return Does_Object_Have_Access_To_Portal (m_PathObject, portal);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Does_Object_Have_Access_To_Portal
+//
+///////////////////////////////////////////////////////////////////////////
+bool
+PathSolveClass::Does_Object_Have_Access_To_Portal
+(
+	const PathObjectClass &	path_object,
+	PathfindPortalClass *	portal
+)
 {
 	bool retval = true;
 
@@ -860,7 +893,7 @@ PathSolveClass::Does_Object_Have_Access_To_Portal (PathfindPortalClass *portal)
 			//	See if we can unlock this mechanism
 			//
 			if (accessible_obj != NULL && accessible_obj->Get_Lock_Code () != 0) {
-				retval = accessible_obj->Can_Unlock (m_PathObject.Get_Key_Ring ());
+				retval = accessible_obj->Can_Unlock (path_object.Get_Key_Ring ());
 			}
 		}
 	}
@@ -1489,8 +1522,6 @@ Check_Line
 //	Post_Process_Path
 //
 ///////////////////////////////////////////////////////////////////////////
-PathSolveClass::PATHNODE_LIST PathSolveClass::temp_node_list;
-
 void
 PathSolveClass::Post_Process_Path (void)
 {
@@ -1499,9 +1530,9 @@ PathSolveClass::Post_Process_Path (void)
 	//
 	//	Build a list of the nodes (in order) the path passes through.
 	//
-	temp_node_list.Reset_Active();
+	FrameDynamicVectorClass<PathNodeClass *> node_list;
 	for (PathNodeClass *node = m_CompletedNode; node != NULL; node = node->Peek_Parent_Node ()) {
-		temp_node_list.Add_Head (node);
+		node_list.Add_Head (node);
 	}
 
 
@@ -1512,9 +1543,9 @@ PathSolveClass::Post_Process_Path (void)
 	m_Path[m_Path.Count () - 1].m_SectorCenter = m_StartSector->Get_Bounding_Box ().Center;
 	m_Path[m_Path.Count () - 1].m_SectorExtent = m_StartSector->Get_Bounding_Box ().Extent;
 
-	for (int index = 0; index < temp_node_list.Count (); index ++) {
+	for (int index = 0; index < node_list.Count (); index ++) {
 
-		PathNodeClass *node				= temp_node_list[index];
+		PathNodeClass *node				= node_list[index];
 		PathfindPortalClass *portal	= node->Peek_Portal ();
 
 		m_Path.Add (PathDataStruct (portal, node->Get_Position ()));
@@ -1661,6 +1692,83 @@ PathSolveClass::Post_Process_Path (void)
 }
 
 
+/////////////////////////////////////////////////////////////////////////////////
+//
+//	Solve_From_Flow_Field
+//
+/////////////////////////////////////////////////////////////////////////////////
+bool
+PathSolveClass::Solve_From_Flow_Field (PathfindFlowFieldClass &field)
+{
+	int edge_index = field.Get_First_Edge (m_StartSector);
+	if (edge_index == PathfindFlowFieldClass::NO_EDGE) {
+		return false;
+	}
+
+	//
+	//	Walk the field from our starting sector, building the same chain of
+	// path nodes the A-Star search would have produced.
+	//
+	Matrix3D current_tm (m_StartPos);
+	PathfindSectorClass *sector	= m_StartSector;
+	PathNodeClass *parent_node		= NULL;
+	float traversal_cost				= 0;
+	int max_steps						= field.Get_Edge_Count ();
+
+	for (int step = 0; edge_index != PathfindFlowFieldClass::NO_EDGE && step < max_steps; step ++) {
+		PathfindPortalClass *portal		= field.Peek_Edge_Portal (edge_index);
+		PathfindSectorClass *dest_sector	= field.Peek_Edge_Dest_Sector (edge_index);
+
+		Matrix3D ending_tm (1);
+		if (Can_Object_Go_Through_Portal (current_tm, sector, portal, &ending_tm) == false) {
+			break;
+		}
+
+		Vector3 delta = ending_tm.Get_Translation () - current_tm.Get_Translation ();
+		delta.Z = 0;
+		traversal_cost += delta.Length ();
+
+		PathNodeClass *node = new PathNodeClass;
+		node->Set_Sector (dest_sector);
+		node->Set_Parent_Node (parent_node);
+		node->Set_Portal (portal);
+		node->Set_Traversal_Cost (traversal_cost);
+		node->Set_Transform (ending_tm);
+		m_NodeList.Add (node);
+
+		parent_node	= node;
+		current_tm	= ending_tm;
+		sector		= dest_sector;
+
+		if (sector == m_DestSector) {
+			break;
+		}
+
+		edge_index = field.Get_Next_Edge (edge_index);
+	}
+
+	//
+	//	If the field didn't take us all the way there, throw away what we
+	// built and let the normal solver have a go.
+	//
+	if (sector != m_DestSector) {
+		Reset_Lists ();
+		return false;
+	}
+
+	m_CompletedNode = parent_node;
+	m_CompletedNode->Add_Ref ();
+
+	for (PathNodeClass *path_node = m_CompletedNode; path_node != NULL; path_node = path_node->Peek_Parent_Node ()) {
+		path_node->On_Final_Path (true);
+	}
+
+	Post_Process_Path ();
+	m_State = SOLVED_PATH;
+	return true;
+}
+
+
 /////////////////////////////////////////////////////////////////////////////////
 //
 //	Keep_Unit_Inside_Sectors
@@ -1942,4 +2050,4 @@ PathSolveClass::Load_Variables (ChunkLoadClass &cload)
 	}
 
 	return ;
-}
\ No newline at end of file
+}
\ No newline at end of file
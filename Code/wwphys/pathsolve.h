@@ -61,6 +61,7 @@ class	AABoxClass;
 class WayPathClass;
 class ChunkSaveClass;
 class ChunkLoadClass;
+class PathfindFlowFieldClass;
 
 
 typedef DynamicVectorClass<AABoxClass *>		BOX_LIST;
@@ -133,6 +134,13 @@ public:
 	//
 	uint32				Get_Birth_Time (void) const	{ return m_BirthTime; }
 
+	//
+	//	Statistics
+	//
+	int					Get_Expanded_Node_Count (void) const	{ return m_ExpandedNodeCount; }
+	int					Get_Path_Point_Count (void) const		{ return m_Path.Count (); }
+	const Vector3 &	Get_Path_Point (int index) const			{ return m_Path[index].m_Point; }
+
 	//
 	// Volume access
 	//
@@ -151,6 +159,11 @@ public:
 	void					Process_Initial_Sector (void);
 	void					Unlink_Pathfind_Hooks (void);
 
+	//
+	//	Portal access (shared with the flow field builder)
+	//
+	static bool			Does_Object_Have_Access_To_Portal (const PathObjectClass &path_object, PathfindPortalClass *portal);
+
 
 protected:
 
@@ -202,6 +215,11 @@ protected:
 	Vector3	Relax_Line (const Vector3 &start, const Vector3 &end, const AABoxClass &box);
 	void		Keep_Unit_Inside_Sectors (void);
 
+	//
+	//	Flow field methods
+	//
+	bool		Solve_From_Flow_Field (PathfindFlowFieldClass &field);
+
 	//
 	//	Portal access
 	//
@@ -234,6 +252,7 @@ private:
 	STATE_DESC										m_State;
 	float												m_Priority;
 	uint32											m_BirthTime;
+	int												m_ExpandedNodeCount;
 
 	PathfindSectorClass *						m_StartSector;
 	PathfindSectorClass *						m_DestSector;
@@ -246,8 +265,6 @@ private:
 
 	PathObjectClass								m_PathObject;
 
-	static PATHNODE_LIST							temp_node_list;
-
 	/////////////////////////////////////////////////////////////////////////
 	// Friends
 	/////////////////////////////////////////////////////////////////////////
@@ -159,7 +159,7 @@ void PhysClass::Init(const PhysDefClass & def)
 		if (::strchr(def.ModelName, '.') != NULL) {
 			model = ::create_render_obj_from_filename(def.ModelName);
 		} else {
-			model = WW3DAssetManager::Get_Instance()->Create_Render_Obj(def.ModelName);
+			model = WW3DAssetManager::Get_Instance()->Create_Render_Obj(def.Get_Model_Atom());
 		}
 
 		if ( model == NULL ) {
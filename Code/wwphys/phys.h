@@ -55,6 +55,7 @@
 #include "multilist.h"
 #include "phystexproject.h"
 #include "wwstring.h"
+#include "stringatom.h"
 #include "materialeffect.h"
 #include "materialeffectlist.h"
 #include "wwstring.h"
@@ -807,6 +808,7 @@ public:
 
 	// accessors
 	const StringClass &			Get_Model_Name()					{ return ModelName; }
+	const StringAtomClass &		Get_Model_Atom() const			{ return ModelAtom.Refresh(ModelName); }
 	bool								Get_Is_Pre_Lit()					{ return IsPreLit; }
 	
 	//	Editable interface requirements
@@ -815,6 +817,7 @@ public:
 protected:
 	
 	StringClass						ModelName;
+	mutable StringAtomClass		ModelAtom;				// ModelName as an atom, see Get_Model_Atom
 	bool								IsPreLit;
 	
 	friend class PhysClass;
@@ -822,4 +825,4 @@ protected:
 
 
 
-#endif
\ No newline at end of file
+#endif
\ No newline at end of file
@@ -81,6 +81,7 @@
 #include "wwdebug.h"
 #include "wwhack.h"
 #include "wwprofile.h"
+#include "collisionprofiler.h"
 #include "wwphystrig.h"
 #include "physcoltest.h"
 #include "physinttest.h"
@@ -1079,6 +1080,7 @@ bool Phys3Class::Intersection_Test(PhysMeshIntersectionTestClass & test)
 void Phys3Class::Timestep(float dt)
 {	
 	WWPROFILE("Phys3::Timestep");
+	COLLISION_PROFILE_CATEGORY("Characters");
 	VERBOSE_LOG(("\r\n***** Phys3::Timestep. %s position: %f %f %f\r\n",Model->Get_Name(),State.Position.X,State.Position.Y,State.Position.Z));
 
 	/*
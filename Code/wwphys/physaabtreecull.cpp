@@ -40,6 +40,7 @@
 #include "physcoltest.h"
 #include "physinttest.h"
 #include "wwstring.h"
+#include "collisionprofiler.h"
 
 
 /*
@@ -69,7 +70,8 @@ inline PhysClass * get_next_object(PhysClass * tile)
 ** Implementation of PhysAABTreeCullClass
 */
 PhysAABTreeCullClass::PhysAABTreeCullClass(PhysicsSceneClass * pscene) :
-	Scene(pscene)
+	Scene(pscene),
+	BatchTop(0)
 {
 }
 
@@ -89,6 +91,8 @@ bool PhysAABTreeCullClass::Cast_Ray_Recursive
 	PhysRayCollisionTestClass &	raytest
 )
 {
+	_CollisionProfiler.Count_Node();
+
 	/*
 	** Cull the collision test against the bounding volume of this node
 	** If it is culled, stop descending the tree.
@@ -133,6 +137,8 @@ bool PhysAABTreeCullClass::Cast_AABox_Recursive
 	PhysAABoxCollisionTestClass &		boxtest
 )
 {
+	_CollisionProfiler.Count_Node();
+
 	/*
 	** Cull the collision test against the bounding volume of this node
 	** If it is culled, stop descending the tree.
@@ -170,12 +176,202 @@ bool PhysAABTreeCullClass::Cast_AABox_Recursive
 	return res;
 }
 
+bool PhysAABTreeCullClass::Cast_Ray_Batch(PhysRayCollisionTestClass ** raytests,bool * results,int count)
+{
+	WWASSERT(RootNode != NULL);
+	WWASSERT(BatchTop == 0);
+
+	int i;
+	for (i=0; i<count; i++) {
+		results[i] = false;
+	}
+
+	Begin_Batch(count);
+	Cast_Ray_Batch_Recursive(RootNode,raytests,results,0,count);
+	BatchTop = 0;
+
+	bool res = false;
+	for (i=0; i<count; i++) {
+		res |= results[i];
+	}
+	return res;
+}
+
+
+bool PhysAABTreeCullClass::Cast_AABox_Batch(PhysAABoxCollisionTestClass ** boxtests,bool * results,int count)
+{
+	WWASSERT(RootNode != NULL);
+	WWASSERT(BatchTop == 0);
+
+	int i;
+	for (i=0; i<count; i++) {
+		results[i] = false;
+	}
+
+	Begin_Batch(count);
+	Cast_AABox_Batch_Recursive(RootNode,boxtests,results,0,count);
+	BatchTop = 0;
+
+	bool res = false;
+	for (i=0; i<count; i++) {
+		res |= results[i];
+	}
+	return res;
+}
+
+
+void PhysAABTreeCullClass::Begin_Batch(int count)
+{
+	/*
+	** Every test starts out active at the root.  Each level of the traversal only
+	** ever needs room for the tests that survived its parent, so count entries per
+	** level is always enough.  Entries are addressed by index rather than pointer
+	** so growing the stack doesn't invalidate the levels above us.
+	*/
+	if (BatchStack.Length() < count * 8) {
+		BatchStack.Resize(count * 8);
+	}
+	for (int i=0; i<count; i++) {
+		BatchStack[i] = i;
+	}
+	BatchTop = count;
+}
+
+
+void PhysAABTreeCullClass::Cast_Ray_Batch_Recursive
+(
+	AABTreeNodeClass *				node,
+	PhysRayCollisionTestClass **	raytests,
+	bool *								results,
+	int									first,
+	int									count
+)
+{
+	/*
+	** Cull each active test against the bounding volume of this node, the ones
+	** that survive are pushed on the batch stack for this level.
+	*/
+	if (BatchStack.Length() < BatchTop + count) {
+		BatchStack.Resize(2 * (BatchTop + count));
+	}
+
+	int active_first = BatchTop;
+	int active_count = 0;
+	for (int i=0; i<count; i++) {
+		int test_index = BatchStack[first + i];
+		if (!raytests[test_index]->Cull(node->Box)) {
+			BatchStack[active_first + active_count++] = test_index;
+		}
+	}
+	if (active_count == 0) {
+		return;
+	}
+	BatchTop += active_count;
+
+	/*
+	** Test any objects in this node against all of the surviving tests.
+	*/
+	if (node->Object) {
+		PhysClass * obj = get_first_object(node);
+		while (obj) {
+			if (!obj->Is_Ignore_Me()) {
+				for (int i=0; i<active_count; i++) {
+					int test_index = BatchStack[active_first + i];
+					PhysRayCollisionTestClass * raytest = raytests[test_index];
+					if (Scene->Do_Groups_Collide(obj->Get_Collision_Group(),raytest->CollisionGroup)) {
+						results[test_index] |= obj->Cast_Ray(*raytest);
+					}
+				}
+			}
+			obj = get_next_object(obj);
+		}
+	}
+
+	/*
+	** Pass the survivors on to the children
+	*/
+	if (node->Back) {
+		Cast_Ray_Batch_Recursive(node->Back,raytests,results,active_first,active_count);
+	}
+	if (node->Front) {
+		Cast_Ray_Batch_Recursive(node->Front,raytests,results,active_first,active_count);
+	}
+
+	BatchTop = active_first;
+}
+
+
+void PhysAABTreeCullClass::Cast_AABox_Batch_Recursive
+(
+	AABTreeNodeClass *					node,
+	PhysAABoxCollisionTestClass **	boxtests,
+	bool *									results,
+	int										first,
+	int										count
+)
+{
+	/*
+	** Cull each active test against the bounding volume of this node, the ones
+	** that survive are pushed on the batch stack for this level.
+	*/
+	if (BatchStack.Length() < BatchTop + count) {
+		BatchStack.Resize(2 * (BatchTop + count));
+	}
+
+	int active_first = BatchTop;
+	int active_count = 0;
+	for (int i=0; i<count; i++) {
+		int test_index = BatchStack[first + i];
+		if (!boxtests[test_index]->Cull(node->Box)) {
+			BatchStack[active_first + active_count++] = test_index;
+		}
+	}
+	if (active_count == 0) {
+		return;
+	}
+	BatchTop += active_count;
+
+	/*
+	** Test any objects in this node against all of the surviving tests.
+	*/
+	if (node->Object) {
+		PhysClass * obj = get_first_object(node);
+		while (obj) {
+			if (!obj->Is_Ignore_Me()) {
+				for (int i=0; i<active_count; i++) {
+					int test_index = BatchStack[active_first + i];
+					PhysAABoxCollisionTestClass * boxtest = boxtests[test_index];
+					if (Scene->Do_Groups_Collide(obj->Get_Collision_Group(),boxtest->CollisionGroup)) {
+						results[test_index] |= obj->Cast_AABox(*boxtest);
+					}
+				}
+			}
+			obj = get_next_object(obj);
+		}
+	}
+
+	/*
+	** Pass the survivors on to the children
+	*/
+	if (node->Back) {
+		Cast_AABox_Batch_Recursive(node->Back,boxtests,results,active_first,active_count);
+	}
+	if (node->Front) {
+		Cast_AABox_Batch_Recursive(node->Front,boxtests,results,active_first,active_count);
+	}
+
+	BatchTop = active_first;
+}
+
+
 bool PhysAABTreeCullClass::Cast_OBBox_Recursive
 (
 	AABTreeNodeClass *					node,
 	PhysOBBoxCollisionTestClass &		boxtest
 )
 {
+	_CollisionProfiler.Count_Node();
+
 	/*
 	** Cull the collision test against the bounding volume of this node
 	** If it is culled, stop descending the tree.
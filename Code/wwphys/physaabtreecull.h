@@ -46,6 +46,7 @@
 #include "aabtreecull.h"
 #include "phys.h"
 #include "wwdebug.h"
+#include "vector.h"
 
 class PhysicsSceneClass;
 class StringClass;
@@ -74,6 +75,15 @@ public:
 	bool					Cast_Ray(PhysRayCollisionTestClass & raytest);
 	bool					Cast_AABox(PhysAABoxCollisionTestClass & boxtest);
 	bool					Cast_OBBox(PhysOBBoxCollisionTestClass & boxtest);
+
+	/*
+	** Batched collision detection.  Casts 'count' tests through the tree in a single
+	** traversal, results[i] is set to what Cast_Ray/Cast_AABox would have returned for
+	** test i.  Each test sees the same objects in the same order as a single cast would
+	** so the results are identical.  Returns true if any test hit something.
+	*/
+	bool					Cast_Ray_Batch(PhysRayCollisionTestClass ** raytests,bool * results,int count);
+	bool					Cast_AABox_Batch(PhysAABoxCollisionTestClass ** boxtests,bool * results,int count);
 	
 	bool					Intersection_Test(PhysAABoxIntersectionTestClass & boxtest);
 	bool					Intersection_Test(PhysOBBoxIntersectionTestClass & boxtest);
@@ -94,12 +104,18 @@ protected:
 	bool					Cast_Ray_Recursive(AABTreeNodeClass * node,PhysRayCollisionTestClass & raytest);
 	bool					Cast_AABox_Recursive(AABTreeNodeClass * node,PhysAABoxCollisionTestClass & boxtest);
 	bool					Cast_OBBox_Recursive(AABTreeNodeClass * node,PhysOBBoxCollisionTestClass & boxtest);
+	void					Cast_Ray_Batch_Recursive(AABTreeNodeClass * node,PhysRayCollisionTestClass ** raytests,bool * results,int first,int count);
+	void					Cast_AABox_Batch_Recursive(AABTreeNodeClass * node,PhysAABoxCollisionTestClass ** boxtests,bool * results,int first,int count);
+	void					Begin_Batch(int count);
 		
 	/*
 	** Members
 	*/
 	PhysicsSceneClass *	Scene;				// scene that we are a member of
 
+	VectorClass<int>		BatchStack;			// indices of the tests still active at each level of a batch cast
+	int						BatchTop;			// first free entry in BatchStack
+
 	static bool				_HierarchicalVisCullingEnabled;
 };
 
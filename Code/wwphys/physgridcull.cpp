@@ -50,6 +50,7 @@
 #include "chunkio.h"
 #include "iostruct.h"
 #include "colmathinlines.h"
+#include "physsweepprune.h"
 
 
 #define  NEW_CAST_FUNCTIONS 1
@@ -79,7 +80,8 @@ enum
 *******************************************************************************************************/
 
 PhysGridCullClass::PhysGridCullClass(PhysicsSceneClass * scene) :
-	Scene(scene)
+	Scene(scene),
+	Broadphase(NULL)
 {
 }
 
@@ -103,6 +105,14 @@ void PhysGridCullClass::Re_Partition(const Vector3 & min,const Vector3 & max,flo
 	WWASSERT(Scene != NULL);
 }
 
+void PhysGridCullClass::Update_Culling(CullableClass * obj)
+{
+	TypedGridCullSystemClass<PhysClass>::Update_Culling(obj);
+	if (Broadphase != NULL) {
+		Broadphase->Update_Object((PhysClass *)obj);
+	}
+}
+
 void PhysGridCullClass::Collect_Visible_Objects(const FrustumClass & frustum,VisTableClass * pvs,RefPhysListClass & visobjlist)
 {
 	Reset_Collection();
@@ -614,4 +624,4 @@ void PhysGridCullClass::Save_Static_Variables(ChunkSaveClass & csave)
 	WRITE_MICRO_CHUNK(csave,PHYSGRID_VARIABLE_DUMMYVISID,DummyVisId);
 	WRITE_MICRO_CHUNK(csave,PHYSGRID_VARIABLE_BASEVISID,BaseVisId);
 */
-}
\ No newline at end of file
+}
\ No newline at end of file
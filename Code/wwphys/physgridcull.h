@@ -51,6 +51,7 @@ class PhysicsSceneClass;
 class VisRenderContextClass;
 class VisTableClass;
 class AABoxRenderObjClass;
+class PhysSweepPruneClass;
 
 /*
 ** PhysGridCullClass
@@ -64,6 +65,10 @@ public:
 	virtual ~PhysGridCullClass(void);
 	
 	void	Re_Partition(const Vector3 & min,const Vector3 & max,float objdim);
+	virtual void	Update_Culling(CullableClass * obj);
+
+	// Broadphase which is told whenever one of our objects' cull boxes changes
+	void	Set_Broadphase(PhysSweepPruneClass * broadphase)	{ Broadphase = broadphase; }
 	
 	bool	Cast_Ray(PhysRayCollisionTestClass & raytest);
 	bool	Cast_AABox(PhysAABoxCollisionTestClass & boxtest);
@@ -95,6 +100,9 @@ protected:
 	// pointer to the physics scene that this culling system is part of
 	PhysicsSceneClass * Scene;
 
+	// sweep-and-prune broadphase tracking our objects (if enabled)
+	PhysSweepPruneClass * Broadphase;
+
 };
 
 
@@ -0,0 +1,350 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/***********************************************************************************************
+ ***              C O N F I D E N T I A L  ---  W E S T W O O D  S T U D I O S               ***
+ ***********************************************************************************************
+ *                                                                                             *
+ *                 Project Name : WWPhys                                                       *
+ *                                                                                             *
+ *                     $Archive:: /Commando/Code/wwphys/physisland.cpp                        $*
+ *                                                                                             *
+ *---------------------------------------------------------------------------------------------*
+ * Functions:                                                                                  *
+ *   PhysIslandBuilderClass::PhysIslandBuilderClass -- Constructor                             *
+ *   PhysIslandBuilderClass::~PhysIslandBuilderClass -- Destructor                             *
+ *   PhysIslandBuilderClass::Reset -- Forget the islands from the last build                   *
+ *   PhysIslandBuilderClass::Build -- Partition the simulating objects into islands            *
+ *   PhysIslandBuilderClass::Get_Largest_Island_Size -- Size of the biggest island             *
+ *   PhysIslandBuilderClass::Find_Root -- Union-find root lookup                               *
+ *   PhysIslandBuilderClass::Join -- Union-find merge                                          *
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+#include "physisland.h"
+#include "phys.h"
+#include "movephys.h"
+#include "physgridcull.h"
+#include "wwprofile.h"
+#include "framearena.h"
+
+
+/*
+** Extra room added around every object's swept box.  This covers small
+** penetration corrections and contact offsets that aren't part of the velocity.
+*/
+const float ISLAND_MARGIN = 0.25f;
+
+/*
+** How far a pusher (elevator, door, etc) is allowed to shove the objects touching it
+** in one frame.  The pushed objects don't have that motion in their velocity so
+** their reach has to be grown by hand.
+*/
+const float PUSHER_SWEEP = 1.0f;
+
+
+/***********************************************************************************************
+ * PhysIslandBuilderClass::PhysIslandBuilderClass -- Constructor                               *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+PhysIslandBuilderClass::PhysIslandBuilderClass(void)
+{
+	Objects.Set_Growth_Step(128);
+	Sweeps.Set_Growth_Step(128);
+	Parents.Set_Growth_Step(128);
+	IslandObjects.Set_Growth_Step(128);
+	IslandStart.Set_Growth_Step(128);
+}
+
+
+/***********************************************************************************************
+ * PhysIslandBuilderClass::~PhysIslandBuilderClass -- Destructor                               *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+PhysIslandBuilderClass::~PhysIslandBuilderClass(void)
+{
+	Reset();
+}
+
+
+/***********************************************************************************************
+ * PhysIslandBuilderClass::Reset -- Forget the islands from the last build                     *
+ *                                                                                             *
+ * The object pointers are not ref-counted, the islands are only valid until the time-step     *
+ * list changes.                                                                               *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void PhysIslandBuilderClass::Reset(void)
+{
+	Objects.Reset_Active();
+	Sweeps.Reset_Active();
+	Parents.Reset_Active();
+	IslandObjects.Reset_Active();
+	IslandStart.Reset_Active();
+	IndexTable.Remove_All();
+}
+
+
+/***********************************************************************************************
+ * PhysIslandBuilderClass::Build -- Partition the simulating objects into islands              *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * list - the scene's time-step list                                                           *
+ * culling - the dynamic object culling system                                                 *
+ * dt - length of the frame that is about to be simulated                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ * Uses the culling system's collection list.                                                  *
+ * Pushers aren't in the dynamic culling system so they are joined from their own side.        *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void PhysIslandBuilderClass::Build(RefPhysListClass & list,PhysGridCullClass * culling,float dt)
+{
+	WWPROFILE("Build Islands");
+	Reset();
+
+	/*
+	** Gather the simulating objects and how far each one could travel this frame
+	*/
+	float max_sweep = 0.0f;
+	RefPhysListIterator it(&list);
+	for (it.First(); !it.Is_Done(); it.Next()) {
+		PhysClass * obj = it.Peek_Obj();
+		if (obj->Is_Object_Simulating()) {
+
+			float sweep = 0.0f;
+			MoveablePhysClass * moveable = obj->As_MoveablePhysClass();
+			if (moveable != NULL) {
+				Vector3 vel;
+				moveable->Get_Velocity(&vel);
+				sweep = vel.Length() * dt;
+			}
+			max_sweep = WWMath::Max(max_sweep,sweep);
+
+			IndexTable.Insert(obj,Objects.Count());
+			Parents.Add(Objects.Count());
+			Objects.Add(obj);
+			Sweeps.Add(sweep);
+		}
+	}
+
+	/*
+	** Pushers (StaticAnimPhys elevators and doors) are in the time-step list but not
+	** in the dynamic culling system, so no other object's query can find them.  Join
+	** each pusher with every dynamic object its collision box touches so that the
+	** pusher and its riders end up in one island and keep the serial step order.
+	** Anything the pusher touches can be shoved further than its velocity says.
+	*/
+	int index;
+	for (index = 0; index < Objects.Count(); index++) {
+
+		if (Objects[index]->As_StaticAnimPhysClass() == NULL) {
+			continue;
+		}
+
+		AABoxClass box = Objects[index]->Get_Cull_Box();
+		float grow = max_sweep + PUSHER_SWEEP + ISLAND_MARGIN;
+		box.Extent += Vector3(grow,grow,grow);
+
+		culling->Reset_Collection();
+		culling->Collect_Objects(box);
+
+		for (	PhysClass * other = culling->Get_First_Collected_Object();
+				other != NULL;
+				other = culling->Get_Next_Collected_Object(other))
+		{
+			int other_index;
+			if (IndexTable.Get(other,other_index)) {
+				Join(index,other_index);
+				Sweeps[other_index] += PUSHER_SWEEP;
+				max_sweep = WWMath::Max(max_sweep,Sweeps[other_index]);
+			}
+		}
+	}
+
+	/*
+	** Join each object with everything its box could reach.  The other object may
+	** be moving towards us as well, so grow the box by the largest sweep of any
+	** object rather than just our own.
+	*/
+	for (index = 0; index < Objects.Count(); index++) {
+
+		if (Objects[index]->As_StaticAnimPhysClass() != NULL) {
+			continue;
+		}
+
+		AABoxClass box = Objects[index]->Get_Cull_Box();
+		float grow = Sweeps[index] + max_sweep + ISLAND_MARGIN;
+		box.Extent += Vector3(grow,grow,grow);
+
+		culling->Reset_Collection();
+		culling->Collect_Objects(box);
+
+		for (	PhysClass * other = culling->Get_First_Collected_Object();
+				other != NULL;
+				other = culling->Get_Next_Collected_Object(other))
+		{
+			int other_index;
+			if ((other != Objects[index]) && IndexTable.Get(other,other_index)) {
+				Join(index,other_index);
+			}
+		}
+	}
+
+	/*
+	** Number the islands in order of their first member, then bucket the objects
+	** so each island's members stay in list order.
+	*/
+	FrameDynamicVectorClass<int> island_of_root(Objects.Count());
+	FrameDynamicVectorClass<int> island_of_object(Objects.Count());
+	FrameDynamicVectorClass<int> island_size(Objects.Count());
+
+	for (index = 0; index < Objects.Count(); index++) {
+		island_of_root.Add(-1);
+	}
+
+	for (index = 0; index < Objects.Count(); index++) {
+		int root = Find_Root(index);
+		if (island_of_root[root] == -1) {
+			island_of_root[root] = island_size.Count();
+			island_size.Add(0);
+		}
+		int island = island_of_root[root];
+		island_of_object.Add(island);
+		island_size[island]++;
+	}
+
+	int start = 0;
+	for (index = 0; index < island_size.Count(); index++) {
+		IslandStart.Add(start);
+		start += island_size[index];
+	}
+
+	FrameDynamicVectorClass<int> next_slot(island_size.Count());
+	for (index = 0; index < IslandStart.Count(); index++) {
+		next_slot.Add(IslandStart[index]);
+	}
+
+	for (index = 0; index < Objects.Count(); index++) {
+		IslandObjects.Add(NULL);
+	}
+
+	for (index = 0; index < Objects.Count(); index++) {
+		IslandObjects[next_slot[island_of_object[index]]++] = Objects[index];
+	}
+}
+
+
+/***********************************************************************************************
+ * PhysIslandBuilderClass::Get_Largest_Island_Size -- Size of the biggest island               *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+int PhysIslandBuilderClass::Get_Largest_Island_Size(void) const
+{
+	int largest = 0;
+	for (int island = 0; island < Get_Island_Count(); island++) {
+		largest = max(largest,Get_Island_Object_Count(island));
+	}
+	return largest;
+}
+
+
+/***********************************************************************************************
+ * PhysIslandBuilderClass::Find_Root -- Union-find root lookup                                 *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+int PhysIslandBuilderClass::Find_Root(int index)
+{
+	int root = index;
+	while (Parents[root] != root) {
+		root = Parents[root];
+	}
+
+	/*
+	** Point everything on the way up straight at the root
+	*/
+	while (Parents[index] != root) {
+		int next = Parents[index];
+		Parents[index] = root;
+		index = next;
+	}
+	return root;
+}
+
+
+/***********************************************************************************************
+ * PhysIslandBuilderClass::Join -- Union-find merge                                            *
+ *                                                                                             *
+ * The lower index always becomes the root so the result doesn't depend on the order the       *
+ * overlaps were found in.                                                                     *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void PhysIslandBuilderClass::Join(int index0,int index1)
+{
+	int root0 = Find_Root(index0);
+	int root1 = Find_Root(index1);
+	if (root0 < root1) {
+		Parents[root1] = root0;
+	} else if (root1 < root0) {
+		Parents[root0] = root1;
+	}
+}
@@ -0,0 +1,101 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/***********************************************************************************************
+ ***              C O N F I D E N T I A L  ---  W E S T W O O D  S T U D I O S               ***
+ ***********************************************************************************************
+ *                                                                                             *
+ *                 Project Name : WWPhys                                                       *
+ *                                                                                             *
+ *                     $Archive:: /Commando/Code/wwphys/physisland.h                          $*
+ *                                                                                             *
+ *---------------------------------------------------------------------------------------------*
+ * Functions:                                                                                  *
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#ifndef PHYSISLAND_H
+#define PHYSISLAND_H
+
+#include "always.h"
+#include "vector.h"
+#include "hashtemplate.h"
+#include "physlist.h"
+
+class PhysClass;
+class PhysGridCullClass;
+
+
+/*
+** PhysIslandBuilderClass
+** Splits the simulating objects in the time-step list into islands of objects
+** that could touch each other during a frame.  Two objects end up in the same
+** island if their culling boxes, grown by how far either could move this frame,
+** overlap in the dynamic culling system.  Pushers (elevators, doors) are not in
+** that system, so each one is joined with every dynamic object its box touches;
+** the pusher and its riders then share an island and are stepped in list order
+** within each sub-step, same as the serial loop.  Objects in different islands
+** can't interact (other than through the static world), so each island can be
+** time-stepped on its own with the same result as stepping everything in list
+** order.  PhysReplay -compare checks this against a recording.
+**
+** Islands are numbered in the order their first member appears in the list and
+** each island keeps its members in list order, so the partition is deterministic.
+*/
+class PhysIslandBuilderClass
+{
+public:
+
+	PhysIslandBuilderClass(void);
+	~PhysIslandBuilderClass(void);
+
+	void						Build(RefPhysListClass & list,PhysGridCullClass * culling,float dt);
+	void						Reset(void);
+
+	int						Get_Island_Count(void) const								{ return IslandStart.Count(); }
+	int						Get_Island_Object_Count(int island) const;
+	PhysClass *				Peek_Island_Object(int island,int index) const		{ return IslandObjects[IslandStart[island] + index]; }
+	int						Get_Largest_Island_Size(void) const;
+
+protected:
+
+	int						Find_Root(int index);
+	void						Join(int index0,int index1);
+
+	DynamicVectorClass<PhysClass *>			Objects;			// simulating objects, in list order
+	DynamicVectorClass<float>					Sweeps;			// how far each object could move this frame
+	DynamicVectorClass<int>						Parents;			// union-find parent links
+	HashTemplateClass<PhysClass *,int>		IndexTable;		// object -> index into Objects
+
+	DynamicVectorClass<PhysClass *>			IslandObjects;	// objects grouped by island
+	DynamicVectorClass<int>						IslandStart;	// index of each island's first object
+};
+
+
+inline int PhysIslandBuilderClass::Get_Island_Object_Count(int island) const
+{
+	int end = (island + 1 < IslandStart.Count()) ? IslandStart[island + 1] : IslandObjects.Count();
+	return end - IslandStart[island];
+}
+
+
+#endif //PHYSISLAND_H
@@ -0,0 +1,627 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/***********************************************************************************************
+ ***              C O N F I D E N T I A L  ---  W E S T W O O D  S T U D I O S               ***
+ ***********************************************************************************************
+ *                                                                                             *
+ *                 Project Name : WWPhys                                                       *
+ *                                                                                             *
+ *                     $Archive:: /Commando/Code/wwphys/physrecorder.cpp                      $*
+ *                                                                                             *
+ *---------------------------------------------------------------------------------------------*
+ * Functions:                                                                                  *
+ *   PhysRecorderClass::PhysRecorderClass -- Constructor                                       *
+ *   PhysRecorderClass::~PhysRecorderClass -- Destructor                                       *
+ *   PhysRecorderClass::Start_Recording -- Save the initial state and start recording frames   *
+ *   PhysRecorderClass::Stop_Recording -- Write out the frames and close the recording         *
+ *   PhysRecorderClass::Is_Recorded -- Was this object in the scene when recording started?    *
+ *   PhysRecorderClass::Record_Frame -- Remember the controller inputs for one frame           *
+ *   PhysRecorderClass::Reset -- Release all recorded or loaded data                           *
+ *   PhysRecorderClass::Apply_Frame_Inputs -- Set the controllers up for a recorded frame      *
+ *   PhysRecorderClass::Get_Final_Transform -- Where an object was when the recording ended    *
+ *   PhysRecorderClass::Save -- Save the recording                                             *
+ *   PhysRecorderClass::Load -- Load a recording                                               *
+ *   PhysRecorderClass::On_Post_Load -- Hook the loaded objects up to the replay controllers   *
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+#include "physrecorder.h"
+#include "wwphysids.h"
+#include "pscene.h"
+#include "phys.h"
+#include "movephys.h"
+#include "physcontrol.h"
+#include "physdynamicsavesystem.h"
+#include "physstaticsavesystem.h"
+#include "definitionmgr.h"
+#include "saveload.h"
+#include "chunkio.h"
+#include "rawfile.h"
+#include "wwmemlog.h"
+#include "wwdebug.h"
+
+/*
+** Instantiate the Physics Recording System
+*/
+PhysRecorderClass _PhysRecorder;
+
+
+/***********************************************************************************************
+ * PhysRecorderClass::PhysRecorderClass -- Constructor                                         *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+PhysRecorderClass::PhysRecorderClass(void) :
+	File(NULL),
+	Saver(NULL),
+	UpdateOnlyVisibleObjects(false),
+	LoadedObjects(NULL)
+{
+	Frames.Set_Growth_Step(1024);
+	Inputs.Set_Growth_Step(1024);
+}
+
+
+/***********************************************************************************************
+ * PhysRecorderClass::~PhysRecorderClass -- Destructor                                         *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+PhysRecorderClass::~PhysRecorderClass(void)
+{
+	Stop_Recording();
+	Reset();
+}
+
+
+uint32 PhysRecorderClass::Chunk_ID(void) const
+{
+	return PHYSICS_CHUNKID_RECORDING_SUBSYSTEM;
+}
+
+
+bool PhysRecorderClass::Contains_Data(void) const
+{
+	return (Objects.Count() > 0) || (Frames.Count() > 0);
+}
+
+
+/***********************************************************************************************
+ * PhysRecorderClass::Start_Recording -- Save the initial state and start recording frames     *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * filename - file to record into                                                              *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ * true if the recording was started                                                           *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ * Objects that are added to the scene after this point are not recorded and won't exist      *
+ * when the recording is replayed.                                                             *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+bool PhysRecorderClass::Start_Recording(const char * filename)
+{
+	WWMEMLOG(MEM_PHYSICSDATA);
+	PhysicsSceneClass * scene = PhysicsSceneClass::Get_Instance();
+	if ((scene == NULL) || Is_Recording()) {
+		return false;
+	}
+
+	Reset();
+
+	File = new RawFileClass(filename);
+	if (!File->Open(RawFileClass::WRITE)) {
+		WWDEBUG_SAY(("PhysRecorder: unable to open %s\r\n",filename));
+		delete File;
+		File = NULL;
+		return false;
+	}
+	Saver = new ChunkSaveClass(File);
+
+	/*
+	** Write the initial state with the normal save sub-systems
+	*/
+	SaveLoadSystemClass::Save(*Saver,_TheDefinitionMgr);
+	SaveLoadSystemClass::Save(*Saver,_PhysStaticDataSaveSystem);
+	SaveLoadSystemClass::Save(*Saver,_PhysStaticObjectsSaveSystem);
+	SaveLoadSystemClass::Save(*Saver,_PhysDynamicSaveSystem);
+
+	/*
+	** Remember the dynamic objects that were just saved, in the order they were saved.  
+	** We hold a reference to each one so that its address can't be re-used by a new 
+	** object while we're recording.
+	*/
+	RefPhysListIterator it = scene->Get_Dynamic_Object_Iterator();
+	for (it.First(); !it.Is_Done(); it.Next()) {
+		PhysClass * obj = it.Peek_Obj();
+		if (obj->Is_Dont_Save_Enabled() == false) {
+			ObjectStruct entry;
+			entry.Obj = obj;
+			entry.Controller = NULL;
+			entry.HasFinalTransform = false;
+			entry.FinalTransform.Make_Identity();
+			entry.Obj->Add_Ref();
+			Objects.Add(entry);
+		}
+	}
+
+	UpdateOnlyVisibleObjects = scene->Get_Update_Only_Visible_Objects();
+	WWDEBUG_SAY(("PhysRecorder: recording %d objects into %s\r\n",Objects.Count(),filename));
+	return true;
+}
+
+
+/***********************************************************************************************
+ * PhysRecorderClass::Stop_Recording -- Write out the frames and close the recording           *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void PhysRecorderClass::Stop_Recording(void)
+{
+	if (!Is_Recording()) {
+		return;
+	}
+
+	/*
+	** Grab the final transforms of the objects which are still in the scene
+	*/
+	PhysicsSceneClass * scene = PhysicsSceneClass::Get_Instance();
+	for (int i=0; i<Objects.Count(); i++) {
+		ObjectStruct & entry = Objects[i];
+		entry.HasFinalTransform = (scene != NULL) && scene->Contains(entry.Obj);
+		if (entry.HasFinalTransform) {
+			entry.FinalTransform = entry.Obj->Get_Transform();
+		}
+	}
+
+	SaveLoadSystemClass::Save(*Saver,*this);
+	WWDEBUG_SAY(("PhysRecorder: recorded %d frames\r\n",Frames.Count()));
+
+	/*
+	** Let the user know if anything was spawned, the replay won't match the game
+	*/
+	if (scene != NULL) {
+		int missed = 0;
+		RefPhysListIterator it = scene->Get_Dynamic_Object_Iterator();
+		for (it.First(); !it.Is_Done(); it.Next()) {
+			if ((it.Peek_Obj()->Is_Dont_Save_Enabled() == false) && !Is_Recorded(it.Peek_Obj())) {
+				missed++;
+			}
+		}
+		if (missed > 0) {
+			WWDEBUG_SAY(("PhysRecorder: %d objects were added during the recording and were not recorded\r\n",missed));
+		}
+	}
+
+	delete Saver;
+	Saver = NULL;
+	File->Close();
+	delete File;
+	File = NULL;
+
+	Reset();
+}
+
+
+/***********************************************************************************************
+ * PhysRecorderClass::Is_Recorded -- Was this object in the scene when recording started?      *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ * Linear search, only used when the recording is stopped.                                     *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+bool PhysRecorderClass::Is_Recorded(PhysClass * obj) const
+{
+	for (int i=0; i<Objects.Count(); i++) {
+		if (Objects[i].Obj == obj) {
+			return true;
+		}
+	}
+	return false;
+}
+
+
+/***********************************************************************************************
+ * PhysRecorderClass::Record_Frame -- Remember the controller inputs for one frame             *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * dt - length of the frame the scene is about to simulate                                     *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void PhysRecorderClass::Record_Frame(float dt)
+{
+	WWMEMLOG(MEM_PHYSICSDATA);
+	PhysicsSceneClass * scene = PhysicsSceneClass::Get_Instance();
+
+	FrameStruct frame;
+	frame.Dt = dt;
+	frame.FirstInput = Inputs.Count();
+	frame.InputCount = 0;
+
+	for (int i=0; i<Objects.Count(); i++) {
+
+		/*
+		** Once an object has left the scene its controller may be gone too
+		*/
+		PhysClass * obj = Objects[i].Obj;
+		MoveablePhysClass * moveable = obj->As_MoveablePhysClass();
+		if ((moveable == NULL) || (moveable->Get_Controller() == NULL) || !scene->Contains(obj)) {
+			continue;
+		}
+
+		PhysControllerClass * controller = moveable->Get_Controller();
+		InputStruct input;
+		input.Object = i;
+		input.Move = controller->Get_Move_Vector();
+		input.Turn = controller->Get_Turn_Left();
+		Inputs.Add(input);
+		frame.InputCount++;
+	}
+
+	Frames.Add(frame);
+}
+
+
+/***********************************************************************************************
+ * PhysRecorderClass::Reset -- Release all recorded or loaded data                             *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ * Call this before the scene is destroyed when replaying, the objects are still using our     *
+ * controllers.                                                                                *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void PhysRecorderClass::Reset(void)
+{
+	WWASSERT(!Is_Recording());
+
+	for (int i=0; i<Objects.Count(); i++) {
+		ObjectStruct & entry = Objects[i];
+		if (entry.Obj != NULL) {
+			if (entry.Controller != NULL) {
+				entry.Obj->As_MoveablePhysClass()->Set_Controller(NULL);
+			}
+			entry.Obj->Release_Ref();
+		}
+		delete entry.Controller;
+	}
+
+	if (LoadedObjects != NULL) {
+		delete[] LoadedObjects;
+		LoadedObjects = NULL;
+	}
+
+	Objects.Delete_All();
+	Frames.Delete_All();
+	Inputs.Delete_All();
+	UpdateOnlyVisibleObjects = false;
+}
+
+
+/***********************************************************************************************
+ * PhysRecorderClass::Apply_Frame_Inputs -- Set the controllers up for a recorded frame        *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * frame - index of the frame that is about to be simulated                                    *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void PhysRecorderClass::Apply_Frame_Inputs(int frame)
+{
+	/*
+	** Objects that weren't in the frame had no controller that frame
+	*/
+	int i;
+	for (i=0; i<Objects.Count(); i++) {
+		if (Objects[i].Controller != NULL) {
+			Objects[i].Controller->Reset();
+		}
+	}
+
+	const FrameStruct & f = Frames[frame];
+	for (i=f.FirstInput; i<f.FirstInput + f.InputCount; i++) {
+		const InputStruct & input = Inputs[i];
+		if ((input.Object < 0) || (input.Object >= Objects.Count())) {
+			continue;
+		}
+		PhysControllerClass * controller = Objects[input.Object].Controller;
+		if (controller != NULL) {
+			controller->Set_Move_Forward(input.Move.X);
+			controller->Set_Move_Left(input.Move.Y);
+			controller->Set_Move_Up(input.Move.Z);
+			controller->Set_Turn_Left(input.Turn);
+		}
+	}
+}
+
+
+/***********************************************************************************************
+ * PhysRecorderClass::Get_Final_Transform -- Where an object was when the recording ended      *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ * false if the object had left the scene before the recording ended                           *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+bool PhysRecorderClass::Get_Final_Transform(int index,Matrix3D * set_tm) const
+{
+	const ObjectStruct & entry = Objects[index];
+	if (entry.HasFinalTransform) {
+		*set_tm = entry.FinalTransform;
+	}
+	return entry.HasFinalTransform;
+}
+
+
+/***********************************************************************************************
+ * PhysRecorderClass::Save -- Save the recording                                               *
+ *                                                                                             *
+ * The object pointers are the ones the dynamic save sub-system saved at the start of the      *
+ * recording, so they get re-mapped to the new objects when the file is loaded.                *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+bool PhysRecorderClass::Save(ChunkSaveClass & csave)
+{
+	WWMEMLOG(MEM_PHYSICSDATA);
+
+	csave.Begin_Chunk(PRSSC_CHUNKID_VARIABLES);
+	WRITE_MICRO_CHUNK(csave,PRSSC_VARIABLE_UPDATEONLYVISIBLE,UpdateOnlyVisibleObjects);
+	csave.End_Chunk();
+
+	csave.Begin_Chunk(PRSSC_CHUNKID_OBJECTS);
+	int count = Objects.Count();
+	csave.Write(&count,sizeof(count));
+	for (int i=0; i<Objects.Count(); i++) {
+		const ObjectStruct & entry = Objects[i];
+		csave.Write(&entry.Obj,sizeof(entry.Obj));
+		csave.Write(&entry.HasFinalTransform,sizeof(entry.HasFinalTransform));
+		csave.Write(&entry.FinalTransform,sizeof(entry.FinalTransform));
+	}
+	csave.End_Chunk();
+
+	csave.Begin_Chunk(PRSSC_CHUNKID_FRAMES);
+	for (int f=0; f<Frames.Count(); f++) {
+		const FrameStruct & frame = Frames[f];
+		csave.Begin_Chunk(PRSSC_CHUNKID_FRAME);
+		csave.Write(&frame.Dt,sizeof(frame.Dt));
+		csave.Write(&frame.InputCount,sizeof(frame.InputCount));
+		for (int i=frame.FirstInput; i<frame.FirstInput + frame.InputCount; i++) {
+			const InputStruct & input = Inputs[i];
+			csave.Write(&input.Object,sizeof(input.Object));
+			csave.Write(&input.Move,sizeof(input.Move));
+			csave.Write(&input.Turn,sizeof(input.Turn));
+		}
+		csave.End_Chunk();
+	}
+	csave.End_Chunk();
+
+	return true;
+}
+
+
+/***********************************************************************************************
+ * PhysRecorderClass::Load -- Load a recording                                                 *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+bool PhysRecorderClass::Load(ChunkLoadClass & cload)
+{
+	WWMEMLOG(MEM_PHYSICSDATA);
+	Reset();
+
+	while (cload.Open_Chunk()) {
+		switch (cload.Cur_Chunk_ID()) {
+		case PRSSC_CHUNKID_VARIABLES:
+			Load_Variables(cload);
+			break;
+		case PRSSC_CHUNKID_OBJECTS:
+			Load_Objects(cload);
+			break;
+		case PRSSC_CHUNKID_FRAMES:
+			Load_Frames(cload);
+			break;
+		default:
+			WWDEBUG_SAY(("Unhandled Chunk: 0x%X in file: %s, line %d\n",cload.Cur_Chunk_ID(),__FILE__,__LINE__));
+			break;
+		}
+		cload.Close_Chunk();
+	}
+
+	SaveLoadSystemClass::Register_Post_Load_Callback(this);
+	return true;
+}
+
+
+void PhysRecorderClass::Load_Variables(ChunkLoadClass & cload)
+{
+	while (cload.Open_Micro_Chunk()) {
+		switch (cload.Cur_Micro_Chunk_ID()) {
+			READ_MICRO_CHUNK(cload,PRSSC_VARIABLE_UPDATEONLYVISIBLE,UpdateOnlyVisibleObjects);
+			default:
+				WWDEBUG_SAY(("Unhandled Micro Chunk: 0x%X in file: %s, line %d\n",cload.Cur_Micro_Chunk_ID(),__FILE__,__LINE__));
+				break;
+		}
+		cload.Close_Micro_Chunk();
+	}
+}
+
+
+void PhysRecorderClass::Load_Objects(ChunkLoadClass & cload)
+{
+	/*
+	** The pointers are re-mapped in place after all of the sub-systems have loaded so
+	** they go in an array that won't move until On_Post_Load.
+	*/
+	int count = 0;
+	cload.Read(&count,sizeof(count));
+
+	/*
+	** Don't trust the count any further than the chunk can back it up
+	*/
+	const int entry_size = sizeof(PhysClass *) + sizeof(bool) + sizeof(Matrix3D);
+	int max_count = (int)((cload.Cur_Chunk_Length() - sizeof(count)) / entry_size);
+	if ((count < 0) || (count > max_count) || (LoadedObjects != NULL)) {
+		WWDEBUG_SAY(("PhysRecorder: bad object count %d, ignoring the objects\r\n",count));
+		return;
+	}
+
+	LoadedObjects = new PhysClass * [count];
+
+	for (int i=0; i<count; i++) {
+		ObjectStruct entry;
+		entry.Obj = NULL;
+		entry.Controller = NULL;
+		cload.Read(&LoadedObjects[i],sizeof(LoadedObjects[i]));
+		cload.Read(&entry.HasFinalTransform,sizeof(entry.HasFinalTransform));
+		cload.Read(&entry.FinalTransform,sizeof(entry.FinalTransform));
+		Objects.Add(entry);
+
+		REQUEST_POINTER_REMAP((void **)&LoadedObjects[i]);
+	}
+}
+
+
+void PhysRecorderClass::Load_Frames(ChunkLoadClass & cload)
+{
+	while (cload.Open_Chunk()) {
+		if (cload.Cur_Chunk_ID() == PRSSC_CHUNKID_FRAME) {
+			FrameStruct frame;
+			cload.Read(&frame.Dt,sizeof(frame.Dt));
+			cload.Read(&frame.InputCount,sizeof(frame.InputCount));
+			frame.FirstInput = Inputs.Count();
+
+			const int input_size = sizeof(int) + sizeof(Vector3) + sizeof(float);
+			int max_count = (int)((cload.Cur_Chunk_Length() - sizeof(frame.Dt) - sizeof(frame.InputCount)) / input_size);
+			if ((frame.InputCount < 0) || (frame.InputCount > max_count)) {
+				WWDEBUG_SAY(("PhysRecorder: bad input count %d, dropping the frame's inputs\r\n",frame.InputCount));
+				frame.InputCount = 0;
+			}
+
+			for (int i=0; i<frame.InputCount; i++) {
+				InputStruct input;
+				cload.Read(&input.Object,sizeof(input.Object));
+				cload.Read(&input.Move,sizeof(input.Move));
+				cload.Read(&input.Turn,sizeof(input.Turn));
+				Inputs.Add(input);
+			}
+			Frames.Add(frame);
+		}
+		cload.Close_Chunk();
+	}
+}
+
+
+/***********************************************************************************************
+ * PhysRecorderClass::On_Post_Load -- Hook the loaded objects up to the replay controllers     *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void PhysRecorderClass::On_Post_Load(void)
+{
+	if (LoadedObjects == NULL) {
+		return;
+	}
+
+	int i;
+	for (i=0; i<Objects.Count(); i++) {
+		Objects[i].Obj = LoadedObjects[i];
+		if (Objects[i].Obj != NULL) {
+			Objects[i].Obj->Add_Ref();
+		}
+	}
+	delete[] LoadedObjects;
+	LoadedObjects = NULL;
+
+	/*
+	** Every object that had a controller at some point in the recording gets one of ours.
+	** Inputs for objects that aren't in the recording are dropped.
+	*/
+	for (i=0; i<Inputs.Count(); i++) {
+		if ((Inputs[i].Object < 0) || (Inputs[i].Object >= Objects.Count())) {
+			WWDEBUG_SAY(("PhysRecorder: input %d refers to object %d of %d, ignoring it\r\n",i,Inputs[i].Object,Objects.Count()));
+			Inputs[i].Object = -1;
+			continue;
+		}
+		ObjectStruct & entry = Objects[Inputs[i].Object];
+		if ((entry.Controller == NULL) && (entry.Obj != NULL) && (entry.Obj->As_MoveablePhysClass() != NULL)) {
+			entry.Controller = new PhysControllerClass;
+			entry.Obj->As_MoveablePhysClass()->Set_Controller(entry.Controller);
+		}
+	}
+}
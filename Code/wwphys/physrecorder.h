@@ -0,0 +1,177 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/***********************************************************************************************
+ ***              C O N F I D E N T I A L  ---  W E S T W O O D  S T U D I O S               ***
+ ***********************************************************************************************
+ *                                                                                             *
+ *                 Project Name : WWPhys                                                       *
+ *                                                                                             *
+ *                     $Archive:: /Commando/Code/wwphys/physrecorder.h                        $*
+ *                                                                                             *
+ *---------------------------------------------------------------------------------------------*
+ * Functions:                                                                                  *
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#ifndef PHYSRECORDER_H
+#define PHYSRECORDER_H
+
+#include "always.h"
+#include "saveloadsubsystem.h"
+#include "vector.h"
+#include "vector3.h"
+#include "matrix3d.h"
+
+class PhysClass;
+class PhysControllerClass;
+class RawFileClass;
+class ChunkSaveClass;
+
+
+/******************************************************************************************
+**
+** PhysRecorderClass
+** Records a stretch of physics simulation so that it can be re-run without the game.
+** 
+** A recording file starts with the definitions, the level's static data and the dynamic
+** physics objects, all written by their usual save sub-systems, so it can be loaded with
+** SaveLoadSystemClass::Load like any other save file.  This sub-system's chunk comes 
+** last and holds the frame times, the controller inputs of each object on every frame 
+** and the transforms the objects ended up with.
+**
+** When a recording is loaded, the objects are hooked back up to controllers owned by
+** the recorder and Apply_Frame_Inputs sets them up for each frame before the scene is 
+** updated.  Only the controllers are replayed; anything else the game does to the 
+** objects (scripts, damage, teleports) isn't recorded.  Only the objects that were in
+** the scene when the recording started are recorded; objects spawned later (new
+** players, vehicles, projectiles) won't exist when the recording is replayed, so
+** record a stretch of play without spawns.  Stop_Recording reports how many objects
+** were missed.
+**
+** In the game, recordings are started and stopped with the phys_record_begin and
+** phys_record_end console commands.
+**
+******************************************************************************************/
+class PhysRecorderClass : public SaveLoadSubSystemClass
+{
+public:
+
+	PhysRecorderClass(void);
+	virtual ~PhysRecorderClass(void);
+
+	virtual uint32				Chunk_ID (void) const;
+
+	/*
+	** Recording.  Record_Frame is called by PhysicsSceneClass::Update
+	*/
+	bool							Start_Recording(const char * filename);
+	void							Stop_Recording(void);
+	bool							Is_Recording(void) const						{ return Saver != NULL; }
+	void							Record_Frame(float dt);
+
+	/*
+	** Playback, after a recording has been loaded
+	*/
+	void							Reset(void);
+	int							Get_Frame_Count(void) const					{ return Frames.Count(); }
+	float							Get_Frame_Time(int frame) const				{ return Frames[frame].Dt; }
+	void							Apply_Frame_Inputs(int frame);
+	bool							Get_Update_Only_Visible_Objects(void) const	{ return UpdateOnlyVisibleObjects; }
+
+	int							Get_Object_Count(void) const					{ return Objects.Count(); }
+	PhysClass *					Peek_Object(int index) const					{ return Objects[index].Obj; }
+	bool							Get_Final_Transform(int index,Matrix3D * set_tm) const;
+
+protected:
+
+	virtual bool				Contains_Data(void) const;
+	virtual bool				Save (ChunkSaveClass &csave);
+	virtual bool				Load (ChunkLoadClass &cload);
+	virtual const char*		Name() const { return "PhysRecorderClass"; }
+	virtual void				On_Post_Load(void);
+
+	void							Load_Variables(ChunkLoadClass & cload);
+	void							Load_Objects(ChunkLoadClass & cload);
+	void							Load_Frames(ChunkLoadClass & cload);
+	bool							Is_Recorded(PhysClass * obj) const;
+
+	struct ObjectStruct
+	{
+		PhysClass *				Obj;
+		PhysControllerClass *Controller;			// only used for playback
+		bool						HasFinalTransform;
+		Matrix3D					FinalTransform;
+
+		bool operator == (const ObjectStruct & that) { return Obj == that.Obj; }
+		bool operator != (const ObjectStruct & that) { return Obj != that.Obj; }
+	};
+
+	struct FrameStruct
+	{
+		float						Dt;
+		int						FirstInput;
+		int						InputCount;
+
+		bool operator == (const FrameStruct & that) { return false; }
+		bool operator != (const FrameStruct & that) { return true; }
+	};
+
+	struct InputStruct
+	{
+		int						Object;
+		Vector3					Move;
+		float						Turn;
+
+		bool operator == (const InputStruct & that) { return false; }
+		bool operator != (const InputStruct & that) { return true; }
+	};
+
+	RawFileClass *								File;
+	ChunkSaveClass *							Saver;
+	bool											UpdateOnlyVisibleObjects;
+	PhysClass **								LoadedObjects;		// pointers waiting to be re-mapped during a load
+
+	DynamicVectorClass<ObjectStruct>		Objects;
+	DynamicVectorClass<FrameStruct>		Frames;
+	DynamicVectorClass<InputStruct>		Inputs;
+
+	/*
+	** internal chunk id's
+	*/
+	enum 
+	{
+		PRSSC_CHUNKID_VARIABLES				= 0x03170001,
+		PRSSC_CHUNKID_OBJECTS,
+		PRSSC_CHUNKID_FRAMES,
+		PRSSC_CHUNKID_FRAME,
+		
+		PRSSC_VARIABLE_UPDATEONLYVISIBLE	= 0x00,
+	};
+};
+
+/*
+** _PhysRecorder - global instance of the physics recording sub-system
+*/
+extern PhysRecorderClass _PhysRecorder;
+
+#endif
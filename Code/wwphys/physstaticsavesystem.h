@@ -72,8 +72,11 @@ protected:
 	virtual const char*		Name() const { return "PhysStaticSaveSystemClass"; }
 	virtual void				On_Post_Load(void);
 
+public:
+
 	/*
-	** internal chunk id's
+	** internal chunk id's (public so tools can pull the pathfind data
+	** out of a level file without loading the whole scene)
 	*/
 	enum 
 	{
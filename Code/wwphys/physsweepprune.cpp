@@ -0,0 +1,606 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/***********************************************************************************************
+ ***              C O N F I D E N T I A L  ---  W E S T W O O D  S T U D I O S               ***
+ ***********************************************************************************************
+ *                                                                                             *
+ *                 Project Name : WWPhys                                                       *
+ *                                                                                             *
+ *                     $Archive:: /Commando/Code/wwphys/physsweepprune.cpp                    $*
+ *                                                                                             *
+ *---------------------------------------------------------------------------------------------*
+ * Functions:                                                                                  *
+ *   PhysSweepPruneClass::PhysSweepPruneClass -- Constructor                                   *
+ *   PhysSweepPruneClass::~PhysSweepPruneClass -- Destructor                                   *
+ *   PhysSweepPruneClass::Add_Object -- Start tracking a dynamic object                        *
+ *   PhysSweepPruneClass::Remove_Object -- Stop tracking a dynamic object                      *
+ *   PhysSweepPruneClass::Update_Object -- The object's culling box has changed                *
+ *   PhysSweepPruneClass::Expand_Object -- Make sure the object's fat box contains a box       *
+ *   PhysSweepPruneClass::Reset -- Stop tracking everything                                    *
+ *   PhysSweepPruneClass::Collect_Overlapping_Objects -- Dynamic objects touching a box        *
+ *   PhysSweepPruneClass::Compute_Fat_Box -- Fat box for an object's current culling box       *
+ *   PhysSweepPruneClass::Refit -- Move a proxy's fat box                                      *
+ *   PhysSweepPruneClass::Sort_Endpoint -- Move one end to its place in the sorted list        *
+ *   PhysSweepPruneClass::Set_Endpoint_Index -- Tell a proxy where its end is                  *
+ *   PhysSweepPruneClass::Is_Overlapping -- Do two proxies' fat boxes overlap?                 *
+ *   PhysSweepPruneClass::Add_Pair -- Remember that two proxies overlap                        *
+ *   PhysSweepPruneClass::Remove_Pair -- Forget that two proxies overlap                       *
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+#include "physsweepprune.h"
+#include "phys.h"
+#include "movephys.h"
+#include "aabox.h"
+#include "wwdebug.h"
+
+
+/*
+** Slack added around every object's culling box.  The bigger this is, the
+** less often objects have to be moved in the sorted lists, but the more pairs
+** there are.  Moving objects also get room for where they are headed.
+*/
+const float SWEEP_PRUNE_MARGIN		= 0.5f;
+const float SWEEP_PRUNE_LOOKAHEAD	= 0.25f;
+
+/*
+** A fat box that has grown this much past the box Compute_Fat_Box would give
+** (from Expand_Object or from a fast object slowing down) is shrunk back so
+** it doesn't keep pairs it no longer needs.  This is much bigger than the
+** margin so that objects which expand every frame don't refit every frame.
+*/
+const float SWEEP_PRUNE_SHRINK		= 2.0f;
+
+
+/*
+** Sorting order for the ends.  A min end sorts before a max end with the same
+** value so that boxes which just touch count as overlapping.
+*/
+static inline bool Endpoint_Less(float value0,int ismax0,float value1,int ismax1)
+{
+	return (value0 < value1) || ((value0 == value1) && !ismax0 && ismax1);
+}
+
+
+/***********************************************************************************************
+ * PhysSweepPruneClass::PhysSweepPruneClass -- Constructor                                     *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+PhysSweepPruneClass::PhysSweepPruneClass(void) :
+	PairCount(0),
+	RefitCount(0)
+{
+	Proxies.Set_Growth_Step(128);
+	for (int axis = 0; axis < 3; axis++) {
+		Endpoints[axis].Set_Growth_Step(256);
+	}
+}
+
+
+/***********************************************************************************************
+ * PhysSweepPruneClass::~PhysSweepPruneClass -- Destructor                                     *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+PhysSweepPruneClass::~PhysSweepPruneClass(void)
+{
+	Reset();
+}
+
+
+/***********************************************************************************************
+ * PhysSweepPruneClass::Add_Object -- Start tracking a dynamic object                          *
+ *                                                                                             *
+ * The new ends are added at the top of each list and sorted down into place, which finds      *
+ * every pair the new object is part of.                                                       *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void PhysSweepPruneClass::Add_Object(PhysClass * obj)
+{
+	WWASSERT(obj != NULL);
+	if (Is_Tracking(obj)) {
+		return;
+	}
+
+	ProxyStruct * proxy = new ProxyStruct;
+	proxy->Obj = obj;
+	proxy->ProxyIndex = Proxies.Count();
+	Compute_Fat_Box(obj,&(proxy->Min),&(proxy->Max));
+
+	Proxies.Add(proxy);
+	ProxyTable.Insert(obj,proxy);
+
+	for (int axis = 0; axis < 3; axis++) {
+
+		EndpointStruct end;
+		end.Proxy = proxy;
+
+		end.Value = proxy->Min[axis];
+		end.IsMax = 0;
+		proxy->MinIndex[axis] = Endpoints[axis].Count();
+		Endpoints[axis].Add(end);
+
+		end.Value = proxy->Max[axis];
+		end.IsMax = 1;
+		proxy->MaxIndex[axis] = Endpoints[axis].Count();
+		Endpoints[axis].Add(end);
+
+		Sort_Endpoint(axis,proxy->MinIndex[axis]);
+		Sort_Endpoint(axis,proxy->MaxIndex[axis]);
+	}
+}
+
+
+/***********************************************************************************************
+ * PhysSweepPruneClass::Remove_Object -- Stop tracking a dynamic object                        *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void PhysSweepPruneClass::Remove_Object(PhysClass * obj)
+{
+	ProxyStruct * proxy = NULL;
+	if (!ProxyTable.Get(obj,proxy)) {
+		return;
+	}
+
+	/*
+	** Drop all of our pairs
+	*/
+	while (proxy->Partners.Count() > 0) {
+		Remove_Pair(proxy,proxy->Partners[proxy->Partners.Count() - 1]);
+	}
+
+	/*
+	** Pull our ends out of the lists, the ends above them slide down one or two places
+	*/
+	for (int axis = 0; axis < 3; axis++) {
+		int min_index = proxy->MinIndex[axis];
+		int max_index = proxy->MaxIndex[axis];
+		WWASSERT(min_index < max_index);
+
+		Endpoints[axis].Delete(max_index);
+		Endpoints[axis].Delete(min_index);
+
+		for (int index = min_index; index < Endpoints[axis].Count(); index++) {
+			Set_Endpoint_Index(axis,index);
+		}
+	}
+
+	/*
+	** Fill our hole in the proxy array with the last proxy
+	*/
+	int last = Proxies.Count() - 1;
+	if (proxy->ProxyIndex != last) {
+		Proxies[proxy->ProxyIndex] = Proxies[last];
+		Proxies[proxy->ProxyIndex]->ProxyIndex = proxy->ProxyIndex;
+	}
+	Proxies.Delete(last);
+
+	ProxyTable.Remove(obj);
+	delete proxy;
+}
+
+
+/***********************************************************************************************
+ * PhysSweepPruneClass::Update_Object -- The object's culling box has changed                  *
+ *                                                                                             *
+ * Called by the dynamic culling system whenever a tracked object's culling box is set.        *
+ * Nothing happens unless the box has left the object's fat box or the fat box has grown       *
+ * much bigger than it needs to be.                                                            *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void PhysSweepPruneClass::Update_Object(PhysClass * obj)
+{
+	ProxyStruct * proxy = NULL;
+	if (!ProxyTable.Get(obj,proxy)) {
+		return;
+	}
+
+	const AABoxClass & box = obj->Get_Cull_Box();
+	Vector3 min = box.Center - box.Extent;
+	Vector3 max = box.Center + box.Extent;
+
+	if (	(min.X < proxy->Min.X) || (min.Y < proxy->Min.Y) || (min.Z < proxy->Min.Z) ||
+			(max.X > proxy->Max.X) || (max.Y > proxy->Max.Y) || (max.Z > proxy->Max.Z)	)
+	{
+		Vector3 fat_min,fat_max;
+		Compute_Fat_Box(obj,&fat_min,&fat_max);
+		Refit(proxy,fat_min,fat_max);
+		return;
+	}
+
+	Vector3 fat_min,fat_max;
+	Compute_Fat_Box(obj,&fat_min,&fat_max);
+	fat_min -= Vector3(SWEEP_PRUNE_SHRINK,SWEEP_PRUNE_SHRINK,SWEEP_PRUNE_SHRINK);
+	fat_max += Vector3(SWEEP_PRUNE_SHRINK,SWEEP_PRUNE_SHRINK,SWEEP_PRUNE_SHRINK);
+
+	if (	(proxy->Min.X < fat_min.X) || (proxy->Min.Y < fat_min.Y) || (proxy->Min.Z < fat_min.Z) ||
+			(proxy->Max.X > fat_max.X) || (proxy->Max.Y > fat_max.Y) || (proxy->Max.Z > fat_max.Z)	)
+	{
+		Compute_Fat_Box(obj,&fat_min,&fat_max);
+		Refit(proxy,fat_min,fat_max);
+	}
+}
+
+
+/***********************************************************************************************
+ * PhysSweepPruneClass::Expand_Object -- Make sure the object's fat box contains a box         *
+ *                                                                                             *
+ * Used before a query around an object so that every dynamic object touching the query box   *
+ * is one of its partners.                                                                     *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * obj - tracked object                                                                        *
+ * box - box which must be inside the object's fat box                                         *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void PhysSweepPruneClass::Expand_Object(PhysClass * obj,const AABoxClass & box)
+{
+	ProxyStruct * proxy = NULL;
+	if (!ProxyTable.Get(obj,proxy)) {
+		return;
+	}
+
+	Vector3 min = box.Center - box.Extent;
+	Vector3 max = box.Center + box.Extent;
+
+	if (	(min.X < proxy->Min.X) || (min.Y < proxy->Min.Y) || (min.Z < proxy->Min.Z) ||
+			(max.X > proxy->Max.X) || (max.Y > proxy->Max.Y) || (max.Z > proxy->Max.Z)	)
+	{
+		Vector3 fat_min,fat_max;
+		Compute_Fat_Box(obj,&fat_min,&fat_max);
+
+		Vector3 margin(SWEEP_PRUNE_MARGIN,SWEEP_PRUNE_MARGIN,SWEEP_PRUNE_MARGIN);
+		min -= margin;
+		max += margin;
+		fat_min.Update_Min(min);
+		fat_max.Update_Max(max);
+
+		Refit(proxy,fat_min,fat_max);
+	}
+}
+
+
+/***********************************************************************************************
+ * PhysSweepPruneClass::Reset -- Stop tracking everything                                      *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void PhysSweepPruneClass::Reset(void)
+{
+	for (int index = 0; index < Proxies.Count(); index++) {
+		delete Proxies[index];
+	}
+	Proxies.Delete_All();
+	for (int axis = 0; axis < 3; axis++) {
+		Endpoints[axis].Delete_All();
+	}
+	ProxyTable.Remove_All();
+	PairCount = 0;
+	RefitCount = 0;
+}
+
+
+/***********************************************************************************************
+ * PhysSweepPruneClass::Collect_Overlapping_Objects -- Dynamic objects touching a box          *
+ *                                                                                             *
+ * Adds every tracked object (including obj itself) whose culling box touches the given box    *
+ * to the list.  This is the same set of objects the dynamic culling system would collect for  *
+ * the box.                                                                                    *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * obj - tracked object the query is centered on                                               *
+ * box - query box, usually around obj                                                         *
+ * list - list to add the objects to                                                           *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ * May move obj's fat box.                                                                     *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void PhysSweepPruneClass::Collect_Overlapping_Objects(PhysClass * obj,const AABoxClass & box,NonRefPhysListClass * list)
+{
+	WWASSERT(list != NULL);
+
+	ProxyStruct * proxy = NULL;
+	if (!ProxyTable.Get(obj,proxy)) {
+		return;
+	}
+
+	Expand_Object(obj,box);
+
+	for (int index = -1; index < proxy->Partners.Count(); index++) {
+		PhysClass * other = (index == -1) ? obj : proxy->Partners[index]->Obj;
+		const AABoxClass & other_box = other->Get_Cull_Box();
+		Vector3 dc = other_box.Center - box.Center;
+
+		if (	(WWMath::Fabs(dc.X) <= other_box.Extent.X + box.Extent.X) &&
+				(WWMath::Fabs(dc.Y) <= other_box.Extent.Y + box.Extent.Y) &&
+				(WWMath::Fabs(dc.Z) <= other_box.Extent.Z + box.Extent.Z)	)
+		{
+			list->Add(other);
+		}
+	}
+}
+
+
+/***********************************************************************************************
+ * PhysSweepPruneClass::Compute_Fat_Box -- Fat box for an object's current culling box         *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void PhysSweepPruneClass::Compute_Fat_Box(PhysClass * obj,Vector3 * set_min,Vector3 * set_max)
+{
+	const AABoxClass & box = obj->Get_Cull_Box();
+	*set_min = box.Center - box.Extent;
+	*set_max = box.Center + box.Extent;
+
+	Vector3 margin(SWEEP_PRUNE_MARGIN,SWEEP_PRUNE_MARGIN,SWEEP_PRUNE_MARGIN);
+	*set_min -= margin;
+	*set_max += margin;
+
+	/*
+	** Stretch the box towards where the object is headed
+	*/
+	MoveablePhysClass * moveable = obj->As_MoveablePhysClass();
+	if (moveable != NULL) {
+		Vector3 vel;
+		moveable->Get_Velocity(&vel);
+		vel *= SWEEP_PRUNE_LOOKAHEAD;
+		for (int axis = 0; axis < 3; axis++) {
+			if (vel[axis] < 0.0f) {
+				(*set_min)[axis] += vel[axis];
+			} else {
+				(*set_max)[axis] += vel[axis];
+			}
+		}
+	}
+}
+
+
+/***********************************************************************************************
+ * PhysSweepPruneClass::Refit -- Move a proxy's fat box                                        *
+ *                                                                                             *
+ * All three axes get their new values before any of them are sorted so that the overlap      *
+ * tests done while sorting see the final box.                                                 *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void PhysSweepPruneClass::Refit(ProxyStruct * proxy,const Vector3 & min,const Vector3 & max)
+{
+	RefitCount++;
+	proxy->Min = min;
+	proxy->Max = max;
+
+	int axis;
+	for (axis = 0; axis < 3; axis++) {
+		Endpoints[axis][proxy->MinIndex[axis]].Value = min[axis];
+		Endpoints[axis][proxy->MaxIndex[axis]].Value = max[axis];
+	}
+
+	for (axis = 0; axis < 3; axis++) {
+		Sort_Endpoint(axis,proxy->MinIndex[axis]);
+		Sort_Endpoint(axis,proxy->MaxIndex[axis]);
+	}
+}
+
+
+/***********************************************************************************************
+ * PhysSweepPruneClass::Sort_Endpoint -- Move one end to its place in the sorted list          *
+ *                                                                                             *
+ * A min end passing a max end (or the reverse) means two boxes have started or stopped        *
+ * overlapping along this axis.  Pairs are only added when the boxes overlap on all three.     *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void PhysSweepPruneClass::Sort_Endpoint(int axis,int index)
+{
+	DynamicVectorClass<EndpointStruct> & ends = Endpoints[axis];
+	EndpointStruct moving = ends[index];
+
+	/*
+	** Slide down
+	*/
+	while ((index > 0) && Endpoint_Less(moving.Value,moving.IsMax,ends[index - 1].Value,ends[index - 1].IsMax)) {
+
+		EndpointStruct & other = ends[index - 1];
+		if (other.Proxy != moving.Proxy) {
+			if (!moving.IsMax && other.IsMax) {
+				if (Is_Overlapping(moving.Proxy,other.Proxy)) {
+					Add_Pair(moving.Proxy,other.Proxy);
+				}
+			} else if (moving.IsMax && !other.IsMax) {
+				Remove_Pair(moving.Proxy,other.Proxy);
+			}
+		}
+
+		ends[index] = other;
+		Set_Endpoint_Index(axis,index);
+		index--;
+	}
+
+	/*
+	** Slide up
+	*/
+	while ((index < ends.Count() - 1) && Endpoint_Less(ends[index + 1].Value,ends[index + 1].IsMax,moving.Value,moving.IsMax)) {
+
+		EndpointStruct & other = ends[index + 1];
+		if (other.Proxy != moving.Proxy) {
+			if (moving.IsMax && !other.IsMax) {
+				if (Is_Overlapping(moving.Proxy,other.Proxy)) {
+					Add_Pair(moving.Proxy,other.Proxy);
+				}
+			} else if (!moving.IsMax && other.IsMax) {
+				Remove_Pair(moving.Proxy,other.Proxy);
+			}
+		}
+
+		ends[index] = other;
+		Set_Endpoint_Index(axis,index);
+		index++;
+	}
+
+	ends[index] = moving;
+	Set_Endpoint_Index(axis,index);
+}
+
+
+/***********************************************************************************************
+ * PhysSweepPruneClass::Set_Endpoint_Index -- Tell a proxy where its end is                    *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void PhysSweepPruneClass::Set_Endpoint_Index(int axis,int index)
+{
+	EndpointStruct & end = Endpoints[axis][index];
+	if (end.IsMax) {
+		end.Proxy->MaxIndex[axis] = index;
+	} else {
+		end.Proxy->MinIndex[axis] = index;
+	}
+}
+
+
+/***********************************************************************************************
+ * PhysSweepPruneClass::Is_Overlapping -- Do two proxies' fat boxes overlap?                   *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+bool PhysSweepPruneClass::Is_Overlapping(ProxyStruct * p0,ProxyStruct * p1) const
+{
+	return	(p0->Min.X <= p1->Max.X) && (p1->Min.X <= p0->Max.X) &&
+				(p0->Min.Y <= p1->Max.Y) && (p1->Min.Y <= p0->Max.Y) &&
+				(p0->Min.Z <= p1->Max.Z) && (p1->Min.Z <= p0->Max.Z);
+}
+
+
+/***********************************************************************************************
+ * PhysSweepPruneClass::Add_Pair -- Remember that two proxies overlap                          *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void PhysSweepPruneClass::Add_Pair(ProxyStruct * p0,ProxyStruct * p1)
+{
+	if (p0->Partners.ID(p1) == -1) {
+		p0->Partners.Add(p1);
+		p1->Partners.Add(p0);
+		PairCount++;
+	}
+}
+
+
+/***********************************************************************************************
+ * PhysSweepPruneClass::Remove_Pair -- Forget that two proxies overlap                         *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void PhysSweepPruneClass::Remove_Pair(ProxyStruct * p0,ProxyStruct * p1)
+{
+	if (p0->Partners.Delete(p1)) {
+		p1->Partners.Delete(p0);
+		PairCount--;
+	}
+}
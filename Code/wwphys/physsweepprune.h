@@ -0,0 +1,128 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/***********************************************************************************************
+ ***              C O N F I D E N T I A L  ---  W E S T W O O D  S T U D I O S               ***
+ ***********************************************************************************************
+ *                                                                                             *
+ *                 Project Name : WWPhys                                                       *
+ *                                                                                             *
+ *                     $Archive:: /Commando/Code/wwphys/physsweepprune.h                      $*
+ *                                                                                             *
+ *---------------------------------------------------------------------------------------------*
+ * Functions:                                                                                  *
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#ifndef PHYSSWEEPPRUNE_H
+#define PHYSSWEEPPRUNE_H
+
+#include "always.h"
+#include "vector.h"
+#include "vector3.h"
+#include "hashtemplate.h"
+#include "physlist.h"
+
+class PhysClass;
+class AABoxClass;
+
+
+/*
+** PhysSweepPruneClass
+** Persistent broadphase for the dynamic objects.  Every object gets a "fat" box
+** which contains its culling box plus some slack.  The ends of the fat boxes are
+** kept sorted along each axis and every pair of objects whose fat boxes overlap
+** is remembered.  When an object's culling box leaves its fat box, the fat box is
+** refit and its ends are moved to their new place in the sorted lists with an
+** insertion sort, adding and removing pairs as they pass other ends.  Objects
+** that stay inside their fat box cost nothing.  A fat box that ends up much
+** bigger than it needs to be is shrunk back the next time the object moves.
+**
+** Since an object's culling box is always inside its fat box, the partners of an
+** object include every dynamic object whose culling box touches its fat box.
+** Collect_Overlapping_Objects uses this to answer box queries around an object
+** without going to the culling grid.
+**
+** The object pointers are not ref-counted; the scene adds and removes objects
+** as they enter and leave the dynamic culling system.
+*/
+class PhysSweepPruneClass
+{
+public:
+
+	PhysSweepPruneClass(void);
+	~PhysSweepPruneClass(void);
+
+	void						Add_Object(PhysClass * obj);
+	void						Remove_Object(PhysClass * obj);
+	void						Update_Object(PhysClass * obj);
+	void						Expand_Object(PhysClass * obj,const AABoxClass & box);
+	void						Reset(void);
+
+	bool						Is_Tracking(PhysClass * obj) const							{ return ProxyTable.Exists(obj); }
+	int						Get_Object_Count(void) const									{ return Proxies.Count(); }
+	int						Get_Pair_Count(void) const										{ return PairCount; }
+	int						Get_Refit_Count(void) const									{ return RefitCount; }
+	void						Reset_Statistics(void)											{ RefitCount = 0; }
+
+	void						Collect_Overlapping_Objects(PhysClass * obj,const AABoxClass & box,NonRefPhysListClass * list);
+
+protected:
+
+	struct ProxyStruct
+	{
+		PhysClass *									Obj;
+		Vector3										Min;					// fat box
+		Vector3										Max;
+		int											MinIndex[3];		// where our ends are in the sorted lists
+		int											MaxIndex[3];
+		int											ProxyIndex;			// where we are in Proxies
+		DynamicVectorClass<ProxyStruct *>	Partners;			// everything our fat box overlaps
+	};
+
+	struct EndpointStruct
+	{
+		float											Value;
+		ProxyStruct *								Proxy;
+		int											IsMax;
+
+		bool operator == (const EndpointStruct & that) { return (Proxy == that.Proxy) && (IsMax == that.IsMax); }
+		bool operator != (const EndpointStruct & that) { return !(*this == that); }
+	};
+
+	void						Compute_Fat_Box(PhysClass * obj,Vector3 * set_min,Vector3 * set_max);
+	void						Refit(ProxyStruct * proxy,const Vector3 & min,const Vector3 & max);
+	void						Sort_Endpoint(int axis,int index);
+	void						Set_Endpoint_Index(int axis,int index);
+	bool						Is_Overlapping(ProxyStruct * p0,ProxyStruct * p1) const;
+	void						Add_Pair(ProxyStruct * p0,ProxyStruct * p1);
+	void						Remove_Pair(ProxyStruct * p0,ProxyStruct * p1);
+
+	DynamicVectorClass<ProxyStruct *>				Proxies;
+	DynamicVectorClass<EndpointStruct>				Endpoints[3];
+	HashTemplateClass<PhysClass *,ProxyStruct *>	ProxyTable;
+	int														PairCount;
+	int														RefitCount;
+};
+
+
+#endif //PHYSSWEEPPRUNE_H
@@ -46,6 +46,7 @@
 #include "wwdebug.h"
 #include "wwhack.h"
 #include "wwprofile.h"
+#include "collisionprofiler.h"
 
 
 
@@ -214,6 +215,7 @@ void ProjectileClass::Integrate(float dt)
 void ProjectileClass::Timestep(float dt)
 {
 	WWPROFILE("Projectile::Timestep");
+	COLLISION_PROFILE_CATEGORY("Projectiles");
 	const int MAX_BUMPS = 5;
 
 	if (Is_User_Control_Enabled()) {
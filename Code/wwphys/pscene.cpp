@@ -73,6 +73,8 @@
  *   PhysicsSceneClass::Re_Partition_Static_Projectors -- partition the static projectors      *
  *   PhysicsSceneClass::Update_Culling_System_Bounding_Boxes -- updates the cull systems       *
  *   PhysicsSceneClass::Get_Level_Extents -- returns the bounds of the level                   *
+ *   PhysicsSceneClass::Begin_Collision_Profile -- Start profiling the collision queries       *
+ *   PhysicsSceneClass::End_Collision_Profile -- Stop profiling and write out the results      *
  *   PhysicsSceneClass::Set_Polygon_Budgets -- set the budgets for the LOD system              *
  *   PhysicsSceneClass::Get_Polygon_Budgets -- returns the budgets for the LOD system          *
  *   PhysicsSceneClass::Per_Frame_Statistics_Update -- statistics tracking                     *
@@ -91,6 +93,8 @@
 #include "wwprofile.h"
 #include "wwmemlog.h"
 #include "physgridcull.h"
+#include "physisland.h"
+#include "physsweepprune.h"
 #include "staticaabtreecull.h"
 #include "dynamicaabtreecull.h"
 #include "lightcull.h"
@@ -107,6 +111,7 @@
 #include "shader.h"
 #include "lookuptable.h"
 #include "shattersystem.h"
+#include "collisionprofiler.h"
 #include "projectile.h"
 #include "staticphys.h"
 #include "vistable.h"
@@ -116,6 +121,7 @@
 #include "dx8wrapper.h"
 #include "physresourcemgr.h"
 #include "phys3.h"
+#include "physrecorder.h"
 
 #include "umbrasupport.h"
 
@@ -213,7 +219,11 @@ PhysicsSceneClass::PhysicsSceneClass(void) :
 	CameraShakeSystem(NULL),
 	HighlightMaterialPass(NULL),
 	UpdateOnlyVisibleObjects(false),
-	CurrentFrameNumber(0)
+	CurrentFrameNumber(0),
+	IslandBuilder(NULL),
+	IslandTimestepEnabled(false),
+	SweepPrune(NULL),
+	SweepPruneEnabled(false)
 {
 	WWASSERT_PRINT(TheScene == NULL,"Only one instance of the PhysicsSceneClass is allowed.\r\n");
 	WWMEMLOG(MEM_PHYSICSDATA);
@@ -251,6 +261,16 @@ PhysicsSceneClass::PhysicsSceneClass(void) :
 	*/
 	CameraShakeSystem = new CameraShakeSystemClass;
 
+	/*
+	** Allocate the island builder
+	*/
+	IslandBuilder = new PhysIslandBuilderClass;
+
+	/*
+	** Allocate the sweep-and-prune broadphase, it stays empty until enabled
+	*/
+	SweepPrune = new PhysSweepPruneClass;
+
 	/*
 	** Allocate the sun light
 	*/
@@ -285,6 +305,7 @@ PhysicsSceneClass::PhysicsSceneClass(void) :
 PhysicsSceneClass::~PhysicsSceneClass(void)
 {
 	Remove_All();
+	Enable_Sweep_Prune(false);
 
 	delete StaticCullingSystem;
 	delete DynamicCullingSystem;
@@ -294,6 +315,8 @@ PhysicsSceneClass::~PhysicsSceneClass(void)
 	delete DynamicProjectorCullingSystem;
 	delete Pathfinder;
 	delete CameraShakeSystem;
+	delete IslandBuilder;
+	delete SweepPrune;
 
 	REF_PTR_RELEASE(SunLight);
 
@@ -338,10 +361,25 @@ void PhysicsSceneClass::Update(float dt,int frameid)
 		return;
 	}
 
+	if (_PhysRecorder.Is_Recording()) {
+		_PhysRecorder.Record_Frame(dt);
+	}
+
 	/*
-	** Timestep all of the physics objects
+	** Timestep all of the physics objects.  In island mode each island runs
+	** through all of the sub-steps before the next island starts.
 	*/
-	{
+	if (IslandTimestepEnabled) {
+		IslandBuilder->Build(TimestepList,DynamicCullingSystem,dt);
+
+		WWPROFILE("Timestep");
+		for (int island = 0; island < IslandBuilder->Get_Island_Count(); island++) {
+			Timestep_Island(island,dt);
+		}
+
+	} else {
+		IslandBuilder->Reset();
+
 		WWPROFILE("Timestep");
 		float remaining = dt;
 		
@@ -355,15 +393,8 @@ void PhysicsSceneClass::Update(float dt,int frameid)
 			RefPhysListIterator it(&TimestepList);
 			for (it.First(); !it.Is_Done(); it.Next()) {
 				PhysClass* phys_obj=it.Peek_Obj();
-				// Little optimization hack - only update vehicles that are visible (for now update all other physics
-				// objects regardless of the visibility to avoid problems, vehicles are the most expensive anyway).
-				// This same thing is done to Post Timestep couple lines lower.
-				if (phys_obj->Is_Object_Simulating()) {
-					if (!UpdateOnlyVisibleObjects	||
-						phys_obj->Get_Last_Visible_Frame()==CurrentFrameNumber ||
-						!phys_obj->As_VehiclePhysClass()) {
-						phys_obj->Timestep(step);
-					}
+				if (Should_Timestep(phys_obj)) {
+					phys_obj->Timestep(step);
 				}
 			}
 
@@ -378,12 +409,8 @@ void PhysicsSceneClass::Update(float dt,int frameid)
 //			if (it.Peek_Obj()->Is_Object_Simulating()) {
 //				if (!UpdateOnlyVisibleObjects || it.Peek_Obj()->Get_Last_Visible_Frame()==CurrentFrameNumber) {
 			PhysClass* phys_obj=it.Peek_Obj();
-			if (phys_obj->Is_Object_Simulating()) {
-				if (!UpdateOnlyVisibleObjects	||
-					phys_obj->Get_Last_Visible_Frame()==CurrentFrameNumber ||
-					!phys_obj->As_VehiclePhysClass()) {
-					phys_obj->Post_Timestep_Process();
-				}
+			if (Should_Timestep(phys_obj)) {
+				phys_obj->Post_Timestep_Process();
 			}
 		}
 	}
@@ -413,6 +440,197 @@ void PhysicsSceneClass::Update(float dt,int frameid)
 }
 
 
+/***********************************************************************************************
+ * PhysicsSceneClass::Should_Timestep -- Should this object be simulated this frame?           *
+ *                                                                                             *
+ * Little optimization hack - only update vehicles that are visible (for now update all other  *
+ * physics objects regardless of the visibility to avoid problems, vehicles are the most       *
+ * expensive anyway).  Used for both Timestep and Post_Timestep_Process.                       *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+bool PhysicsSceneClass::Should_Timestep(PhysClass * phys_obj)
+{
+	if (phys_obj->Is_Object_Simulating()) {
+		return (	!UpdateOnlyVisibleObjects	||
+					phys_obj->Get_Last_Visible_Frame()==CurrentFrameNumber ||
+					!phys_obj->As_VehiclePhysClass());
+	}
+	return false;
+}
+
+
+/***********************************************************************************************
+ * PhysicsSceneClass::Timestep_Island -- Simulate one island through the whole frame           *
+ *                                                                                             *
+ * The objects in the island are stepped in time-step list order, so the result for the       *
+ * island is the same as the serial update.                                                    *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * island - index of the island in the island builder                                          *
+ * dt - length of the frame                                                                    *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void PhysicsSceneClass::Timestep_Island(int island,float dt)
+{
+	int count = IslandBuilder->Get_Island_Object_Count(island);
+	float remaining = dt;
+
+	while (remaining > 0) {
+
+		float step = min(remaining,MAX_TIMESTEP);
+		for (int index = 0; index < count; index++) {
+			PhysClass * phys_obj = IslandBuilder->Peek_Island_Object(island,index);
+			if (Should_Timestep(phys_obj)) {
+				phys_obj->Timestep(step);
+			}
+		}
+
+		remaining -= step;
+	}
+}
+
+
+/***********************************************************************************************
+ * PhysicsSceneClass::Get_Island_Count -- Number of islands built for the last update          *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+int PhysicsSceneClass::Get_Island_Count(void)
+{
+	return IslandBuilder->Get_Island_Count();
+}
+
+
+/***********************************************************************************************
+ * PhysicsSceneClass::Get_Largest_Island_Size -- Object count of the biggest island            *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+int PhysicsSceneClass::Get_Largest_Island_Size(void)
+{
+	return IslandBuilder->Get_Largest_Island_Size();
+}
+
+
+/***********************************************************************************************
+ * PhysicsSceneClass::Enable_Sweep_Prune -- Turn the sweep-and-prune broadphase on or off      *
+ *                                                                                             *
+ * Turning it on adds every dynamic object to the broadphase, after that objects are added     *
+ * and removed along with the dynamic culling system.                                          *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void PhysicsSceneClass::Enable_Sweep_Prune(bool onoff)
+{
+	if (onoff == SweepPruneEnabled) {
+		return;
+	}
+
+	SweepPruneEnabled = onoff;
+	SweepPrune->Reset();
+
+	if (SweepPruneEnabled) {
+		Rebuild_Sweep_Prune();
+		DynamicCullingSystem->Set_Broadphase(SweepPrune);
+	} else {
+		DynamicCullingSystem->Set_Broadphase(NULL);
+	}
+}
+
+
+/***********************************************************************************************
+ * PhysicsSceneClass::Rebuild_Sweep_Prune -- Re-add every dynamic object to the broadphase     *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ * Does nothing unless the broadphase is enabled.                                              *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void PhysicsSceneClass::Rebuild_Sweep_Prune(void)
+{
+	if (SweepPruneEnabled == false) {
+		return;
+	}
+
+	SweepPrune->Reset();
+
+	RefPhysListIterator it(&ObjList);
+	for (it.First(); !it.Is_Done(); it.Next()) {
+		if (it.Peek_Obj()->Get_Culling_System() == DynamicCullingSystem) {
+			SweepPrune->Add_Object(it.Peek_Obj());
+		}
+	}
+}
+
+
+/***********************************************************************************************
+ * PhysicsSceneClass::Get_Sweep_Prune_Pair_Count -- Number of pairs in the broadphase          *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+int PhysicsSceneClass::Get_Sweep_Prune_Pair_Count(void)
+{
+	return SweepPrune->Get_Pair_Count();
+}
+
+
+/***********************************************************************************************
+ * PhysicsSceneClass::Get_Sweep_Prune_Refit_Count -- Fat boxes moved since the last reset      *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+int PhysicsSceneClass::Get_Sweep_Prune_Refit_Count(void)
+{
+	return SweepPrune->Get_Refit_Count();
+}
+
+
 /***********************************************************************************************
  * PhysicsSceneClass::Add_Dynamic_Object -- Adds a dynamic object to the scene                 *
  *                                                                                             *
@@ -468,6 +686,9 @@ void PhysicsSceneClass::Internal_Add_Dynamic_Object(PhysClass * newobj)
 	if (newobj->Needs_Timestep()) {
 		TimestepList.Add(newobj);
 	}
+	if (SweepPruneEnabled && (newobj->Get_Culling_System() == DynamicCullingSystem)) {
+		SweepPrune->Add_Object(newobj);
+	}
 }
 
 
@@ -522,6 +743,11 @@ void PhysicsSceneClass::Internal_Add_Static_Object(StaticPhysClass * newtile)
 	if (newtile->As_StaticAnimPhysClass() != NULL) {
 		StaticAnimList.Add(newtile);
 	}
+
+	// Cut up any shatterable meshes now rather than when they break
+	if (ShatterSystem::Is_Fragment_Cache_Enabled()) {
+		ShatterSystem::Precache_Render_Object(newtile->Peek_Model());
+	}
 }
 
 
@@ -665,6 +891,7 @@ void PhysicsSceneClass::Remove_Object(PhysClass * obj)
 
 	if (cullsys == DynamicCullingSystem) {
 
+		SweepPrune->Remove_Object(obj);
 		DynamicCullingSystem->Remove_Object(obj);
 		ObjList.Remove(obj);
 	
@@ -733,6 +960,11 @@ void PhysicsSceneClass::Remove_All(void)
 	}
 
 	Pathfinder->Reset_Sectors ();
+
+	/*
+	** The precached shatter fragments hold on to the level's models
+	*/
+	ShatterSystem::Flush_Fragment_Cache();
 }
 
 
@@ -1803,6 +2035,44 @@ void PhysicsSceneClass::Get_Level_Extents(Vector3 &min, Vector3 &max)
 }
 
 
+/***********************************************************************************************
+ * PhysicsSceneClass::Begin_Collision_Profile -- Start profiling the collision queries         *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * cell_size - size of the heatmap cells                                                       *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void PhysicsSceneClass::Begin_Collision_Profile(float cell_size)
+{
+	Vector3 min,max;
+	Get_Level_Extents(min,max);
+	_CollisionProfiler.Begin_Collecting(min,max,cell_size);
+}
+
+
+/***********************************************************************************************
+ * PhysicsSceneClass::End_Collision_Profile -- Stop profiling and write out the results        *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * filename - name of the report file                                                          *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void PhysicsSceneClass::End_Collision_Profile(const char * filename)
+{
+	_CollisionProfiler.End_Collecting(filename);
+}
+
+
 /***********************************************************************************************
  * PhysicsSceneClass::Set_Polygon_Budgets -- set the budgets for the LOD system                *
  *                                                                                             *
@@ -1875,6 +2145,16 @@ void PhysicsSceneClass::Per_Frame_Statistics_Update(void)
 		StaticCullingSystem->Reset_Statistics();
 		StaticLightingSystem->Reset_Statistics();
 
+		/*
+		** Collect the dynamic vis tree lookup stats
+		*/
+		const DynamicAABTreeCullClass::LookupStatsStruct & lookup_stats = DynamicObjVisSystem->Get_Lookup_Statistics();
+		CurrentStats.VisIDLookups = lookup_stats.Lookups;
+		CurrentStats.VisIDCoherentLookups = lookup_stats.CoherentLookups;
+		CurrentStats.VisIDNodesSearched = lookup_stats.NodesSearched;
+		CurrentStats.VisIDCoherentNodes = lookup_stats.CoherentNodeCount;
+		DynamicObjVisSystem->Reset_Lookup_Statistics();
+
 		/*
 		** Copy over LastValidStats, reset
 		*/
@@ -2122,6 +2402,10 @@ void PhysicsSceneClass::StatsStruct::Reset(void)
 	CullNodesAccepted = 0;
 	CullNodesTriviallyAccepted = 0;
 	CullNodesRejected = 0;
+	VisIDLookups = 0;
+	VisIDCoherentLookups = 0;
+	VisIDNodesSearched = 0;
+	VisIDCoherentNodes = 0;
 }
 
 
@@ -91,6 +91,8 @@ class PhysAABTreeCullClass;
 class StaticAABTreeCullClass;
 class	DynamicAABTreeCullClass;
 class PhysGridCullClass;
+class PhysIslandBuilderClass;
+class PhysSweepPruneClass;
 class StaticLightCullClass;
 
 // Lighting solver
@@ -640,18 +642,27 @@ public:
 	** Collision Detection Methods
 	** Set_Collision_Region - collects objects in the given region into a list for subsequent collision checks
 	**                        this is useful if you're going to do a lot of checks in the same general area (e.g. RigidBody)
+	**                        if obj is given and the sweep-and-prune broadphase is on, the dynamic objects come from
+	**                        obj's cached pairs rather than the culling grid
 	** Release_Collision_Region - releases the collision region list
 	** Cast_Ray - casts a ray into the world, returning information about what was collided and at what point along the ray
 	** Cast_AABox - casts an axis aligned box, returning information about what was collided and at what point
 	** Cast_OBBox - casts an oriented box, returning information about what was collided and at what point
 	** Intersection_Test - tests the given primitive for intersection with anything else in the system
+	** Cast_Ray_Batch, Cast_AABox_Batch - casts many rays or boxes at once, sharing a single traversal of
+	**                        the static culling tree.  results[i] gets what the single cast would have returned
+	**                        for test i and each test's result struct is filled in identically.  Returns the
+	**                        number of tests that hit something.
 	*/
-	void Set_Collision_Region(const AABoxClass & bounds,int colgroup);
+	void Set_Collision_Region(const AABoxClass & bounds,int colgroup,PhysClass * obj = NULL);
 	void Release_Collision_Region(void);
 
 	bool Cast_Ray(PhysRayCollisionTestClass & raytest,bool use_collision_region = false);
 	bool Cast_AABox(PhysAABoxCollisionTestClass & boxtest,bool use_collision_region = false);
 	bool Cast_OBBox(PhysOBBoxCollisionTestClass & boxtest,bool use_collision_region = false);
+
+	int  Cast_Ray_Batch(PhysRayCollisionTestClass ** raytests,bool * results,int count);
+	int  Cast_AABox_Batch(PhysAABoxCollisionTestClass ** boxtests,bool * results,int count);
 	
 	bool Intersection_Test(PhysAABoxIntersectionTestClass & boxtest,bool use_collision_region = false);
 	bool Intersection_Test(PhysOBBoxIntersectionTestClass & boxtest,bool use_collision_region = false);
@@ -943,6 +954,29 @@ public:
 	void							Set_Update_Only_Visible_Objects(bool b) { UpdateOnlyVisibleObjects=b; }
 	bool							Get_Update_Only_Visible_Objects() { return UpdateOnlyVisibleObjects; }
 
+	/*
+	** Island time-stepping.  When enabled, the simulating objects are split into
+	** independent islands each frame (see PhysIslandBuilderClass) and each island
+	** is stepped through the whole frame before moving on to the next one.
+	*/
+	void							Enable_Island_Timestep(bool onoff) { IslandTimestepEnabled=onoff; }
+	bool							Is_Island_Timestep_Enabled(void) { return IslandTimestepEnabled; }
+	int							Get_Island_Count(void);
+	int							Get_Largest_Island_Size(void);
+
+	/*
+	** Sweep-and-prune broadphase.  When enabled, the dynamic objects are also tracked
+	** by a PhysSweepPruneClass which keeps the pairs of objects that are close to each
+	** other up to date as they move.  Collision regions set up around a tracked object
+	** take their dynamic objects from its pairs instead of querying the culling grid.
+	** The broadphase is rebuilt after a level's dynamic data is loaded since loading
+	** doesn't report cull box changes.
+	*/
+	void							Enable_Sweep_Prune(bool onoff);
+	bool							Is_Sweep_Prune_Enabled(void) { return SweepPruneEnabled; }
+	int							Get_Sweep_Prune_Pair_Count(void);
+	int							Get_Sweep_Prune_Refit_Count(void);
+
 	/*
 	** Scene Class methods.  These should *only* be used when absolutely necessary since
 	** it is more efficient to operate through the physics interface (I can keep track
@@ -994,12 +1028,25 @@ public:
 		int	CullNodesTriviallyAccepted;
 		int	CullNodesRejected;
 
+		int	VisIDLookups;
+		int	VisIDCoherentLookups;
+		int	VisIDNodesSearched;
+		int	VisIDCoherentNodes;
+
 	};
 
 	void							Per_Frame_Statistics_Update(void);
 	const StatsStruct &		Get_Statistics(void);
 	float							Compute_Vis_Mesh_Ram(void);
 
+	/*
+	** Collision query profiling.  Records every Cast_Ray, Cast_AABox, Cast_OBBox, batched 
+	** cast and Intersection_Test call made on the calling thread into a grid over the level extents (see CollisionProfilerClass) 
+	** until End_Collision_Profile writes the results to the given file.
+	*/
+	void							Begin_Collision_Profile(float cell_size);
+	void							End_Collision_Profile(const char * filename);
+
 protected:
 	
 	/*
@@ -1059,6 +1106,9 @@ protected:
 	** Misc
 	*/
 	void							Internal_Add_Dynamic_Object(PhysClass * newobj);
+	bool							Should_Timestep(PhysClass * obj);
+	void							Timestep_Island(int island,float dt);
+	void							Rebuild_Sweep_Prune(void);
 	void							Internal_Add_Static_Object(StaticPhysClass * newtile);
 	void							Internal_Add_Static_Light(LightPhysClass * newlight);
 
@@ -1066,6 +1116,15 @@ protected:
 	void							Load_Sun_Light(ChunkLoadClass & cload);
 	void							Save_Sun_Light(ChunkSaveClass & csave);
 
+	bool							Internal_Cast_Ray(PhysRayCollisionTestClass & raytest,bool use_collision_region);
+	bool							Internal_Cast_AABox(PhysAABoxCollisionTestClass & boxtest,bool use_collision_region);
+	int							Internal_Cast_Ray_Batch(PhysRayCollisionTestClass ** raytests,bool * results,int count);
+	int							Internal_Cast_AABox_Batch(PhysAABoxCollisionTestClass ** boxtests,bool * results,int count);
+	bool							Internal_Cast_OBBox(PhysOBBoxCollisionTestClass & boxtest,bool use_collision_region);
+	bool							Internal_Intersection_Test(PhysAABoxIntersectionTestClass & boxtest,bool use_collision_region);
+	bool							Internal_Intersection_Test(PhysOBBoxIntersectionTestClass & boxtest,bool use_collision_region);
+	bool							Internal_Intersection_Test(PhysMeshIntersectionTestClass & meshtest,bool use_collision_region);
+
 	void							Add_Collected_Objects_To_List(bool static_objs,bool dynamic_objs,NonRefPhysListClass * list);
 	void							Add_Collected_Collideable_Objects_To_List(int colgroup,bool static_objs,bool dynamic_objs,NonRefPhysListClass * list);
 	void							Add_Collected_Lights_To_List(bool static_lights,bool dynamic_lights,NonRefPhysListClass * list);
@@ -1253,6 +1312,12 @@ protected:
 	bool							UpdateOnlyVisibleObjects;
 	unsigned						CurrentFrameNumber;
 
+	PhysIslandBuilderClass *	IslandBuilder;
+	bool							IslandTimestepEnabled;
+
+	PhysSweepPruneClass *	SweepPrune;
+	bool							SweepPruneEnabled;
+
 private:
 	
 	/*
@@ -1279,4 +1344,4 @@ private:
 
 	
 
-#endif
\ No newline at end of file
+#endif
\ No newline at end of file
@@ -43,8 +43,12 @@
 #include "staticaabtreecull.h"
 #include "dynamicaabtreecull.h"
 #include "physgridcull.h"
+#include "physsweepprune.h"
 #include "lightcull.h"
 #include "staticphys.h"
+#include "wwprofile.h"
+#include "collisionprofiler.h"
+#include "framearena.h"
 
 
 
@@ -120,9 +124,31 @@ void PhysicsSceneClass::Disable_All_Collision_Detections(int group)
 	}
 }
 
-void PhysicsSceneClass::Set_Collision_Region(const AABoxClass & bounds,int colgroup)
+void PhysicsSceneClass::Set_Collision_Region(const AABoxClass & bounds,int colgroup,PhysClass * obj)
 {
-	Collect_Collideable_Objects(bounds,colgroup,true,true,&CollisionRegionList);
+	if (SweepPruneEnabled && (obj != NULL) && SweepPrune->Is_Tracking(obj)) {
+
+		/*
+		** Static objects from the culling tree, dynamic objects from the broadphase
+		*/
+		Collect_Collideable_Objects(bounds,colgroup,true,false,&CollisionRegionList);
+
+		NonRefPhysListClass dynamic_list;
+		SweepPrune->Collect_Overlapping_Objects(obj,bounds,&dynamic_list);
+
+		NonRefPhysListIterator it(&dynamic_list);
+		for ( ; !it.Is_Done(); it.Next()) {
+			PhysClass * other = it.Peek_Obj();
+			if (	Do_Groups_Collide(other->Get_Collision_Group(),colgroup) && 
+					!other->Is_Ignore_Me()	) 
+			{
+				CollisionRegionList.Add(other);
+			}
+		}
+
+	} else {
+		Collect_Collideable_Objects(bounds,colgroup,true,true,&CollisionRegionList);
+	}
 }
 
 void PhysicsSceneClass::Release_Collision_Region(void)
@@ -131,6 +157,22 @@ void PhysicsSceneClass::Release_Collision_Region(void)
 }
 
 bool PhysicsSceneClass::Cast_Ray(PhysRayCollisionTestClass & raytest,bool use_collision_region)
+{
+	if (!_CollisionProfiler.Begin_Query()) {
+		return Internal_Cast_Ray(raytest,use_collision_region);
+	}
+
+	bool res;
+	float time = 0.0f;
+	{
+		WWMeasureItClass measure(&time);
+		res = Internal_Cast_Ray(raytest,use_collision_region);
+	}
+	_CollisionProfiler.End_Query(CollisionProfilerClass::QUERY_RAY,raytest.CollisionGroup,raytest.Ray.Get_P0(),time);
+	return res;
+}
+
+bool PhysicsSceneClass::Internal_Cast_Ray(PhysRayCollisionTestClass & raytest,bool use_collision_region)
 {
 	/*
 	** Assert that the result structure has been initialized with the 
@@ -184,6 +226,22 @@ bool PhysicsSceneClass::Cast_Ray(PhysRayCollisionTestClass & raytest,bool use_co
 }
 
 bool PhysicsSceneClass::Cast_AABox(PhysAABoxCollisionTestClass & boxtest,bool use_collision_region)
+{
+	if (!_CollisionProfiler.Begin_Query()) {
+		return Internal_Cast_AABox(boxtest,use_collision_region);
+	}
+
+	bool res;
+	float time = 0.0f;
+	{
+		WWMeasureItClass measure(&time);
+		res = Internal_Cast_AABox(boxtest,use_collision_region);
+	}
+	_CollisionProfiler.End_Query(CollisionProfilerClass::QUERY_AABOX,boxtest.CollisionGroup,boxtest.Box.Center,time);
+	return res;
+}
+
+bool PhysicsSceneClass::Internal_Cast_AABox(PhysAABoxCollisionTestClass & boxtest,bool use_collision_region)
 {
 	/*
 	** Assert that the result structure has been initialized with the 
@@ -235,7 +293,169 @@ bool PhysicsSceneClass::Cast_AABox(PhysAABoxCollisionTestClass & boxtest,bool us
 	return res;
 }
 
+int PhysicsSceneClass::Cast_Ray_Batch(PhysRayCollisionTestClass ** raytests,bool * results,int count)
+{
+	if ((count <= 0) || !_CollisionProfiler.Begin_Query()) {
+		return Internal_Cast_Ray_Batch(raytests,results,count);
+	}
+
+	int res;
+	float time = 0.0f;
+	{
+		WWMeasureItClass measure(&time);
+		res = Internal_Cast_Ray_Batch(raytests,results,count);
+	}
+	for (int i=0; i<count; i++) {
+		_CollisionProfiler.End_Query(CollisionProfilerClass::QUERY_RAY,raytests[i]->CollisionGroup,raytests[i]->Ray.Get_P0(),time,count);
+	}
+	return res;
+}
+
+int PhysicsSceneClass::Internal_Cast_Ray_Batch(PhysRayCollisionTestClass ** raytests,bool * results,int count)
+{
+	WWPROFILE("Cast_Ray_Batch");
+
+	/*
+	** Same initial conditions as Cast_Ray for every test.  Gather the tests that
+	** want the static objects so they can all go through the static tree together.
+	*/
+	FrameDynamicVectorClass<PhysRayCollisionTestClass *> static_tests(count);
+	int i;
+	for (i=0; i<count; i++) {
+		assert(raytests[i]->Result->Fraction == 1.0f);
+		assert(raytests[i]->Result->StartBad == false);
+		raytests[i]->CollidedPhysObj = NULL;
+		results[i] = false;
+		if (raytests[i]->CheckStaticObjs) {
+			static_tests.Add(raytests[i]);
+		}
+	}
+
+	if (static_tests.Count() > 0) {
+		FrameDynamicVectorClass<bool> static_results(static_tests.Count());
+		for (i=0; i<static_tests.Count(); i++) {
+			static_results.Add(false);
+		}
+		StaticCullingSystem->Cast_Ray_Batch(&(static_tests[0]),&(static_results[0]),static_tests.Count());
+
+		int static_index = 0;
+		for (i=0; i<count; i++) {
+			if (raytests[i]->CheckStaticObjs) {
+				results[i] = static_results[static_index++];
+			}
+		}
+	}
+
+	/*
+	** The dynamic objects live in a grid, each remaining test is cast on its own
+	*/
+	int hit_count = 0;
+	for (i=0; i<count; i++) {
+		if (raytests[i]->Result->StartBad) {
+			results[i] = true;
+		} else if (raytests[i]->CheckDynamicObjs) {
+			results[i] |= DynamicCullingSystem->Cast_Ray(*raytests[i]);
+			if (raytests[i]->Result->StartBad) {
+				results[i] = true;
+			}
+		}
+		if (results[i]) {
+			hit_count++;
+		}
+	}
+	return hit_count;
+}
+
+int PhysicsSceneClass::Cast_AABox_Batch(PhysAABoxCollisionTestClass ** boxtests,bool * results,int count)
+{
+	if ((count <= 0) || !_CollisionProfiler.Begin_Query()) {
+		return Internal_Cast_AABox_Batch(boxtests,results,count);
+	}
+
+	int res;
+	float time = 0.0f;
+	{
+		WWMeasureItClass measure(&time);
+		res = Internal_Cast_AABox_Batch(boxtests,results,count);
+	}
+	for (int i=0; i<count; i++) {
+		_CollisionProfiler.End_Query(CollisionProfilerClass::QUERY_AABOX,boxtests[i]->CollisionGroup,boxtests[i]->Box.Center,time,count);
+	}
+	return res;
+}
+
+int PhysicsSceneClass::Internal_Cast_AABox_Batch(PhysAABoxCollisionTestClass ** boxtests,bool * results,int count)
+{
+	WWPROFILE("Cast_AABox_Batch");
+
+	/*
+	** Same initial conditions as Cast_AABox for every test.  Gather the tests that
+	** want the static objects so they can all go through the static tree together.
+	*/
+	FrameDynamicVectorClass<PhysAABoxCollisionTestClass *> static_tests(count);
+	int i;
+	for (i=0; i<count; i++) {
+		WWASSERT(boxtests[i]->Result->Fraction == 1.0f);
+		WWASSERT(boxtests[i]->Result->StartBad == false);
+		boxtests[i]->CollidedPhysObj = NULL;
+		results[i] = false;
+		if (boxtests[i]->CheckStaticObjs) {
+			static_tests.Add(boxtests[i]);
+		}
+	}
+
+	if (static_tests.Count() > 0) {
+		FrameDynamicVectorClass<bool> static_results(static_tests.Count());
+		for (i=0; i<static_tests.Count(); i++) {
+			static_results.Add(false);
+		}
+		StaticCullingSystem->Cast_AABox_Batch(&(static_tests[0]),&(static_results[0]),static_tests.Count());
+
+		int static_index = 0;
+		for (i=0; i<count; i++) {
+			if (boxtests[i]->CheckStaticObjs) {
+				results[i] = static_results[static_index++];
+			}
+		}
+	}
+
+	/*
+	** The dynamic objects live in a grid, each remaining test is cast on its own
+	*/
+	int hit_count = 0;
+	for (i=0; i<count; i++) {
+		if (boxtests[i]->Result->StartBad) {
+			results[i] = true;
+		} else if (boxtests[i]->CheckDynamicObjs) {
+			results[i] |= DynamicCullingSystem->Cast_AABox(*boxtests[i]);
+			if (boxtests[i]->Result->StartBad) {
+				results[i] = true;
+			}
+		}
+		if (results[i]) {
+			hit_count++;
+		}
+	}
+	return hit_count;
+}
+
 bool PhysicsSceneClass::Cast_OBBox(PhysOBBoxCollisionTestClass & boxtest,bool use_collision_region)
+{
+	if (!_CollisionProfiler.Begin_Query()) {
+		return Internal_Cast_OBBox(boxtest,use_collision_region);
+	}
+
+	bool res;
+	float time = 0.0f;
+	{
+		WWMeasureItClass measure(&time);
+		res = Internal_Cast_OBBox(boxtest,use_collision_region);
+	}
+	_CollisionProfiler.End_Query(CollisionProfilerClass::QUERY_OBBOX,boxtest.CollisionGroup,boxtest.Box.Center,time);
+	return res;
+}
+
+bool PhysicsSceneClass::Internal_Cast_OBBox(PhysOBBoxCollisionTestClass & boxtest,bool use_collision_region)
 {
 	/*
 	** Assert that the result structure has been initialized with the 
@@ -288,6 +508,22 @@ bool PhysicsSceneClass::Cast_OBBox(PhysOBBoxCollisionTestClass & boxtest,bool us
 }
 
 bool PhysicsSceneClass::Intersection_Test(PhysAABoxIntersectionTestClass & boxtest,bool use_collision_region)
+{
+	if (!_CollisionProfiler.Begin_Query()) {
+		return Internal_Intersection_Test(boxtest,use_collision_region);
+	}
+
+	bool res;
+	float time = 0.0f;
+	{
+		WWMeasureItClass measure(&time);
+		res = Internal_Intersection_Test(boxtest,use_collision_region);
+	}
+	_CollisionProfiler.End_Query(CollisionProfilerClass::QUERY_INTERSECTION,boxtest.CollisionGroup,boxtest.Box.Center,time);
+	return res;
+}
+
+bool PhysicsSceneClass::Internal_Intersection_Test(PhysAABoxIntersectionTestClass & boxtest,bool use_collision_region)
 {
 	if (use_collision_region) {
 	
@@ -328,6 +564,22 @@ bool PhysicsSceneClass::Intersection_Test(PhysAABoxIntersectionTestClass & boxte
 }
 
 bool PhysicsSceneClass::Intersection_Test(PhysOBBoxIntersectionTestClass & boxtest,bool use_collision_region)
+{
+	if (!_CollisionProfiler.Begin_Query()) {
+		return Internal_Intersection_Test(boxtest,use_collision_region);
+	}
+
+	bool res;
+	float time = 0.0f;
+	{
+		WWMeasureItClass measure(&time);
+		res = Internal_Intersection_Test(boxtest,use_collision_region);
+	}
+	_CollisionProfiler.End_Query(CollisionProfilerClass::QUERY_INTERSECTION,boxtest.CollisionGroup,boxtest.Box.Center,time);
+	return res;
+}
+
+bool PhysicsSceneClass::Internal_Intersection_Test(PhysOBBoxIntersectionTestClass & boxtest,bool use_collision_region)
 {
 	if (use_collision_region) {
 		
@@ -366,6 +618,22 @@ bool PhysicsSceneClass::Intersection_Test(PhysOBBoxIntersectionTestClass & boxte
 }
 
 bool PhysicsSceneClass::Intersection_Test(PhysMeshIntersectionTestClass & meshtest,bool use_collision_region)
+{
+	if (!_CollisionProfiler.Begin_Query()) {
+		return Internal_Intersection_Test(meshtest,use_collision_region);
+	}
+
+	bool res;
+	float time = 0.0f;
+	{
+		WWMeasureItClass measure(&time);
+		res = Internal_Intersection_Test(meshtest,use_collision_region);
+	}
+	_CollisionProfiler.End_Query(CollisionProfilerClass::QUERY_INTERSECTION,meshtest.CollisionGroup,meshtest.BoundingBox.Center,time);
+	return res;
+}
+
+bool PhysicsSceneClass::Internal_Intersection_Test(PhysMeshIntersectionTestClass & meshtest,bool use_collision_region)
 {
 	if (use_collision_region) {
 		
@@ -713,6 +713,11 @@ void PhysicsSceneClass::Post_Load_Level_Dynamic_Data(void)
 	// We don't necessarily have active device at this point so we can't render the shadows yet.
 	// The shadows will be generated as soon as the device is available at the start of the game.
 	Invalidate_Static_Shadow_Projectors();
+
+	/*
+	** Loading doesn't tell the broadphase about the objects' final cull boxes
+	*/
+	Rebuild_Sweep_Prune();
 }
 
 StaticPhysClass * PhysicsSceneClass::Get_Static_Object_By_ID(uint32 id)
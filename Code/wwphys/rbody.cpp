@@ -49,6 +49,7 @@
 #include "wwphysids.h"
 #include "wwhack.h"
 #include "wwprofile.h"
+#include "collisionprofiler.h"
 #include "hlod.h"
 #include "physcontrol.h"
 #include "phys3.h"
@@ -1100,18 +1101,45 @@ int RigidBodyClass::Compute_Derivatives
 	}
 #endif
 
+	RigidBodyDerivativeStruct derivs;
+	Compute_Derivatives(&derivs);
+
 	// time derivitive of position
-	(*dydt)[index++] = Velocity[0];
-	(*dydt)[index++] = Velocity[1];
-	(*dydt)[index++] = Velocity[2];
+	(*dydt)[index++] = derivs.Velocity[0];
+	(*dydt)[index++] = derivs.Velocity[1];
+	(*dydt)[index++] = derivs.Velocity[2];
+
+	// time derivitive of orientation
+	(*dydt)[index++] = derivs.Spin[0];
+	(*dydt)[index++] = derivs.Spin[1];
+	(*dydt)[index++] = derivs.Spin[2];
+	(*dydt)[index++] = derivs.Spin[3];
+
+	// time derivitives of momentum and angular momentum (a.k.a. force and torque)
+	(*dydt)[index++] = derivs.Force[0];
+	(*dydt)[index++] = derivs.Force[1];
+	(*dydt)[index++] = derivs.Force[2];
+
+	(*dydt)[index++] = derivs.Torque[0];
+	(*dydt)[index++] = derivs.Torque[1];
+	(*dydt)[index++] = derivs.Torque[2];
+	
+#if RBODY_DEBUGGING
+	if (RBODY_DEBUG_FILTER) {
+		WWDEBUG_SAY(("  done. \r\n\r\n"));
+	}
+#endif
+	return index;
+}
+
+void RigidBodyClass::Compute_Derivatives(RigidBodyDerivativeStruct * set_derivs)
+{
+	// time derivitive of position
+	set_derivs->Velocity = Velocity;
 
 	// time derivitive of orientation
 	Quaternion avel(AngularVelocity.X,AngularVelocity.Y,AngularVelocity.Z,0.0f);
-	Quaternion qdot = 0.5 * avel * State.Orientation;
-	(*dydt)[index++] = qdot[0];
-	(*dydt)[index++] = qdot[1];
-	(*dydt)[index++] = qdot[2];
-	(*dydt)[index++] = qdot[3];
+	set_derivs->Spin = 0.5 * avel * State.Orientation;
 
 	// time derivitives of momentum and angular momentum (a.k.a. force and torque)
 	Vector3 force(0,0,0);
@@ -1126,21 +1154,9 @@ int RigidBodyClass::Compute_Derivatives
 		WWDEBUG_SAY(("Torque:	%10.10f , %10.10f , %10.10f\r\n",torque[0],torque[1],torque[2]));
 	}
 #endif
-	
-	(*dydt)[index++] = force[0];
-	(*dydt)[index++] = force[1];
-	(*dydt)[index++] = force[2];
 
-	(*dydt)[index++] = torque[0];
-	(*dydt)[index++] = torque[1];
-	(*dydt)[index++] = torque[2];
-	
-#if RBODY_DEBUGGING
-	if (RBODY_DEBUG_FILTER) {
-		WWDEBUG_SAY(("  done. \r\n\r\n"));
-	}
-#endif
-	return index;
+	set_derivs->Force = force;
+	set_derivs->Torque = torque;
 }
 
 void RigidBodyClass::Get_State(StateVectorClass & set_state)
@@ -1166,9 +1182,13 @@ void RigidBodyClass::Integrate(float time)
 {
 	Assert_State_Valid();
 
-	//IntegrationSystem::Euler_Integrate(this,time);
-	IntegrationSystem::Midpoint_Integrate(this,time);
-	//IntegrationSystem::Runge_Kutta_Integrate(this,time);
+	if (Use_Direct_Integrator()) {
+		Direct_Midpoint_Integrate(time);
+	} else {
+		//IntegrationSystem::Euler_Integrate(this,time);
+		IntegrationSystem::Midpoint_Integrate(this,time);
+		//IntegrationSystem::Runge_Kutta_Integrate(this,time);
+	}
 
 	// normalize the orientation since it slowly drifts due to integrator error
 	State.Orientation.Normalize();
@@ -1177,6 +1197,55 @@ void RigidBodyClass::Integrate(float time)
 	Assert_State_Valid();
 }
 
+/*
+** Helper for the direct integrator, res = y0 + dt * dydt / divisor.  The arithmetic is
+** done a component at a time in the same order as IntegrationSystem::Midpoint_Integrate
+** so both integrators give identical results.
+*/
+static inline void Advance_State
+(
+	const RigidBodyStateStruct &			y0,
+	const RigidBodyDerivativeStruct &	dydt,
+	float											dt,
+	float											divisor,
+	RigidBodyStateStruct *					res
+)
+{
+	int i;
+	for (i=0; i<3; i++) {
+		res->Position[i] = y0.Position[i] + dt * dydt.Velocity[i] / divisor;
+	}
+	for (i=0; i<4; i++) {
+		res->Orientation[i] = y0.Orientation[i] + dt * dydt.Spin[i] / divisor;
+	}
+	for (i=0; i<3; i++) {
+		res->LMomentum[i] = y0.LMomentum[i] + dt * dydt.Force[i] / divisor;
+	}
+	for (i=0; i<3; i++) {
+		res->AMomentum[i] = y0.AMomentum[i] + dt * dydt.Torque[i] / divisor;
+	}
+}
+
+void RigidBodyClass::Direct_Midpoint_Integrate(float time)
+{
+	/*
+	** Same midpoint method as IntegrationSystem::Midpoint_Integrate but working directly
+	** on our state rather than packing it into StateVectorClass's and going through the
+	** virtual ODESystemClass interface for every step.
+	*/
+	RigidBodyStateStruct y0 = State;
+	RigidBodyStateStruct ynext;
+	RigidBodyDerivativeStruct dydt;
+
+	Compute_Derivatives(&dydt);
+	Advance_State(y0,dydt,time,2.0f,&ynext);
+	Set_State(ynext);
+
+	Compute_Derivatives(&dydt);
+	Advance_State(y0,dydt,time,1.0f,&ynext);
+	Set_State(ynext);
+}
+
 void RigidBodyClass::Compute_Inertia(void)
 {
 	// I'm assuming that the CM is at the origin and the principal axes of inertia
@@ -1471,14 +1540,14 @@ void RigidBodyClass::Set_Moving_Collision_Region(float dt)
 	// Now, scale to account for any rotational effects
 	region.Extent *= 2.0f;
 
-	PhysicsSceneClass::Get_Instance()->Set_Collision_Region(region,Get_Collision_Group());
+	PhysicsSceneClass::Get_Instance()->Set_Collision_Region(region,Get_Collision_Group(),this);
 }
 
 void RigidBodyClass::Set_Stationary_Collision_Region(void)
 {
 	AABoxClass region;
 	ContactBox->Get_Outer_Bounds(&region);		// start with bounds of collision box
-	PhysicsSceneClass::Get_Instance()->Set_Collision_Region(region,Get_Collision_Group());
+	PhysicsSceneClass::Get_Instance()->Set_Collision_Region(region,Get_Collision_Group(),this);
 }
 
 
@@ -1589,6 +1658,7 @@ inline void RigidBodyClass::Dump_State(void) const
 void RigidBodyClass::Timestep(float dt)
 {	
 	WWPROFILE("RigidBody::Timestep");
+	COLLISION_PROFILE_CATEGORY("Rigid Bodies");
 	LastTimestep = dt;
 
 // DEBUG DEBUG
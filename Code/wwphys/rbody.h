@@ -61,6 +61,20 @@ struct RigidBodyStateStruct
 };
 
 
+/**
+** RigidBodyDerivativeStruct
+** Time derivative of a RigidBodyStateStruct.  The direct integrator in RigidBodyClass
+** works with these instead of going through StateVectorClass.
+*/
+struct RigidBodyDerivativeStruct
+{
+	Vector3			Velocity;
+	Quaternion		Spin;
+	Vector3			Force;
+	Vector3			Torque;
+};
+
+
 /** 
 ** RigidBodyClass
 ** Simulation of a rigid body.  The shape is limited to be an oriented box.
@@ -166,8 +180,17 @@ protected:
 	virtual int						Set_State(const StateVectorClass & new_state,int start_index);
 	void								Set_State(const RigidBodyStateStruct & new_state);
 	virtual int						Compute_Derivatives(float t,StateVectorClass * test_state,StateVectorClass * set_derivs,int start_index);
+	void								Compute_Derivatives(RigidBodyDerivativeStruct * set_derivs);
 
 	void								Integrate(float time);
+	void								Direct_Midpoint_Integrate(float time);
+
+	/*
+	** Bodies which extend the integrator (e.g. vehicles, whose engine state is updated from
+	** Set_State and which have their own force models) return false and are integrated 
+	** through the ODESystemClass interface.
+	*/
+	virtual bool					Use_Direct_Integrator(void)				{ return true; }
 
 	/*
 	** Internal functions
@@ -358,4 +381,4 @@ protected:
 };
 
 
-#endif
\ No newline at end of file
+#endif
\ No newline at end of file
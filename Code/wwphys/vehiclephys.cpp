@@ -47,6 +47,9 @@
 #include "pscene.h"
 #include "wwprofile.h"
 #include "vehicledazzle.h"
+#include "physcoltest.h"
+#include "lineseg.h"
+#include "collisionprofiler.h"
 
 // Vehicles will sit rolled over for this long before exploding!
 const float		EXPIRE_SECONDS								= 4.0f;
@@ -58,6 +61,46 @@ const float		PARKING_BRAKE_DAMPING					= 0.5f;
 const int		MAX_CAPTURED_BONE_COUNT					= 4;
 const char *	ENGINE_FLAME_BONE_NAME					= "ENGINEFLAME";
 
+// max number of suspension rays cast in one batch
+const int		MAX_SPRING_BATCH							= 16;
+
+
+/*
+** One suspension ray in a batch, see VehiclePhysClass::Intersect_Springs
+*/
+class SpringRayClass
+{
+public:
+	SpringRayClass(void) :
+		Test(LineSegClass(Vector3(0,0,0),Vector3(0,0,-1)),&Result,0,COLLISION_TYPE_PHYSICAL | COLLISION_TYPE_VEHICLE),
+		Wheel(NULL)
+	{
+	}
+
+	CastResultStruct					Result;
+	PhysRayCollisionTestClass		Test;
+	SuspensionElementClass *		Wheel;
+};
+
+static void Cast_Spring_Batch(SpringRayClass * rays,int count)
+{
+	COLLISION_PROFILE_CATEGORY("Wheels");
+
+	PhysRayCollisionTestClass * raytests[MAX_SPRING_BATCH];
+	bool hits[MAX_SPRING_BATCH];
+
+	int i;
+	for (i=0; i<count; i++) {
+		raytests[i] = &(rays[i].Test);
+	}
+
+	PhysicsSceneClass::Get_Instance()->Cast_Ray_Batch(raytests,hits,count);
+
+	for (i=0; i<count; i++) {
+		rays[i].Wheel->End_Intersect_Spring(rays[i].Test.Ray,rays[i].Result);
+	}
+}
+
 // Wheel parsing constants...
 const char *	WHEELP_BONE_NAME							= "WheelP";		// Position bone (contact patch)
 const char *	WHEELC_BONE_NAME							= "WheelC";		// Center bone (rotational center of the wheel)
@@ -307,6 +350,11 @@ void VehiclePhysClass::Compute_Force_And_Torque(Vector3 * force,Vector3 * torque
 	{
 		WWPROFILE("VehiclePhysClass::Compute_Force_And_Torque");
 		
+		/*
+		** Cast all of the suspension rays together
+		*/
+		Intersect_Springs();
+
 		/*
 		** Compute forces and torques for each wheel.
 		*/
@@ -333,6 +381,45 @@ void VehiclePhysClass::Compute_Force_And_Torque(Vector3 * force,Vector3 * torque
 	RigidBodyClass::Compute_Force_And_Torque(force,torque);
 }
 
+void VehiclePhysClass::Intersect_Springs(void)
+{
+	WWPROFILE("Intersect_Springs");
+
+	/*
+	** Gather the spring rays of every real wheel and cast them through the scene
+	** as a batch.  Each wheel is flagged so that its Compute_Force_And_Torque
+	** uses this result rather than casting its spring again.  Nothing the wheels
+	** do while computing their forces moves the vehicle, so these are the same
+	** rays they would have cast themselves.
+	*/
+	SpringRayClass rays[MAX_SPRING_BATCH];
+	int count = 0;
+
+	for (int iwheel = 0; iwheel<Wheels.Length(); iwheel++) {
+		SuspensionElementClass * wheel = Wheels[iwheel];
+		if (wheel->Get_Flag(SuspensionElementClass::FAKE)) {
+			continue;
+		}
+
+		if (count == MAX_SPRING_BATCH) {
+			Cast_Spring_Batch(rays,count);
+			count = 0;
+		}
+
+		wheel->Set_Flag(SuspensionElementClass::SPRING_CAST,true);
+		if (wheel->Begin_Intersect_Spring(&(rays[count].Test.Ray))) {
+			rays[count].Wheel = wheel;
+			rays[count].Test.CollisionGroup = Get_Collision_Group();
+			rays[count].Result.Reset();
+			count++;
+		}
+	}
+
+	if (count > 0) {
+		Cast_Spring_Batch(rays,count);
+	}
+}
+
 bool VehiclePhysClass::Can_Go_To_Sleep(float dt)
 {
 	/*
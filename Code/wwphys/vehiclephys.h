@@ -133,6 +133,8 @@ protected:
 	*/
 	virtual void						Compute_Force_And_Torque(Vector3 * force,Vector3 * torque);
 	virtual bool						Can_Go_To_Sleep(float dt);
+	virtual bool						Use_Direct_Integrator(void)				{ return false; }
+	void									Intersect_Springs(void);
 
 	/*
 	** Suspension initialization
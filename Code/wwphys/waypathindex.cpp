@@ -0,0 +1,482 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/***********************************************************************************************
+ ***              C O N F I D E N T I A L  ---  W E S T W O O D  S T U D I O S               ***
+ ***********************************************************************************************
+ *                                                                                             *
+ *                 Project Name : wwphys																		  *
+ *                                                                                             *
+ *                     $Archive:: /Commando/Code/wwphys/waypathindex.cpp                      $*
+ *                                                                                             *
+ *---------------------------------------------------------------------------------------------*
+ * Functions:                                                                                  *
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+#include "waypathindex.h"
+#include "waypath.h"
+#include "waypoint.h"
+#include "colmath.h"
+#include <stdlib.h>
+
+
+///////////////////////////////////////////////////////////////////////////
+//	Constants
+///////////////////////////////////////////////////////////////////////////
+const float	INITIAL_NEAREST_RADIUS	= 10.0F;
+
+
+///////////////////////////////////////////////////////////////////////////
+//	Local prototypes
+///////////////////////////////////////////////////////////////////////////
+static int __cdecl	fnCompareProxySequenceCallback (const void *elem1, const void *elem2);
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	WaypathIndexClass
+//
+///////////////////////////////////////////////////////////////////////////
+WaypathIndexClass::WaypathIndexClass (void)	:
+	m_NextSequence (0),
+	m_IsDirty (false),
+	m_IsStartCacheValid (false)
+{
+	m_StartProxyList.Set_Growth_Step (10);
+	m_PathProxyList.Set_Growth_Step (10);
+	return ;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	~WaypathIndexClass
+//
+///////////////////////////////////////////////////////////////////////////
+WaypathIndexClass::~WaypathIndexClass (void)
+{
+	Reset ();
+	return ;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Add
+//
+///////////////////////////////////////////////////////////////////////////
+void
+WaypathIndexClass::Add (WaypathClass *waypath)
+{
+	if (waypath == NULL) {
+		return ;
+	}
+
+	Invalidate_Cache ();
+
+	int sequence = m_NextSequence ++;
+	m_IDTable.Insert (waypath->Get_ID (), waypath);
+
+	//
+	//	Waypaths without any points can still be found by ID,
+	// but there is nothing to put in the trees.
+	//
+	int point_count = waypath->Get_Point_Count ();
+	if (point_count == 0) {
+		return ;
+	}
+
+	//
+	//	Index the start point
+	//
+	const Vector3 &start_pos = waypath->Get_Point (0)->Get_Position ();
+	WaypathCullableClass *start_proxy = new WaypathCullableClass (waypath, sequence);
+	start_proxy->Set_Cull_Box (AABoxClass (start_pos, Vector3 (0, 0, 0)));
+	m_StartTree.Add_Object (start_proxy);
+	m_StartProxyList.Add (start_proxy);
+
+	//
+	//	Index the whole path
+	//
+	AABoxClass path_box (start_pos, Vector3 (0, 0, 0));
+	for (int index = 1; index < point_count; index ++) {
+		path_box.Add_Point (waypath->Get_Point (index)->Get_Position ());
+	}
+
+	WaypathCullableClass *path_proxy = new WaypathCullableClass (waypath, sequence);
+	path_proxy->Set_Cull_Box (path_box);
+	m_PathTree.Add_Object (path_proxy);
+	m_PathProxyList.Add (path_proxy);
+
+	m_IsDirty = true;
+	return ;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Remove
+//
+///////////////////////////////////////////////////////////////////////////
+void
+WaypathIndexClass::Remove (WaypathClass *waypath)
+{
+	if (waypath == NULL) {
+		return ;
+	}
+
+	Invalidate_Cache ();
+
+	m_IDTable.Remove (waypath->Get_ID (), waypath);
+	Remove_Proxy (m_StartTree, m_StartProxyList, waypath);
+	Remove_Proxy (m_PathTree, m_PathProxyList, waypath);
+	return ;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Remove_Proxy
+//
+///////////////////////////////////////////////////////////////////////////
+void
+WaypathIndexClass::Remove_Proxy
+(
+	WAYPATH_TREE &	tree,
+	PROXY_LIST &	proxy_list,
+	WaypathClass *	waypath
+)
+{
+	int index = proxy_list.Count ();
+	while (index --) {
+		WaypathCullableClass *proxy = proxy_list[index];
+		if (proxy->Peek_Waypath () == waypath) {
+			tree.Remove_Object (proxy);
+			proxy_list.Delete (index);
+			REF_PTR_RELEASE (proxy);
+			m_IsDirty = true;
+			break;
+		}
+	}
+
+	return ;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Reset
+//
+///////////////////////////////////////////////////////////////////////////
+void
+WaypathIndexClass::Reset (void)
+{
+	int index = 0;
+	for (index = 0; index < m_StartProxyList.Count (); index ++) {
+		WaypathCullableClass *proxy = m_StartProxyList[index];
+		m_StartTree.Remove_Object (proxy);
+		REF_PTR_RELEASE (proxy);
+	}
+
+	for (index = 0; index < m_PathProxyList.Count (); index ++) {
+		WaypathCullableClass *proxy = m_PathProxyList[index];
+		m_PathTree.Remove_Object (proxy);
+		REF_PTR_RELEASE (proxy);
+	}
+
+	m_StartProxyList.Delete_All ();
+	m_PathProxyList.Delete_All ();
+	m_IDTable.Remove_All ();
+	m_StartCacheList.Delete_All ();
+	m_NextSequence			= 0;
+	m_IsDirty				= true;
+	m_IsStartCacheValid	= false;
+	return ;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Update_Trees
+//
+///////////////////////////////////////////////////////////////////////////
+void
+WaypathIndexClass::Update_Trees (void)
+{
+	//
+	//	Objects added after the last partition just get pushed down
+	// the existing tree, so rebuild it once before the next query.
+	//
+	if (m_IsDirty) {
+		m_StartTree.Re_Partition ();
+		m_PathTree.Re_Partition ();
+		m_IsDirty = false;
+	}
+
+	return ;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Find
+//
+///////////////////////////////////////////////////////////////////////////
+WaypathClass *
+WaypathIndexClass::Find (int id) const
+{
+	return m_IDTable.Get (id);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Collect_Sorted
+//
+///////////////////////////////////////////////////////////////////////////
+void
+WaypathIndexClass::Collect_Sorted
+(
+	WAYPATH_TREE &			tree,
+	const AABoxClass &	box,
+	PROXY_LIST &			list
+)
+{
+	Update_Trees ();
+
+	tree.Reset_Collection ();
+	tree.Collect_Objects (box);
+
+	WaypathCullableClass *proxy = NULL;
+	for (	proxy = tree.Get_First_Collected_Object ();
+			proxy != NULL;
+			proxy = tree.Get_Next_Collected_Object (proxy))
+	{
+		list.Add (proxy);
+	}
+
+	//
+	//	Put the results back into the order the waypaths were added in
+	//
+	if (list.Count () > 1) {
+		::qsort (&list[0], list.Count (), sizeof (WaypathCullableClass *), fnCompareProxySequenceCallback);
+	}
+
+	return ;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Collect_Starting_In_Box
+//
+///////////////////////////////////////////////////////////////////////////
+void
+WaypathIndexClass::Collect_Starting_In_Box
+(
+	const AABoxClass &						box,
+	DynamicVectorClass<WaypathClass *> &	list
+)
+{
+	Update_Start_Cache (box);
+	for (int index = 0; index < m_StartCacheList.Count (); index ++) {
+		list.Add (m_StartCacheList[index]);
+	}
+
+	return ;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Count_Starting_In_Box
+//
+///////////////////////////////////////////////////////////////////////////
+int
+WaypathIndexClass::Count_Starting_In_Box (const AABoxClass &box)
+{
+	Update_Start_Cache (box);
+	return m_StartCacheList.Count ();
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Get_Starting_In_Box
+//
+///////////////////////////////////////////////////////////////////////////
+WaypathClass *
+WaypathIndexClass::Get_Starting_In_Box (const AABoxClass &box, int index)
+{
+	WaypathClass *waypath = NULL;
+
+	Update_Start_Cache (box);
+	if (index >= 0 && index < m_StartCacheList.Count ()) {
+		waypath = m_StartCacheList[index];
+	}
+
+	return waypath;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Update_Start_Cache
+//
+///////////////////////////////////////////////////////////////////////////
+void
+WaypathIndexClass::Update_Start_Cache (const AABoxClass &box)
+{
+	//
+	//	Redo the query unless it is the same as the last one
+	//
+	if (	m_IsStartCacheValid == false ||
+			m_StartCacheBox.Center != box.Center ||
+			m_StartCacheBox.Extent != box.Extent)
+	{
+		m_StartCacheList.Delete_All ();
+
+		PROXY_LIST proxy_list;
+		Collect_Sorted (m_StartTree, box, proxy_list);
+
+		for (int index = 0; index < proxy_list.Count (); index ++) {
+			WaypathClass *waypath = proxy_list[index]->Peek_Waypath ();
+
+			//
+			//	The tree test is inclusive, keep the original strict
+			// containment test so callers see the same results.
+			//
+			if (CollisionMath::Overlap_Test (box, waypath->Get_Point (0)->Get_Position ()) == CollisionMath::INSIDE) {
+				m_StartCacheList.Add (waypath);
+			}
+		}
+
+		m_StartCacheBox		= box;
+		m_IsStartCacheValid	= true;
+	}
+
+	return ;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Collect_In_Box
+//
+///////////////////////////////////////////////////////////////////////////
+void
+WaypathIndexClass::Collect_In_Box
+(
+	const AABoxClass &						box,
+	DynamicVectorClass<WaypathClass *> &	list
+)
+{
+	PROXY_LIST proxy_list;
+	Collect_Sorted (m_PathTree, box, proxy_list);
+
+	for (int index = 0; index < proxy_list.Count (); index ++) {
+		list.Add (proxy_list[index]->Peek_Waypath ());
+	}
+
+	return ;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Find_Nearest_Start
+//
+///////////////////////////////////////////////////////////////////////////
+WaypathClass *
+WaypathIndexClass::Find_Nearest_Start (const Vector3 &pos, float max_dist)
+{
+	if (m_StartProxyList.Count () == 0) {
+		return NULL;
+	}
+
+	Update_Trees ();
+
+	//
+	//	There is no point searching further out than the farthest
+	// corner of the tree.
+	//
+	const AABoxClass &bounds = m_StartTree.Get_Bounding_Box ();
+	float limit = (pos - bounds.Center).Length () + bounds.Extent.Length ();
+	limit = WWMath::Min (limit, max_dist);
+
+	//
+	//	Search a growing box around the position.  A candidate can only
+	// be trusted once it is inside the sphere the box encloses, anything
+	// in the box corners might still lose to a point just outside it.
+	//
+	float radius = WWMath::Min (INITIAL_NEAREST_RADIUS, limit);
+	for (;;) {
+
+		AABoxClass box (pos, Vector3 (radius, radius, radius));
+		m_StartTree.Reset_Collection ();
+		m_StartTree.Collect_Objects (box);
+
+		WaypathCullableClass *best_proxy	= NULL;
+		float best_dist2						= radius * radius;
+
+		WaypathCullableClass *proxy = NULL;
+		for (	proxy = m_StartTree.Get_First_Collected_Object ();
+				proxy != NULL;
+				proxy = m_StartTree.Get_Next_Collected_Object (proxy))
+		{
+			float dist2 = (proxy->Get_Cull_Box ().Center - pos).Length2 ();
+			if (	dist2 < best_dist2 ||
+					(dist2 == best_dist2 && (best_proxy == NULL || proxy->Get_Sequence () < best_proxy->Get_Sequence ())))
+			{
+				best_proxy	= proxy;
+				best_dist2	= dist2;
+			}
+		}
+
+		if (best_proxy != NULL) {
+			return best_proxy->Peek_Waypath ();
+		}
+
+		if (radius >= limit) {
+			break;
+		}
+
+		radius = WWMath::Min (radius * 2.0F, limit);
+	}
+
+	return NULL;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	fnCompareProxySequenceCallback
+//
+///////////////////////////////////////////////////////////////////////////
+static int __cdecl
+fnCompareProxySequenceCallback
+(
+	const void *elem1,
+	const void *elem2
+)
+{
+	WaypathCullableClass *proxy1 = *((WaypathCullableClass **)elem1);
+	WaypathCullableClass *proxy2 = *((WaypathCullableClass **)elem2);
+
+	return proxy1->Get_Sequence () - proxy2->Get_Sequence ();
+}
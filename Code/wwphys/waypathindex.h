@@ -0,0 +1,170 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/***********************************************************************************************
+ ***              C O N F I D E N T I A L  ---  W E S T W O O D  S T U D I O S               ***
+ ***********************************************************************************************
+ *                                                                                             *
+ *                 Project Name : wwphys																		  *
+ *                                                                                             *
+ *                     $Archive:: /Commando/Code/wwphys/waypathindex.h                        $*
+ *                                                                                             *
+ *---------------------------------------------------------------------------------------------*
+ * Functions:                                                                                  *
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#ifndef __WAYPATH_INDEX_H
+#define __WAYPATH_INDEX_H
+
+#include "aabtreecull.h"
+#include "hashtemplate.h"
+#include "vector.h"
+
+
+/////////////////////////////////////////////////////////////////////////
+// Forward declarations
+/////////////////////////////////////////////////////////////////////////
+class WaypathClass;
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	WaypathCullableClass
+//
+//		Proxy that lets a waypath live in an AABTree culling system.  A
+//	waypath has one proxy for its start point and one for its whole
+// extent.  The sequence number records the order the waypath was added
+// in, so query results can be returned in the same order the old linear
+// scan returned them.
+//
+/////////////////////////////////////////////////////////////////////////
+class WaypathCullableClass : public CullableClass
+{
+public:
+
+	/////////////////////////////////////////////////////////////////////////
+	// Public constructors/destructors
+	/////////////////////////////////////////////////////////////////////////
+	WaypathCullableClass (WaypathClass *waypath, int sequence)
+		:	m_Waypath (waypath),
+			m_Sequence (sequence)	{}
+
+	/////////////////////////////////////////////////////////////////////////
+	// Public methods
+	/////////////////////////////////////////////////////////////////////////
+	WaypathClass *		Peek_Waypath (void) const	{ return m_Waypath; }
+	int					Get_Sequence (void) const	{ return m_Sequence; }
+
+private:
+
+	/////////////////////////////////////////////////////////////////////////
+	// Private member data
+	/////////////////////////////////////////////////////////////////////////
+	WaypathClass *		m_Waypath;
+	int					m_Sequence;
+};
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	WaypathIndexClass
+//
+//		Spatial and ID index over the waypaths owned by PathfindClass.
+// Start points and whole-path bounds are kept in two AABTree culling
+// systems and IDs in a hash table, so box, nearest and ID lookups no
+// longer have to walk the whole waypath list.  The trees are
+// re-partitioned lazily on the first query after a change.
+//
+//		The result of the last start point query is kept until the index
+// changes, so the Count/Get-by-index loops scripts use against the same
+// box only do the query once.
+//
+//		The index does not hold a reference on the waypaths themselves,
+// PathfindClass owns those.
+//
+/////////////////////////////////////////////////////////////////////////
+class WaypathIndexClass
+{
+public:
+
+	/////////////////////////////////////////////////////////////////////////
+	// Public constructors/destructors
+	/////////////////////////////////////////////////////////////////////////
+	WaypathIndexClass (void);
+	~WaypathIndexClass (void);
+
+	/////////////////////////////////////////////////////////////////////////
+	// Public methods
+	/////////////////////////////////////////////////////////////////////////
+
+	//
+	//	Maintenance
+	//
+	void					Add (WaypathClass *waypath);
+	void					Remove (WaypathClass *waypath);
+	void					Reset (void);
+
+	//
+	//	Queries
+	//
+	WaypathClass *		Find (int id) const;
+	void					Collect_Starting_In_Box (const AABoxClass &box, DynamicVectorClass<WaypathClass *> &list);
+	int					Count_Starting_In_Box (const AABoxClass &box);
+	WaypathClass *		Get_Starting_In_Box (const AABoxClass &box, int index);
+	void					Collect_In_Box (const AABoxClass &box, DynamicVectorClass<WaypathClass *> &list);
+	WaypathClass *		Find_Nearest_Start (const Vector3 &pos, float max_dist);
+
+private:
+
+	/////////////////////////////////////////////////////////////////////////
+	// Private data types
+	/////////////////////////////////////////////////////////////////////////
+	typedef TypedAABTreeCullSystemClass<WaypathCullableClass>	WAYPATH_TREE;
+	typedef DynamicVectorClass<WaypathCullableClass *>				PROXY_LIST;
+
+	/////////////////////////////////////////////////////////////////////////
+	// Private methods
+	/////////////////////////////////////////////////////////////////////////
+	void					Update_Trees (void);
+	void					Remove_Proxy (WAYPATH_TREE &tree, PROXY_LIST &proxy_list, WaypathClass *waypath);
+	void					Collect_Sorted (WAYPATH_TREE &tree, const AABoxClass &box, PROXY_LIST &list);
+	void					Update_Start_Cache (const AABoxClass &box);
+	void					Invalidate_Cache (void)		{ m_IsStartCacheValid = false; }
+
+	/////////////////////////////////////////////////////////////////////////
+	// Private member data
+	/////////////////////////////////////////////////////////////////////////
+	WAYPATH_TREE							m_StartTree;
+	WAYPATH_TREE							m_PathTree;
+	PROXY_LIST								m_StartProxyList;
+	PROXY_LIST								m_PathProxyList;
+	HashTemplateClass<int, WaypathClass *>	m_IDTable;
+	int										m_NextSequence;
+	bool										m_IsDirty;
+
+	AABoxClass								m_StartCacheBox;
+	DynamicVectorClass<WaypathClass *>	m_StartCacheList;
+	bool										m_IsStartCacheValid;
+};
+
+
+#endif //__WAYPATH_INDEX_H
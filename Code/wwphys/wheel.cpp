@@ -38,6 +38,8 @@
  *   SuspensionElementClass::~SuspensionElementClass -- Destructor                             *
  *   SuspensionElementClass::Init -- Initialization, pass in bone indices for this wheel       *
  *   SuspensionElementClass::Intersect_Spring -- Intersect the suspension spring with the terr *
+ *   SuspensionElementClass::Begin_Intersect_Spring -- Compute the spring ray                  *
+ *   SuspensionElementClass::End_Intersect_Spring -- Evaluate the result of the spring ray     *
  *   SuspensionElementClass::Update_Model -- Update the wheel transforms in the model.         *
  *   SuspensionElementClass::Translate_Wheel_On_Axis -- Translates the wheel to the contact po *
  *   SuspensionElementClass::Translate_Wheel -- Translates the wheel to the contact point      *
@@ -60,6 +62,7 @@
 #include "physcon.h"
 #include "pscene.h"
 #include "wwprofile.h"
+#include "collisionprofiler.h"
 
 
 // Wheel friction is a proportional controller, this is the constant.
@@ -305,6 +308,35 @@ void SuspensionElementClass::Init(VehiclePhysClass * obj,int pbone,int rbone,int
  *   12/18/2000 gth : Created.                                                                 *
  *=============================================================================================*/
 void SuspensionElementClass::Intersect_Spring(void)
+{
+	COLLISION_PROFILE_CATEGORY("Wheels");
+
+	LineSegClass line;
+	if (!Begin_Intersect_Spring(&line)) return;
+
+	// cast a ray, colliding with "physical" objects
+	CastResultStruct result;
+	PhysRayCollisionTestClass raytest(line,&result,Parent->Get_Collision_Group(),COLLISION_TYPE_PHYSICAL | COLLISION_TYPE_VEHICLE);
+	PhysicsSceneClass::Get_Instance()->Cast_Ray(raytest,false);
+
+	End_Intersect_Spring(line,result);
+}
+
+
+/***********************************************************************************************
+ * SuspensionElementClass::Begin_Intersect_Spring -- Compute the spring ray                    *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * set_line - returns the ray to cast                                                          *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ * false if the spring hasn't moved since the last cast and no ray needs to be cast            *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+bool SuspensionElementClass::Begin_Intersect_Spring(LineSegClass * set_line)
 {
 	WWASSERT(Parent != NULL);
 
@@ -318,21 +350,35 @@ void SuspensionElementClass::Intersect_Spring(void)
 
 	// If the spring endpoints haven't changed don't do raycast (very expensive)
 	// TODO: Ensure we are not on top of an animated mesh!
-	if (p1==SpringEndP1 && WheelP0==SpringEndP0) return;
+	if (p1==SpringEndP1 && WheelP0==SpringEndP0) return false;
 	SpringEndP1=p1;
 	SpringEndP0=WheelP0;
 
-	// cast a ray, colliding with "physical" objects
-	LineSegClass line(WheelP0,p1);
-	CastResultStruct result;
-	PhysRayCollisionTestClass raytest(line,&result,Parent->Get_Collision_Group(),COLLISION_TYPE_PHYSICAL | COLLISION_TYPE_VEHICLE);
-	PhysicsSceneClass::Get_Instance()->Cast_Ray(raytest,false);
+	set_line->Set(WheelP0,p1);
+	return true;
+}
+
 
+/***********************************************************************************************
+ * SuspensionElementClass::End_Intersect_Spring -- Evaluate the result of the spring ray       *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * line - the ray returned by Begin_Intersect_Spring                                           *
+ * result - result of casting it                                                               *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void SuspensionElementClass::End_Intersect_Spring(const LineSegClass & line,const CastResultStruct & result)
+{
 	// evaluate the result of the raycast
 	if (result.Fraction >= 1.0f) {
 		Set_Flag(INCONTACT,false);
-		WheelTM.Set_Translation(p1);
-		Contact = p1;
+		WheelTM.Set_Translation(line.Get_P1());
+		Contact = line.Get_P1();
 	} else {
 		Set_Flag(INCONTACT,true);
 		line.Compute_Point(result.Fraction,&Contact);
@@ -699,7 +745,10 @@ void WheelClass::Compute_Force_And_Torque(Vector3 * force,Vector3 * torque)
 	
 	// Intersect the spring with the world to find our contact point
 	// If it doesn't hit anything, we are done!
-	{
+	// (the parent vehicle may already have done this as part of a batch)
+	if (Get_Flag(SPRING_CAST)) {
+		Set_Flag(SPRING_CAST,false);
+	} else {
 		WWPROFILE("Intersect_Spring");
 		Intersect_Spring();	
 	}
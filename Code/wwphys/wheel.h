@@ -44,6 +44,8 @@
 
 class VehiclePhysClass;
 class RenderObjClass;
+class LineSegClass;
+struct CastResultStruct;
 
 
 /*
@@ -116,6 +118,7 @@ public:
 		DISABLED					= 0x0100,			// this wheel is disabled
 		INCONTACT				= 0x0200,			// this wheel is in contact with the ground
 		BRAKING					= 0x0400,			// this wheel is undergoing braking
+		SPRING_CAST				= 0x0800,			// the spring ray was already cast as part of a batch this step
 		DEFAULT_FLAGS			= 0
 	};
 
@@ -160,6 +163,14 @@ public:
 
 	virtual void	Non_Physical_Update(float suspension_fraction,float rotation);
 
+	/*
+	** Spring intersection split in two so the parent vehicle can cast all of its
+	** spring rays in one batch.  Begin returns false if the spring hasn't moved
+	** and no ray needs to be cast.
+	*/
+	bool				Begin_Intersect_Spring(LineSegClass * set_line);
+	void				End_Intersect_Spring(const LineSegClass & line,const CastResultStruct & result);
+
 protected:
 
 	/*
@@ -55,6 +55,7 @@ enum
 	PHYSICS_CHUNKID_STATIC_DATA_SUBSYSTEM		= CHUNKID_WWPHYS_BEGIN,
 	PHYSICS_CHUNKID_STATIC_OBJECTS_SUBSYSTEM,
 	PHYSICS_CHUNKID_DYNAMIC_DATA_SUBSYSTEM		= CHUNKID_WWPHYS_BEGIN + 0x50,
+	PHYSICS_CHUNKID_RECORDING_SUBSYSTEM,
 
 	// Individual persist object chunk id's
 	PHYSICS_CHUNKID_DECORATIONPHYS				= CHUNKID_WWPHYS_BEGIN + 0x100,
@@ -169,6 +169,16 @@ inline void
 DefinitionClass::Set_Name (const char *new_name)
 {
 	m_Name = new_name;
+
+	//
+	//	If we are registered with the definition manager, then re-link
+	// ourselves so it forgets any lookups by our old name
+	//
+	if (m_DefinitionMgrLink != -1) {
+		DefinitionMgrClass::Unregister_Definition (this);
+		DefinitionMgrClass::Register_Definition (this);
+	}
+
 	return ;
 }
 
@@ -77,7 +77,8 @@ enum
 DefinitionClass **	DefinitionMgrClass::_SortedDefinitionArray	= NULL;
 int						DefinitionMgrClass::_DefinitionCount			= 0;
 int						DefinitionMgrClass::_MaxDefinitionCount		= 0;
-HashTemplateClass<StringClass, DynamicVectorClass<DefinitionClass*>*>* DefinitionMgrClass::DefinitionHash;
+HashTemplateClass<StringAtomClass, DynamicVectorClass<DefinitionClass*>*>* DefinitionMgrClass::DefinitionHash;
+HashTemplateClass<StringAtomClass, DefinitionClass*>* DefinitionMgrClass::NamedDefinitionHash;
 
 //////////////////////////////////////////////////////////////////////////////////
 //
@@ -180,22 +181,80 @@ DefinitionMgrClass::Find_Definition (uint32 id, bool twiddle)
 //////////////////////////////////////////////////////////////////////////////////
 DefinitionClass *
 DefinitionMgrClass::Find_Named_Definition (const char *name, bool twiddle)
+{
+	StringAtomClass atom;
+	if (Find_Name_Atom (name, atom) == false) {
+		return NULL;
+	}
+
+	return Find_Named_Definition (atom, twiddle);
+}
+
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//	Find_Name_Atom
+//
+//	Looks up the atom for a name without adding the names of failed searches
+// to the atom table.  Registered and loaded definitions have atoms for their
+// names, but one that was renamed may not, so a name without an atom is
+// checked against the definitions before it is given up on.
+//
+//////////////////////////////////////////////////////////////////////////////////
+bool
+DefinitionMgrClass::Find_Name_Atom (const char *name, StringAtomClass &atom)
+{
+	atom = StringAtomClass::Find (name);
+	if (atom.Is_Empty () == false || name == NULL || name[0] == 0) {
+		return true;
+	}
+
+	for (int index = 0; index < _DefinitionCount; index ++) {
+		DefinitionClass *curr_def = _SortedDefinitionArray[index];
+		if (curr_def != NULL && ::stricmp (curr_def->Get_Name (), name) == 0) {
+			atom = StringAtomClass (name);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//	Find_Named_Definition
+//
+//////////////////////////////////////////////////////////////////////////////////
+DefinitionClass *
+DefinitionMgrClass::Find_Named_Definition (const StringAtomClass &name, bool twiddle)
 {
 	DefinitionClass *definition = NULL;
 
 	//
-	//	Loop through all the definitions and see if we can
-	// find the one with the requested name
+	//	The hash table remembers the result of every search by name (including
+	// the ones that failed) until definitions are registered, unregistered or loaded.
 	//
-	for (int index = 0; index < _DefinitionCount; index ++) {
-		DefinitionClass *curr_def = _SortedDefinitionArray[index];
-		
+	if (NamedDefinitionHash == NULL || NamedDefinitionHash->Get (name, definition) == false) {
+
 		//
-		//	Is this the definition we were looking for?
+		//	Loop through all the definitions and see if we can
+		// find the one with the requested name
 		//
-		if (curr_def != NULL && ::stricmp (curr_def->Get_Name (), name) == 0) {
-			definition = curr_def;
-			break;
+		for (int index = 0; index < _DefinitionCount; index ++) {
+			DefinitionClass *curr_def = _SortedDefinitionArray[index];
+			
+			//
+			//	Is this the definition we were looking for?
+			//
+			if (curr_def != NULL && ::stricmp (curr_def->Get_Name (), name.Get_String ()) == 0) {
+				definition = curr_def;
+				break;
+			}
+		}
+
+		if (NamedDefinitionHash != NULL) {
+			NamedDefinitionHash->Insert (name, definition);
 		}
 	}
 
@@ -222,12 +281,29 @@ DefinitionMgrClass::Find_Named_Definition (const char *name, bool twiddle)
 
 DefinitionClass *
 DefinitionMgrClass::Find_Typed_Definition (const char *name, uint32 class_id, bool twiddle)
+{
+	StringAtomClass atom;
+	if (Find_Name_Atom (name, atom) == false) {
+		return NULL;
+	}
+
+	return Find_Typed_Definition (atom, class_id, twiddle);
+}
+
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//	Find_Typed_Definition
+//
+//////////////////////////////////////////////////////////////////////////////////
+DefinitionClass *
+DefinitionMgrClass::Find_Typed_Definition (const StringAtomClass &name, uint32 class_id, bool twiddle)
 {
 	//
 	//	Sanity check
 	//
 	if (DefinitionHash == NULL) {
-		WWDEBUG_SAY (("DefinitionMgrClass::Find_Typed_Definition () failed due to a NULL DefinitionHash. %s\n", name));
+		WWDEBUG_SAY (("DefinitionMgrClass::Find_Typed_Definition () failed due to a NULL DefinitionHash. %s\n", name.Get_String ()));
 		return NULL;
 	}
 
@@ -241,9 +317,7 @@ DefinitionMgrClass::Find_Typed_Definition (const char *name, uint32 class_id, bo
 	//
 	WWASSERT(DefinitionHash != NULL);
 
-	StringClass lower_case_name(name,true);
-	_strlwr(lower_case_name.Peek_Buffer());
-	DynamicVectorClass<DefinitionClass*>* defs = DefinitionHash->Get(lower_case_name);
+	DynamicVectorClass<DefinitionClass*>* defs = DefinitionHash->Get(name);
 
 	if (defs) {
 		for (int i=0;i<defs->Length();++i) {
@@ -280,12 +354,12 @@ DefinitionMgrClass::Find_Typed_Definition (const char *name, uint32 class_id, bo
 					//
 					//	Is this the definition we were looking for?
 					//
-					if (::stricmp (curr_def->Get_Name (), name) == 0) {
+					if (::stricmp (curr_def->Get_Name (), name.Get_String ()) == 0) {
 						definition = curr_def;
 						// Add the definition to the hash table, so that it can be quickly accessed the next time it is needed.
 						if (!defs) {
 							defs=new DynamicVectorClass<DefinitionClass*>;
-							DefinitionHash->Insert(lower_case_name,defs);
+							DefinitionHash->Insert(name,defs);
 						}
 						defs->Add(definition);
 						break;
@@ -466,17 +540,13 @@ DefinitionMgrClass::Get_Next (DefinitionClass *curr_def)
 void
 DefinitionMgrClass::Free_Definitions (void)
 {
-	// Clear the hash table
+	// Clear the hash tables
 	if (DefinitionHash) {
-		HashTemplateIterator<StringClass,DynamicVectorClass<DefinitionClass*>*> ite(*DefinitionHash);
-		for (ite.First();!ite.Is_Done();ite.Next()) {
-			DynamicVectorClass<DefinitionClass*>* defs=ite.Peek_Value();
-//			delete ite.Peek_Value();
-			delete defs;
-		}
-		DefinitionHash->Remove_All();
+		Flush_Name_Hashes();
 		delete DefinitionHash;
 		DefinitionHash=NULL;
+		delete NamedDefinitionHash;
+		NamedDefinitionHash=NULL;
 	}
 
 	//
@@ -533,7 +603,36 @@ DefinitionMgrClass::Prepare_Definition_Array (void)
 		_SortedDefinitionArray	= new_array;
 		_MaxDefinitionCount		= new_size;		
 	}
-	if (!DefinitionHash) DefinitionHash=new HashTemplateClass<StringClass, DynamicVectorClass<DefinitionClass*>*>;
+	if (!DefinitionHash) DefinitionHash=new HashTemplateClass<StringAtomClass, DynamicVectorClass<DefinitionClass*>*>;
+	if (!NamedDefinitionHash) NamedDefinitionHash=new HashTemplateClass<StringAtomClass, DefinitionClass*>;
+
+	return ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////
+//
+//	Flush_Name_Hashes
+//
+//	Forgets the results of all previous searches by name.  Called whenever
+// a definition is registered or unregistered.
+//
+////////////////////////////////////////////////////////////////////////////
+void
+DefinitionMgrClass::Flush_Name_Hashes (void)
+{
+	if (DefinitionHash && DefinitionHash->Get_Count () > 0) {
+		HashTemplateIterator<StringAtomClass,DynamicVectorClass<DefinitionClass*>*> ite(*DefinitionHash);
+		for (ite.First();!ite.Is_Done();ite.Next()) {
+			DynamicVectorClass<DefinitionClass*>* defs=ite.Peek_Value();
+			delete defs;
+		}
+		DefinitionHash->Remove_All();
+	}
+
+	if (NamedDefinitionHash && NamedDefinitionHash->Get_Count () > 0) {
+		NamedDefinitionHash->Remove_All();
+	}
 
 	return ;
 }
@@ -625,6 +724,12 @@ DefinitionMgrClass::Register_Definition (DefinitionClass *definition)
 			definition->m_DefinitionMgrLink			= insert_index;
 			_SortedDefinitionArray[insert_index]	= definition;
 			_DefinitionCount ++;
+			Flush_Name_Hashes ();
+
+			//
+			//	Make sure the name has an atom, the searches by name rely on it
+			//
+			StringAtomClass name_atom (definition->Get_Name ());
 		}
 	}
 
@@ -656,6 +761,7 @@ DefinitionMgrClass::Unregister_Definition (DefinitionClass *definition)
 		_SortedDefinitionArray[_DefinitionCount - 1] = NULL;
 		definition->m_DefinitionMgrLink = -1;
 		_DefinitionCount --;
+		Flush_Name_Hashes ();
 	}
 	
 	return ;
@@ -808,6 +914,11 @@ DefinitionMgrClass::Load_Objects (ChunkLoadClass &cload)
 				//				
 				Prepare_Definition_Array ();
 				_SortedDefinitionArray[_DefinitionCount ++] = definition;				
+
+				//
+				//	Give the name an atom, as Register_Definition does
+				//
+				StringAtomClass name_atom (definition->Get_Name ());
 			}
 		}
 
@@ -828,6 +939,10 @@ DefinitionMgrClass::Load_Objects (ChunkLoadClass &cload)
 		_SortedDefinitionArray[index]->m_DefinitionMgrLink = index;
 	}
 
+	//
+	//	Forget the searches made before these definitions were loaded
+	//
+	Flush_Name_Hashes ();
 	return retval;
 }
 
@@ -50,6 +50,7 @@
 #include "wwdebug.h"
 #include "wwstring.h"
 #include "hashtemplate.h"
+#include "stringatom.h"
 #include "vector.h"
 
 
@@ -86,7 +87,9 @@ public:
 	// Type identification
 	static DefinitionClass *	Find_Definition (uint32 id, bool twiddle = true);
 	static DefinitionClass *	Find_Named_Definition (const char *name, bool twiddle = true);
+	static DefinitionClass *	Find_Named_Definition (const StringAtomClass &name, bool twiddle = true);
 	static DefinitionClass *	Find_Typed_Definition (const char *name, uint32 class_id, bool twiddle = true);
+	static DefinitionClass *	Find_Typed_Definition (const StringAtomClass &name, uint32 class_id, bool twiddle = true);
    static void                List_Available_Definitions (void); 
    static void                List_Available_Definitions (int superclass_id); 	
 	static uint32					Get_New_ID (uint32 class_id);
@@ -130,12 +133,15 @@ protected:
 	bool								Load_Variables (ChunkLoadClass &cload);	
 
 private:
-	static HashTemplateClass<StringClass, DynamicVectorClass<DefinitionClass*>*>* DefinitionHash;
+	static HashTemplateClass<StringAtomClass, DynamicVectorClass<DefinitionClass*>*>* DefinitionHash;
+	static HashTemplateClass<StringAtomClass, DefinitionClass*>* NamedDefinitionHash;
 
 	/////////////////////////////////////////////////////////////////////
 	//	Private methods
 	/////////////////////////////////////////////////////////////////////
 	static void						Prepare_Definition_Array (void);
+	static void						Flush_Name_Hashes (void);
+	static bool						Find_Name_Atom (const char *name, StringAtomClass &atom);
 	static int __cdecl			fnCompareDefinitionsCallback (const void *elem1, const void *elem2);
 
 	/////////////////////////////////////////////////////////////////////